@@ -1,6 +1,8 @@
 release = ["-DCMAKE_BUILD_TYPE=Release"]
 debug = ["-DCMAKE_BUILD_TYPE=Debug"]
 releasenolp = ["-DCMAKE_BUILD_TYPE=Release", "-DUSE_LP=NO"]
+# Compiles the heuristic search algorithms with the struct-of-arrays layout.
+releasesoa = ["-DCMAKE_BUILD_TYPE=Release", "-DUSE_SOA_STATE_INFORMATION=YES"]
 # USE_GLIBCXX_DEBUG is not compatible with USE_LP (see issue983).
 glibcxx_debug = ["-DCMAKE_BUILD_TYPE=Debug", "-DUSE_LP=NO", "-DUSE_GLIBCXX_DEBUG=YES"]
 minimal = ["-DCMAKE_BUILD_TYPE=Release", "-DDISABLE_PLUGINS_BY_DEFAULT=YES"]
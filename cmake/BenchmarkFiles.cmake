@@ -0,0 +1,41 @@
+create_benchmark_library(
+    NAME benchmark_utils
+    HELP "Benchmark harness and synthetic MDPs"
+    SOURCES
+        benchmarks/benchmark
+        benchmarks/synthetic_mdp
+        benchmarks/utils
+    DEPENDS
+        mdp
+        core_probabilistic_tasks
+    CORE_LIBRARY
+)
+
+create_benchmark_library(
+    NAME state_space_benchmarks
+    HELP "State Space Benchmarks"
+    SOURCES
+        benchmarks/state_space_benchmarks
+    DEPENDS
+        benchmark_utils
+)
+
+create_benchmark_library(
+    NAME algorithm_benchmarks
+    HELP "Algorithm Benchmarks"
+    SOURCES
+        benchmarks/algorithm_benchmarks
+    DEPENDS
+        benchmark_utils
+)
+
+create_benchmark_library(
+    NAME pdb_benchmarks
+    HELP "PDB Benchmarks"
+    SOURCES
+        benchmarks/pdb_benchmarks
+    DEPENDS
+        benchmark_utils
+        probability_aware_pdbs
+        padbs_pattern_generators
+)
@@ -49,10 +49,16 @@ create_probfd_library(
 
     # Utility
     probfd/utils/guards
+    probfd/utils/thread_pool
+
+    # Storage
+    probfd/storage/spill_file_resource
+    probfd/storage/value_file
 
     probfd/solver_interface
 
     probfd/solvers/mdp_solver
+    probfd/solvers/policy_simulator
     DEPENDS
     core_sources
     core_tasks
@@ -81,6 +87,7 @@ create_probfd_library(
     probfd/tasks/cost_adapted_task
     probfd/tasks/delegating_task
     probfd/tasks/root_task
+    probfd/tasks/binary_task
     probfd/tasks/all_outcomes_determinization
     CORE_LIBRARY
 )
@@ -124,6 +131,14 @@ create_probfd_library(
     DEPENDS mdp
 )
 
+create_probfd_library(
+    NAME flat_value_iteration_solver
+    HELP "flat_value_iteration"
+    SOURCES
+    probfd/solvers/flat_vi
+    DEPENDS mdp
+)
+
 create_probfd_library(
     NAME interval_iteration_solver
     HELP "interval_iteration"
@@ -263,6 +278,14 @@ create_probfd_library(
     DEPENDS successor_generator task_dependent_heuristic
 )
 
+create_probfd_library(
+    NAME stored_value_heuristic
+    HELP "Heuristic initializing the state values from a value file"
+    SOURCES
+    probfd/heuristics/stored_value_heuristic
+    DEPENDS mdp
+)
+
 create_probfd_library(
     NAME lp_based_heuristic
     HELP "LP-based heuristic"
@@ -300,6 +323,7 @@ create_probfd_library(
     probfd/pdbs/distances
     probfd/pdbs/evaluators
     probfd/pdbs/match_tree
+    probfd/pdbs/pdb_cache
     probfd/pdbs/policy_extraction
     probfd/pdbs/probability_aware_pattern_database
     probfd/pdbs/projection_operator
@@ -308,6 +332,7 @@ create_probfd_library(
     probfd/pdbs/saturation
     probfd/pdbs/state_ranking_function
     probfd/pdbs/utils
+    probfd/pdbs/value_table
     probfd/pdbs/verification
     DEPENDS
         pdbs
@@ -329,6 +354,7 @@ create_probfd_library(
 
     probfd/pdbs/subcollection_finder_factory
     probfd/pdbs/subcollection_finder
+    probfd/pdbs/pdb_collection_evaluator
     probfd/pdbs/max_orthogonal_finder_factory
     probfd/pdbs/max_orthogonal_finder
     probfd/pdbs/trivial_finder_factory
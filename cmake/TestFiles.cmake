@@ -19,6 +19,15 @@ create_test_library(
         core_probabilistic_tasks
 )
 
+create_test_library(
+    NAME small_vector_tests
+    HELP "Small Vector Tests"
+    SOURCES
+        tests/small_vector_tests
+    DEPENDS
+        mdp
+)
+
 create_test_library(
     NAME test_utils
     HELP "Interval Tests"
@@ -65,5 +74,18 @@ create_test_library(
     DEPENDS
         test_utils
         probability_aware_pdbs
+        padbs_pattern_generators
+        papdbs_systematic_generator
+        papdbs_hillclimbing_generator
         mdp
-)
\ No newline at end of file
+)
+
+create_test_library(
+    NAME storage_tests
+    HELP "Storage Tests"
+    SOURCES
+        tests/storage_tests
+    DEPENDS
+        test_utils
+        stored_value_heuristic
+)
@@ -24,6 +24,8 @@ target_compile_options(common_cxx_flags INTERFACE
     "$<${using_gcc_like_release}:-O3;-DNDEBUG;-fomit-frame-pointer>")
 target_compile_definitions(common_cxx_flags INTERFACE
     "$<${should_use_glibcxx_debug}:_GLIBCXX_DEBUG>")
+target_compile_definitions(common_cxx_flags INTERFACE
+    "$<$<BOOL:${USE_SOA_STATE_INFORMATION}>:PROBFD_SOA_STATE_INFORMATION>")
 # Enable exceptions for MSVC.
 target_compile_options(common_cxx_flags INTERFACE
     "$<${using_msvc}:/EHsc>")
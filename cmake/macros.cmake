@@ -86,6 +86,10 @@ function(create_test_library)
     create_library(TARGET probfd_tests FLAGS test_cxx_flags FIND_SOURCES add_existing_test_sources_to_list ${ARGV})
 endfunction()
 
+function(create_benchmark_library)
+    create_library(TARGET probfd_benchmarks FLAGS benchmark_cxx_flags FIND_SOURCES add_existing_test_sources_to_list ${ARGV})
+endfunction()
+
 function(create_library)
     set(_OPTIONS DEPENDENCY_ONLY CORE_LIBRARY)
     set(_ONE_VALUE_ARGS NAME HELP TARGET FLAGS FIND_SOURCES)
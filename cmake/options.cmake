@@ -27,6 +27,14 @@ option USE_LP to false."
             "not supported when an LP solver is used. See issue982 for details.")
     endif()
 
+    option(
+        USE_SOA_STATE_INFORMATION
+        "Store the per-state information of the heuristic search algorithms in \
+one array per field (struct of arrays) instead of one record per state. \
+The search statistics report the number of bytes stored per state for \
+either layout."
+        FALSE)
+
     option(
         DISABLE_LIBRARIES_BY_DEFAULT
         "If set to YES only libraries that are specifically enabled will be compiled"
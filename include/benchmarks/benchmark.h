@@ -0,0 +1,133 @@
+#ifndef BENCHMARKS_BENCHMARK_H
+#define BENCHMARKS_BENCHMARK_H
+
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace benchmarks {
+
+/**
+ * @brief The state of a running benchmark.
+ *
+ * A benchmark performs its setup, then runs the measured code while
+ * keep_running() returns true. Only the loop body is timed, and each iteration
+ * is one repetition of the benchmark:
+ *
+ * @code
+ * PROBFD_BENCHMARK(my_benchmark, "arg1", "arg2")
+ * {
+ *     // setup for state.get_argument() ...
+ *     while (state.keep_running()) {
+ *         // measured code ...
+ *         state.add_counter("states", num_states);
+ *     }
+ * }
+ * @endcode
+ *
+ * Counters are accumulated over all repetitions and reported as throughput,
+ * i.e. divided by the total measured time.
+ */
+class BenchmarkState {
+    using Clock = std::chrono::steady_clock;
+
+    const std::string argument_;
+    const std::filesystem::path resources_directory_;
+    const int repetitions_;
+    int remaining_;
+
+    Clock::time_point start_;
+    Clock::duration elapsed_ = Clock::duration::zero();
+    bool running_ = false;
+
+    std::map<std::string, unsigned long long> counters_;
+
+public:
+    BenchmarkState(
+        std::string argument,
+        std::filesystem::path resources_directory,
+        int repetitions);
+
+    /**
+     * @brief Returns whether another repetition should be run.
+     *
+     * Starts the timer on the first call and stops it once all repetitions
+     * are done.
+     */
+    bool keep_running();
+
+    /// Stops the timer, e.g. to exclude per-repetition setup.
+    void pause_timing();
+
+    /// Restarts the timer after pause_timing().
+    void resume_timing();
+
+    /// Adds \p count to the counter with the given name.
+    void add_counter(const std::string& name, unsigned long long count);
+
+    /// Returns the argument the benchmark was registered with.
+    [[nodiscard]]
+    const std::string& get_argument() const
+    {
+        return argument_;
+    }
+
+    /// Returns the path of the given file in the resources directory.
+    [[nodiscard]]
+    std::filesystem::path get_resource_path(const std::string& file) const
+    {
+        return resources_directory_ / file;
+    }
+
+    [[nodiscard]]
+    int get_repetitions() const
+    {
+        return repetitions_;
+    }
+
+    /// Returns the total measured time in seconds.
+    [[nodiscard]]
+    double get_elapsed_seconds() const;
+
+    [[nodiscard]]
+    const std::map<std::string, unsigned long long>& get_counters() const
+    {
+        return counters_;
+    }
+};
+
+using BenchmarkFunction = void (*)(BenchmarkState&);
+
+/**
+ * @brief Registers a benchmark function once for each given argument.
+ *
+ * The benchmark is run as `<name>/<argument>`. Use the PROBFD_BENCHMARK macro
+ * instead of using this class directly.
+ */
+class BenchmarkRegistration {
+public:
+    BenchmarkRegistration(
+        const std::string& name,
+        BenchmarkFunction function,
+        const std::vector<std::string>& arguments);
+};
+
+/**
+ * @brief Runs all registered benchmarks matching the command line options and
+ * prints a report to stdout. Returns the exit code of the program.
+ */
+int run_benchmarks(int argc, const char* const* argv);
+
+} // namespace benchmarks
+
+#define PROBFD_BENCHMARK(name, ...)                                            \
+    static void name(::benchmarks::BenchmarkState&);                           \
+    static const ::benchmarks::BenchmarkRegistration name##_registration(      \
+        #name,                                                                 \
+        name,                                                                  \
+        {__VA_ARGS__});                                                        \
+    static void name(::benchmarks::BenchmarkState& state)
+
+#endif // BENCHMARKS_BENCHMARK_H
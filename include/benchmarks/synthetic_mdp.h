@@ -0,0 +1,82 @@
+#ifndef BENCHMARKS_SYNTHETIC_MDP_H
+#define BENCHMARKS_SYNTHETIC_MDP_H
+
+#include "probfd/mdp.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace benchmarks {
+
+/**
+ * @brief A randomly generated MDP with integer states and actions.
+ *
+ * The states are 0, ..., num_states - 1, where the last state is the only goal
+ * state. Every non-goal state has num_actions actions, the action of state s
+ * with index i is represented by i. Transitions are generated on the fly from
+ * a hash of the seed, the state and the action, so the MDP does not store
+ * anything and every state is its own state ID.
+ *
+ * The states are partitioned into consecutive blocks of window states. All
+ * actions except the last one have num_outcomes outcomes. The first outcome
+ * makes progress towards the goal by moving up to window states forward, the
+ * remaining outcomes lead to random states in the block of the source state.
+ * Hence, the strongly connected components are (at most) the blocks. The last
+ * action toggles between the states 2k and 2k + 1, so that every such pair is
+ * an end component if window is even.
+ */
+class SyntheticMDP : public probfd::SimpleMDP<int, int> {
+    const int num_states_;
+    const int num_actions_;
+    const int num_outcomes_;
+    const int window_;
+    const std::uint64_t seed_;
+
+public:
+    SyntheticMDP(
+        int num_states,
+        int num_actions,
+        int num_outcomes,
+        int window,
+        std::uint64_t seed);
+
+    probfd::StateID get_state_id(int state) override;
+    int get_state(probfd::StateID state_id) override;
+
+    void generate_applicable_actions(int state, std::vector<int>& result)
+        override;
+
+    void generate_action_transitions(
+        int state,
+        int action,
+        probfd::Distribution<probfd::StateID>& result) override;
+
+    void generate_all_transitions(
+        int state,
+        std::vector<int>& aops,
+        std::vector<probfd::Distribution<probfd::StateID>>& successors)
+        override;
+
+    void generate_all_transitions(
+        int state,
+        std::vector<probfd::Transition<int>>& transitions) override;
+
+    probfd::value_t get_action_cost(int action) override;
+
+    bool is_goal(int state) const override;
+    probfd::value_t get_non_goal_termination_cost() const override;
+
+    [[nodiscard]]
+    int get_num_states() const
+    {
+        return num_states_;
+    }
+
+private:
+    [[nodiscard]]
+    std::uint64_t get_hash(int state, int action, int outcome) const;
+};
+
+} // namespace benchmarks
+
+#endif // BENCHMARKS_SYNTHETIC_MDP_H
@@ -0,0 +1,90 @@
+#ifndef BENCHMARKS_UTILS_H
+#define BENCHMARKS_UTILS_H
+
+#include "benchmarks/synthetic_mdp.h"
+
+#include "probfd/distribution.h"
+#include "probfd/mdp.h"
+#include "probfd/transition.h"
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace probfd {
+class ProbabilisticTask;
+}
+
+namespace benchmarks {
+class BenchmarkState;
+
+/**
+ * @brief Reads the task from the resource file named by the benchmark
+ * argument and makes it the root task.
+ *
+ * Throws std::runtime_error if the file cannot be opened.
+ */
+std::shared_ptr<probfd::ProbabilisticTask>
+load_task(const BenchmarkState& state);
+
+/// Returns the integer benchmark argument, e.g. the size of a synthetic MDP.
+int get_int_argument(const BenchmarkState& state);
+
+/**
+ * @brief Creates the synthetic MDP used by all synthetic benchmarks, with the
+ * number of states given by the benchmark argument.
+ */
+SyntheticMDP create_synthetic_mdp(const BenchmarkState& state);
+
+/**
+ * @brief Explores the state space reachable from \p initial_state in
+ * breadth-first order and returns the number of reachable states.
+ *
+ * The number of generated transitions is added to \p num_transitions.
+ */
+template <typename State, typename Action>
+unsigned long long explore_state_space(
+    probfd::MDP<State, Action>& mdp,
+    probfd::param_type<State> initial_state,
+    unsigned long long& num_transitions)
+{
+    std::vector<bool> seen;
+    std::deque<probfd::StateID> queue;
+
+    std::vector<probfd::Transition<Action>> transitions;
+
+    auto insert = [&](probfd::StateID id) {
+        if (id >= seen.size()) seen.resize(id + 1, false);
+        if (seen[id]) return;
+        seen[id] = true;
+        queue.push_back(id);
+    };
+
+    insert(mdp.get_state_id(initial_state));
+
+    unsigned long long num_states = 0;
+
+    while (!queue.empty()) {
+        const probfd::StateID state_id = queue.front();
+        queue.pop_front();
+        ++num_states;
+
+        const State state = mdp.get_state(state_id);
+        transitions.clear();
+        mdp.generate_all_transitions(state, transitions);
+        num_transitions += transitions.size();
+
+        for (const auto& transition : transitions) {
+            for (const probfd::StateID succ_id :
+                 transition.successor_dist.support()) {
+                insert(succ_id);
+            }
+        }
+    }
+
+    return num_states;
+}
+
+} // namespace benchmarks
+
+#endif // BENCHMARKS_UTILS_H
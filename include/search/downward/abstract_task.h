@@ -43,10 +43,31 @@ inline void feed(HashState& hash_state, const FactPair& fact)
 
 class AbstractTaskBase
     : public subscriber::SubscriberService<AbstractTaskBase> {
+protected:
+    /*
+      Tasks that store the preconditions of their operators contiguously may
+      set these pointers, which allows the task proxies to access the
+      preconditions without virtual calls. The preconditions of operator i are
+      found in the range [precondition_offsets[i], precondition_offsets[i + 1])
+      of contiguous_preconditions.
+    */
+    const int* precondition_offsets = nullptr;
+    const FactPair* contiguous_preconditions = nullptr;
+
 public:
     AbstractTaskBase() = default;
     virtual ~AbstractTaskBase() = default;
 
+    const int* get_precondition_offsets() const
+    {
+        return precondition_offsets;
+    }
+
+    const FactPair* get_contiguous_preconditions() const
+    {
+        return contiguous_preconditions;
+    }
+
     virtual int get_num_variables() const = 0;
     virtual std::string get_variable_name(int var) const = 0;
     virtual int get_variable_domain_size(int var) const = 0;
@@ -39,9 +39,21 @@ public:
     explicit IntPacker(const std::vector<int> &ranges);
     ~IntPacker();
 
+    /*
+      Describes where a variable is stored in a packed buffer: its value is
+      (buffer[bin_index] & read_mask) >> shift.
+    */
+    struct Location {
+        int bin_index;
+        int shift;
+        Bin read_mask;
+    };
+
     int get(const Bin *buffer, int var) const;
     void set(Bin *buffer, int var, int value) const;
 
+    Location get_location(int var) const;
+
     int get_num_bins() const { return num_bins; }
 };
 }
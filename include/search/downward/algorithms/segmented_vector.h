@@ -367,11 +367,11 @@ public:
 
 
     SegmentedArrayVector(size_t elements_per_array_, const ElementAllocator &allocator_)
-        : element_allocator(allocator_),
-          elements_per_array(elements_per_array_),
+        : elements_per_array(elements_per_array_),
           arrays_per_segment(
               std::max(SEGMENT_BYTES / (elements_per_array * sizeof(Element)), size_t(1))),
           elements_per_segment(elements_per_array * arrays_per_segment),
+          element_allocator(allocator_),
           the_size(0) {
     }
 
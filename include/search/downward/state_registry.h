@@ -12,6 +12,7 @@
 #include "downward/task_utils/task_properties.h"
 #include "downward/utils/hash.h"
 
+#include <memory_resource>
 #include <set>
 #include <vector>
 
@@ -114,13 +115,19 @@ class IntPacker;
 using PackedStateBin = int_packer::IntPacker::Bin;
 
 class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
+    /*
+      The packed state data is allocated from a memory resource, which allows
+      to place it in external memory (see probfd::storage::SpillFileResource).
+    */
+    using StateDataPool = segmented_vector::SegmentedArrayVector<
+        PackedStateBin,
+        std::pmr::polymorphic_allocator<PackedStateBin>>;
+
     struct StateIDSemanticHash {
-        const segmented_vector::SegmentedArrayVector<PackedStateBin>&
-            state_data_pool;
+        const StateDataPool& state_data_pool;
         int state_size;
         StateIDSemanticHash(
-            const segmented_vector::SegmentedArrayVector<PackedStateBin>&
-                state_data_pool,
+            const StateDataPool& state_data_pool,
             int state_size)
             : state_data_pool(state_data_pool)
             , state_size(state_size)
@@ -139,12 +146,10 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     };
 
     struct StateIDSemanticEqual {
-        const segmented_vector::SegmentedArrayVector<PackedStateBin>&
-            state_data_pool;
+        const StateDataPool& state_data_pool;
         int state_size;
         StateIDSemanticEqual(
-            const segmented_vector::SegmentedArrayVector<PackedStateBin>&
-                state_data_pool,
+            const StateDataPool& state_data_pool,
             int state_size)
             : state_data_pool(state_data_pool)
             , state_size(state_size)
@@ -172,7 +177,7 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     AxiomEvaluator& axiom_evaluator;
     const int num_variables;
 
-    segmented_vector::SegmentedArrayVector<PackedStateBin> state_data_pool;
+    StateDataPool state_data_pool;
     StateIDSet registered_states;
 
     std::unique_ptr<State> cached_initial_state;
@@ -181,7 +186,9 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     int get_bins_per_state() const;
 
 public:
-    explicit StateRegistry(const TaskBaseProxy& task_proxy);
+    explicit StateRegistry(
+        const TaskBaseProxy& task_proxy,
+        std::pmr::memory_resource* memory = std::pmr::get_default_resource());
 
     const TaskBaseProxy& get_task_proxy() const { return task_proxy; }
 
@@ -451,12 +451,21 @@ public:
 
     std::size_t size() const
     {
+        if (const int* offsets = task->get_precondition_offsets()) {
+            return offsets[op_index + 1] - offsets[op_index];
+        }
         return task->get_num_operator_preconditions(op_index);
     }
 
     FactProxy operator[](std::size_t fact_index) const
     {
         assert(fact_index < size());
+        if (const int* offsets = task->get_precondition_offsets()) {
+            return FactProxy(
+                *task,
+                task->get_contiguous_preconditions()
+                    [offsets[op_index] + fact_index]);
+        }
         return FactProxy(
             *task,
             task->get_operator_precondition(op_index, fact_index));
@@ -15,7 +15,7 @@ class CountdownTimer;
 
 namespace probfd::policies {
 template <typename, typename>
-class MapPolicy;
+class VectorPolicy;
 }
 
 /// Namespace dedicated to the acyclic value iteration algorithm.
@@ -68,7 +68,7 @@ class AcyclicValueIteration : public MDPAlgorithm<State, Action> {
     using MDPType = typename Base::MDPType;
     using EvaluatorType = typename Base::EvaluatorType;
 
-    using MapPolicy = policies::MapPolicy<State, Action>;
+    using VectorPolicy = policies::VectorPolicy<State, Action>;
 
     using StateInfo = internal::StateInfo<Action>;
     using Statistics = internal::Statistics;
@@ -94,14 +94,14 @@ class AcyclicValueIteration : public MDPAlgorithm<State, Action> {
             MDPType& mdp);
 
         bool next_successor();
-        bool next_transition(MDPType& mdp, MapPolicy* policy);
+        bool next_transition(MDPType& mdp, VectorPolicy* policy);
 
         void backtrack_successor(value_t probability, StateInfo& succ_info);
 
     private:
         void setup_transition(MDPType& mdp);
         void finalize_transition();
-        void finalize_expansion(MapPolicy* policy);
+        void finalize_expansion(VectorPolicy* policy);
     };
 
     Statistics statistics_;
@@ -129,7 +129,7 @@ public:
         EvaluatorType& heuristic,
         param_type<State> initial_state,
         double max_time,
-        MapPolicy* policy);
+        VectorPolicy* policy);
 
     void print_statistics(std::ostream& out) const override;
 
@@ -138,12 +138,12 @@ private:
         MDPType& mdp,
         EvaluatorType& heuristic,
         utils::CountdownTimer& timer,
-        MapPolicy* policy);
+        VectorPolicy* policy);
 
     bool dfs_backtrack(
         MDPType& mdp,
         utils::CountdownTimer& timer,
-        MapPolicy* policy);
+        VectorPolicy* policy);
 
     bool push_state(
         MDPType& mdp,
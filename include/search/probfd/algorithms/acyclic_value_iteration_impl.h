@@ -4,7 +4,7 @@
 
 #include "probfd/algorithms/utils.h"
 
-#include "probfd/policies/map_policy.h"
+#include "probfd/policies/vector_policy.h"
 
 #include "probfd/evaluator.h"
 #include "probfd/mdp.h"
@@ -44,7 +44,7 @@ bool AcyclicValueIteration<State, Action>::IncrementalExpansionInfo::
 
 template <typename State, typename Action>
 bool AcyclicValueIteration<State, Action>::IncrementalExpansionInfo::
-    next_transition(MDPType& mdp, MapPolicy* policy)
+    next_transition(MDPType& mdp, VectorPolicy* policy)
 {
     assert(!remaining_aops.empty());
     remaining_aops.pop_back();
@@ -79,7 +79,7 @@ auto AcyclicValueIteration<State, Action>::compute_policy(
     ProgressReport,
     double max_time) -> std::unique_ptr<PolicyType>
 {
-    std::unique_ptr<MapPolicy> policy(new MapPolicy(&mdp));
+    std::unique_ptr<VectorPolicy> policy(new VectorPolicy(&mdp));
     this->solve(mdp, heuristic, initial_state, max_time, policy.get());
     return policy;
 }
@@ -101,7 +101,7 @@ Interval AcyclicValueIteration<State, Action>::solve(
     EvaluatorType& heuristic,
     param_type<State> initial_state,
     double max_time,
-    MapPolicy* policy)
+    VectorPolicy* policy)
 {
     utils::CountdownTimer timer(max_time);
 
@@ -132,7 +132,7 @@ void AcyclicValueIteration<State, Action>::dfs_expand(
     MDPType& mdp,
     EvaluatorType& heuristic,
     utils::CountdownTimer& timer,
-    MapPolicy* policy)
+    VectorPolicy* policy)
 {
     IncrementalExpansionInfo* e = &expansion_stack_.top();
 
@@ -175,7 +175,7 @@ void AcyclicValueIteration<State, Action>::IncrementalExpansionInfo::
 
 template <typename State, typename Action>
 void AcyclicValueIteration<State, Action>::IncrementalExpansionInfo::
-    finalize_expansion(MapPolicy* policy)
+    finalize_expansion(VectorPolicy* policy)
 {
     if (!policy) return;
     policy->emplace_decision(
@@ -188,7 +188,7 @@ template <typename State, typename Action>
 bool AcyclicValueIteration<State, Action>::dfs_backtrack(
     MDPType& mdp,
     utils::CountdownTimer& timer,
-    MapPolicy* policy)
+    VectorPolicy* policy)
 {
     IncrementalExpansionInfo* e;
 
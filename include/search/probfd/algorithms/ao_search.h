@@ -3,10 +3,12 @@
 
 #include "probfd/algorithms/heuristic_search_base.h"
 
+#include "probfd/storage/chunked_list_pool.h"
 #include "probfd/storage/per_state_storage.h"
 
 #include <iosfwd>
 #include <queue>
+#include <span>
 #include <type_traits>
 #include <vector>
 
@@ -26,7 +28,10 @@ struct PerStateInformation : public StateInfo {
     static constexpr uint8_t BITS = StateInfo::BITS + 2;
 
     unsigned update_order = 0;
-    std::vector<StateID> parents;
+
+    // The first parents are stored inline, the remaining ones in the parent
+    // list pool of the algorithm.
+    storage::ChunkedListPool<StateID>::List parents;
 
     [[nodiscard]]
     bool is_tip_state() const
@@ -52,18 +57,6 @@ struct PerStateInformation : public StateInfo {
         return (this->info & MASK) == 0;
     }
 
-    [[nodiscard]]
-    const std::vector<StateID>& get_parents() const
-    {
-        return parents;
-    }
-
-    [[nodiscard]]
-    std::vector<StateID>& get_parents()
-    {
-        return parents;
-    }
-
     void mark()
     {
         assert(!is_solved());
@@ -73,8 +66,6 @@ struct PerStateInformation : public StateInfo {
     void unmark() { this->info = (this->info & ~MARK); }
 
     void set_solved() { this->info = (this->info & ~MASK) | SOLVED; }
-
-    void add_parent(StateID s) { parents.push_back(s); }
 };
 
 /**
@@ -100,7 +91,9 @@ class AOBase
           Action,
           Interval,
           StorePolicy,
-          StateInfoExtension> {
+          StateInfoExtension,
+          // The update order is stored in the state information.
+          heuristic_search::StateInfoLayout::ARRAY_OF_STRUCTS> {
     using Base = typename AOBase::HeuristicSearchAlgorithm;
 
 protected:
@@ -124,6 +117,13 @@ private:
 
     std::priority_queue<PrioritizedStateID> queue_;
 
+    // The parent lists of all states. Released once a state is solved.
+    storage::ChunkedListPool<StateID> parent_lists_;
+
+    // The states of the current backpropagation batch whose parents must be
+    // pushed to the queue.
+    std::vector<StateID> batch_;
+
 protected:
     std::vector<Transition<Action>> transitions_;
 
@@ -157,8 +157,12 @@ protected:
         bool& value_changed,
         utils::CountdownTimer& timer);
 
+    void add_parent(StateInfo& info, StateID parent);
+
     void push_parents_to_queue(StateInfo& info);
 
+    void push_parents_to_queue(std::span<const StateID> states);
+
     void mark_solved_push_parents(StateInfo& info, bool dead);
 
 private:
@@ -3,6 +3,7 @@
 #endif
 
 #include <ostream>
+#include <span>
 
 #include "downward/utils/countdown_timer.h"
 
@@ -24,6 +25,8 @@ void AOBase<State, Action, Interval, StorePolicy, StateInfoExtension>::
     print_additional_statistics(std::ostream& out) const
 {
     statistics_.print(out);
+    out << "  Parent list memory: " << parent_lists_.size_in_bytes()
+        << " bytes" << std::endl;
 }
 
 template <
@@ -56,36 +59,47 @@ void AOBase<State, Action, Interval, StorePolicy, StateInfoExtension>::
     while (!queue_.empty()) {
         timer.throw_if_expired();
 
-        auto elem = queue_.top();
-        queue_.pop();
+        // All queued states of the lowest update order are updated as one
+        // batch. Afterwards, the parents of the batch are pushed in one pass.
+        const unsigned update_order = queue_.top().update_order;
 
-        auto& info = this->get_state_info(elem.state_id);
-        assert(!info.is_goal_state());
-        assert(!info.is_terminal() || info.is_solved());
+        do {
+            const StateID state_id = queue_.top().state_id;
+            queue_.pop();
 
-        if (info.is_solved()) {
-            // has been handled already
-            continue;
-        }
+            auto& info = this->get_state_info(state_id);
+            assert(!info.is_goal_state());
+            assert(!info.is_terminal() || info.is_solved());
 
-        assert(info.is_marked());
-        info.unmark();
-
-        bool solved = false;
-        bool dead = false;
-        bool value_changed = update_value_check_solved(
-            mdp,
-            heuristic,
-            elem.state_id,
-            info,
-            solved,
-            dead);
-
-        if (solved) {
-            mark_solved_push_parents(info, dead);
-        } else if (value_changed) {
-            push_parents_to_queue(info);
-        }
+            if (info.is_solved()) {
+                // has been handled already
+                continue;
+            }
+
+            assert(info.is_marked());
+            info.unmark();
+
+            bool solved = false;
+            bool dead = false;
+            bool value_changed = update_value_check_solved(
+                mdp,
+                heuristic,
+                state_id,
+                info,
+                solved,
+                dead);
+
+            if (solved) {
+                assert(!dead || info.is_dead_end());
+                info.set_solved();
+                batch_.push_back(state_id);
+            } else if (value_changed) {
+                batch_.push_back(state_id);
+            }
+        } while (!queue_.empty() && queue_.top().update_order == update_order);
+
+        push_parents_to_queue(batch_);
+        batch_.clear();
     }
 }
 
@@ -112,7 +126,7 @@ void AOBase<State, Action, Interval, StorePolicy, StateInfoExtension>::
             continue;
         }
 
-        std::erase_if(info.get_parents(), [this, elem](StateID state_id) {
+        parent_lists_.erase_if(info.parents, [this, elem](StateID state_id) {
             auto& pinfo = this->get_state_info(state_id);
             if (pinfo.is_solved()) {
                 return true;
@@ -167,6 +181,19 @@ void AOBase<State, Action, Interval, StorePolicy, StateInfoExtension>::
     assert(queue_.empty());
 }
 
+template <
+    typename State,
+    typename Action,
+    bool Interval,
+    bool StorePolicy,
+    template <typename>
+    class StateInfoExtension>
+void AOBase<State, Action, Interval, StorePolicy, StateInfoExtension>::
+    add_parent(StateInfo& info, StateID parent)
+{
+    parent_lists_.add(info.parents, parent);
+}
+
 template <
     typename State,
     typename Action,
@@ -177,29 +204,51 @@ template <
 void AOBase<State, Action, Interval, StorePolicy, StateInfoExtension>::
     push_parents_to_queue(StateInfo& info)
 {
-    auto& parents = info.get_parents();
-    for (StateID parent : parents) {
-        auto& pinfo = this->get_state_info(parent);
-        assert(!pinfo.is_dead_end() || pinfo.is_solved());
+    const bool solved = info.is_solved();
+    [[maybe_unused]] const bool alive = !info.is_dead_end();
+
+    // The parents are processed one chunk at a time.
+    parent_lists_.for_each_chunk(
+        info.parents,
+        [&](std::span<const StateID> parents) {
+            for (const StateID parent : parents) {
+                auto& pinfo = this->get_state_info(parent);
+                assert(!pinfo.is_dead_end() || pinfo.is_solved());
+
+                if constexpr (!StorePolicy) {
+                    if (solved) {
+                        assert(pinfo.unsolved > 0 || pinfo.is_solved());
+                        --pinfo.unsolved;
+                        if (alive) {
+                            pinfo.alive = 1;
+                        }
+                    }
+                }
 
-        if constexpr (!StorePolicy) {
-            if (info.is_solved()) {
-                assert(pinfo.unsolved > 0 || pinfo.is_solved());
-                --pinfo.unsolved;
-                if (!info.is_dead_end()) {
-                    pinfo.alive = 1;
+                if (pinfo.is_unflagged()) {
+                    pinfo.mark();
+                    queue_.emplace(pinfo.update_order, parent);
                 }
             }
-        }
+        });
 
-        if (pinfo.is_unflagged()) {
-            pinfo.mark();
-            queue_.emplace(pinfo.update_order, parent);
-        }
+    if (solved) {
+        parent_lists_.clear(info.parents);
     }
+}
 
-    if (info.is_solved()) {
-        utils::release_vector_memory(parents);
+template <
+    typename State,
+    typename Action,
+    bool Interval,
+    bool StorePolicy,
+    template <typename>
+    class StateInfoExtension>
+void AOBase<State, Action, Interval, StorePolicy, StateInfoExtension>::
+    push_parents_to_queue(std::span<const StateID> states)
+{
+    for (const StateID state_id : states) {
+        push_parents_to_queue(this->get_state_info(state_id));
     }
 }
 
@@ -96,7 +96,7 @@ Interval AOStar<State, Action, UseInterval>::do_solve(
 
                         assert(!succ_info.is_solved());
                         succ_info.mark();
-                        succ_info.add_parent(stateid);
+                        this->add_parent(succ_info, stateid);
                         assert(
                             succ_info.update_order <
                             std::numeric_limits<unsigned>::max());
@@ -80,7 +80,7 @@ Interval ExhaustiveAOSearch<State, Action, UseInterval>::do_solve(
                 if (!succ_info.is_solved()) {
                     if (!succ_info.is_marked()) {
                         succ_info.mark();
-                        succ_info.add_parent(stateid);
+                        this->add_parent(succ_info, stateid);
                         min_succ_order =
                             std::min(min_succ_order, succ_info.update_order);
                         ++unsolved;
@@ -0,0 +1,204 @@
+#ifndef PROBFD_ALGORITHMS_FLAT_VALUE_ITERATION_H
+#define PROBFD_ALGORITHMS_FLAT_VALUE_ITERATION_H
+
+#include "probfd/algorithms/types.h"
+
+#include "probfd/preprocessing/end_component_decomposition.h"
+
+#include "probfd/quotients/quotient_system.h"
+
+#include "probfd/flat_explicit_mdp.h"
+#include "probfd/mdp_algorithm.h"
+
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include <vector>
+
+// Forward Declarations
+namespace utils {
+class CountdownTimer;
+}
+
+namespace probfd::policies {
+template <typename, typename>
+class VectorPolicy;
+}
+
+/// Namespace dedicated to value iteration on flat explicit MDP snapshots.
+namespace probfd::algorithms::flat_vi {
+
+/**
+ * @brief Flat value iteration statistics.
+ */
+struct Statistics {
+    unsigned long long states = 0;
+    unsigned long long transitions = 0;
+    unsigned long long successors = 0;
+    unsigned long long sccs = 0;
+    unsigned long long singleton_sccs = 0;
+    unsigned long long bellman_backups = 0;
+    unsigned long long sweeps = 0;
+    std::size_t memory_bytes = 0;
+
+    void print(std::ostream& out) const;
+};
+
+/**
+ * @brief Value iteration on a flat explicit snapshot of the MDP.
+ *
+ * The algorithm first explores the reachable state space once and stores it
+ * as a FlatExplicitMDP. All Bellman backups afterwards run as tight loops over
+ * the contiguous transition arrays of the snapshot, without any further
+ * queries to the MDP interface or allocations.
+ *
+ * In topological mode, the SCCs of the snapshot are computed with Tarjan's
+ * algorithm and solved one after another in reverse topological order, like
+ * in TopologicalValueIteration. Otherwise, Gauss-Seidel sweeps over all states
+ * in reverse exploration order are performed until convergence.
+ *
+ * With value intervals, both bounds are iterated until neither changes by
+ * more than g_epsilon. Zero-cost end components (traps) would keep the upper
+ * bound from converging, so, as in interval iteration, they are collapsed by
+ * the end component decomposition first and the snapshot is taken of the
+ * resulting quotient. The policy decisions for the members of a collapsed
+ * trap lead towards the member that owns the optimal quotient action, like
+ * in FRET.
+ *
+ * @tparam State - The state type of the underlying MDP model.
+ * @tparam Action - The action type of the underlying MDP model.
+ * @tparam UseInterval - Whether value intervals are used.
+ */
+template <typename State, typename Action, bool UseInterval = false>
+class FlatValueIteration : public MDPAlgorithm<State, Action> {
+    using Base = typename FlatValueIteration::MDPAlgorithm;
+
+    using PolicyType = typename Base::PolicyType;
+    using MDPType = typename Base::MDPType;
+    using EvaluatorType = typename Base::EvaluatorType;
+
+    using VectorPolicy = policies::VectorPolicy<State, Action>;
+    using AlgorithmValueType = algorithms::AlgorithmValue<UseInterval>;
+
+    using QSystem = quotients::QuotientSystem<State, Action>;
+    using QState = quotients::QuotientState<State, Action>;
+    using QAction = quotients::QuotientAction<Action>;
+
+    using FlatMDP = FlatExplicitMDP<Action>;
+    using FlatQuotientMDP = FlatExplicitMDP<QAction>;
+    using StateIndex = typename FlatMDP::StateIndex;
+    using TransitionIndex = typename FlatMDP::TransitionIndex;
+
+    static constexpr TransitionIndex NO_TRANSITION =
+        std::numeric_limits<TransitionIndex>::max();
+
+    const bool expand_goals_;
+    const bool topological_;
+
+    Statistics statistics_;
+    preprocessing::ECDStatistics ecd_statistics_;
+
+public:
+    FlatValueIteration(bool expand_goals, bool topological);
+
+    std::unique_ptr<PolicyType> compute_policy(
+        MDPType& mdp,
+        EvaluatorType& heuristic,
+        param_type<State> state,
+        ProgressReport progress,
+        double max_time) override;
+
+    Interval solve(
+        MDPType& mdp,
+        EvaluatorType& heuristic,
+        param_type<State> state,
+        ProgressReport progress,
+        double max_time) override;
+
+    void print_statistics(std::ostream& out) const override;
+
+    /**
+     * @brief Retreive the algorithm statistics.
+     */
+    [[nodiscard]]
+    Statistics get_statistics() const;
+
+    /**
+     * @brief Solves a flat MDP snapshot.
+     *
+     * Stores the value of every state of the snapshot in \p values and, if
+     * \p best_transitions is not null, the index of a greedy transition or
+     * NO_TRANSITION for terminal states in \p best_transitions.
+     *
+     * The snapshot is solved as is. With value intervals, it must not contain
+     * zero-cost end components for the upper bound to converge.
+     */
+    template <typename FlatAction>
+    void solve(
+        const FlatExplicitMDP<FlatAction>& flat_mdp,
+        std::vector<AlgorithmValueType>& values,
+        std::vector<TransitionIndex>* best_transitions,
+        utils::CountdownTimer& timer);
+
+private:
+    Interval solve(
+        MDPType& mdp,
+        EvaluatorType& heuristic,
+        param_type<State> state,
+        double max_time,
+        VectorPolicy* policy);
+
+    Interval solve_quotient(
+        MDPType& mdp,
+        EvaluatorType& heuristic,
+        param_type<State> state,
+        utils::CountdownTimer& timer,
+        VectorPolicy* policy);
+
+    template <typename FlatAction>
+    void set_snapshot_statistics(const FlatExplicitMDP<FlatAction>& flat_mdp);
+
+    /**
+     * Adds the policy decisions for the members of \p trap other than
+     * \p exiting_id, which lead to \p exiting_id within the trap.
+     */
+    static void add_trap_decisions(
+        MDPType& mdp,
+        const QState& trap,
+        StateID exiting_id,
+        Interval bound,
+        VectorPolicy& policy);
+
+    /**
+     * Computes the Bellman update of a state and applies it to its value.
+     * Returns true if the value changed by more than g_epsilon.
+     */
+    template <typename FlatAction>
+    static bool bellman_update(
+        const FlatExplicitMDP<FlatAction>& flat_mdp,
+        StateIndex state,
+        std::vector<AlgorithmValueType>& values,
+        TransitionIndex* best_transition);
+
+    template <typename FlatAction>
+    void topological_value_iteration(
+        const FlatExplicitMDP<FlatAction>& flat_mdp,
+        std::vector<AlgorithmValueType>& values,
+        std::vector<TransitionIndex>* best_transitions,
+        utils::CountdownTimer& timer);
+
+    template <typename FlatAction>
+    void gauss_seidel_value_iteration(
+        const FlatExplicitMDP<FlatAction>& flat_mdp,
+        std::vector<AlgorithmValueType>& values,
+        std::vector<TransitionIndex>* best_transitions,
+        utils::CountdownTimer& timer);
+};
+
+} // namespace probfd::algorithms::flat_vi
+
+#define GUARD_INCLUDE_PROBFD_ALGORITHMS_FLAT_VALUE_ITERATION_H
+#include "probfd/algorithms/flat_value_iteration_impl.h"
+#undef GUARD_INCLUDE_PROBFD_ALGORITHMS_FLAT_VALUE_ITERATION_H
+
+#endif // PROBFD_ALGORITHMS_FLAT_VALUE_ITERATION_H
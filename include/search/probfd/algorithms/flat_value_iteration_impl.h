@@ -0,0 +1,459 @@
+#ifndef GUARD_INCLUDE_PROBFD_ALGORITHMS_FLAT_VALUE_ITERATION_H
+#error "This file should only be included from flat_value_iteration.h"
+#endif
+
+#include "probfd/algorithms/utils.h"
+
+#include "probfd/policies/vector_policy.h"
+
+#include "probfd/quotients/quotient_max_heuristic.h"
+
+#include "probfd/evaluator.h"
+#include "probfd/progress_report.h"
+
+#include "downward/utils/countdown_timer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <set>
+#include <span>
+#include <unordered_map>
+
+namespace probfd::algorithms::flat_vi {
+
+inline void Statistics::print(std::ostream& out) const
+{
+    out << "  Stored state(s): " << states << std::endl;
+    out << "  Stored transition(s): " << transitions << std::endl;
+    out << "  Stored successor(s): " << successors << std::endl;
+    out << "  Snapshot memory: " << memory_bytes << " bytes" << std::endl;
+    if (sccs != 0) {
+        out << "  Maximal SCCs: " << sccs << " (" << singleton_sccs
+            << " are singleton)" << std::endl;
+    } else {
+        out << "  Sweeps: " << sweeps << std::endl;
+    }
+    out << "  Bellman backups: " << bellman_backups << std::endl;
+}
+
+template <typename State, typename Action, bool UseInterval>
+FlatValueIteration<State, Action, UseInterval>::FlatValueIteration(
+    bool expand_goals,
+    bool topological)
+    : expand_goals_(expand_goals)
+    , topological_(topological)
+{
+}
+
+template <typename State, typename Action, bool UseInterval>
+auto FlatValueIteration<State, Action, UseInterval>::compute_policy(
+    MDPType& mdp,
+    EvaluatorType& heuristic,
+    param_type<State> state,
+    ProgressReport,
+    double max_time) -> std::unique_ptr<PolicyType>
+{
+    std::unique_ptr<VectorPolicy> policy(new VectorPolicy(&mdp));
+    this->solve(mdp, heuristic, state, max_time, policy.get());
+    return policy;
+}
+
+template <typename State, typename Action, bool UseInterval>
+Interval FlatValueIteration<State, Action, UseInterval>::solve(
+    MDPType& mdp,
+    EvaluatorType& heuristic,
+    param_type<State> state,
+    ProgressReport,
+    double max_time)
+{
+    return this->solve(mdp, heuristic, state, max_time, nullptr);
+}
+
+template <typename State, typename Action, bool UseInterval>
+void FlatValueIteration<State, Action, UseInterval>::print_statistics(
+    std::ostream& out) const
+{
+    statistics_.print(out);
+    if constexpr (UseInterval) ecd_statistics_.print(out);
+}
+
+template <typename State, typename Action, bool UseInterval>
+Statistics FlatValueIteration<State, Action, UseInterval>::get_statistics() const
+{
+    return statistics_;
+}
+
+template <typename State, typename Action, bool UseInterval>
+Interval FlatValueIteration<State, Action, UseInterval>::solve(
+    MDPType& mdp,
+    EvaluatorType& heuristic,
+    param_type<State> state,
+    double max_time,
+    VectorPolicy* policy)
+{
+    utils::CountdownTimer timer(max_time);
+
+    if constexpr (UseInterval) {
+        return solve_quotient(mdp, heuristic, state, timer, policy);
+    } else {
+        const FlatMDP flat_mdp(
+            mdp,
+            heuristic,
+            mdp.get_state_id(state),
+            expand_goals_,
+            timer);
+
+        set_snapshot_statistics(flat_mdp);
+
+        std::vector<AlgorithmValueType> values;
+        std::vector<TransitionIndex> best_transitions;
+
+        solve(flat_mdp, values, policy ? &best_transitions : nullptr, timer);
+
+        if (policy) {
+            for (StateIndex s = 0; s != flat_mdp.num_states(); ++s) {
+                const TransitionIndex t = best_transitions[s];
+                if (t == NO_TRANSITION) continue;
+
+                policy->emplace_decision(
+                    flat_mdp.get_state_id(s),
+                    flat_mdp.get_action(t),
+                    Interval(values[s], INFINITE_VALUE));
+            }
+        }
+
+        return Interval(values.front(), INFINITE_VALUE);
+    }
+}
+
+template <typename State, typename Action, bool UseInterval>
+Interval FlatValueIteration<State, Action, UseInterval>::solve_quotient(
+    MDPType& mdp,
+    EvaluatorType& heuristic,
+    param_type<State> state,
+    utils::CountdownTimer& timer,
+    VectorPolicy* policy)
+{
+    preprocessing::EndComponentDecomposition<State, Action> ec_decomposer(
+        expand_goals_);
+
+    std::unique_ptr<QSystem> quotient = ec_decomposer.build_quotient_system(
+        mdp,
+        &heuristic,
+        state,
+        timer.get_remaining_time());
+
+    ecd_statistics_ = ec_decomposer.get_statistics();
+
+    quotients::QuotientMaxHeuristic<State, Action> qheuristic(heuristic);
+
+    const FlatQuotientMDP flat_mdp(
+        *quotient,
+        qheuristic,
+        quotient->translate_state_id(mdp.get_state_id(state)),
+        expand_goals_,
+        timer);
+
+    set_snapshot_statistics(flat_mdp);
+
+    std::vector<AlgorithmValueType> values;
+    std::vector<TransitionIndex> best_transitions;
+
+    solve(flat_mdp, values, policy ? &best_transitions : nullptr, timer);
+
+    if (policy) {
+        for (StateIndex s = 0; s != flat_mdp.num_states(); ++s) {
+            const TransitionIndex t = best_transitions[s];
+            if (t == NO_TRANSITION) continue;
+
+            const QAction& quotient_action = flat_mdp.get_action(t);
+
+            policy->emplace_decision(
+                quotient_action.state_id,
+                quotient_action.action,
+                values[s]);
+
+            const QState trap = quotient->get_state(flat_mdp.get_state_id(s));
+
+            if (trap.num_members() != 1) {
+                add_trap_decisions(
+                    mdp,
+                    trap,
+                    quotient_action.state_id,
+                    values[s],
+                    *policy);
+            }
+        }
+    }
+
+    return values.front();
+}
+
+template <typename State, typename Action, bool UseInterval>
+template <typename FlatAction>
+void FlatValueIteration<State, Action, UseInterval>::set_snapshot_statistics(
+    const FlatExplicitMDP<FlatAction>& flat_mdp)
+{
+    statistics_.states = flat_mdp.num_states();
+    statistics_.transitions = flat_mdp.num_transitions();
+    statistics_.successors = flat_mdp.num_successors();
+    statistics_.memory_bytes = flat_mdp.get_memory_usage();
+}
+
+template <typename State, typename Action, bool UseInterval>
+void FlatValueIteration<State, Action, UseInterval>::add_trap_decisions(
+    MDPType& mdp,
+    const QState& trap,
+    StateID exiting_id,
+    Interval bound,
+    VectorPolicy& policy)
+{
+    // Build the inverse graph of the actions within the trap and traverse it
+    // backwards from the exiting state. Every member is assigned the action
+    // with which it is first reached.
+    std::unordered_map<StateID, std::set<QAction>> parents;
+
+    std::vector<QAction> inner_actions;
+    trap.get_collapsed_actions(inner_actions);
+
+    Distribution<StateID> successors;
+
+    for (const QAction& qaction : inner_actions) {
+        successors.clear();
+        mdp.generate_action_transitions(
+            mdp.get_state(qaction.state_id),
+            qaction.action,
+            successors);
+
+        for (const StateID succ_id : successors.support()) {
+            parents[succ_id].insert(qaction);
+        }
+    }
+
+    std::deque<StateID> queue;
+    std::set<StateID> visited;
+    queue.push_back(exiting_id);
+    visited.insert(exiting_id);
+
+    do {
+        const StateID next_id = queue.front();
+        queue.pop_front();
+
+        for (const auto& [pred_id, action] : parents[next_id]) {
+            if (visited.insert(pred_id).second) {
+                policy.emplace_decision(pred_id, action, bound);
+                queue.push_back(pred_id);
+            }
+        }
+    } while (!queue.empty());
+}
+
+template <typename State, typename Action, bool UseInterval>
+template <typename FlatAction>
+void FlatValueIteration<State, Action, UseInterval>::solve(
+    const FlatExplicitMDP<FlatAction>& flat_mdp,
+    std::vector<AlgorithmValueType>& values,
+    std::vector<TransitionIndex>* best_transitions,
+    utils::CountdownTimer& timer)
+{
+    const std::size_t num_states = flat_mdp.num_states();
+
+    values.clear();
+    values.reserve(num_states);
+
+    for (StateIndex s = 0; s != num_states; ++s) {
+        if constexpr (UseInterval) {
+            values.emplace_back(
+                flat_mdp.get_estimate(s),
+                flat_mdp.get_termination_cost(s));
+        } else {
+            values.push_back(flat_mdp.get_estimate(s));
+        }
+    }
+
+    if (best_transitions) {
+        best_transitions->assign(num_states, NO_TRANSITION);
+    }
+
+    if (topological_) {
+        topological_value_iteration(flat_mdp, values, best_transitions, timer);
+    } else {
+        gauss_seidel_value_iteration(
+            flat_mdp,
+            values,
+            best_transitions,
+            timer);
+    }
+}
+
+template <typename State, typename Action, bool UseInterval>
+template <typename FlatAction>
+bool FlatValueIteration<State, Action, UseInterval>::bellman_update(
+    const FlatExplicitMDP<FlatAction>& flat_mdp,
+    StateIndex state,
+    std::vector<AlgorithmValueType>& values,
+    TransitionIndex* best_transition)
+{
+    AlgorithmValueType best(flat_mdp.get_termination_cost(state));
+    TransitionIndex best_t = NO_TRANSITION;
+
+    for (const TransitionIndex t : flat_mdp.transitions(state)) {
+        const std::span<const StateIndex> succs = flat_mdp.successors(t);
+        const std::span<const value_t> probs = flat_mdp.probabilities(t);
+
+        AlgorithmValueType q(flat_mdp.get_cost(t));
+
+        for (std::size_t i = 0; i != succs.size(); ++i) {
+            q += probs[i] * values[succs[i]];
+        }
+
+        if (set_min(best, q)) best_t = t;
+    }
+
+    if (best_transition) *best_transition = best_t;
+
+    return update(values[state], best);
+}
+
+template <typename State, typename Action, bool UseInterval>
+template <typename FlatAction>
+void FlatValueIteration<State, Action, UseInterval>::
+    topological_value_iteration(
+        const FlatExplicitMDP<FlatAction>& flat_mdp,
+        std::vector<AlgorithmValueType>& values,
+        std::vector<TransitionIndex>* best_transitions,
+        utils::CountdownTimer& timer)
+{
+    constexpr unsigned UNVISITED = std::numeric_limits<unsigned>::max();
+
+    struct Frame {
+        StateIndex state;
+        const StateIndex* next_successor;
+        const StateIndex* end;
+    };
+
+    const std::size_t num_states = flat_mdp.num_states();
+
+    std::vector<unsigned> dfs_index(num_states, UNVISITED);
+    std::vector<unsigned> lowlink(num_states);
+    std::vector<bool> on_stack(num_states, false);
+    std::vector<std::size_t> stack_pos(num_states);
+    std::vector<StateIndex> stack;
+    std::vector<Frame> call_stack;
+
+    unsigned next_index = 0;
+
+    auto best_of = [best_transitions](StateIndex s) {
+        return best_transitions ? &(*best_transitions)[s] : nullptr;
+    };
+
+    auto push = [&](StateIndex s) {
+        dfs_index[s] = lowlink[s] = next_index++;
+        on_stack[s] = true;
+        stack_pos[s] = stack.size();
+        stack.push_back(s);
+        const std::span<const StateIndex> succs = flat_mdp.all_successors(s);
+        call_stack.emplace_back(s, succs.data(), succs.data() + succs.size());
+    };
+
+    // All states are reachable from the initial state with index 0.
+    push(0);
+
+    while (!call_stack.empty()) {
+        Frame& frame = call_stack.back();
+
+        if (frame.next_successor != frame.end) {
+            const StateIndex succ = *frame.next_successor++;
+
+            if (dfs_index[succ] == UNVISITED) {
+                push(succ);
+            } else if (on_stack[succ]) {
+                lowlink[frame.state] =
+                    std::min(lowlink[frame.state], dfs_index[succ]);
+            }
+
+            continue;
+        }
+
+        const StateIndex state = frame.state;
+        call_stack.pop_back();
+
+        if (!call_stack.empty()) {
+            const StateIndex parent = call_stack.back().state;
+            lowlink[parent] = std::min(lowlink[parent], lowlink[state]);
+        }
+
+        if (lowlink[state] != dfs_index[state]) continue;
+
+        timer.throw_if_expired();
+
+        // Found an SCC. All successor SCCs have converged already.
+        // The SCC root is where it was pushed, so no stack search is needed.
+        auto scc_begin = stack.begin() + stack_pos[state];
+        const std::span<const StateIndex> scc(scc_begin, stack.end());
+
+        ++statistics_.sccs;
+
+        for (const StateIndex s : scc) {
+            on_stack[s] = false;
+        }
+
+        if (scc.size() == 1) {
+            ++statistics_.singleton_sccs;
+            ++statistics_.bellman_backups;
+            bellman_update(flat_mdp, state, values, best_of(state));
+        } else {
+            bool converged;
+
+            do {
+                timer.throw_if_expired();
+
+                converged = true;
+
+                for (const StateIndex s : scc) {
+                    if (bellman_update(flat_mdp, s, values, best_of(s))) {
+                        converged = false;
+                    }
+                }
+
+                statistics_.bellman_backups += scc.size();
+            } while (!converged);
+        }
+
+        stack.erase(scc_begin, stack.end());
+    }
+}
+
+template <typename State, typename Action, bool UseInterval>
+template <typename FlatAction>
+void FlatValueIteration<State, Action, UseInterval>::
+    gauss_seidel_value_iteration(
+        const FlatExplicitMDP<FlatAction>& flat_mdp,
+        std::vector<AlgorithmValueType>& values,
+        std::vector<TransitionIndex>* best_transitions,
+        utils::CountdownTimer& timer)
+{
+    const auto num_states = static_cast<StateIndex>(flat_mdp.num_states());
+
+    bool converged;
+
+    do {
+        timer.throw_if_expired();
+
+        converged = true;
+
+        // Sweep in reverse exploration order, so that states close to the
+        // initial state see updated successor values.
+        for (StateIndex s = num_states; s-- != 0;) {
+            TransitionIndex* best =
+                best_transitions ? &(*best_transitions)[s] : nullptr;
+            if (bellman_update(flat_mdp, s, values, best)) converged = false;
+        }
+
+        ++statistics_.sweeps;
+        statistics_.bellman_backups += num_states;
+    } while (!converged);
+}
+
+} // namespace probfd::algorithms::flat_vi
@@ -11,6 +11,7 @@
 #include "downward/utils/timer.h"
 #endif
 
+#include <deque>
 #include <limits>
 #include <type_traits>
 
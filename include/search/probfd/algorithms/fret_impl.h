@@ -2,7 +2,7 @@
 #error "This file should only be included from fret.h"
 #endif
 
-#include "probfd/policies/map_policy.h"
+#include "probfd/policies/vector_policy.h"
 
 #include "probfd/quotients/quotient_max_heuristic.h"
 
@@ -71,8 +71,8 @@ auto FRET<State, Action, StateInfoT, GreedyGraphGenerator>::compute_policy(
      * it is encountered first as the policy action.
      */
 
-    std::unique_ptr<policies::MapPolicy<State, Action>> policy(
-        new policies::MapPolicy<State, Action>(&mdp));
+    std::unique_ptr<policies::VectorPolicy<State, Action>> policy(
+        new policies::VectorPolicy<State, Action>(&mdp));
 
     const StateID initial_state_id = mdp.get_state_id(state);
 
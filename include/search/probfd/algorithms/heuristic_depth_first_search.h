@@ -130,6 +130,7 @@ class HeuristicDepthFirstSearch
 
 public:
     using StateInfo = typename Base::StateInfo;
+    using StateInfoRef = typename Base::StateInfoRef;
 
 private:
     using MDP = typename Base::MDPType;
@@ -213,7 +214,7 @@ private:
         MDP& mdp,
         Evaluator& heuristic,
         StateID stateid,
-        StateInfo& sinfo,
+        StateInfoRef sinfo,
         bool& parent_value_changed);
 
     bool value_iteration(
@@ -62,7 +62,7 @@ HeuristicDepthFirstSearch<State, Action, UseInterval>::
 template <typename State, typename Action, bool UseInterval>
 void HeuristicDepthFirstSearch<State, Action, UseInterval>::reset_search_state()
 {
-    for (StateInfo& state_info : this->get_state_infos()) {
+    for (StateInfoRef state_info : this->get_state_infos()) {
         state_info.clear();
     }
 }
@@ -146,7 +146,7 @@ bool HeuristicDepthFirstSearch<State, Action, UseInterval>::policy_exploration(
     ClearGuard _(state_infos_);
 
     {
-        StateInfo& pers_info = this->get_state_info(state);
+        StateInfoRef pers_info = this->get_state_info(state);
         bool value_changed = false;
         const uint8_t pstatus =
             push(mdp, heuristic, state, pers_info, value_changed);
@@ -268,7 +268,7 @@ bool HeuristicDepthFirstSearch<State, Action, UseInterval>::push_successor(
 
         StateID succid = einfo.get_current_successor();
 
-        StateInfo& pers_succ_info = this->get_state_info(succid);
+        StateInfoRef pers_succ_info = this->get_state_info(succid);
 
         if (pers_succ_info.is_solved()) {
             continue;
@@ -315,7 +315,7 @@ uint8_t HeuristicDepthFirstSearch<State, Action, UseInterval>::push(
     MDP& mdp,
     Evaluator& heuristic,
     StateID stateid,
-    StateInfo& sinfo,
+    StateInfoRef sinfo,
     bool& parent_value_changed)
 {
     using namespace internal;
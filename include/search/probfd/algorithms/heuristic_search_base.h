@@ -2,7 +2,9 @@
 #define PROBFD_ALGORITHMS_HEURISTIC_SEARCH_BASE_H
 
 #include "probfd/algorithms/heuristic_search_state_information.h"
+#include "probfd/algorithms/qvalue_batch.h"
 #include "probfd/algorithms/types.h"
+#include "probfd/algorithms/utils.h"
 
 #include "probfd/mdp_algorithm.h"
 #include "probfd/progress_report.h"
@@ -13,7 +15,11 @@
 
 #include <iostream>
 #include <limits>
+#include <optional>
+#include <ranges>
+#include <span>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 // Forward Declarations
@@ -78,11 +84,37 @@ struct Statistics : public CoreStatistics {
     }
 };
 
+template <typename StateInfo, StateInfoLayout = StateInfo::Layout>
+class StateInfos;
+
+/// Replaces the base information of a (possibly extended) state information
+/// type by \p NewBase.
+template <typename StateInfo, typename NewBase>
+struct RebindBaseInformation {
+    static_assert(
+        std::is_same_v<StateInfo, typename StateInfo::BaseInformation>);
+    using type = NewBase;
+};
+
+template <template <typename> class Extension, typename Base, typename NewBase>
+struct RebindBaseInformation<Extension<Base>, NewBase> {
+    using type = Extension<typename RebindBaseInformation<Base, NewBase>::type>;
+};
+
+/**
+ * @brief Stores one state information record per state.
+ */
 template <typename StateInfo>
-class StateInfos : public StateProperties {
+class StateInfos<StateInfo, StateInfoLayout::ARRAY_OF_STRUCTS>
+    : public StateProperties {
     storage::PerStateStorage<StateInfo> state_infos_;
 
 public:
+    using reference = StateInfo&;
+    using const_reference = const StateInfo&;
+
+    static constexpr std::size_t BYTES_PER_STATE = sizeof(StateInfo);
+
     StateInfo& operator[](StateID sid) { return state_infos_[sid]; }
     const StateInfo& operator[](StateID sid) const { return state_infos_[sid]; }
 
@@ -99,6 +131,120 @@ public:
     auto get_infos() { return std::views::all(state_infos_); }
 };
 
+/**
+ * @brief Stores the flags, the values and the policy of all states in
+ * separate columns.
+ *
+ * Accessing the information of a state yields a proxy object referring to
+ * the fields of the state. Scans that only read some of the fields, e.g. the
+ * values, therefore only touch the corresponding columns.
+ */
+template <typename StateInfo>
+class StateInfos<StateInfo, StateInfoLayout::STRUCT_OF_ARRAYS>
+    : public StateProperties {
+    using BaseInformation = typename StateInfo::BaseInformation;
+    using Action = typename StateInfo::ActionType;
+    using AlgorithmValueType = AlgorithmValue<StateInfo::UseInterval>;
+
+    static_assert(
+        sizeof(StateInfo) == sizeof(BaseInformation),
+        "The struct-of-arrays layout does not support state information "
+        "extensions with data members.");
+
+    // The proxy handed out for const accesses. Its fields are const
+    // references, so it cannot be used to modify the state information.
+    using ReadOnlyBaseInformation = PerStateBaseInformation<
+        Action,
+        StateInfo::StorePolicy,
+        StateInfo::UseInterval,
+        StateInfoLayout::STRUCT_OF_ARRAYS_READ_ONLY>;
+    using ReadOnlyStateInfo =
+        typename RebindBaseInformation<StateInfo, ReadOnlyBaseInformation>::
+            type;
+
+    struct NoPolicyColumn {};
+
+    storage::PerStateStorage<std::uint8_t> flags_;
+    storage::PerStateStorage<AlgorithmValueType> values_;
+
+    [[no_unique_address]]
+    std::conditional_t<
+        StateInfo::StorePolicy,
+        storage::PerStateStorage<std::optional<Action>>,
+        NoPolicyColumn> policies_;
+
+public:
+    using reference = StateInfo;
+    using const_reference = const ReadOnlyStateInfo;
+
+    static constexpr std::size_t BYTES_PER_STATE =
+        sizeof(std::uint8_t) + sizeof(AlgorithmValueType) +
+        (StateInfo::StorePolicy ? sizeof(std::optional<Action>) : 0);
+
+    StateInfo operator[](StateID sid)
+    {
+        if constexpr (StateInfo::StorePolicy) {
+            return make_info<StateInfo, BaseInformation>(
+                flags_[sid],
+                values_[sid],
+                policies_[sid]);
+        } else {
+            return make_info<StateInfo, BaseInformation>(
+                flags_[sid],
+                values_[sid]);
+        }
+    }
+
+    // The fields of the returned proxy refer to default values if the state
+    // is not stored yet.
+    const ReadOnlyStateInfo operator[](StateID sid) const
+    {
+        if constexpr (StateInfo::StorePolicy) {
+            return make_info<ReadOnlyStateInfo, ReadOnlyBaseInformation>(
+                flags_[sid],
+                values_[sid],
+                policies_[sid]);
+        } else {
+            return make_info<ReadOnlyStateInfo, ReadOnlyBaseInformation>(
+                flags_[sid],
+                values_[sid]);
+        }
+    }
+
+    value_t lookup_value(StateID state_id) override
+    {
+        return as_lower_bound(values_[state_id]);
+    }
+
+    Interval lookup_bounds(StateID state_id) override
+    {
+        if constexpr (StateInfo::UseInterval) {
+            return values_[state_id];
+        } else {
+            return Interval(values_[state_id], INFINITE_VALUE);
+        }
+    }
+
+    auto get_infos()
+    {
+        return std::views::iota(std::size_t(0), flags_.size()) |
+               std::views::transform(
+                   [this](std::size_t i) { return (*this)[StateID(i)]; });
+    }
+
+private:
+    template <typename Info, typename Base>
+    static Info make_info(auto& flags, auto& value, auto&... policy)
+    {
+        Base base{{policy...}, {flags}, value};
+        if constexpr (std::is_same_v<Info, Base>) {
+            return base;
+        } else {
+            return Info{base};
+        }
+    }
+};
+
 } // namespace internal
 
 /**
@@ -125,15 +271,31 @@ public:
 
     using AlgorithmValueType = AlgorithmValue<UseInterval>;
 
+private:
+    using StateInfoStorage = internal::StateInfos<StateInfo>;
+
+public:
+    /// A reference to the state information of a state. A proxy object for
+    /// the struct-of-arrays layout.
+    using StateInfoRef = typename StateInfoStorage::reference;
+    using ConstStateInfoRef = typename StateInfoStorage::const_reference;
+
 private:
     std::shared_ptr<PolicyPickerType> policy_chooser_;
 
-    internal::StateInfos<StateInfo> state_infos_;
+    StateInfoStorage state_infos_;
 
-    StateInfo* initial_state_info_ = nullptr;
+    // Identifies the initial state by the address of its value.
+    const AlgorithmValueType* initial_state_value_ = nullptr;
 
-    // Reused buffer
+    // Reused buffers
     std::vector<TransitionType> transitions_;
+    QValueBatch<UseInterval> qvalue_batch_;
+    std::vector<std::pair<StateID, value_t>> batch_states_;
+    std::vector<std::pair<StateID, value_t>> eval_state_ids_;
+    std::vector<State> eval_states_;
+    std::vector<const State*> eval_state_ptrs_;
+    std::vector<value_t> eval_values_;
 
 protected:
     internal::Statistics statistics_;
@@ -180,6 +342,16 @@ public:
     [[nodiscard]]
     bool was_visited(StateID state_id) const;
 
+    /**
+     * @brief Returns the statistics shared by all heuristic search algorithms,
+     * e.g. the number of Bellman backups performed so far.
+     */
+    [[nodiscard]]
+    const internal::Statistics& get_heuristic_search_statistics() const
+    {
+        return statistics_;
+    }
+
     /**
      * @brief Clears the currently selected greedy action for the state
      * represented by \p state_id
@@ -210,6 +382,20 @@ public:
         StateID state_id,
         std::vector<TransitionType>& greedy);
 
+    /**
+     * @brief Computes the Bellman updates for a batch of states and returns
+     * whether any value changed.
+     *
+     * The successor values of all states are gathered before any state value
+     * is updated, i.e., the states are updated simultaneously rather than one
+     * after another. All Q-values of the batch are computed in one pass over
+     * contiguous buffers.
+     */
+    bool bellman_update(
+        MDPType& mdp,
+        EvaluatorType& h,
+        std::span<const StateID> state_ids);
+
     /**
      * @brief Computes the Bellman update for a state, recomputes the greedy
      * action for it, and outputs status changes and the new greedy transition.
@@ -232,12 +418,12 @@ protected:
     /**
      * @brief Get the state info object of a state.
      */
-    StateInfo& get_state_info(StateID id);
+    StateInfoRef get_state_info(StateID id);
 
     /**
      * @brief Get the state info object of a state.
      */
-    const StateInfo& get_state_info(StateID id) const;
+    ConstStateInfoRef get_state_info(StateID id) const;
 
     StateID sample_state(
         SuccessorSampler<Action>& sampler,
@@ -246,26 +432,49 @@ protected:
 
 private:
     // Stores dead-end information in state info and returns true on change.
-    bool notify_dead_end(StateInfo& state_info, value_t termination_cost);
+    bool notify_dead_end(StateInfoRef state_info, value_t termination_cost);
 
-    bool update(StateInfo& state_info, AlgorithmValueType other);
+    bool update(StateInfoRef state_info, AlgorithmValueType other);
 
-    void state_value_changed(StateInfo& info);
+    void state_value_changed(StateInfoRef info);
 
-    StateInfo&
+    StateInfoRef
     lookup_initialize(MDPType& mdp, EvaluatorType& h, StateID state_id);
 
     bool initialize_if_needed(
         MDPType& mdp,
         EvaluatorType& h,
         StateID state_id,
-        StateInfo& state_info);
+        StateInfoRef state_info);
 
-    std::optional<AlgorithmValueType> normalized_qvalue(
+    // Stores the heuristic estimate of a non-goal state in its state info.
+    void set_estimate(
+        StateInfoRef state_info,
+        value_t estimate,
+        value_t termination_cost);
+
+    // Initializes all uninitialized successors of a state, evaluating the
+    // heuristic on them as one batch.
+    void initialize_successors(
+        MDPType& mdp,
+        EvaluatorType& h,
+        StateID state_id,
+        const std::vector<TransitionType>& transitions);
+
+    // Gathers the successor values of the transitions of a state into the
+    // Q-value batch, ignoring self-loops.
+    void add_to_batch(
         MDPType& mdp,
         EvaluatorType& h,
         StateID state_id,
-        const TransitionType& transition);
+        const std::vector<TransitionType>& transitions);
+
+    // Updates the state info with the minimum Q-value of a state in the
+    // Q-value batch and returns true on change.
+    bool apply_batch_update(
+        StateInfoRef state_info,
+        std::size_t batch_state,
+        value_t termination_cost);
 
     AlgorithmValueType filter_greedy_transitions(
         MDPType& mdp,
@@ -278,7 +487,7 @@ private:
         MDPType& mdp,
         EvaluatorType& h,
         StateID state_id,
-        StateInfo& state_info,
+        StateInfoRef state_info,
         auto&... optional_out_greedy);
 };
 
@@ -367,24 +576,26 @@ template <
     typename Action,
     bool UseInterval = false,
     bool StorePolicy = false,
-    template <typename> class StateInfoExtension = NoAdditionalStateData>
+    template <typename> class StateInfoExtension = NoAdditionalStateData,
+    StateInfoLayout Layout = DEFAULT_STATE_INFO_LAYOUT>
 using HeuristicSearchBaseExt = HeuristicSearchBase<
     State,
     Action,
     StateInfoExtension<
-        PerStateBaseInformation<Action, StorePolicy, UseInterval>>>;
+        PerStateBaseInformation<Action, StorePolicy, UseInterval, Layout>>>;
 
 template <
     typename State,
     typename Action,
     bool UseInterval = false,
     bool StorePolicy = false,
-    template <typename> class StateInfoExtension = NoAdditionalStateData>
+    template <typename> class StateInfoExtension = NoAdditionalStateData,
+    StateInfoLayout Layout = DEFAULT_STATE_INFO_LAYOUT>
 using HeuristicSearchAlgorithmExt = HeuristicSearchAlgorithm<
     State,
     Action,
     StateInfoExtension<
-        PerStateBaseInformation<Action, StorePolicy, UseInterval>>>;
+        PerStateBaseInformation<Action, StorePolicy, UseInterval, Layout>>>;
 
 } // namespace probfd::algorithms::heuristic_search
 
@@ -6,7 +6,7 @@
 
 #include "probfd/algorithms/utils.h"
 
-#include "probfd/policies/map_policy.h"
+#include "probfd/policies/vector_policy.h"
 
 #include "probfd/utils/language.h"
 
@@ -16,8 +16,10 @@
 
 #include "downward/utils/collections.h"
 
+#include <algorithm>
 #include <cassert>
-#include <deque>
+#include <functional>
+#include <vector>
 
 namespace probfd::algorithms::heuristic_search {
 
@@ -74,7 +76,7 @@ HeuristicSearchBase<State, Action, StateInfoT>::HeuristicSearchBase(
     std::shared_ptr<PolicyPickerType> policy_chooser)
     : policy_chooser_(policy_chooser)
 {
-    statistics_.state_info_bytes = sizeof(StateInfo);
+    statistics_.state_info_bytes = StateInfoStorage::BYTES_PER_STATE;
 }
 
 template <typename State, typename Action, typename StateInfoT>
@@ -122,7 +124,7 @@ void HeuristicSearchBase<State, Action, StateInfoT>::clear_policy(
 
 template <typename State, typename Action, typename StateInfoT>
 bool HeuristicSearchBase<State, Action, StateInfoT>::notify_dead_end(
-    StateInfo& state_info,
+    StateInfoRef state_info,
     value_t termination_cost)
 {
     if (!state_info.is_dead_end()) {
@@ -203,7 +205,7 @@ auto HeuristicSearchBase<State, Action, StateInfoT>::bellman_policy_update(
     StateID state_id) -> UpdateResult
     requires(StorePolicy)
 {
-    StateInfo& state_info = lookup_initialize(mdp, h, state_id);
+    StateInfoRef state_info = lookup_initialize(mdp, h, state_id);
 
     ClearGuard guard(transitions_);
 
@@ -244,18 +246,19 @@ void HeuristicSearchBase<State, Action, StateInfoT>::initialize_report(
     ProgressReport& progress)
 {
     const StateID initial_id = mdp.get_state_id(state);
-    StateInfo& info = get_state_info(initial_id);
-    initial_state_info_ = &info;
+    StateInfoRef info = get_state_info(initial_id);
+    const AlgorithmValueType* value = &info.value;
+    initial_state_value_ = value;
 
     if (!initialize_if_needed(mdp, h, initial_id, info)) {
         return;
     }
 
     if constexpr (UseInterval) {
-        progress.register_bound("v", [&info]() { return info.value; });
+        progress.register_bound("v", [value]() { return *value; });
     } else {
-        progress.register_bound("v", [&info]() {
-            return Interval(info.value, INFINITE_VALUE);
+        progress.register_bound("v", [value]() {
+            return Interval(*value, INFINITE_VALUE);
         });
     }
 
@@ -275,14 +278,14 @@ void HeuristicSearchBase<State, Action, StateInfoT>::print_statistics(
 
 template <typename State, typename Action, typename StateInfoT>
 auto HeuristicSearchBase<State, Action, StateInfoT>::get_state_info(StateID id)
-    -> StateInfo&
+    -> StateInfoRef
 {
     return state_infos_[id];
 }
 
 template <typename State, typename Action, typename StateInfoT>
 auto HeuristicSearchBase<State, Action, StateInfoT>::get_state_info(
-    StateID id) const -> const StateInfo&
+    StateID id) const -> ConstStateInfoRef
 {
     return state_infos_[id];
 }
@@ -302,7 +305,7 @@ StateID HeuristicSearchBase<State, Action, StateInfoT>::sample_state(
 
 template <typename State, typename Action, typename StateInfoT>
 bool HeuristicSearchBase<State, Action, StateInfoT>::update(
-    StateInfo& state_info,
+    StateInfoRef state_info,
     AlgorithmValueType other)
 {
     bool b = algorithms::update(state_info.value, other);
@@ -312,10 +315,10 @@ bool HeuristicSearchBase<State, Action, StateInfoT>::update(
 
 template <typename State, typename Action, typename StateInfoT>
 void HeuristicSearchBase<State, Action, StateInfoT>::state_value_changed(
-    StateInfo& info)
+    StateInfoRef info)
 {
     ++statistics_.value_changes;
-    if (&info == initial_state_info_) {
+    if (&info.value == initial_state_value_) {
         statistics_.jump();
     }
 }
@@ -324,9 +327,9 @@ template <typename State, typename Action, typename StateInfoT>
 auto HeuristicSearchBase<State, Action, StateInfoT>::lookup_initialize(
     MDPType& mdp,
     EvaluatorType& h,
-    StateID state_id) -> StateInfo&
+    StateID state_id) -> StateInfoRef
 {
-    StateInfo& state_info = get_state_info(state_id);
+    StateInfoRef state_info = get_state_info(state_id);
     initialize_if_needed(mdp, h, state_id, state_info);
     return state_info;
 }
@@ -336,7 +339,7 @@ bool HeuristicSearchBase<State, Action, StateInfoT>::initialize_if_needed(
     MDPType& mdp,
     EvaluatorType& h,
     StateID state_id,
-    StateInfo& state_info)
+    StateInfoRef state_info)
 {
     if (state_info.is_value_initialized()) return false;
 
@@ -353,93 +356,184 @@ bool HeuristicSearchBase<State, Action, StateInfoT>::initialize_if_needed(
         return true;
     }
 
-    const value_t estimate = h.evaluate(state);
-    if (estimate == t_cost) {
+    set_estimate(state_info, h.evaluate(state), t_cost);
+
+    return true;
+}
+
+template <typename State, typename Action, typename StateInfoT>
+void HeuristicSearchBase<State, Action, StateInfoT>::set_estimate(
+    StateInfoRef state_info,
+    value_t estimate,
+    value_t termination_cost)
+{
+    if (estimate == termination_cost) {
         statistics_.pruned_states++;
-        notify_dead_end(state_info, t_cost);
+        notify_dead_end(state_info, termination_cost);
     } else {
         state_info.set_on_fringe();
 
         if constexpr (UseInterval) {
             state_info.value.lower = estimate;
-            state_info.value.upper = t_cost;
+            state_info.value.upper = termination_cost;
         } else {
             state_info.value = estimate;
         }
     }
-
-    return true;
 }
 
 template <typename State, typename Action, typename StateInfoT>
-auto HeuristicSearchBase<State, Action, StateInfoT>::normalized_qvalue(
+void HeuristicSearchBase<State, Action, StateInfoT>::initialize_successors(
     MDPType& mdp,
     EvaluatorType& h,
     StateID state_id,
-    const TransitionType& transition) -> std::optional<AlgorithmValueType>
+    const std::vector<TransitionType>& transitions)
 {
-    AlgorithmValueType t_value(mdp.get_action_cost(transition.action));
-    value_t non_self_loop = 1_vt;
-    bool loop = true;
+    ClearGuard guard(
+        eval_state_ids_,
+        eval_states_,
+        eval_state_ptrs_,
+        eval_values_);
+
+    for (const auto& transition : transitions) {
+        for (const auto& [succ_id, _] : transition.successor_dist) {
+            if (succ_id == state_id ||
+                get_state_info(succ_id).is_value_initialized()) {
+                continue;
+            }
+
+            eval_state_ids_.emplace_back(succ_id, 0_vt);
+        }
+    }
+
+    if (eval_state_ids_.empty()) return;
+
+    // Transitions frequently share successors.
+    std::ranges::sort(eval_state_ids_);
+    const auto duplicates = std::ranges::unique(
+        eval_state_ids_,
+        std::ranges::equal_to(),
+        project<0>);
+    eval_state_ids_.erase(duplicates.begin(), duplicates.end());
+
+    // Goal states are initialized immediately, the others are evaluated.
+    auto it = eval_state_ids_.begin();
+
+    for (auto& [succ_id, t_cost] : eval_state_ids_) {
+        statistics_.evaluated_states++;
+
+        State state = mdp.get_state(succ_id);
+        TerminationInfo term = mdp.get_termination_info(state);
+        t_cost = term.get_cost();
 
-    for (const auto& [succ_id, prob] : transition.successor_dist) {
-        if (succ_id == state_id) {
-            non_self_loop -= prob;
+        if (term.is_goal_state()) {
+            StateInfoRef succ_info = get_state_info(succ_id);
+            succ_info.set_goal();
+            succ_info.value = AlgorithmValueType(t_cost);
+            statistics_.goal_states++;
             continue;
         }
 
-        const auto& succ_info = lookup_initialize(mdp, h, succ_id);
-        t_value += prob * succ_info.value;
-        loop = false;
+        *it++ = {succ_id, t_cost};
+        eval_states_.push_back(std::move(state));
     }
 
-    if (loop) return std::nullopt;
-
-    if (non_self_loop < 1_vt) {
-        t_value *= (1 / non_self_loop);
+    eval_state_ids_.erase(it, eval_state_ids_.end());
+    for (const State& state : eval_states_) {
+        eval_state_ptrs_.push_back(&state);
     }
 
-    return t_value;
+    eval_values_.resize(eval_states_.size());
+
+    h.evaluate_batch(eval_state_ptrs_, eval_values_);
+
+    for (std::size_t i = 0; i != eval_state_ids_.size(); ++i) {
+        const auto [succ_id, t_cost] = eval_state_ids_[i];
+        set_estimate(get_state_info(succ_id), eval_values_[i], t_cost);
+    }
 }
 
 template <typename State, typename Action, typename StateInfoT>
-auto HeuristicSearchBase<State, Action, StateInfoT>::filter_greedy_transitions(
+void HeuristicSearchBase<State, Action, StateInfoT>::add_to_batch(
     MDPType& mdp,
     EvaluatorType& h,
     StateID state_id,
-    std::vector<TransitionType>& transitions,
-    value_t termination_cost) -> AlgorithmValueType
+    const std::vector<TransitionType>& transitions)
 {
-    using std::ranges::remove_if;
+    initialize_successors(mdp, h, state_id, transitions);
 
-    // First compute the (self-loop normalized) Q values for the lower
-    // bound, the minimum Q value, and remove self-loop transitions in the
-    // process
-    AlgorithmValueType best_value(termination_cost);
+    for (const auto& transition : transitions) {
+        qvalue_batch_.begin_transition(mdp.get_action_cost(transition.action));
 
-    std::vector<value_t> lower_bound_qvalues;
-    lower_bound_qvalues.reserve(transitions.size());
+        for (const auto& [succ_id, prob] : transition.successor_dist) {
+            if (succ_id == state_id) {
+                qvalue_batch_.add_self_loop(prob);
+                continue;
+            }
 
-    std::erase_if(transitions, [&, state_id](const auto& transition) {
-        if (auto q = normalized_qvalue(mdp, h, state_id, transition)) {
-            set_min(best_value, *q);
-            lower_bound_qvalues.push_back(as_lower_bound(*q));
-            return false;
+            const auto& succ_info = lookup_initialize(mdp, h, succ_id);
+            qvalue_batch_.add_successor(prob, succ_info.value);
         }
 
-        return true;
-    });
+        qvalue_batch_.end_transition();
+    }
+
+    qvalue_batch_.end_state();
+}
+
+template <typename State, typename Action, typename StateInfoT>
+bool HeuristicSearchBase<State, Action, StateInfoT>::apply_batch_update(
+    StateInfoRef state_info,
+    std::size_t batch_state,
+    value_t termination_cost)
+{
+    const auto [begin, end] = qvalue_batch_.transitions(batch_state);
 
-    // Now filter non-epsilon-greedy transitions
-    if (!transitions.empty()) {
-        const value_t best = as_lower_bound(best_value);
-        auto view = std::views::zip(transitions, lower_bound_qvalues);
-        auto [it, end] = remove_if(view, approx_neq_to(best), project<1>);
+    if (begin == end) {
+        statistics_.terminal_states++;
+        return notify_dead_end(state_info, termination_cost);
+    }
 
-        const size_t offset = std::distance(view.begin(), it);
-        transitions.erase(transitions.begin() + offset, transitions.end());
+    if (qvalue_batch_.has_only_self_loops(batch_state)) {
+        statistics_.self_loop_states++;
+        return notify_dead_end(state_info, termination_cost);
     }
 
+    return this->update(
+        state_info,
+        qvalue_batch_.compute_min_qvalue(
+            batch_state,
+            AlgorithmValueType(termination_cost)));
+}
+
+template <typename State, typename Action, typename StateInfoT>
+auto HeuristicSearchBase<State, Action, StateInfoT>::filter_greedy_transitions(
+    MDPType& mdp,
+    EvaluatorType& h,
+    StateID state_id,
+    std::vector<TransitionType>& transitions,
+    value_t termination_cost) -> AlgorithmValueType
+{
+    // First compute the (self-loop normalized) Q values of all transitions
+    // and the minimum Q value.
+    qvalue_batch_.clear();
+    add_to_batch(mdp, h, state_id, transitions);
+    qvalue_batch_.compute_qvalues();
+
+    const AlgorithmValueType best_value = qvalue_batch_.compute_min_qvalue(
+        0,
+        AlgorithmValueType(termination_cost));
+
+    // Now remove self-loop transitions and non-epsilon-greedy transitions
+    const value_t best = as_lower_bound(best_value);
+    std::size_t i = 0;
+
+    std::erase_if(transitions, [&](const auto&) {
+        const std::size_t t = i++;
+        return qvalue_batch_.is_self_loop(t) ||
+               !is_approx_equal(best, qvalue_batch_.get_lower_qvalue(t));
+    });
+
     return best_value;
 }
 
@@ -448,7 +542,7 @@ bool HeuristicSearchBase<State, Action, StateInfoT>::bellman_update(
     MDPType& mdp,
     EvaluatorType& h,
     StateID state_id,
-    StateInfo& state_info,
+    StateInfoRef state_info,
     auto&... optional_out_greedy)
 {
     static_assert(sizeof...(optional_out_greedy) < 2);
@@ -470,54 +564,92 @@ bool HeuristicSearchBase<State, Action, StateInfoT>::bellman_update(
     }
 
     const State state = mdp.get_state(state_id);
+    const value_t termination_cost = mdp.get_termination_info(state).get_cost();
 
-    auto& transitions = [&]() -> auto& {
-        if constexpr (input_exists) {
-            auto& transitions = select<0>(optional_out_greedy...);
-            mdp.generate_all_transitions(state, transitions);
-            return transitions;
-        } else {
-            mdp.generate_all_transitions(state, transitions_);
-            return transitions_;
-        }
-    }();
+    if constexpr (!input_exists) {
+        ClearGuard guard(transitions_);
+        mdp.generate_all_transitions(state, transitions_);
 
-    const value_t termination_cost = mdp.get_termination_info(state).get_cost();
+        qvalue_batch_.clear();
+        add_to_batch(mdp, h, state_id, transitions_);
+        qvalue_batch_.compute_qvalues();
 
-    if (transitions.empty()) {
-        statistics_.terminal_states++;
-        return notify_dead_end(state_info, termination_cost);
-    }
+        return apply_batch_update(state_info, 0, termination_cost);
+    } else {
+        auto& transitions = select<0>(optional_out_greedy...);
+        mdp.generate_all_transitions(state, transitions);
 
-    AlgorithmValueType best_value;
-    bool has_only_self_loops;
+        if (transitions.empty()) {
+            statistics_.terminal_states++;
+            return notify_dead_end(state_info, termination_cost);
+        }
 
-    if constexpr (input_exists) {
-        best_value = filter_greedy_transitions(
+        const AlgorithmValueType best_value = filter_greedy_transitions(
             mdp,
             h,
             state_id,
             transitions,
             termination_cost);
-        has_only_self_loops = transitions.empty();
-    } else {
-        best_value = AlgorithmValueType(termination_cost);
-        has_only_self_loops = true;
 
-        for (auto& transition : transitions) {
-            if (auto q = normalized_qvalue(mdp, h, state_id, transition)) {
-                set_min(best_value, *q);
-                has_only_self_loops = false;
-            }
+        if (transitions.empty()) {
+            statistics_.self_loop_states++;
+            return notify_dead_end(state_info, termination_cost);
         }
+
+        return this->update(state_info, best_value);
     }
+}
 
-    if (has_only_self_loops) {
-        statistics_.self_loop_states++;
-        return notify_dead_end(state_info, termination_cost);
+template <typename State, typename Action, typename StateInfoT>
+bool HeuristicSearchBase<State, Action, StateInfoT>::bellman_update(
+    MDPType& mdp,
+    EvaluatorType& h,
+    std::span<const StateID> state_ids)
+{
+#if defined(EXPENSIVE_STATISTICS)
+    TimerScope scoped_upd_timer(statistics_.update_time);
+#endif
+
+    ClearGuard guard(batch_states_);
+    qvalue_batch_.clear();
+
+    // Gather the transitions of all states before updating any value.
+    for (const StateID state_id : state_ids) {
+        statistics_.backups++;
+
+        StateInfoRef state_info = lookup_initialize(mdp, h, state_id);
+
+        if (state_info.is_terminal()) continue;
+
+        if (state_info.is_on_fringe()) {
+            ++statistics_.backed_up_states;
+            state_info.removed_from_fringe();
+        }
+
+        const State state = mdp.get_state(state_id);
+
+        ClearGuard transitions_guard(transitions_);
+        mdp.generate_all_transitions(state, transitions_);
+        add_to_batch(mdp, h, state_id, transitions_);
+
+        batch_states_.emplace_back(
+            state_id,
+            mdp.get_termination_info(state).get_cost());
+    }
+
+    qvalue_batch_.compute_qvalues();
+
+    bool value_changed = false;
+
+    for (std::size_t i = 0; i != batch_states_.size(); ++i) {
+        const auto [state_id, termination_cost] = batch_states_[i];
+        StateInfoRef state_info = get_state_info(state_id);
+        if (apply_batch_update(state_info, i, termination_cost)) {
+            value_changed = true;
+        }
     }
 
-    return this->update(state_info, best_value);
+    return value_changed;
 }
 
 template <typename State, typename Action, typename StateInfoT>
@@ -545,21 +677,32 @@ auto HeuristicSearchAlgorithm<State, Action, StateInfoT>::compute_policy(
 
     /*
      * Expand some greedy policy graph, starting from the initial state.
-     * Collect optimal actions along the way.
+     * Collect optimal actions along the way. The policy is filled in a single
+     * breadth-first pass, the visited states are tracked in a dense bit
+     * vector indexed by state ID.
      */
-    using MapPolicy = policies::MapPolicy<State, Action>;
-    std::unique_ptr<MapPolicy> policy(new MapPolicy(&mdp));
+    using VectorPolicy = policies::VectorPolicy<State, Action>;
+    std::unique_ptr<VectorPolicy> policy(new VectorPolicy(&mdp));
 
     const StateID initial_state_id = mdp.get_state_id(initial_state);
 
-    std::deque<StateID> queue;
-    std::set<StateID> visited;
+    std::vector<StateID> queue;
+    std::vector<bool> visited;
+
+    auto mark_visited = [&visited](StateID state_id) {
+        if (state_id >= visited.size()) visited.resize(state_id + 1, false);
+        if (visited[state_id]) return false;
+        visited[state_id] = true;
+        return true;
+    };
+
     queue.push_back(initial_state_id);
-    visited.insert(initial_state_id);
+    mark_visited(initial_state_id);
+
+    Distribution<StateID> successors;
 
-    do {
-        const StateID state_id = queue.front();
-        queue.pop_front();
+    for (std::size_t i = 0; i != queue.size(); ++i) {
+        const StateID state_id = queue[i];
 
         std::optional<Action> action;
 
@@ -581,15 +724,15 @@ auto HeuristicSearchAlgorithm<State, Action, StateInfoT>::compute_policy(
         // Push the successor traps.
         const State state = mdp.get_state(state_id);
 
-        Distribution<StateID> successors;
+        successors.clear();
         mdp.generate_action_transitions(state, *action, successors);
 
         for (const StateID succ_id : successors.support()) {
-            if (visited.insert(succ_id).second) {
+            if (mark_visited(succ_id)) {
                 queue.push_back(succ_id);
             }
         }
-    } while (!queue.empty());
+    }
 
     return policy;
 }
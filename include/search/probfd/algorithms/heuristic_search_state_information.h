@@ -12,15 +12,81 @@
 #include <cassert>
 #include <cstdint>
 #include <optional>
+#include <type_traits>
 
 namespace probfd::algorithms::heuristic_search {
 
-template <typename, bool StorePolicy = false>
-struct StatesPolicy {};
+/**
+ * @brief Specifies how the per-state information of a heuristic search
+ * algorithm is laid out in memory.
+ */
+enum class StateInfoLayout {
+    /// One record per state that holds all fields of the state.
+    ARRAY_OF_STRUCTS,
+
+    /**
+     * One array per field, i.e., the flags, the values and the policy of all
+     * states are stored in separate columns. The state information objects
+     * are proxies that refer to the fields of one state.
+     */
+    STRUCT_OF_ARRAYS,
+
+    /**
+     * Not a storage layout. The layout of the read-only proxies handed out by
+     * const accesses to the struct-of-arrays storage, whose fields are const
+     * references into the columns.
+     */
+    STRUCT_OF_ARRAYS_READ_ONLY
+};
 
-template <typename Action>
-struct StatesPolicy<Action, true> {
+/// The layout used by the heuristic search algorithms unless specified
+/// otherwise. Selected by the CMake option USE_SOA_STATE_INFORMATION.
+#if defined(PROBFD_SOA_STATE_INFORMATION)
+inline constexpr StateInfoLayout DEFAULT_STATE_INFO_LAYOUT =
+    StateInfoLayout::STRUCT_OF_ARRAYS;
+#else
+inline constexpr StateInfoLayout DEFAULT_STATE_INFO_LAYOUT =
+    StateInfoLayout::ARRAY_OF_STRUCTS;
+#endif
+
+/// A field of the state information. A reference into the column of the field
+/// for the struct-of-arrays layout.
+template <typename T, StateInfoLayout Layout>
+using StateInfoField = std::conditional_t<
+    Layout == StateInfoLayout::STRUCT_OF_ARRAYS,
+    T&,
+    std::conditional_t<
+        Layout == StateInfoLayout::STRUCT_OF_ARRAYS_READ_ONLY,
+        const T&,
+        T>>;
+
+template <typename Action, StateInfoLayout Layout>
+struct StatesPolicyStorage {
     std::optional<Action> policy = std::nullopt;
+};
+
+template <typename Action>
+struct StatesPolicyStorage<Action, StateInfoLayout::STRUCT_OF_ARRAYS> {
+    std::optional<Action>& policy;
+};
+
+template <typename Action>
+struct StatesPolicyStorage<
+    Action,
+    StateInfoLayout::STRUCT_OF_ARRAYS_READ_ONLY> {
+    const std::optional<Action>& policy;
+};
+
+template <
+    typename,
+    bool StorePolicy = false,
+    StateInfoLayout = StateInfoLayout::ARRAY_OF_STRUCTS>
+struct StatesPolicy {};
+
+template <typename Action, StateInfoLayout Layout>
+struct StatesPolicy<Action, true, Layout>
+    : public StatesPolicyStorage<Action, Layout> {
+    using StatesPolicyStorage<Action, Layout>::policy;
 
     void set_policy(Action a) { policy = a; }
     void clear_policy() { policy = std::nullopt; }
@@ -36,7 +102,23 @@ struct StatesPolicy<Action, true> {
     }
 };
 
-struct StateFlags {
+template <StateInfoLayout Layout>
+struct StateFlagsStorage {
+    uint8_t info = 0;
+};
+
+template <>
+struct StateFlagsStorage<StateInfoLayout::STRUCT_OF_ARRAYS> {
+    uint8_t& info;
+};
+
+template <>
+struct StateFlagsStorage<StateInfoLayout::STRUCT_OF_ARRAYS_READ_ONLY> {
+    const uint8_t& info;
+};
+
+template <StateInfoLayout Layout = StateInfoLayout::ARRAY_OF_STRUCTS>
+struct StateFlags : public StateFlagsStorage<Layout> {
     static constexpr uint8_t INITIALIZED = 1;
     static constexpr uint8_t DEAD = 2;
     static constexpr uint8_t GOAL = 4;
@@ -44,7 +126,7 @@ struct StateFlags {
     static constexpr uint8_t MASK = 7;
     static constexpr uint8_t BITS = 3;
 
-    uint8_t info = 0;
+    using StateFlagsStorage<Layout>::info;
 
     [[nodiscard]]
     bool is_value_initialized() const
@@ -101,14 +183,30 @@ struct StateFlags {
     }
 };
 
-template <typename Action, bool StorePolicy_, bool UseInterval_>
+/**
+ * @brief The per-state information shared by all heuristic search algorithms.
+ *
+ * For the struct-of-arrays layout, this type is a proxy whose fields are
+ * references into the columns of internal::StateInfos. Extensions of it may
+ * then only add flags, but no data members. Const accesses yield the same
+ * extension of the read-only proxy, which has const references as fields.
+ */
+template <
+    typename Action,
+    bool StorePolicy_,
+    bool UseInterval_,
+    StateInfoLayout Layout_ = StateInfoLayout::ARRAY_OF_STRUCTS>
 struct PerStateBaseInformation
-    : public StatesPolicy<Action, StorePolicy_>
-    , public StateFlags {
+    : public StatesPolicy<Action, StorePolicy_, Layout_>
+    , public StateFlags<Layout_> {
+    using BaseInformation = PerStateBaseInformation;
+    using ActionType = Action;
+
     static constexpr bool StorePolicy = StorePolicy_;
     static constexpr bool UseInterval = UseInterval_;
+    static constexpr StateInfoLayout Layout = Layout_;
 
-    AlgorithmValue<UseInterval> value;
+    StateInfoField<AlgorithmValue<UseInterval>, Layout> value;
 
     /// Checks if the value bounds are epsilon-close.
     [[nodiscard]]
@@ -151,6 +151,7 @@ class LRTDP
 
 public:
     using StateInfo = typename Base::StateInfo;
+    using StateInfoRef = typename Base::StateInfoRef;
 
 private:
     using MDPType = typename Base::MDPType;
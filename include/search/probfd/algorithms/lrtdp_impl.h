@@ -36,7 +36,7 @@ LRTDP<State, Action, UseInterval>::LRTDP(
 template <typename State, typename Action, bool UseInterval>
 void LRTDP<State, Action, UseInterval>::reset_search_state()
 {
-    for (StateInfo& state_info : this->get_state_infos()) {
+    for (StateInfoRef state_info : this->get_state_infos()) {
         state_info.clear();
     }
 }
@@ -54,7 +54,7 @@ Interval LRTDP<State, Action, UseInterval>::do_solve(
     const StateID state_id = mdp.get_state_id(state);
 
     for (;;) {
-        StateInfo& info = this->get_state_info(state_id);
+        StateInfoRef info = this->get_state_info(state_id);
 
         if (info.is_solved()) {
             break;
@@ -102,7 +102,7 @@ void LRTDP<State, Action, UseInterval>::trial(
 
         const StateID state_id = current_trial_.back();
 
-        auto& state_info = this->get_state_info(state_id);
+        auto&& state_info = this->get_state_info(state_id);
         if (state_info.is_solved()) {
             current_trial_.pop_back();
             break;
@@ -143,7 +143,7 @@ void LRTDP<State, Action, UseInterval>::trial(
         current_trial_.pop_back();
 
         for (const StateID state : current_trial_) {
-            auto& info = this->get_state_info(state);
+            auto&& info = this->get_state_info(state);
             assert(info.is_marked_trial());
             info.unmark_trial();
         }
@@ -175,7 +175,7 @@ bool LRTDP<State, Action, UseInterval>::check_and_solve(
     bool epsilon_consistent = true;
 
     {
-        auto& init_info = this->get_state_info(init_state_id);
+        auto&& init_info = this->get_state_info(init_state_id);
         if (init_info.is_solved()) return true;
         init_info.mark_open();
         policy_queue_.emplace_back(init_state_id);
@@ -187,7 +187,7 @@ bool LRTDP<State, Action, UseInterval>::check_and_solve(
         const auto state_id = policy_queue_.back();
         policy_queue_.pop_back();
 
-        auto& info = this->get_state_info(state_id);
+        auto&& info = this->get_state_info(state_id);
         assert(info.is_marked_open() && !info.is_solved());
 
         this->statistics_.check_and_solve_bellman_backups++;
@@ -217,7 +217,7 @@ bool LRTDP<State, Action, UseInterval>::check_and_solve(
         }
 
         for (StateID succ_id : transition->successor_dist.support()) {
-            auto& succ_info = this->get_state_info(succ_id);
+            auto&& succ_info = this->get_state_info(succ_id);
             if (!succ_info.is_solved() && !succ_info.is_marked_open()) {
                 succ_info.mark_open();
                 policy_queue_.emplace_back(succ_id);
@@ -257,7 +257,7 @@ bool LRTDP<State, Action, UseInterval>::check_and_solve_original(
         policy_queue_.pop_back();
         visited_.push_back(stateid);
 
-        auto& info = this->get_state_info(stateid);
+        auto&& info = this->get_state_info(stateid);
         if (info.is_solved()) {
             continue;
         }
@@ -279,7 +279,7 @@ bool LRTDP<State, Action, UseInterval>::check_and_solve_original(
 
         if (rv && !transition) {
             for (StateID succid : transition->successor_dist.support()) {
-                auto& succ_info = this->get_state_info(succid);
+                auto&& succ_info = this->get_state_info(succid);
                 if (!succ_info.is_solved() && !succ_info.is_marked_open()) {
                     succ_info.mark_open();
                     policy_queue_.emplace_back(succid);
@@ -291,7 +291,7 @@ bool LRTDP<State, Action, UseInterval>::check_and_solve_original(
     if (rv) {
         while (!visited_.empty()) {
             const StateID sid = visited_.back();
-            auto& info = this->get_state_info(sid);
+            auto&& info = this->get_state_info(sid);
             info.unmark();
             info.mark_solved();
             visited_.pop_back();
@@ -299,7 +299,7 @@ bool LRTDP<State, Action, UseInterval>::check_and_solve_original(
     } else {
         while (!visited_.empty()) {
             const StateID sid = visited_.back();
-            auto& info = this->get_state_info(sid);
+            auto&& info = this->get_state_info(sid);
             info.unmark();
             this->bellman_policy_update(mdp, heuristic, sid);
             visited_.pop_back();
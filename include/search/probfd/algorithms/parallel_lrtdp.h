@@ -0,0 +1,250 @@
+#ifndef PROBFD_ALGORITHMS_PARALLEL_LRTDP_H
+#define PROBFD_ALGORITHMS_PARALLEL_LRTDP_H
+
+#include "probfd/algorithms/lrtdp.h"
+
+#include "probfd/distribution.h"
+#include "probfd/mdp_algorithm.h"
+#include "probfd/types.h"
+#include "probfd/value_type.h"
+
+#include "downward/utils/rng.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+// Forward Declarations
+namespace utils {
+class CountdownTimer;
+}
+
+namespace probfd::algorithms::lrtdp {
+
+namespace internal {
+
+struct ParallelStatistics {
+    unsigned long long trials = 0;
+    unsigned long long trial_bellman_backups = 0;
+    unsigned long long check_and_solve_bellman_backups = 0;
+    unsigned long long evaluated_states = 0;
+    unsigned long long expanded_states = 0;
+
+    void print(std::ostream& out) const;
+};
+
+} // namespace internal
+
+/**
+ * @brief Implements a multi-threaded variant of labelled real-time dynamic
+ * programming (LRTDP) \cite bonet:geffner:icaps-03.
+ *
+ * A fixed number of workers run LRTDP trials and check-and-solve labelling
+ * concurrently from the initial state until it is labelled solved. All
+ * workers share one per-state table. It stores the state values as atomics,
+ * so Bellman updates never lock and may read slightly stale successor values.
+ * The SOLVED label is set with an atomic bit operation. Concurrent labelling
+ * procedures may observe each other's intermediate values, so a state can be
+ * labelled based on a stale residual. Once the initial state is labelled
+ * solved, the workers are therefore joined and the residuals of all states
+ * reachable by the greedy policy are checked again sequentially. If any of
+ * them is epsilon-inconsistent, their labels are removed and the workers are
+ * restarted, so the result is epsilon-consistent as with sequential LRTDP.
+ *
+ * Neither the MDP nor the heuristic is thread-safe. All calls to them,
+ * i.e., transition generation, state lookups and heuristic evaluations, are
+ * therefore serialized by a single model lock. Every state is expanded
+ * exactly once under this lock, its successors are evaluated during the same
+ * expansion, and its transitions are cached in the state table. Afterwards,
+ * all backups of the state only read the cached transitions, so the workers
+ * contend on the lock only at the search frontier. Only the trials, the
+ * Bellman backups and the labelling run in parallel. The algorithm pays off
+ * if these dominate the expansion cost, e.g., for cheap heuristics on MDPs
+ * with many revisits.
+ *
+ * In contrast to sequential LRTDP, the cached transitions keep the actions,
+ * costs and successor distributions of every expanded state in memory until
+ * the solver is destroyed.
+ *
+ * Each worker samples trial successors proportionally to their probability,
+ * using its own random number generator seeded from the base seed and the
+ * worker index. Greedy ties are broken in favour of the first applicable
+ * action. The state values are real values; value intervals are not
+ * supported.
+ *
+ * @note The time limit is measured in process CPU time, i.e., it accumulates
+ * over all workers.
+ *
+ * @tparam State - The state type of the MDP model.
+ * @tparam Action - The action type of the MDP model.
+ */
+template <typename State, typename Action>
+class ParallelLRTDP : public MDPAlgorithm<State, Action> {
+    using Base = MDPAlgorithm<State, Action>;
+
+    using MDPType = typename Base::MDPType;
+    using EvaluatorType = typename Base::EvaluatorType;
+    using PolicyType = typename Base::PolicyType;
+
+    using Statistics = internal::ParallelStatistics;
+
+    static constexpr std::uint8_t INITIALIZED = 1 << 0;
+    static constexpr std::uint8_t GOAL = 1 << 1;
+    static constexpr std::uint8_t DEAD_END = 1 << 2;
+    static constexpr std::uint8_t SOLVED = 1 << 3;
+
+    // The cached transitions of an expanded state.
+    struct Expansion {
+        std::vector<Action> actions;
+        std::vector<value_t> costs;
+        std::vector<Distribution<StateID>> successors;
+    };
+
+    // Written under the model lock before INITIALIZED or the expansion is
+    // published, read lock-free afterwards.
+    struct StateEntry {
+        std::atomic<value_t> value = 0_vt;
+        std::atomic<std::uint8_t> flags = 0;
+        std::atomic<const Expansion*> expansion = nullptr;
+        value_t termination_cost = 0_vt;
+    };
+
+    struct BackupResult {
+        bool value_changed;
+        int greedy; // Index of the greedy transition, -1 if none.
+    };
+
+    struct Worker {
+        utils::RandomNumberGenerator rng;
+        std::vector<StateID> current_trial;
+        std::unordered_set<StateID> trial_states;
+        std::vector<StateID> policy_queue;
+        std::vector<StateID> visited;
+        std::unordered_set<StateID> open;
+        Statistics statistics;
+
+        explicit Worker(int seed)
+            : rng(seed)
+        {
+        }
+    };
+
+    // The entries are stored in segments of 2^SEGMENT_SHIFT entries that are
+    // allocated on demand and never moved. The directory can address all
+    // non-negative 32-bit state IDs.
+    static constexpr unsigned SEGMENT_SHIFT = 14;
+    static constexpr std::size_t ENTRIES_PER_SEGMENT = std::size_t(1)
+                                                       << SEGMENT_SHIFT;
+    static constexpr std::size_t MAX_SEGMENTS = std::size_t(1)
+                                                << (31 - SEGMENT_SHIFT);
+
+    const TrialTerminationCondition stop_consistent_;
+    const unsigned num_threads_;
+    const int seed_;
+
+    std::unique_ptr<std::atomic<StateEntry*>[]> segments_;
+
+    // Serializes all accesses to the MDP and the heuristic.
+    std::mutex model_mutex_;
+    std::vector<std::unique_ptr<Expansion>> expansions_;
+
+    std::atomic<unsigned long long> trials_ = 0;
+    Statistics statistics_;
+
+public:
+    /**
+     * @brief Constructs a parallel LRTDP solver object with \p num_threads
+     * workers.
+     */
+    ParallelLRTDP(
+        TrialTerminationCondition stop_consistent,
+        unsigned num_threads,
+        int seed);
+
+    ~ParallelLRTDP() override;
+
+    Interval solve(
+        MDPType& mdp,
+        EvaluatorType& heuristic,
+        param_type<State> state,
+        ProgressReport progress,
+        double max_time) override;
+
+    std::unique_ptr<PolicyType> compute_policy(
+        MDPType& mdp,
+        EvaluatorType& heuristic,
+        param_type<State> state,
+        ProgressReport progress,
+        double max_time) override;
+
+    void print_statistics(std::ostream& out) const override;
+
+private:
+    void run_worker(
+        MDPType& mdp,
+        EvaluatorType& heuristic,
+        StateID initial_state,
+        Worker& worker,
+        ProgressReport* progress,
+        utils::CountdownTimer& timer);
+
+    void trial(
+        MDPType& mdp,
+        EvaluatorType& heuristic,
+        StateID initial_state,
+        Worker& worker,
+        utils::CountdownTimer& timer);
+
+    bool check_and_solve(
+        MDPType& mdp,
+        EvaluatorType& heuristic,
+        StateID init_state_id,
+        Worker& worker,
+        utils::CountdownTimer& timer);
+
+    bool verify_solved(
+        MDPType& mdp,
+        EvaluatorType& heuristic,
+        StateID initial_state,
+        utils::CountdownTimer& timer);
+
+    BackupResult bellman_update(
+        MDPType& mdp,
+        EvaluatorType& heuristic,
+        StateID state_id,
+        StateEntry& entry);
+
+    StateEntry& get_entry(StateID state_id) const;
+
+    StateEntry& initialize(
+        MDPType& mdp,
+        EvaluatorType& heuristic,
+        StateID state_id);
+
+    StateEntry& initialize_locked(
+        MDPType& mdp,
+        EvaluatorType& heuristic,
+        StateID state_id);
+
+    const Expansion& expand(
+        MDPType& mdp,
+        EvaluatorType& heuristic,
+        StateID state_id,
+        StateEntry& entry);
+
+    std::unique_ptr<Expansion>
+    generate_expansion(MDPType& mdp, StateID state_id);
+
+    void clear_entries();
+};
+
+} // namespace probfd::algorithms::lrtdp
+
+#define GUARD_INCLUDE_PROBFD_ALGORITHMS_PARALLEL_LRTDP_H
+#include "probfd/algorithms/parallel_lrtdp_impl.h"
+#undef GUARD_INCLUDE_PROBFD_ALGORITHMS_PARALLEL_LRTDP_H
+
+#endif // PROBFD_ALGORITHMS_PARALLEL_LRTDP_H
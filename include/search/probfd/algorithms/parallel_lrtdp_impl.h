@@ -0,0 +1,630 @@
+#ifndef GUARD_INCLUDE_PROBFD_ALGORITHMS_PARALLEL_LRTDP_H
+#error "This file should only be included from parallel_lrtdp.h"
+#endif
+
+#include "probfd/policies/vector_policy.h"
+
+#include "probfd/utils/thread_pool.h"
+
+#include "probfd/cost_function.h"
+#include "probfd/evaluator.h"
+#include "probfd/mdp.h"
+
+#include "downward/utils/countdown_timer.h"
+#include "downward/utils/hash.h"
+
+#include <cassert>
+#include <ranges>
+
+namespace probfd::algorithms::lrtdp {
+
+namespace internal {
+
+inline void ParallelStatistics::print(std::ostream& out) const
+{
+    out << "  Evaluated state(s): " << evaluated_states << std::endl;
+    out << "  Expanded state(s): " << expanded_states << std::endl;
+    out << "  Trials: " << trials << std::endl;
+    out << "  Bellman backups (trials): " << trial_bellman_backups << std::endl;
+    out << "  Bellman backups (check&solved): "
+        << check_and_solve_bellman_backups << std::endl;
+}
+
+} // namespace internal
+
+template <typename State, typename Action>
+ParallelLRTDP<State, Action>::ParallelLRTDP(
+    TrialTerminationCondition stop_consistent,
+    unsigned num_threads,
+    int seed)
+    : stop_consistent_(stop_consistent)
+    , num_threads_(num_threads)
+    , seed_(seed)
+    , segments_(new std::atomic<StateEntry*>[MAX_SEGMENTS])
+{
+    assert(num_threads_ > 0);
+    for (std::size_t i = 0; i != MAX_SEGMENTS; ++i) {
+        segments_[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+template <typename State, typename Action>
+ParallelLRTDP<State, Action>::~ParallelLRTDP()
+{
+    clear_entries();
+}
+
+template <typename State, typename Action>
+Interval ParallelLRTDP<State, Action>::solve(
+    MDPType& mdp,
+    EvaluatorType& heuristic,
+    param_type<State> state,
+    ProgressReport progress,
+    double max_time)
+{
+    utils::CountdownTimer timer(max_time);
+
+    const StateID initial_id = mdp.get_state_id(state);
+    StateEntry& initial_entry = initialize(mdp, heuristic, initial_id);
+
+    progress.register_bound("v", [&initial_entry]() {
+        return Interval(
+            initial_entry.value.load(std::memory_order_relaxed),
+            INFINITE_VALUE);
+    });
+
+    progress.register_print([this](std::ostream& out) {
+        out << "trials=" << trials_.load(std::memory_order_relaxed);
+    });
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    workers.reserve(num_threads_);
+    for (unsigned i = 0; i != num_threads_; ++i) {
+        utils::HashState hash_state;
+        utils::feed(hash_state, seed_);
+        utils::feed(hash_state, i);
+        workers.push_back(std::make_unique<Worker>(
+            static_cast<int>(hash_state.get_hash32() >> 1)));
+    }
+
+    auto collect_statistics = [&] {
+        for (const auto& worker : workers) {
+            const Statistics& s = worker->statistics;
+            statistics_.trials += s.trials;
+            statistics_.trial_bellman_backups += s.trial_bellman_backups;
+            statistics_.check_and_solve_bellman_backups +=
+                s.check_and_solve_bellman_backups;
+        }
+    };
+
+    try {
+        if (num_threads_ == 1) {
+            run_worker(
+                mdp,
+                heuristic,
+                initial_id,
+                *workers.front(),
+                &progress,
+                timer);
+        } else {
+            ThreadPool pool(num_threads_);
+
+            do {
+                // Only the first worker prints progress reports.
+                for (unsigned i = 0; i != num_threads_; ++i) {
+                    pool.submit([&, i] {
+                        run_worker(
+                            mdp,
+                            heuristic,
+                            initial_id,
+                            *workers[i],
+                            i == 0 ? &progress : nullptr,
+                            timer);
+                    });
+                }
+                pool.wait();
+            } while (!verify_solved(mdp, heuristic, initial_id, timer));
+        }
+    } catch (...) {
+        collect_statistics();
+        throw;
+    }
+
+    collect_statistics();
+
+    return Interval(
+        initial_entry.value.load(std::memory_order_relaxed),
+        INFINITE_VALUE);
+}
+
+template <typename State, typename Action>
+auto ParallelLRTDP<State, Action>::compute_policy(
+    MDPType& mdp,
+    EvaluatorType& heuristic,
+    param_type<State> state,
+    ProgressReport progress,
+    double max_time) -> std::unique_ptr<PolicyType>
+{
+    this->solve(mdp, heuristic, state, progress, max_time);
+
+    // Expand the greedy policy graph in a single breadth-first pass. The
+    // workers have joined, so the MDP may be accessed directly.
+    using VectorPolicy = policies::VectorPolicy<State, Action>;
+    std::unique_ptr<VectorPolicy> policy(new VectorPolicy(&mdp));
+
+    std::vector<StateID> queue;
+    std::unordered_set<StateID> visited;
+
+    const StateID initial_id = mdp.get_state_id(state);
+    queue.push_back(initial_id);
+    visited.insert(initial_id);
+
+    for (std::size_t i = 0; i != queue.size(); ++i) {
+        const StateID state_id = queue[i];
+        StateEntry& entry = get_entry(state_id);
+
+        const int greedy =
+            bellman_update(mdp, heuristic, state_id, entry).greedy;
+
+        // Terminal states have no policy decision.
+        if (greedy == -1) continue;
+
+        const Expansion& expansion = expand(mdp, heuristic, state_id, entry);
+
+        policy->emplace_decision(
+            state_id,
+            expansion.actions[greedy],
+            Interval(
+                entry.value.load(std::memory_order_relaxed),
+                INFINITE_VALUE));
+
+        for (const StateID succ_id : expansion.successors[greedy].support()) {
+            if (visited.insert(succ_id).second) {
+                queue.push_back(succ_id);
+            }
+        }
+    }
+
+    return policy;
+}
+
+template <typename State, typename Action>
+void ParallelLRTDP<State, Action>::print_statistics(std::ostream& out) const
+{
+    out << "  Threads: " << num_threads_ << std::endl;
+    statistics_.print(out);
+}
+
+template <typename State, typename Action>
+void ParallelLRTDP<State, Action>::run_worker(
+    MDPType& mdp,
+    EvaluatorType& heuristic,
+    StateID initial_state,
+    Worker& worker,
+    ProgressReport* progress,
+    utils::CountdownTimer& timer)
+{
+    const StateEntry& initial_entry = get_entry(initial_state);
+
+    while (!(initial_entry.flags.load(std::memory_order_acquire) & SOLVED)) {
+        trial(mdp, heuristic, initial_state, worker, timer);
+        ++worker.statistics.trials;
+        trials_.fetch_add(1, std::memory_order_relaxed);
+        if (progress) progress->print();
+    }
+}
+
+template <typename State, typename Action>
+void ParallelLRTDP<State, Action>::trial(
+    MDPType& mdp,
+    EvaluatorType& heuristic,
+    StateID initial_state,
+    Worker& worker,
+    utils::CountdownTimer& timer)
+{
+    using enum TrialTerminationCondition;
+
+    std::vector<StateID>& current_trial = worker.current_trial;
+
+    current_trial.clear();
+    current_trial.push_back(initial_state);
+
+    for (;;) {
+        timer.throw_if_expired();
+
+        const StateID state_id = current_trial.back();
+
+        StateEntry& entry = get_entry(state_id);
+        if (entry.flags.load(std::memory_order_acquire) & SOLVED) {
+            current_trial.pop_back();
+            break;
+        }
+
+        ++worker.statistics.trial_bellman_backups;
+
+        const auto [value_changed, greedy] =
+            bellman_update(mdp, heuristic, state_id, entry);
+
+        if (greedy == -1) {
+            // terminal
+            entry.flags.fetch_or(SOLVED, std::memory_order_release);
+            current_trial.pop_back();
+            break;
+        }
+
+        if ((stop_consistent_ == CONSISTENT && !value_changed) ||
+            (stop_consistent_ == INCONSISTENT && value_changed) ||
+            (stop_consistent_ == REVISITED &&
+             !worker.trial_states.insert(state_id).second)) {
+            break;
+        }
+
+        // Sample a successor proportionally to its probability.
+        const Distribution<StateID>& successors =
+            entry.expansion.load(std::memory_order_acquire)
+                ->successors[greedy];
+
+        value_t p = worker.rng.random();
+        StateID next = successors.begin()->item;
+        for (const auto& [succ_id, prob] : successors) {
+            next = succ_id;
+            if ((p -= prob) < 0_vt) break;
+        }
+
+        current_trial.push_back(next);
+    }
+
+    if (stop_consistent_ == REVISITED) {
+        if (!current_trial.empty()) current_trial.pop_back();
+        worker.trial_states.clear();
+    }
+
+    // The initial state may have been labelled solved by another worker, in
+    // which case the trial is empty.
+    while (!current_trial.empty()) {
+        timer.throw_if_expired();
+
+        if (!check_and_solve(
+                mdp,
+                heuristic,
+                current_trial.back(),
+                worker,
+                timer)) {
+            break;
+        }
+
+        current_trial.pop_back();
+    }
+}
+
+template <typename State, typename Action>
+bool ParallelLRTDP<State, Action>::check_and_solve(
+    MDPType& mdp,
+    EvaluatorType& heuristic,
+    StateID init_state_id,
+    Worker& worker,
+    utils::CountdownTimer& timer)
+{
+    std::vector<StateID>& policy_queue = worker.policy_queue;
+    std::vector<StateID>& visited = worker.visited;
+    std::unordered_set<StateID>& open = worker.open;
+
+    if (get_entry(init_state_id).flags.load(std::memory_order_acquire) &
+        SOLVED) {
+        return true;
+    }
+
+    // The open marks are local to the worker, so concurrent labelling
+    // procedures never interfere with each other.
+    visited.clear();
+    open.clear();
+    open.insert(init_state_id);
+    policy_queue.push_back(init_state_id);
+
+    bool epsilon_consistent = true;
+
+    do {
+        timer.throw_if_expired();
+
+        const StateID state_id = policy_queue.back();
+        policy_queue.pop_back();
+
+        StateEntry& entry = get_entry(state_id);
+
+        ++worker.statistics.check_and_solve_bellman_backups;
+
+        const auto [value_changed, greedy] =
+            bellman_update(mdp, heuristic, state_id, entry);
+
+        if (value_changed) {
+            epsilon_consistent = false;
+            visited.push_back(state_id);
+            continue;
+        }
+
+        if (greedy == -1) {
+            entry.flags.fetch_or(SOLVED, std::memory_order_release);
+            continue;
+        }
+
+        visited.push_back(state_id);
+
+        const Expansion& expansion =
+            *entry.expansion.load(std::memory_order_acquire);
+
+        for (const StateID succ_id : expansion.successors[greedy].support()) {
+            const StateEntry& succ_entry = get_entry(succ_id);
+            if (!(succ_entry.flags.load(std::memory_order_acquire) & SOLVED) &&
+                open.insert(succ_id).second) {
+                policy_queue.push_back(succ_id);
+            }
+        }
+    } while (!policy_queue.empty());
+
+    if (epsilon_consistent) {
+        for (const StateID state_id : visited) {
+            get_entry(state_id).flags.fetch_or(
+                SOLVED,
+                std::memory_order_release);
+        }
+    } else {
+        for (const StateID state_id : std::views::reverse(visited)) {
+            ++worker.statistics.check_and_solve_bellman_backups;
+            bellman_update(mdp, heuristic, state_id, get_entry(state_id));
+        }
+    }
+
+    return epsilon_consistent;
+}
+
+template <typename State, typename Action>
+bool ParallelLRTDP<State, Action>::verify_solved(
+    MDPType& mdp,
+    EvaluatorType& heuristic,
+    StateID initial_state,
+    utils::CountdownTimer& timer)
+{
+    // The workers have joined, so no value changes during the traversal. In
+    // contrast to check_and_solve, states labelled solved are not skipped.
+    std::vector<StateID> queue;
+    std::unordered_set<StateID> visited;
+
+    queue.push_back(initial_state);
+    visited.insert(initial_state);
+
+    bool epsilon_consistent = true;
+
+    for (std::size_t i = 0; i != queue.size(); ++i) {
+        timer.throw_if_expired();
+
+        const StateID state_id = queue[i];
+        StateEntry& entry = get_entry(state_id);
+
+        ++statistics_.check_and_solve_bellman_backups;
+
+        const auto [value_changed, greedy] =
+            bellman_update(mdp, heuristic, state_id, entry);
+
+        if (value_changed) epsilon_consistent = false;
+
+        if (greedy == -1) continue;
+
+        const Expansion& expansion =
+            *entry.expansion.load(std::memory_order_relaxed);
+
+        for (const StateID succ_id : expansion.successors[greedy].support()) {
+            if (visited.insert(succ_id).second) {
+                queue.push_back(succ_id);
+            }
+        }
+    }
+
+    if (!epsilon_consistent) {
+        // Terminal states stay solved.
+        for (const StateID state_id : queue) {
+            StateEntry& entry = get_entry(state_id);
+            if (!(entry.flags.load(std::memory_order_relaxed) &
+                  (GOAL | DEAD_END))) {
+                entry.flags.fetch_and(
+                    static_cast<std::uint8_t>(~SOLVED),
+                    std::memory_order_relaxed);
+            }
+        }
+    }
+
+    return epsilon_consistent;
+}
+
+template <typename State, typename Action>
+auto ParallelLRTDP<State, Action>::bellman_update(
+    MDPType& mdp,
+    EvaluatorType& heuristic,
+    StateID state_id,
+    StateEntry& entry) -> BackupResult
+{
+    if (entry.flags.load(std::memory_order_acquire) & (GOAL | DEAD_END)) {
+        return {false, -1};
+    }
+
+    const Expansion& expansion = expand(mdp, heuristic, state_id, entry);
+
+    const value_t termination_cost = entry.termination_cost;
+
+    value_t best_qvalue = INFINITE_VALUE;
+    int best = -1;
+
+    for (std::size_t i = 0; i != expansion.actions.size(); ++i) {
+        value_t qvalue = expansion.costs[i];
+        value_t self_loop = 0_vt;
+
+        for (const auto& [succ_id, prob] : expansion.successors[i]) {
+            if (succ_id == state_id) {
+                self_loop += prob;
+            } else {
+                qvalue += prob * get_entry(succ_id).value.load(
+                                     std::memory_order_relaxed);
+            }
+        }
+
+        // Pure self-loops are never greedy.
+        if (is_approx_equal(self_loop, 1_vt)) continue;
+
+        if (self_loop > 0_vt) qvalue /= 1_vt - self_loop;
+
+        if (qvalue < best_qvalue) {
+            best_qvalue = qvalue;
+            best = static_cast<int>(i);
+        }
+    }
+
+    if (best == -1) {
+        // No transitions except self-loops, the state is a dead end.
+        const value_t old_value = entry.value.exchange(
+            termination_cost,
+            std::memory_order_relaxed);
+        entry.flags.fetch_or(DEAD_END, std::memory_order_release);
+        return {!is_approx_equal(old_value, termination_cost), -1};
+    }
+
+    const value_t new_value = std::min(best_qvalue, termination_cost);
+    const value_t old_value =
+        entry.value.exchange(new_value, std::memory_order_relaxed);
+
+    return {
+        !is_approx_equal(old_value, new_value),
+        is_approx_equal(best_qvalue, new_value) ? best : -1};
+}
+
+template <typename State, typename Action>
+auto ParallelLRTDP<State, Action>::get_entry(StateID state_id) const
+    -> StateEntry&
+{
+    assert(state_id < MAX_SEGMENTS * ENTRIES_PER_SEGMENT);
+    StateEntry* segment =
+        segments_[state_id >> SEGMENT_SHIFT].load(std::memory_order_acquire);
+    assert(segment);
+    return segment[state_id & (ENTRIES_PER_SEGMENT - 1)];
+}
+
+template <typename State, typename Action>
+auto ParallelLRTDP<State, Action>::initialize(
+    MDPType& mdp,
+    EvaluatorType& heuristic,
+    StateID state_id) -> StateEntry&
+{
+    std::lock_guard lock(model_mutex_);
+    return initialize_locked(mdp, heuristic, state_id);
+}
+
+template <typename State, typename Action>
+auto ParallelLRTDP<State, Action>::initialize_locked(
+    MDPType& mdp,
+    EvaluatorType& heuristic,
+    StateID state_id) -> StateEntry&
+{
+    std::atomic<StateEntry*>& segment = segments_[state_id >> SEGMENT_SHIFT];
+    if (!segment.load(std::memory_order_relaxed)) {
+        segment.store(
+            new StateEntry[ENTRIES_PER_SEGMENT],
+            std::memory_order_release);
+    }
+
+    StateEntry& entry = get_entry(state_id);
+    if (entry.flags.load(std::memory_order_relaxed) & INITIALIZED) {
+        return entry;
+    }
+
+    ++statistics_.evaluated_states;
+
+    const State state = mdp.get_state(state_id);
+    const TerminationInfo term = mdp.get_termination_info(state);
+    const value_t t_cost = term.get_cost();
+
+    entry.termination_cost = t_cost;
+
+    std::uint8_t flags = INITIALIZED;
+
+    if (term.is_goal_state()) {
+        entry.value.store(t_cost, std::memory_order_relaxed);
+        flags |= GOAL | SOLVED;
+    } else {
+        const value_t estimate = heuristic.evaluate(state);
+        entry.value.store(estimate, std::memory_order_relaxed);
+        if (estimate == t_cost) flags |= DEAD_END | SOLVED;
+    }
+
+    entry.flags.store(flags, std::memory_order_release);
+
+    return entry;
+}
+
+template <typename State, typename Action>
+auto ParallelLRTDP<State, Action>::expand(
+    MDPType& mdp,
+    EvaluatorType& heuristic,
+    StateID state_id,
+    StateEntry& entry) -> const Expansion&
+{
+    if (const Expansion* expansion =
+            entry.expansion.load(std::memory_order_acquire)) {
+        return *expansion;
+    }
+
+    std::lock_guard lock(model_mutex_);
+
+    // Another worker may have expanded the state in the meantime.
+    if (const Expansion* published =
+            entry.expansion.load(std::memory_order_relaxed)) {
+        return *published;
+    }
+
+    ++statistics_.expanded_states;
+
+    std::unique_ptr<Expansion> expansion = generate_expansion(mdp, state_id);
+
+    // Successors must be initialized before the expansion is published.
+    for (const Distribution<StateID>& successors : expansion->successors) {
+        for (const StateID succ_id : successors.support()) {
+            initialize_locked(mdp, heuristic, succ_id);
+        }
+    }
+
+    const Expansion& result = *expansion;
+    entry.expansion.store(&result, std::memory_order_release);
+    expansions_.push_back(std::move(expansion));
+
+    return result;
+}
+
+template <typename State, typename Action>
+auto ParallelLRTDP<State, Action>::generate_expansion(
+    MDPType& mdp,
+    StateID state_id) -> std::unique_ptr<Expansion>
+{
+    auto expansion = std::make_unique<Expansion>();
+
+    const State state = mdp.get_state(state_id);
+    mdp.generate_all_transitions(
+        state,
+        expansion->actions,
+        expansion->successors);
+
+    expansion->costs.reserve(expansion->actions.size());
+    for (const Action& action : expansion->actions) {
+        expansion->costs.push_back(mdp.get_action_cost(action));
+    }
+
+    return expansion;
+}
+
+template <typename State, typename Action>
+void ParallelLRTDP<State, Action>::clear_entries()
+{
+    for (std::size_t i = 0; i != MAX_SEGMENTS; ++i) {
+        delete[] segments_[i].exchange(nullptr, std::memory_order_relaxed);
+    }
+
+    expansions_.clear();
+}
+
+} // namespace probfd::algorithms::lrtdp
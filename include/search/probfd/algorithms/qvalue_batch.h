@@ -0,0 +1,284 @@
+#ifndef PROBFD_ALGORITHMS_QVALUE_BATCH_H
+#define PROBFD_ALGORITHMS_QVALUE_BATCH_H
+
+#include "probfd/algorithms/types.h"
+
+#include "probfd/interval.h"
+#include "probfd/value_type.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace probfd::algorithms {
+
+/**
+ * @brief Computes the dot product of two arrays of length \p n.
+ *
+ * The loop keeps four independent partial sums so that the compiler can map
+ * it onto packed SIMD multiply-add instructions without requiring
+ * reassociation of floating-point additions (-ffast-math).
+ */
+inline value_t
+dot_product(const value_t* lhs, const value_t* rhs, std::size_t n)
+{
+    value_t acc[4] = {0_vt, 0_vt, 0_vt, 0_vt};
+
+    std::size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        for (std::size_t j = 0; j != 4; ++j) {
+            acc[j] += lhs[i + j] * rhs[i + j];
+        }
+    }
+
+    for (; i != n; ++i) {
+        acc[0] += lhs[i] * rhs[i];
+    }
+
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+}
+
+/**
+ * @brief Returns the minimum of \p init and all elements of \p values.
+ */
+inline value_t min_value(value_t init, std::span<const value_t> values)
+{
+    value_t acc[4] = {init, init, init, init};
+
+    std::size_t i = 0;
+
+    for (; i + 4 <= values.size(); i += 4) {
+        for (std::size_t j = 0; j != 4; ++j) {
+            acc[j] = std::min(acc[j], values[i + j]);
+        }
+    }
+
+    for (; i != values.size(); ++i) {
+        acc[0] = std::min(acc[0], values[i]);
+    }
+
+    return std::min(std::min(acc[0], acc[1]), std::min(acc[2], acc[3]));
+}
+
+/**
+ * @brief A batch of transitions whose Q-values are computed together.
+ *
+ * Transitions are added one after another, grouped into states. For every
+ * transition, the probabilities and the current values of its successors
+ * (excluding self-loops) are gathered into contiguous arrays. Value intervals
+ * are stored as separate arrays of lower and upper bounds. Once all
+ * transitions are added, compute_qvalues() evaluates the self-loop normalized
+ * Q-values of all transitions with vectorizable dot product kernels, and
+ * compute_min_qvalue() reduces the Q-values of a state.
+ *
+ * The batch is meant to be reused to avoid allocations. clear() retains the
+ * capacity of all buffers.
+ *
+ * @tparam UseInterval - Whether values are intervals.
+ */
+template <bool UseInterval>
+class QValueBatch {
+    using AlgorithmValueType = AlgorithmValue<UseInterval>;
+
+    // Per successor
+    std::vector<value_t> probabilities_;
+    std::vector<value_t> lower_values_;
+    std::vector<value_t> upper_values_;
+
+    // Per transition
+    std::vector<value_t> costs_;
+    std::vector<value_t> non_self_loop_;
+    std::vector<std::size_t> successor_begin_ = {0};
+    std::vector<value_t> lower_qvalues_;
+    std::vector<value_t> upper_qvalues_;
+
+    // Per state
+    std::vector<std::size_t> transition_begin_ = {0};
+
+public:
+    /// Removes all states and transitions from the batch.
+    void clear()
+    {
+        probabilities_.clear();
+        lower_values_.clear();
+        upper_values_.clear();
+        costs_.clear();
+        non_self_loop_.clear();
+        successor_begin_.resize(1);
+        lower_qvalues_.clear();
+        upper_qvalues_.clear();
+        transition_begin_.resize(1);
+    }
+
+    /// Returns the number of transitions in the batch.
+    [[nodiscard]]
+    std::size_t num_transitions() const
+    {
+        return costs_.size();
+    }
+
+    /// Returns the number of completed states in the batch.
+    [[nodiscard]]
+    std::size_t num_states() const
+    {
+        return transition_begin_.size() - 1;
+    }
+
+    /// Starts a new transition with the given action cost.
+    void begin_transition(value_t cost)
+    {
+        costs_.push_back(cost);
+        non_self_loop_.push_back(1_vt);
+    }
+
+    /// Adds a self-loop with the given probability to the current transition.
+    void add_self_loop(value_t probability)
+    {
+        non_self_loop_.back() -= probability;
+    }
+
+    /// Adds a successor to the current transition.
+    void add_successor(value_t probability, AlgorithmValueType value)
+    {
+        probabilities_.push_back(probability);
+
+        if constexpr (UseInterval) {
+            lower_values_.push_back(value.lower);
+            upper_values_.push_back(value.upper);
+        } else {
+            lower_values_.push_back(value);
+        }
+    }
+
+    /// Completes the current transition.
+    void end_transition() { successor_begin_.push_back(probabilities_.size()); }
+
+    /// Completes the current state, i.e., the transitions added since the
+    /// last call.
+    void end_state() { transition_begin_.push_back(costs_.size()); }
+
+    /// Returns the range of transition indices of a completed state.
+    [[nodiscard]]
+    std::pair<std::size_t, std::size_t> transitions(std::size_t state) const
+    {
+        return {transition_begin_[state], transition_begin_[state + 1]};
+    }
+
+    /// Checks if a transition only has self-loop successors.
+    [[nodiscard]]
+    bool is_self_loop(std::size_t transition) const
+    {
+        return successor_begin_[transition] ==
+               successor_begin_[transition + 1];
+    }
+
+    /// Checks if all transitions of a completed state only have self-loops.
+    [[nodiscard]]
+    bool has_only_self_loops(std::size_t state) const
+    {
+        const auto [begin, end] = transitions(state);
+        return successor_begin_[begin] == successor_begin_[end];
+    }
+
+    /**
+     * @brief Computes the Q-values of all transitions in the batch.
+     *
+     * Transitions that only have self-loops get the Q-value infinity, so they
+     * never affect the minimum Q-value of a state.
+     */
+    void compute_qvalues()
+    {
+        assert(successor_begin_.size() == costs_.size() + 1);
+
+        compute_qvalues(lower_values_, lower_qvalues_);
+
+        if constexpr (UseInterval) {
+            compute_qvalues(upper_values_, upper_qvalues_);
+        }
+    }
+
+    /// Returns the Q-value of a transition computed by compute_qvalues().
+    [[nodiscard]]
+    AlgorithmValueType get_qvalue(std::size_t transition) const
+    {
+        if constexpr (UseInterval) {
+            return Interval(
+                lower_qvalues_[transition],
+                upper_qvalues_[transition]);
+        } else {
+            return lower_qvalues_[transition];
+        }
+    }
+
+    /// Returns the lower bound of the Q-value of a transition.
+    [[nodiscard]]
+    value_t get_lower_qvalue(std::size_t transition) const
+    {
+        return lower_qvalues_[transition];
+    }
+
+    /**
+     * @brief Returns the component-wise minimum of \p init and the Q-values
+     * of all transitions of a completed state.
+     */
+    [[nodiscard]]
+    AlgorithmValueType
+    compute_min_qvalue(std::size_t state, AlgorithmValueType init) const
+    {
+        const auto [begin, end] = transitions(state);
+
+        if constexpr (UseInterval) {
+            return Interval(
+                min_value(init.lower, range(lower_qvalues_, begin, end)),
+                min_value(init.upper, range(upper_qvalues_, begin, end)));
+        } else {
+            return min_value(init, range(lower_qvalues_, begin, end));
+        }
+    }
+
+private:
+    static std::span<const value_t>
+    range(const std::vector<value_t>& v, std::size_t begin, std::size_t end)
+    {
+        return {v.data() + begin, v.data() + end};
+    }
+
+    void compute_qvalues(
+        const std::vector<value_t>& values,
+        std::vector<value_t>& qvalues) const
+    {
+        const std::size_t n = costs_.size();
+
+        qvalues.resize(n);
+
+        const value_t* probs = probabilities_.data();
+        const value_t* vals = values.data();
+
+        for (std::size_t t = 0; t != n; ++t) {
+            const std::size_t begin = successor_begin_[t];
+            const std::size_t size = successor_begin_[t + 1] - begin;
+
+            if (size == 0) {
+                qvalues[t] = INFINITE_VALUE;
+                continue;
+            }
+
+            value_t q =
+                costs_[t] + dot_product(probs + begin, vals + begin, size);
+
+            if (non_self_loop_[t] < 1_vt) {
+                q *= (1 / non_self_loop_[t]);
+            }
+
+            qvalues[t] = q;
+        }
+    }
+};
+
+} // namespace probfd::algorithms
+
+#endif // PROBFD_ALGORITHMS_QVALUE_BATCH_H
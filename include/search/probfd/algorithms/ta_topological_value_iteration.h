@@ -14,6 +14,7 @@
 #include <limits>
 #include <ostream>
 #include <set>
+#include <span>
 #include <vector>
 
 namespace utils {
@@ -34,6 +35,7 @@ struct Statistics {
     unsigned long long singleton_sccs = 0;
     unsigned long long bellman_backups = 0;
     unsigned long long pruned = 0;
+    unsigned long long reused_sccs = 0;
 
     utils::Timer initialize_state_timer = utils::Timer(false);
     utils::Timer successor_handling_timer = utils::Timer(false);
@@ -53,6 +55,9 @@ struct Statistics {
  * traps reachable from the initial state on-the-fly to guarantee the
  * convergence against the optimal value function.
  *
+ * After a local change of the MDP, the solution can be updated with
+ * resolve(), which only re-solves the SCCs affected by the change.
+ *
  * @see topological_vi::TopologicalValueIteration
  *
  * @tparam State - The state type of the underlying MDP model.
@@ -182,6 +187,11 @@ class TATopologicalValueIteration : public MDPAlgorithm<State, Action> {
         // Iteratively refined during end component decomposition.
         std::vector<QValueInfo> ec_transitions;
 
+        // Incremental mode only. The value the state starts with if its SCC
+        // is re-solved, and whether the state is affected by the change.
+        AlgorithmValueType initial_value;
+        bool affected = false;
+
         struct ParentTransition {
             unsigned parent_idx;
             unsigned parent_transition_idx;
@@ -275,7 +285,7 @@ class TATopologicalValueIteration : public MDPAlgorithm<State, Action> {
     };
 
     storage::PerStateStorage<StateInfo> state_information_;
-    std::vector<ExplorationInfo> exploration_stack_;
+    std::deque<ExplorationInfo> exploration_stack_;
     std::deque<StackInfo> stack_;
 
     std::vector<ECDExplorationInfo> exploration_stack_ecd_;
@@ -284,6 +294,13 @@ class TATopologicalValueIteration : public MDPAlgorithm<State, Action> {
     DecompositionQueue decomposition_queue_;
     std::vector<StateID> scc_;
 
+    // Incremental mode only, see resolve(). Before a state is explored, its
+    // flag tells whether it is changed or new. Afterwards, it tells whether
+    // its SCC was re-solved.
+    bool incremental_ = false;
+    std::vector<bool> affected_;
+    std::vector<Action> changed_actions_;
+
     Statistics statistics_;
 
 public:
@@ -291,7 +308,6 @@ public:
 
     explicit TATopologicalValueIteration(std::size_t num_states_hint)
     {
-        exploration_stack_.reserve(num_states_hint);
         exploration_stack_ecd_.reserve(num_states_hint);
         stack_ecd_.reserve(num_states_hint);
         decomposition_queue_.reserve(num_states_hint);
@@ -327,7 +343,40 @@ public:
         auto& value_store,
         double max_time = std::numeric_limits<double>::infinity());
 
+    /**
+     * @brief Updates the values computed by the last completed call to
+     * solve() or resolve() of this object after a local change of the MDP.
+     *
+     * The value store \p value_store must contain the values computed by the
+     * last call. The states in \p changed_states are those whose termination
+     * cost, applicable actions or transitions changed, or whose heuristic
+     * estimate changed from or to the termination cost. The actions in
+     * \p changed_actions are those whose cost or transitions changed in every
+     * state they are applicable in.
+     *
+     * The state space reachable from \p initial_state is explored again, but
+     * end component decomposition and value iteration are only run on the
+     * affected SCCs, i.e., the SCCs that contain a changed or newly reached
+     * state or can reach such an SCC. The states of an affected SCC restart
+     * from their heuristic estimate. All other states keep their previous
+     * value, which is still optimal since their reachable sub-MDP did not
+     * change. Returns the value of the initial state.
+     */
+    Interval resolve(
+        MDPType& mdp,
+        const EvaluatorType& heuristic,
+        StateID init_state_id,
+        auto& value_store,
+        std::span<const StateID> changed_states,
+        std::span<const Action> changed_actions = {},
+        double max_time = std::numeric_limits<double>::infinity());
+
 private:
+    [[nodiscard]]
+    bool is_affected(StateID state_id) const;
+
+    void set_affected(StateID state_id, bool affected);
+
     /**
      * Pushes a state onto the exploration queue and stack.
      */
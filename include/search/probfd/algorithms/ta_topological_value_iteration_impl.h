@@ -26,6 +26,7 @@ inline void Statistics::print(std::ostream& out) const
     out << "  Maximal SCCs: " << sccs << " (" << singleton_sccs
         << " are singleton)" << std::endl;
     out << "  Bellman backups: " << bellman_backups << std::endl;
+    out << "  Reused SCCs: " << reused_sccs << std::endl;
 
     out << "  Time spent initializing state data: " << initialize_state_timer
         << std::endl;
@@ -353,11 +354,16 @@ Interval TATopologicalValueIteration<State, Action, UseInterval>::solve(
 
             TimerScope _(statistics_.backtracking_timer);
 
-            const ExplorationInfo& successor = *explore--;
+            const ExplorationInfo& successor = exploration_stack_.back();
+            explore = &exploration_stack_[exploration_stack_.size() - 2];
 
             const auto [succ_id, prob] = explore->get_current_successor();
 
             if (backtrack_from_scc) {
+                if (incremental_ && is_affected(succ_id)) {
+                    explore->stack_info.affected = true;
+                }
+
                 const AlgorithmValueType value = value_store[succ_id];
                 explore->q_value.conv_part += prob * value;
                 explore->exit_interval.lower =
@@ -388,6 +394,65 @@ Interval TATopologicalValueIteration<State, Action, UseInterval>::solve(
     }
 }
 
+template <typename State, typename Action, bool UseInterval>
+Interval TATopologicalValueIteration<State, Action, UseInterval>::resolve(
+    MDPType& mdp,
+    const EvaluatorType& heuristic,
+    StateID init_state_id,
+    auto& value_store,
+    std::span<const StateID> changed_states,
+    std::span<const Action> changed_actions,
+    double max_time)
+{
+    // Forget the exploration state of the last call, but remember which
+    // states were explored. States reached for the first time are affected.
+    const std::size_t num_states = state_information_.size();
+
+    affected_.assign(num_states, false);
+
+    for (std::size_t i = 0; i != num_states; ++i) {
+        StateInfo& state_info = state_information_[i];
+        affected_[i] = !state_info.explored;
+        state_info = StateInfo();
+    }
+
+    for (const StateID state_id : changed_states) {
+        set_affected(state_id, true);
+    }
+
+    changed_actions_.assign(changed_actions.begin(), changed_actions.end());
+    std::ranges::sort(changed_actions_);
+
+    incremental_ = true;
+
+    scope_exit _([this] {
+        incremental_ = false;
+        changed_actions_.clear();
+    });
+
+    return this->solve(mdp, heuristic, init_state_id, value_store, max_time);
+}
+
+template <typename State, typename Action, bool UseInterval>
+bool TATopologicalValueIteration<State, Action, UseInterval>::is_affected(
+    StateID state_id) const
+{
+    return state_id >= affected_.size() || affected_[state_id];
+}
+
+template <typename State, typename Action, bool UseInterval>
+void TATopologicalValueIteration<State, Action, UseInterval>::set_affected(
+    StateID state_id,
+    bool affected)
+{
+    if (state_id >= affected_.size()) {
+        // Unknown states are affected by default.
+        affected_.resize(state_id + 1, true);
+    }
+
+    affected_[state_id] = affected;
+}
+
 template <typename State, typename Action, bool UseInterval>
 void TATopologicalValueIteration<State, Action, UseInterval>::push_state(
     StateID state_id,
@@ -428,6 +493,10 @@ bool TATopologicalValueIteration<State, Action, UseInterval>::successor_loop(
         }
 
         case StateInfo::CLOSED: {
+            if (incremental_ && is_affected(succ_id)) {
+                explore.stack_info.affected = true;
+            }
+
             const AlgorithmValueType value = value_store[succ_id];
             explore.q_value.conv_part += prob * value;
             explore.exit_interval.lower =
@@ -474,7 +543,15 @@ bool TATopologicalValueIteration<State, Action, UseInterval>::initialize_state(
     exp_info.stack_info.conv_part = AlgorithmValueType(t_cost);
     exp_info.exit_interval = Interval(t_cost);
 
-    AlgorithmValueType& state_value = value_store[exp_info.state_id];
+    // In incremental mode, the previous value is kept until it is known
+    // whether the SCC of the state is affected.
+    AlgorithmValueType& state_value =
+        incremental_ ? exp_info.stack_info.initial_value
+                     : value_store[exp_info.state_id];
+
+    if (incremental_ && is_affected(exp_info.state_id)) {
+        exp_info.stack_info.affected = true;
+    }
 
     if constexpr (UseInterval) {
         state_value.lower = estimate;
@@ -497,6 +574,13 @@ bool TATopologicalValueIteration<State, Action, UseInterval>::initialize_state(
 
     mdp.generate_applicable_actions(state, exp_info.aops);
 
+    if (incremental_ && !exp_info.stack_info.affected &&
+        std::ranges::any_of(exp_info.aops, [this](const Action& action) {
+            return std::ranges::binary_search(changed_actions_, action);
+        })) {
+        exp_info.stack_info.affected = true;
+    }
+
     const size_t num_aops = exp_info.aops.size();
 
     exp_info.stack_info.ec_transitions.reserve(num_aops);
@@ -529,6 +613,31 @@ void TATopologicalValueIteration<State, Action, UseInterval>::scc_found(
 
     ++statistics_.sccs;
 
+    if (incremental_) {
+        const bool affected = std::ranges::any_of(scc, &StackInfo::affected);
+
+        for (StackInfo& stk_info : scc) {
+            set_affected(stk_info.state_id, affected);
+        }
+
+        if (!affected) {
+            // The SCC and everything reachable from it is unchanged, so the
+            // previous values are still optimal.
+            for (StackInfo& stk_info : scc) {
+                state_information_[stk_info.state_id].stack_id =
+                    StateInfo::UNDEF;
+            }
+
+            ++statistics_.reused_sccs;
+            stack_.erase(scc.begin(), scc.end());
+            return;
+        }
+
+        for (StackInfo& stk_info : scc) {
+            *stk_info.value = stk_info.initial_value;
+        }
+    }
+
     if (exp_info.exit_interval.lower == INFINITE_VALUE ||
         (exp_info.exit_interval.lower == exp_info.exit_interval.upper &&
          exp_info.has_all_zero)) {
@@ -8,6 +8,7 @@
 #include "probfd/distribution.h"
 #include "probfd/mdp_algorithm.h"
 
+#include <atomic>
 #include <deque>
 #include <limits>
 #include <ostream>
@@ -18,9 +19,13 @@ namespace utils {
 class CountdownTimer;
 }
 
+namespace probfd {
+class ThreadPool;
+}
+
 namespace probfd::policies {
 template <typename, typename>
-class MapPolicy;
+class VectorPolicy;
 }
 
 /// Namespace dedicated to Topological Value Iteration (TVI).
@@ -57,6 +62,18 @@ struct Statistics {
  * this algorithm must be used, which eliminates as traps on-the-fly to
  * guarantee convergence.
  *
+ * Optionally, the value iteration phase can be run on multiple threads. In
+ * this case, the SCCs found during exploration are not solved immediately,
+ * but deferred until the exploration is complete. Afterwards, every SCC is
+ * scheduled on a work-stealing thread pool as soon as all SCCs reachable
+ * from it have converged, so independent SCCs are solved concurrently. The
+ * resulting values are identical to the sequential ones, up to differences
+ * in floating-point summation order. Note that this mode keeps the
+ * exploration data of all expanded states in memory until the end.
+ *
+ * @note The time limit is measured in process CPU time, i.e., it accumulates
+ * over all threads in parallel mode.
+ *
  * @see interval_iteration::IntervalIteration
  * @see ta_topological_value_iteration::TATopologicalValueIteration
  *
@@ -72,13 +89,15 @@ class TopologicalValueIteration : public MDPAlgorithm<State, Action> {
     using MDPType = typename Base::MDPType;
     using EvaluatorType = typename Base::EvaluatorType;
 
-    using MapPolicy = policies::MapPolicy<State, Action>;
+    using VectorPolicy = policies::VectorPolicy<State, Action>;
     using AlgorithmValueType = algorithms::AlgorithmValue<UseInterval>;
 
     struct StateInfo {
         // Status Flags
         enum { NEW, CLOSED, ONSTACK };
 
+        // Stack index for ONSTACK states. For CLOSED states in the parallel
+        // mode, the index of the deferred SCC containing the state.
         unsigned stack_id = 0;
         uint8_t status = NEW;
     };
@@ -96,6 +115,11 @@ class TopologicalValueIteration : public MDPAlgorithm<State, Action> {
         // self-loops excluded.
         std::vector<ItemProbabilityPair<AlgorithmValueType*>> nconv_successors;
 
+        // Parallel mode only. Pointers to successor values in child SCCs that
+        // have not been solved yet.
+        std::vector<ItemProbabilityPair<AlgorithmValueType*>>
+            deferred_successors;
+
         QValueInfo(Action action, value_t action_cost);
 
         bool finalize_transition(value_t self_loop_prob);
@@ -122,9 +146,23 @@ class TopologicalValueIteration : public MDPAlgorithm<State, Action> {
         // The optimal action among those leaving the SCC.
         std::optional<Action> best_converged = std::nullopt;
 
+        // Parallel mode only. Indices of the deferred child SCCs.
+        std::vector<unsigned> child_sccs;
+
         StackInfo(StateID state_id, AlgorithmValueType& value_ref);
 
         bool update_value();
+
+        void resolve_deferred_successors();
+    };
+
+    struct DeferredSCC {
+        std::vector<StackInfo> states;
+
+        // Indices of the SCCs with a transition into this SCC.
+        std::vector<unsigned> parents;
+
+        unsigned num_children = 0;
     };
 
     struct ExplorationInfo {
@@ -160,18 +198,28 @@ class TopologicalValueIteration : public MDPAlgorithm<State, Action> {
         ItemProbabilityPair<StateID> get_current_successor();
     };
 
-    using StackIterator = typename std::vector<StackInfo>::iterator;
-
     const bool expand_goals_;
+    const unsigned num_threads_;
 
     storage::PerStateStorage<StateInfo> state_information_;
     std::deque<ExplorationInfo> exploration_stack_;
-    std::vector<StackInfo> stack_;
+    std::deque<StackInfo> stack_;
+
+    // SCCs awaiting value iteration, in reverse topological order.
+    std::vector<DeferredSCC> deferred_sccs_;
 
     Statistics statistics_;
 
 public:
-    explicit TopologicalValueIteration(bool expand_goals);
+    /**
+     * @brief Constructs the algorithm.
+     *
+     * If \p num_threads is greater than one, the SCCs are solved in parallel
+     * on the given number of threads after the state space was explored.
+     */
+    explicit TopologicalValueIteration(
+        bool expand_goals,
+        unsigned num_threads = 1);
 
     std::unique_ptr<PolicyType> compute_policy(
         MDPType& mdp,
@@ -209,7 +257,7 @@ public:
         StateID init_state_id,
         ValueStore& value_store,
         double max_time = std::numeric_limits<double>::infinity(),
-        MapPolicy* policy = nullptr);
+        VectorPolicy* policy = nullptr);
 
 private:
     /**
@@ -251,7 +299,37 @@ private:
     /**
      * Handle the new SCC and perform value iteration on it.
      */
-    void scc_found(auto scc, MapPolicy* policy, utils::CountdownTimer& timer);
+    void
+    scc_found(auto scc, VectorPolicy* policy, utils::CountdownTimer& timer);
+
+    /**
+     * Runs value iteration on a non-singleton SCC until convergence. Returns
+     * the number of Bellman backups performed.
+     */
+    static unsigned long long
+    value_iteration(auto& scc, utils::CountdownTimer& timer);
+
+    /**
+     * Stores the optimal decisions of the states of a non-singleton SCC.
+     */
+    static void extract_policy(auto& scc, VectorPolicy& policy);
+
+    /**
+     * Parallel mode only. Solves all deferred SCCs on a thread pool.
+     */
+    void
+    solve_deferred_sccs(VectorPolicy* policy, utils::CountdownTimer& timer);
+
+    /**
+     * Parallel mode only. Solves a deferred SCC whose child SCCs have all
+     * been solved and schedules the parents that become ready.
+     */
+    void solve_deferred_scc(
+        unsigned scc_index,
+        ThreadPool& pool,
+        std::vector<std::atomic<unsigned>>& pending_children,
+        std::atomic<unsigned long long>& backups,
+        utils::CountdownTimer& timer);
 };
 
 } // namespace probfd::algorithms::topological_vi
@@ -4,13 +4,18 @@
 
 #include "probfd/algorithms/utils.h"
 
-#include "probfd/policies/map_policy.h"
+#include "probfd/policies/vector_policy.h"
 
+#include "probfd/utils/thread_pool.h"
+
+#include "probfd/cost_function.h"
 #include "probfd/evaluator.h"
 #include "probfd/progress_report.h"
 
 #include "downward/utils/countdown_timer.h"
 
+#include <algorithm>
+#include <iterator>
 #include <type_traits>
 
 namespace probfd::algorithms::topological_vi {
@@ -101,13 +106,13 @@ template <typename State, typename Action, bool UseInterval>
 bool TopologicalValueIteration<State, Action, UseInterval>::ExplorationInfo::
     forward_non_loop_successor()
 {
-    do {
+    for (; successor != transition.end(); ++successor) {
         if (successor->item != state_id) {
             return true;
         }
 
         self_loop_prob += successor->probability;
-    } while (++successor != transition.end());
+    }
 
     return false;
 }
@@ -149,9 +154,13 @@ bool TopologicalValueIteration<State, Action, UseInterval>::QValueInfo::
         for (auto& pair : nconv_successors) {
             pair.probability *= normalization;
         }
+
+        for (auto& pair : deferred_successors) {
+            pair.probability *= normalization;
+        }
     }
 
-    return nconv_successors.empty();
+    return nconv_successors.empty() && deferred_successors.empty();
 }
 
 template <typename State, typename Action, bool UseInterval>
@@ -197,10 +206,32 @@ bool TopologicalValueIteration<State, Action, UseInterval>::StackInfo::
     }
 }
 
+template <typename State, typename Action, bool UseInterval>
+void TopologicalValueIteration<State, Action, UseInterval>::StackInfo::
+    resolve_deferred_successors()
+{
+    std::erase_if(nconv_qs, [this](QValueInfo& info) {
+        for (auto& [value, prob] : info.deferred_successors) {
+            info.conv_part += prob * (*value);
+        }
+
+        info.deferred_successors.clear();
+
+        if (!info.nconv_successors.empty()) return false;
+
+        if (set_min(conv_part, info.conv_part)) {
+            best_converged = info.action;
+        }
+
+        return true;
+    });
+}
+
 template <typename State, typename Action, bool UseInterval>
 TopologicalValueIteration<State, Action, UseInterval>::
-    TopologicalValueIteration(bool expand_goals)
+    TopologicalValueIteration(bool expand_goals, unsigned num_threads)
     : expand_goals_(expand_goals)
+    , num_threads_(num_threads)
 {
 }
 
@@ -213,7 +244,7 @@ auto TopologicalValueIteration<State, Action, UseInterval>::compute_policy(
     double max_time) -> std::unique_ptr<PolicyType>
 {
     storage::PerStateStorage<AlgorithmValueType> value_store;
-    std::unique_ptr<MapPolicy> policy(new MapPolicy(&mdp));
+    std::unique_ptr<VectorPolicy> policy(new VectorPolicy(&mdp));
     this->solve(
         mdp,
         heuristic,
@@ -259,7 +290,7 @@ Interval TopologicalValueIteration<State, Action, UseInterval>::solve(
     StateID init_state_id,
     ValueStore& value_store,
     double max_time,
-    MapPolicy* policy)
+    VectorPolicy* policy)
 {
     utils::CountdownTimer timer(max_time);
 
@@ -289,6 +320,8 @@ Interval TopologicalValueIteration<State, Action, UseInterval>::solve(
             exploration_stack_.pop_back();
 
             if (exploration_stack_.empty()) {
+                if (num_threads_ > 1) solve_deferred_sccs(policy, timer);
+
                 if constexpr (UseInterval) {
                     return init_value;
                 } else {
@@ -305,7 +338,13 @@ Interval TopologicalValueIteration<State, Action, UseInterval>::solve(
             QValueInfo& tinfo = explore->stack_info.nconv_qs.back();
 
             if (backtrack_from_scc) {
-                tinfo.conv_part += prob * s_value;
+                if (num_threads_ > 1) {
+                    tinfo.deferred_successors.emplace_back(&s_value, prob);
+                    explore->stack_info.child_sccs.push_back(
+                        state_information_[succ_id].stack_id);
+                } else {
+                    tinfo.conv_part += prob * s_value;
+                }
             } else {
                 explore->update_lowlink(lowlink);
                 tinfo.nconv_successors.emplace_back(&s_value, prob);
@@ -413,7 +452,14 @@ bool TopologicalValueIteration<State, Action, UseInterval>::successor_loop(
                 return true; // recursion on new state
             }
 
-            case StateInfo::CLOSED: tinfo.conv_part += prob * s_value; break;
+            case StateInfo::CLOSED:
+                if (num_threads_ > 1) {
+                    tinfo.deferred_successors.emplace_back(&s_value, prob);
+                    explore.stack_info.child_sccs.push_back(succ_info.stack_id);
+                } else {
+                    tinfo.conv_part += prob * s_value;
+                }
+                break;
 
             case StateInfo::ONSTACK:
                 explore.update_lowlink(succ_info.stack_id);
@@ -428,17 +474,48 @@ bool TopologicalValueIteration<State, Action, UseInterval>::successor_loop(
 template <typename State, typename Action, bool UseInterval>
 void TopologicalValueIteration<State, Action, UseInterval>::scc_found(
     auto scc,
-    MapPolicy* policy,
+    VectorPolicy* policy,
     utils::CountdownTimer& timer)
 {
     assert(!scc.empty());
 
     ++statistics_.sccs;
 
-    if (scc.size() == 1) {
+    if (scc.size() == 1) ++statistics_.singleton_sccs;
+
+    if (num_threads_ > 1) {
+        // Defer value iteration until the exploration is complete.
+        const auto scc_index = static_cast<unsigned>(deferred_sccs_.size());
+        DeferredSCC& deferred = deferred_sccs_.emplace_back();
+
+        std::vector<unsigned> children;
+
+        for (StackInfo& stk_info : scc) {
+            StateInfo& state_info = state_information_[stk_info.state_id];
+            assert(state_info.status == StateInfo::ONSTACK);
+            state_info.status = StateInfo::CLOSED;
+            state_info.stack_id = scc_index;
+            children.insert(
+                children.end(),
+                stk_info.child_sccs.begin(),
+                stk_info.child_sccs.end());
+            stk_info.child_sccs.clear();
+        }
+
+        std::ranges::sort(children);
+        const auto [first, last] = std::ranges::unique(children);
+        children.erase(first, last);
+
+        for (const unsigned child : children) {
+            deferred_sccs_[child].parents.push_back(scc_index);
+        }
+
+        deferred.num_children = static_cast<unsigned>(children.size());
+        deferred.states.reserve(scc.size());
+        std::ranges::move(scc, std::back_inserter(deferred.states));
+    } else if (scc.size() == 1) {
         // Singleton SCCs can only transition to a child SCC. The state
         // value has already converged due to topological ordering.
-        ++statistics_.singleton_sccs;
         StackInfo& single = scc.front();
         StateInfo& state_info = state_information_[single.state_id];
         update(*single.value, single.conv_part);
@@ -454,39 +531,152 @@ void TopologicalValueIteration<State, Action, UseInterval>::scc_found(
         }
 
         // Now run VI on the SCC until convergence
-        bool converged;
+        statistics_.bellman_backups += value_iteration(scc, timer);
+
+        // Extract a policy from this SCC
+        if (policy) extract_policy(scc, *policy);
+    }
+
+    stack_.erase(scc.begin(), scc.end());
+}
+
+template <typename State, typename Action, bool UseInterval>
+unsigned long long
+TopologicalValueIteration<State, Action, UseInterval>::value_iteration(
+    auto& scc,
+    utils::CountdownTimer& timer)
+{
+    unsigned long long backups = 0;
+    bool converged;
+
+    do {
+        timer.throw_if_expired();
+
+        converged = true;
+        auto it = scc.begin();
 
         do {
-            timer.throw_if_expired();
+            if (it->update_value()) converged = false;
+            ++backups;
+        } while (++it != scc.end());
+    } while (!converged);
+
+    return backups;
+}
+
+template <typename State, typename Action, bool UseInterval>
+void TopologicalValueIteration<State, Action, UseInterval>::extract_policy(
+    auto& scc,
+    VectorPolicy& policy)
+{
+    for (StackInfo& stk_info : scc) {
+        if constexpr (UseInterval) {
+            policy.emplace_decision(
+                stk_info.state_id,
+                *stk_info.best_action,
+                *stk_info.value);
+        } else {
+            policy.emplace_decision(
+                stk_info.state_id,
+                *stk_info.best_action,
+                Interval(*stk_info.value, INFINITE_VALUE));
+        }
+    }
+}
 
-            converged = true;
-            auto it = scc.begin();
+template <typename State, typename Action, bool UseInterval>
+void TopologicalValueIteration<State, Action, UseInterval>::
+    solve_deferred_sccs(VectorPolicy* policy, utils::CountdownTimer& timer)
+{
+    const std::size_t num_sccs = deferred_sccs_.size();
 
-            do {
-                if (it->update_value()) converged = false;
-                ++statistics_.bellman_backups;
-            } while (++it != scc.end());
-        } while (!converged);
+    std::vector<std::atomic<unsigned>> pending_children(num_sccs);
+    std::atomic<unsigned long long> backups = 0;
 
-        // Extract a policy from this SCC
-        if (policy) {
-            for (StackInfo& stk_info : scc) {
-                if constexpr (UseInterval) {
-                    policy->emplace_decision(
-                        stk_info.state_id,
-                        *stk_info.best_action,
-                        *stk_info.value);
-                } else {
-                    policy->emplace_decision(
-                        stk_info.state_id,
-                        *stk_info.best_action,
-                        Interval(*stk_info.value, INFINITE_VALUE));
-                }
+    {
+        ThreadPool pool(num_threads_);
+
+        for (std::size_t i = 0; i != num_sccs; ++i) {
+            pending_children[i].store(
+                deferred_sccs_[i].num_children,
+                std::memory_order_relaxed);
+        }
+
+        // Start with the leaves of the SCC DAG. The remaining SCCs are
+        // scheduled by their last child to finish.
+        for (std::size_t i = 0; i != num_sccs; ++i) {
+            if (deferred_sccs_[i].num_children != 0) continue;
+            pool.submit([&, i] {
+                solve_deferred_scc(
+                    static_cast<unsigned>(i),
+                    pool,
+                    pending_children,
+                    backups,
+                    timer);
+            });
+        }
+
+        try {
+            pool.wait();
+        } catch (...) {
+            deferred_sccs_.clear();
+            throw;
+        }
+    }
+
+    statistics_.bellman_backups += backups;
+
+    if (policy) {
+        for (DeferredSCC& deferred : deferred_sccs_) {
+            if (deferred.states.size() > 1) {
+                extract_policy(deferred.states, *policy);
             }
         }
     }
 
-    stack_.erase(scc.begin(), scc.end());
+    deferred_sccs_.clear();
+}
+
+template <typename State, typename Action, bool UseInterval>
+void TopologicalValueIteration<State, Action, UseInterval>::
+    solve_deferred_scc(
+        unsigned scc_index,
+        ThreadPool& pool,
+        std::vector<std::atomic<unsigned>>& pending_children,
+        std::atomic<unsigned long long>& backups,
+        utils::CountdownTimer& timer)
+{
+    DeferredSCC& deferred = deferred_sccs_[scc_index];
+    std::vector<StackInfo>& scc = deferred.states;
+
+    // All child SCCs have converged, fold their values into the
+    // precomputed parts of the Q values.
+    for (StackInfo& stk_info : scc) {
+        stk_info.resolve_deferred_successors();
+    }
+
+    if (scc.size() == 1) {
+        StackInfo& single = scc.front();
+        assert(single.nconv_qs.empty());
+        update(*single.value, single.conv_part);
+    } else {
+        backups.fetch_add(
+            value_iteration(scc, timer),
+            std::memory_order_relaxed);
+    }
+
+    for (const unsigned parent : deferred.parents) {
+        if (pending_children[parent].fetch_sub(1) == 1) {
+            pool.submit([&, parent] {
+                solve_deferred_scc(
+                    parent,
+                    pool,
+                    pending_children,
+                    backups,
+                    timer);
+            });
+        }
+    }
 }
 
 } // namespace probfd::algorithms::topological_vi
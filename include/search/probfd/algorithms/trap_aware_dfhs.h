@@ -8,6 +8,7 @@
 
 #include "downward/utils/timer.h"
 
+#include <deque>
 #include <type_traits>
 #include <vector>
 
@@ -81,6 +82,7 @@ class TADFHSImpl
     using QuotientPolicyPicker = typename Base::PolicyPickerType;
     using UpdateResult = typename Base ::UpdateResult;
     using StateInfo = typename Base::StateInfo;
+    using StateInfoRef = typename Base::StateInfoRef;
 
     using QuotientOpenList = OpenList<QAction>;
 
@@ -241,7 +243,7 @@ private:
         QuotientSystem& quotient,
         QEvaluator& heuristic,
         StateID state,
-        StateInfo& state_info,
+        StateInfoRef state_info,
         Flags& flags);
 
     bool repush_trap(
@@ -4,7 +4,7 @@
 
 #include "probfd/algorithms/open_list.h"
 
-#include "probfd/policies/map_policy.h"
+#include "probfd/policies/vector_policy.h"
 
 #include "probfd/quotients/quotient_max_heuristic.h"
 
@@ -210,7 +210,7 @@ bool TADFHSImpl<State, Action, UseInterval>::push_successor(
         if (succ_status == STATE_UNSEEN) {
             // expand state (either not expanded before, or last
             // value change was before pushing einfo.state)
-            StateInfo& succ_info = this->get_state_info(succ);
+            StateInfoRef succ_info = this->get_state_info(succ);
             if (succ_info.is_terminal() || succ_info.is_solved()) {
                 succ_info.set_solved();
                 einfo.flags.update(succ_info);
@@ -246,7 +246,7 @@ bool TADFHSImpl<State, Action, UseInterval>::push_state(
     QuotientSystem& quotient,
     QEvaluator& heuristic,
     StateID state_id,
-    StateInfo& state_info,
+    StateInfoRef state_info,
     Flags& flags)
 {
     assert(
@@ -340,7 +340,7 @@ bool TADFHSImpl<State, Action, UseInterval>::policy_exploration(
 
     {
         Flags flags;
-        StateInfo& state_info = this->get_state_info(start_state);
+        StateInfoRef state_info = this->get_state_info(start_state);
         if (state_info.is_terminal() || state_info.is_solved()) {
             state_info.set_solved();
             flags.update(state_info);
@@ -651,8 +651,8 @@ auto TADepthFirstHeuristicSearch<State, Action, UseInterval>::compute_policy(
      * the action with which it is encountered first as the policy
      * action.
      */
-    using MapPolicy = policies::MapPolicy<State, Action>;
-    std::unique_ptr<MapPolicy> policy(new MapPolicy(&mdp));
+    using VectorPolicy = policies::VectorPolicy<State, Action>;
+    std::unique_ptr<VectorPolicy> policy(new VectorPolicy(&mdp));
 
     const StateID initial_state_id = quotient.get_state_id(qinit);
 
@@ -7,6 +7,8 @@
 
 #include "downward/utils/timer.h"
 
+#include <deque>
+
 // Forward Declarations
 namespace utils {
 class CountdownTimer;
@@ -86,6 +88,7 @@ class TALRTDPImpl
     using QEvaluator = typename Base::EvaluatorType;
     using QuotientPolicyPicker = typename Base::PolicyPickerType;
     using StateInfo = typename Base::StateInfo;
+    using StateInfoRef = typename Base::StateInfoRef;
 
     using QuotientSuccessorSampler = SuccessorSampler<QAction>;
 
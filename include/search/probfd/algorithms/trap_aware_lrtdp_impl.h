@@ -115,7 +115,7 @@ bool TALRTDPImpl<State, Action, UseInterval>::trial(
         timer.throw_if_expired();
 
         StateID stateid = current_trial_.back();
-        auto& info = this->get_state_info(stateid);
+        auto&& info = this->get_state_info(stateid);
         if (info.is_solved()) {
             current_trial_.pop_back();
             break;
@@ -176,7 +176,7 @@ bool TALRTDPImpl<State, Action, UseInterval>::check_and_solve(
     assert(!this->current_trial_.empty());
 
     const StateID s = quotient.translate_state_id(this->current_trial_.back());
-    auto& sinfo = this->get_state_info(s);
+    auto&& sinfo = this->get_state_info(s);
 
     if (sinfo.is_solved()) {
         // was labeled in some prior check_and_solve() invocation
@@ -289,7 +289,7 @@ bool TALRTDPImpl<State, Action, UseInterval>::push_successor(
         timer.throw_if_expired();
 
         const StateID succ = quotient.translate_state_id(einfo.get_successor());
-        StateInfo& succ_info = this->get_state_info(succ);
+        StateInfoRef succ_info = this->get_state_info(succ);
         int& sidx = stack_index_[succ];
         if (sidx == STATE_UNSEEN) {
             if (succ_info.is_terminal()) {
@@ -12,6 +12,7 @@
 
 #include <limits>
 #include <memory>
+#include <memory_resource>
 #include <vector>
 
 // Forward Declarations
@@ -56,7 +57,9 @@ public:
         utils::LogProxy log,
         std::shared_ptr<FDRSimpleCostFunction> task_cost_function,
         const std::vector<std::shared_ptr<::Evaluator>>&
-            path_dependent_evaluators);
+            path_dependent_evaluators,
+        std::pmr::memory_resource* state_memory =
+            std::pmr::get_default_resource());
 
     void generate_applicable_actions(
         const State& state,
@@ -93,6 +93,9 @@ public:
 
     value_t get_cost(int op_index) const;
 
+    /* Needed to saturate abstractions that were refined for other costs. */
+    void set_operator_costs(std::vector<value_t> operator_costs);
+
     int get_num_states() const;
     const AbstractState& get_initial_state() const;
     const Goals& get_goals() const;
@@ -42,6 +42,8 @@ struct CEGARResult {
     std::unique_ptr<CartesianHeuristic> heuristic;
 
     ~CEGARResult();
+
+    CEGARResult& operator=(CEGARResult&&) noexcept;
 };
 
 /*
@@ -75,6 +77,11 @@ public:
     CEGARResult
     run_refinement_loop(const std::shared_ptr<ProbabilisticTask>& task);
 
+    // Build abstraction, using the given split selector.
+    CEGARResult run_refinement_loop(
+        const std::shared_ptr<ProbabilisticTask>& task,
+        SplitSelector& split_selector);
+
 private:
     bool may_keep_refining(const Abstraction& abstraction) const;
 
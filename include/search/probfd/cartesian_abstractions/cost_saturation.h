@@ -23,6 +23,7 @@ class ProbabilisticTask;
 } // namespace probfd
 
 namespace probfd::cartesian_abstractions {
+struct CEGARResult;
 class CartesianHeuristicFunction;
 class FlawGeneratorFactory;
 class SplitSelectorFactory;
@@ -37,6 +38,14 @@ namespace probfd::cartesian_abstractions {
   RefinementHierarchies from Abstractions to
   CartesianHeuristicFunctions, allow extracting
   CartesianHeuristicFunctions into AdditiveCartesianHeuristic.
+
+  If multiple threads are used, the abstractions of the subtasks of one
+  SubtaskGenerator are refined concurrently for the remaining costs before
+  any of them is saturated. The abstractions are then saturated in order,
+  with their goal distances recomputed for the costs that remain at that
+  point. The refinement is speculative, but the cost partitioning stays
+  admissible, since every abstraction only uses the costs left over by the
+  previous ones.
 */
 class CostSaturation {
     const std::vector<std::shared_ptr<SubtaskGenerator>> subtask_generators_;
@@ -46,6 +55,7 @@ class CostSaturation {
     const int max_non_looping_transitions_;
     const double max_time_;
     const bool use_general_costs_;
+    const unsigned num_threads_;
     mutable utils::LogProxy log_;
 
     std::vector<CartesianHeuristicFunction> heuristic_functions_;
@@ -63,6 +73,11 @@ class CostSaturation {
         const std::vector<std::shared_ptr<ProbabilisticTask>>& subtasks,
         const utils::CountdownTimer& timer,
         std::function<bool()> should_abort);
+    void build_abstractions_concurrently(
+        const std::vector<std::shared_ptr<ProbabilisticTask>>& subtasks,
+        const utils::CountdownTimer& timer,
+        std::function<bool()> should_abort);
+    void add_abstraction(CEGARResult& result, bool reset_distances);
     void print_statistics(utils::Duration init_time) const;
 
 public:
@@ -75,6 +90,7 @@ public:
         int max_non_looping_transitions,
         double max_time,
         bool use_general_costs,
+        int num_threads,
         utils::LogProxy log);
 
     ~CostSaturation();
@@ -41,7 +41,9 @@ public:
         utils::LogProxy& log,
         utils::CountdownTimer& timer) = 0;
 
-    virtual void notify_split() = 0;
+    // Called after an abstract state was split into the states with IDs
+    // v1_id and v2_id, where v1_id is the ID of the split state.
+    virtual void notify_split(int v1_id, int v2_id) = 0;
 
     virtual void print_statistics(utils::LogProxy& log) = 0;
 };
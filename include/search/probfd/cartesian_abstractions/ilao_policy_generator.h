@@ -4,7 +4,11 @@
 #include "probfd/cartesian_abstractions/policy_generator.h"
 #include "probfd/cartesian_abstractions/types.h"
 
+#include "probfd/value_type.h"
+
+#include <deque>
 #include <memory>
+#include <vector>
 
 // Forward Declarations
 namespace utils {
@@ -34,6 +38,12 @@ namespace probfd::cartesian_abstractions {
 
 /**
  * @brief Find an optimal policy using ILAO*.
+ *
+ * The goal distance estimates computed by ILAO* are kept as the heuristic for
+ * the next refinement step. Optionally, the estimates are also updated
+ * incrementally after each split: the two new states are backed up, and the
+ * predecessors of every state whose estimate increases are backed up in turn.
+ * Only the region whose estimates actually change is visited.
  */
 class ILAOPolicyGenerator : public PolicyGenerator {
     std::shared_ptr<policy_pickers::ArbitraryTiebreaker<
@@ -41,14 +51,30 @@ class ILAOPolicyGenerator : public PolicyGenerator {
         quotients::QuotientAction<const ProbabilisticTransition*>>>
         picker_;
 
+    const bool incremental_distances_;
+    // States split since the estimates were last updated.
+    std::vector<int> split_states_;
+    std::deque<int> update_queue_;
+    std::vector<bool> is_queued_;
+
 public:
-    ILAOPolicyGenerator();
+    explicit ILAOPolicyGenerator(bool incremental_distances = false);
 
     std::unique_ptr<Solution> find_solution(
         Abstraction& abstraction,
         const AbstractState* init_id,
         CartesianHeuristic& heuristic,
         utils::CountdownTimer& time_limit) override;
+
+    void notify_split(int v1_id, int v2_id) override;
+
+private:
+    void update_distances(
+        Abstraction& abstraction,
+        CartesianHeuristic& heuristic,
+        utils::CountdownTimer& timer);
+
+    void enqueue(int state_id);
 };
 
 } // namespace probfd::cartesian_abstractions
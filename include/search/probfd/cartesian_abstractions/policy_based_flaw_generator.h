@@ -70,16 +70,17 @@ public:
         utils::LogProxy& log,
         utils::CountdownTimer& timer) override;
 
-    void notify_split() override;
+    void notify_split(int v1_id, int v2_id) override;
 
     void print_statistics(utils::LogProxy& log) override;
 };
 
 class ILAOFlawGeneratorFactory : public FlawGeneratorFactory {
     int max_search_states_;
+    bool incremental_distances_;
 
 public:
-    explicit ILAOFlawGeneratorFactory(int max_search_states);
+    ILAOFlawGeneratorFactory(int max_search_states, bool incremental_distances);
 
     std::unique_ptr<FlawGenerator> create_flaw_generator() override;
 };
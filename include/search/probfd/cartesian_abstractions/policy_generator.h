@@ -26,6 +26,10 @@ public:
         const AbstractState* init_id,
         CartesianHeuristic& heuristic,
         utils::CountdownTimer& time_limit) = 0;
+
+    // Called after an abstract state was split into the states with IDs
+    // v1_id and v2_id, where v1_id is the ID of the split state.
+    virtual void notify_split(int v1_id, int v2_id) = 0;
 };
 
 } // namespace probfd::cartesian_abstractions
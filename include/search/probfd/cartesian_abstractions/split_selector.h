@@ -169,6 +169,17 @@ public:
 
     virtual std::unique_ptr<SplitSelector>
     create_split_selector(const std::shared_ptr<ProbabilisticTask>& task) = 0;
+
+    /*
+      Create a split selector that shares no mutable state with the other
+      selectors of this factory, so that it can be used on another thread.
+      Must not be called concurrently.
+    */
+    virtual std::unique_ptr<SplitSelector> create_independent_split_selector(
+        const std::shared_ptr<ProbabilisticTask>& task)
+    {
+        return create_split_selector(task);
+    }
 };
 
 /*
@@ -182,6 +193,9 @@ public:
 
     std::unique_ptr<SplitSelector> create_split_selector(
         const std::shared_ptr<ProbabilisticTask>& task) override;
+
+    std::unique_ptr<SplitSelector> create_independent_split_selector(
+        const std::shared_ptr<ProbabilisticTask>& task) override;
 };
 
 /*
@@ -1,6 +1,8 @@
 #ifndef PROBFD_DISTRIBUTION_H
 #define PROBFD_DISTRIBUTION_H
 
+#include "probfd/utils/small_vector.h"
+
 #include "probfd/value_type.h"
 
 #include "downward/utils/rng.h"
@@ -10,7 +12,6 @@
 #include <compare>
 #include <ranges>
 #include <utility>
-#include <vector>
 
 namespace probfd {
 
@@ -76,16 +77,30 @@ public:
 /**
  * @brief A convenience class that represents a finite probability distribution.
  *
+ * Supports of up to INLINE_CAPACITY elements are stored inline, i.e., without
+ * a heap allocation. Most transitions of typical planning tasks have only a
+ * few outcomes, so constructing them does not allocate.
+ *
+ * @warning Since the elements may be stored inline, moving or swapping a
+ * distribution invalidates its iterators.
+ *
  * @tparam T - The item type.
  */
 template <typename T>
 class Distribution {
-    std::vector<ItemProbabilityPair<T>> distribution_;
+public:
+    /// The number of elements stored without a heap allocation.
+    static constexpr std::size_t INLINE_CAPACITY =
+        std::max<std::size_t>(1, 64 / sizeof(ItemProbabilityPair<T>));
+
+private:
+    using StorageType = SmallVector<ItemProbabilityPair<T>, INLINE_CAPACITY>;
+
+    StorageType distribution_;
 
 public:
-    using iterator = typename std::vector<ItemProbabilityPair<T>>::iterator;
-    using const_iterator =
-        typename std::vector<ItemProbabilityPair<T>>::const_iterator;
+    using iterator = typename StorageType::iterator;
+    using const_iterator = typename StorageType::const_iterator;
 
     Distribution() = default;
 
@@ -276,7 +291,7 @@ public:
     template <typename UnaryPredicate>
     size_t remove_if(UnaryPredicate pred)
     {
-        return std::erase_if(distribution_, pred);
+        return erase_if(distribution_, pred);
     }
 
     template <typename UnaryPredicate>
@@ -284,7 +299,7 @@ public:
     {
         value_t normalize_factor = 0_vt;
 
-        std::erase_if(
+        erase_if(
             this->distribution_,
             [&pred, &normalize_factor](auto& target) {
                 if (pred(target)) {
@@ -5,6 +5,10 @@
 #include "probfd/types.h"
 #include "probfd/value_type.h"
 
+#include <cassert>
+#include <cstddef>
+#include <span>
+
 namespace probfd {
 
 /**
@@ -23,6 +27,24 @@ public:
      */
     virtual value_t evaluate(param_type<State> state) const = 0;
 
+    /**
+     * @brief Evaluates the heuristic on a batch of states and stores the
+     * heuristic value of the state pointed to by \p states[i] at position i
+     * of \p values.
+     *
+     * The default implementation evaluates the states one by one. Heuristics
+     * that can share work between the states of a batch should override it.
+     */
+    virtual void evaluate_batch(
+        std::span<const State* const> states,
+        std::span<value_t> values) const
+    {
+        assert(states.size() == values.size());
+        for (std::size_t i = 0; i != states.size(); ++i) {
+            values[i] = evaluate(*states[i]);
+        }
+    }
+
     /**
      * @brief Prints statistics, e.g. the number of queries made to the
      * interface.
@@ -0,0 +1,289 @@
+#ifndef PROBFD_FLAT_EXPLICIT_MDP_H
+#define PROBFD_FLAT_EXPLICIT_MDP_H
+
+#include "probfd/storage/per_state_storage.h"
+
+#include "probfd/distribution.h"
+#include "probfd/evaluator.h"
+#include "probfd/mdp.h"
+#include "probfd/transition.h"
+#include "probfd/types.h"
+#include "probfd/value_type.h"
+
+#include "downward/utils/countdown_timer.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <vector>
+
+namespace probfd {
+
+/**
+ * @brief An explicit snapshot of the reachable part of an MDP, stored in flat
+ * compressed sparse row (CSR) arrays.
+ *
+ * The snapshot is built once by exhaustively exploring the MDP from an initial
+ * state. Afterwards, states are identified by a dense index in
+ * [0, num_states()), with index 0 being the initial state, and transitions are
+ * identified by a dense index in [0, num_transitions()). The transitions of a
+ * state and the successors of a transition are contiguous ranges of plain
+ * arrays, so solvers can iterate over them without virtual calls or
+ * allocations.
+ *
+ * Self-loops are eliminated during construction: The cost and the remaining
+ * successor probabilities of a transition with self-loop probability p are
+ * scaled by 1 / (1 - p). Transitions that are pure self-loops are dropped.
+ * This is the same normalization applied by topological value iteration and
+ * does not change the optimal state values.
+ *
+ * States whose heuristic estimate equals their termination cost, as well as
+ * goal states unless goal expansion is requested, are not expanded and have
+ * no transitions.
+ *
+ * @tparam Action - The action type of the explored MDP.
+ */
+template <typename Action>
+class FlatExplicitMDP {
+public:
+    using StateIndex = std::uint32_t;
+    using TransitionIndex = std::size_t;
+
+    static constexpr StateIndex UNSEEN = std::numeric_limits<StateIndex>::max();
+
+private:
+    // Per-state data
+    std::vector<StateID> state_ids_;
+    std::vector<value_t> termination_costs_;
+    std::vector<value_t> estimates_;
+    std::vector<bool> goal_flags_;
+    std::vector<TransitionIndex> transition_begin_;
+
+    // Per-transition data
+    std::vector<Action> actions_;
+    std::vector<value_t> transition_costs_;
+    std::vector<std::size_t> successor_begin_;
+
+    // Per-successor data
+    std::vector<StateIndex> successors_;
+    std::vector<value_t> probabilities_;
+
+public:
+    /**
+     * @brief Explores the reachable state space of \p mdp from \p initial_id
+     * and stores it.
+     *
+     * @throws utils::TimeoutException if the time limit of \p timer expires.
+     */
+    template <typename State>
+    FlatExplicitMDP(
+        MDP<State, Action>& mdp,
+        const Evaluator<State>& heuristic,
+        StateID initial_id,
+        bool expand_goals,
+        const utils::CountdownTimer& timer);
+
+    /// Returns the number of stored states.
+    [[nodiscard]]
+    std::size_t num_states() const
+    {
+        return state_ids_.size();
+    }
+
+    /// Returns the number of stored transitions.
+    [[nodiscard]]
+    std::size_t num_transitions() const
+    {
+        return actions_.size();
+    }
+
+    /// Returns the total number of stored successor entries.
+    [[nodiscard]]
+    std::size_t num_successors() const
+    {
+        return successors_.size();
+    }
+
+    /// Returns the state ID of a state in the explored MDP.
+    [[nodiscard]]
+    StateID get_state_id(StateIndex state) const
+    {
+        return state_ids_[state];
+    }
+
+    [[nodiscard]]
+    value_t get_termination_cost(StateIndex state) const
+    {
+        return termination_costs_[state];
+    }
+
+    /// Returns the heuristic estimate computed during exploration.
+    [[nodiscard]]
+    value_t get_estimate(StateIndex state) const
+    {
+        return estimates_[state];
+    }
+
+    [[nodiscard]]
+    bool is_goal(StateIndex state) const
+    {
+        return goal_flags_[state];
+    }
+
+    /// Returns the range of transition indices of a state.
+    [[nodiscard]]
+    auto transitions(StateIndex state) const
+    {
+        return std::views::iota(
+            transition_begin_[state],
+            transition_begin_[state + 1]);
+    }
+
+    [[nodiscard]]
+    const Action& get_action(TransitionIndex transition) const
+    {
+        return actions_[transition];
+    }
+
+    /// Returns the transition cost, normalized wrt. self-loops.
+    [[nodiscard]]
+    value_t get_cost(TransitionIndex transition) const
+    {
+        return transition_costs_[transition];
+    }
+
+    /// Returns the successor states of a transition, excluding self-loops.
+    [[nodiscard]]
+    std::span<const StateIndex> successors(TransitionIndex transition) const
+    {
+        return {
+            successors_.data() + successor_begin_[transition],
+            successors_.data() + successor_begin_[transition + 1]};
+    }
+
+    /// Returns the normalized successor probabilities of a transition.
+    [[nodiscard]]
+    std::span<const value_t> probabilities(TransitionIndex transition) const
+    {
+        return {
+            probabilities_.data() + successor_begin_[transition],
+            probabilities_.data() + successor_begin_[transition + 1]};
+    }
+
+    /// Returns the successors of all transitions of a state.
+    [[nodiscard]]
+    std::span<const StateIndex> all_successors(StateIndex state) const
+    {
+        return {
+            successors_.data() + successor_begin_[transition_begin_[state]],
+            successors_.data() +
+                successor_begin_[transition_begin_[state + 1]]};
+    }
+
+    /// Returns the approximate memory consumption in bytes.
+    [[nodiscard]]
+    std::size_t get_memory_usage() const
+    {
+        return state_ids_.capacity() * sizeof(StateID) +
+               termination_costs_.capacity() * sizeof(value_t) +
+               estimates_.capacity() * sizeof(value_t) +
+               goal_flags_.capacity() / 8 +
+               transition_begin_.capacity() * sizeof(TransitionIndex) +
+               actions_.capacity() * sizeof(Action) +
+               transition_costs_.capacity() * sizeof(value_t) +
+               successor_begin_.capacity() * sizeof(std::size_t) +
+               successors_.capacity() * sizeof(StateIndex) +
+               probabilities_.capacity() * sizeof(value_t);
+    }
+};
+
+template <typename Action>
+template <typename State>
+FlatExplicitMDP<Action>::FlatExplicitMDP(
+    MDP<State, Action>& mdp,
+    const Evaluator<State>& heuristic,
+    StateID initial_id,
+    bool expand_goals,
+    const utils::CountdownTimer& timer)
+{
+    storage::PerStateStorage<StateIndex> indices(UNSEEN);
+
+    auto lookup = [&](StateID state_id) {
+        StateIndex& index = indices[state_id];
+        if (index == UNSEEN) {
+            index = static_cast<StateIndex>(state_ids_.size());
+            state_ids_.push_back(state_id);
+        }
+        return index;
+    };
+
+    lookup(initial_id);
+
+    transition_begin_.push_back(0);
+    successor_begin_.push_back(0);
+
+    std::vector<Transition<Action>> transitions;
+
+    // The state IDs vector doubles as the breadth-first search queue.
+    for (StateIndex index = 0; index != state_ids_.size(); ++index) {
+        timer.throw_if_expired();
+
+        const StateID state_id = state_ids_[index];
+        const State state = mdp.get_state(state_id);
+        const TerminationInfo term = mdp.get_termination_info(state);
+        const value_t t_cost = term.get_cost();
+        const value_t estimate = heuristic.evaluate(state);
+
+        termination_costs_.push_back(t_cost);
+        estimates_.push_back(estimate);
+        goal_flags_.push_back(term.is_goal_state());
+
+        const bool prune =
+            term.is_goal_state() ? !expand_goals : estimate == t_cost;
+
+        if (!prune) {
+            mdp.generate_all_transitions(state, transitions);
+
+            for (const auto& [action, successor_dist] : transitions) {
+                value_t self_loop_prob = 0_vt;
+
+                for (const auto& [succ_id, prob] : successor_dist) {
+                    if (succ_id == state_id) self_loop_prob += prob;
+                }
+
+                if (successor_dist.size() == 1 && self_loop_prob != 0_vt) {
+                    continue;
+                }
+
+                const value_t normalization =
+                    self_loop_prob != 0_vt ? 1_vt / (1_vt - self_loop_prob)
+                                           : 1_vt;
+
+                for (const auto& [succ_id, prob] : successor_dist) {
+                    if (succ_id == state_id) continue;
+                    successors_.push_back(lookup(succ_id));
+                    probabilities_.push_back(prob * normalization);
+                }
+
+                actions_.push_back(action);
+                transition_costs_.push_back(
+                    mdp.get_action_cost(action) * normalization);
+                successor_begin_.push_back(successors_.size());
+            }
+
+            transitions.clear();
+        }
+
+        transition_begin_.push_back(actions_.size());
+    }
+
+    assert(transition_begin_.size() == state_ids_.size() + 1);
+    assert(successor_begin_.size() == actions_.size() + 1);
+}
+
+} // namespace probfd
+
+#endif // PROBFD_FLAT_EXPLICIT_MDP_H
@@ -37,7 +37,8 @@ public:
         int max_states,
         int max_transitions,
         double max_time,
-        bool use_general_costs);
+        bool use_general_costs,
+        int num_threads);
 
 protected:
     value_t evaluate(const State& ancestor_state) const override;
@@ -2,10 +2,12 @@
 #define PROBFD_HEURISTICS_PROBABILITY_AWARE_PDB_HEURISTIC_H
 
 #include "probfd/pdbs/types.h"
+#include "probfd/pdbs/value_table.h"
 
 #include "probfd/heuristics/task_dependent_heuristic.h"
 
 #include <memory>
+#include <span>
 #include <vector>
 
 // Forward Declarations
@@ -15,6 +17,8 @@ class LogProxy;
 
 namespace probfd::pdbs {
 class PatternCollectionGenerator;
+class PDBCache;
+class PDBCollectionEvaluator;
 class SubCollectionFinder;
 } // namespace probfd::pdbs
 
@@ -33,6 +37,7 @@ class ProbabilityAwarePDBHeuristic : public TaskDependentHeuristic {
     std::shared_ptr<pdbs::PPDBCollection> pdbs_;
     std::shared_ptr<std::vector<pdbs::PatternSubCollection>> subcollections_;
     std::shared_ptr<pdbs::SubCollectionFinder> subcollection_finder_;
+    std::unique_ptr<pdbs::PDBCollectionEvaluator> collection_evaluator_;
 
 public:
     ProbabilityAwarePDBHeuristic(
@@ -40,9 +45,18 @@ public:
         std::shared_ptr<FDRCostFunction> task_cost_function,
         std::shared_ptr<pdbs::PatternCollectionGenerator> generator,
         double max_time_dominance_pruning,
+        unsigned num_threads,
+        std::shared_ptr<pdbs::PDBCache> cache,
+        pdbs::ValueTableEncoding value_encoding,
         utils::LogProxy log);
 
+    ~ProbabilityAwarePDBHeuristic() override;
+
     value_t evaluate(const State& state) const override;
+
+    void evaluate_batch(
+        std::span<const State* const> states,
+        std::span<value_t> values) const override;
 };
 
 } // namespace probfd::heuristics
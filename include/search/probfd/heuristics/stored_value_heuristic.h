@@ -0,0 +1,99 @@
+#ifndef PROBFD_HEURISTICS_STORED_VALUE_HEURISTIC_H
+#define PROBFD_HEURISTICS_STORED_VALUE_HEURISTIC_H
+
+#include "probfd/evaluator.h"
+#include "probfd/fdr_types.h"
+#include "probfd/value_type.h"
+
+#include "downward/algorithms/int_packer.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Forward Declarations
+class State;
+
+namespace utils {
+class LogProxy;
+}
+
+namespace probfd {
+class ProbabilisticTask;
+}
+
+namespace probfd::storage {
+class ValueFile;
+}
+
+namespace probfd::heuristics {
+
+/**
+ * @brief Seeds the search with the state values stored in a value file by a
+ * previous solver run.
+ *
+ * For states contained in the value file, the maximum of the stored lower
+ * value bound and the estimate of an underlying heuristic is returned. All
+ * other states are evaluated by the underlying heuristic.
+ *
+ * @note The stored values are admissible if the value file was written for a
+ * task with the same transitions and costs, which is checked with a task
+ * fingerprint when the heuristic is created. If the underlying heuristic is
+ * admissible, this heuristic is admissible as well.
+ */
+class StoredValueHeuristic : public FDREvaluator {
+    using Bin = int_packer::IntPacker::Bin;
+
+    const std::shared_ptr<storage::ValueFile> value_file_;
+    const std::unique_ptr<FDREvaluator> heuristic_;
+    const int_packer::IntPacker& state_packer_;
+
+    mutable std::vector<Bin> packed_buffer_;
+
+    mutable unsigned long long num_lookups_ = 0;
+    mutable unsigned long long num_stored_values_ = 0;
+
+public:
+    /**
+     * @brief Constructs the heuristic from the stored values, the underlying
+     * heuristic and the state packer of the task.
+     */
+    StoredValueHeuristic(
+        std::shared_ptr<storage::ValueFile> value_file,
+        std::unique_ptr<FDREvaluator> heuristic,
+        const int_packer::IntPacker& state_packer);
+
+    ~StoredValueHeuristic() override;
+
+    [[nodiscard]]
+    value_t evaluate(const State& state) const override;
+
+    void evaluate_batch(
+        std::span<const State* const> states,
+        std::span<value_t> values) const override;
+
+    void print_statistics() const override;
+
+private:
+    value_t combine(const State& state, value_t estimate) const;
+};
+
+/**
+ * @brief Checks whether the values stored in a value file can be used for the
+ * given task and cost function.
+ *
+ * The stored values cannot be used if the value file was written for a task
+ * with different variables. If it was written for a task with different
+ * transitions or costs, as detected by the task fingerprint, they can only be
+ * used if \p require_same_task is false. In both cases, a warning is logged.
+ */
+bool can_use_stored_values(
+    const storage::ValueFile& value_file,
+    const ProbabilisticTask& task,
+    FDRCostFunction& cost_function,
+    bool require_same_task,
+    utils::LogProxy& log);
+
+} // namespace probfd::heuristics
+
+#endif // PROBFD_HEURISTICS_STORED_VALUE_HEURISTIC_H
@@ -0,0 +1,132 @@
+#ifndef PROBFD_OPERATOR_TABLE_H
+#define PROBFD_OPERATOR_TABLE_H
+
+#include "downward/abstract_task.h"
+
+#include "probfd/value_type.h"
+
+#include <cassert>
+#include <cstdint>
+#include <span>
+
+namespace probfd {
+
+/**
+ * @brief A read-only view of the probabilistic operators of a task, stored in
+ * contiguous arrays.
+ *
+ * Nested lists are stored in compressed sparse row form, i.e., as an array of
+ * all elements and an array of offsets, where the elements of list i are
+ * found in the range [offsets[i], offsets[i + 1]). The outcomes of all
+ * operators are numbered consecutively, and so are the effects of all
+ * outcomes. The number of an outcome is its ID in the all-outcomes
+ * determinization.
+ *
+ * Tasks storing their operators in this form expose the table with
+ * ProbabilisticTask::get_operator_table(), which lets the task proxies bypass
+ * the virtual task interface.
+ */
+struct OperatorTable {
+    std::span<const value_t> costs;
+
+    std::span<const std::int32_t> precondition_offsets;
+    std::span<const FactPair> preconditions;
+
+    std::span<const std::int32_t> outcome_offsets;
+    std::span<const value_t> outcome_probabilities;
+
+    std::span<const std::int32_t> effect_offsets;
+    std::span<const FactPair> effects;
+
+    std::span<const std::int32_t> condition_offsets;
+    std::span<const FactPair> conditions;
+
+    [[nodiscard]]
+    int get_num_operators() const
+    {
+        return static_cast<int>(costs.size());
+    }
+
+    [[nodiscard]]
+    int get_num_preconditions(int op_index) const
+    {
+        return precondition_offsets[op_index + 1] -
+               precondition_offsets[op_index];
+    }
+
+    [[nodiscard]]
+    FactPair get_precondition(int op_index, int fact_index) const
+    {
+        assert(fact_index < get_num_preconditions(op_index));
+        return preconditions[precondition_offsets[op_index] + fact_index];
+    }
+
+    [[nodiscard]]
+    int get_num_outcomes(int op_index) const
+    {
+        return outcome_offsets[op_index + 1] - outcome_offsets[op_index];
+    }
+
+    /// Returns the number of the outcome among all outcomes.
+    [[nodiscard]]
+    int get_outcome_id(int op_index, int outcome_index) const
+    {
+        assert(outcome_index < get_num_outcomes(op_index));
+        return outcome_offsets[op_index] + outcome_index;
+    }
+
+    [[nodiscard]]
+    value_t get_outcome_probability(int op_index, int outcome_index) const
+    {
+        return outcome_probabilities[get_outcome_id(op_index, outcome_index)];
+    }
+
+    [[nodiscard]]
+    int get_num_effects(int op_index, int outcome_index) const
+    {
+        const int outcome = get_outcome_id(op_index, outcome_index);
+        return effect_offsets[outcome + 1] - effect_offsets[outcome];
+    }
+
+    /// Returns the number of the effect among all effects.
+    [[nodiscard]]
+    int get_effect_id(int op_index, int outcome_index, int eff_index) const
+    {
+        assert(eff_index < get_num_effects(op_index, outcome_index));
+        const int outcome = get_outcome_id(op_index, outcome_index);
+        return effect_offsets[outcome] + eff_index;
+    }
+
+    [[nodiscard]]
+    FactPair get_effect(int op_index, int outcome_index, int eff_index) const
+    {
+        return effects[get_effect_id(op_index, outcome_index, eff_index)];
+    }
+
+    [[nodiscard]]
+    int get_num_effect_conditions(
+        int op_index,
+        int outcome_index,
+        int eff_index) const
+    {
+        const int effect = get_effect_id(op_index, outcome_index, eff_index);
+        return condition_offsets[effect + 1] - condition_offsets[effect];
+    }
+
+    [[nodiscard]]
+    FactPair get_effect_condition(
+        int op_index,
+        int outcome_index,
+        int eff_index,
+        int cond_index) const
+    {
+        const int effect = get_effect_id(op_index, outcome_index, eff_index);
+        assert(cond_index < condition_offsets[effect + 1] -
+                                condition_offsets[effect]);
+        return conditions[condition_offsets[effect] + cond_index];
+    }
+};
+
+} // namespace probfd
+
+#endif // PROBFD_OPERATOR_TABLE_H
@@ -2,6 +2,7 @@
 #define PROBFD_PDBS_EVALUATORS_H
 
 #include "probfd/pdbs/types.h"
+#include "probfd/pdbs/value_table.h"
 
 #include "probfd/evaluator.h"
 #include "probfd/value_type.h"
@@ -42,7 +43,7 @@ public:
 };
 
 class IncrementalPPDBEvaluator : public StateRankEvaluator {
-    const std::vector<value_t>& value_table_;
+    const ValueTable& value_table_;
 
     int left_multiplier_;
     int right_multiplier_;
@@ -50,7 +51,7 @@ class IncrementalPPDBEvaluator : public StateRankEvaluator {
 
 public:
     explicit IncrementalPPDBEvaluator(
-        const std::vector<value_t>& value_table,
+        const ValueTable& value_table,
         const StateRankingFunction& mapper,
         int add_var);
 
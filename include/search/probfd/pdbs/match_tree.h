@@ -4,9 +4,10 @@
 #include "probfd/pdbs/types.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <iosfwd>
+#include <limits>
 #include <memory>
-#include <stack>
 #include <vector>
 
 // Forward Declarations
@@ -27,13 +28,43 @@ namespace probfd::pdbs {
 
 /**
  * @brief Applicable actions generator for projections.
+ *
+ * The operators are first inserted into a pointer-linked tree. Afterwards,
+ * finalize() lays out the tree in breadth-first order in a few contiguous
+ * arrays, which are the only data structures used for lookups. The operators
+ * of each node are stored contiguously, so a node refers to its operators by
+ * an index range. Lookups do not allocate memory and do not modify the match
+ * tree, so they may be performed concurrently.
  */
 class MatchTree {
     struct Node;
 
+    using NodeID = std::uint32_t;
+
+    static constexpr NodeID NO_NODE = std::numeric_limits<NodeID>::max();
+
+    struct FlatNode {
+        // The variable tested by the node, its ranking coefficient and its
+        // domain size. The domain size is zero for leaf nodes.
+        int var_id = -1;
+        int var_multiplier = 0;
+        int var_domain_size = 0;
+
+        // The successor of value v is stored at edges_[first_edge + v].
+        std::uint32_t first_edge = 0;
+        NodeID star_successor = NO_NODE;
+
+        // The range of the applicable operators in projection_operators_.
+        std::uint32_t operators_begin = 0;
+        std::uint32_t operators_end = 0;
+    };
+
+    // Construction-time tree, released by finalize().
     std::unique_ptr<Node> root_;
+
+    std::vector<FlatNode> nodes_;
+    std::vector<NodeID> edges_;
     std::vector<ProjectionOperator> projection_operators_;
-    mutable std::stack<Node*> nodes_; // reuse storage
 
 public:
     explicit MatchTree(size_t hint_num_operators = 0);
@@ -43,6 +74,8 @@ public:
     /**
      * @brief Insert a new projection operator with the given preconditions
      * into the match tree.
+     *
+     * Must not be called after finalize().
      */
     void insert(
         const AssignmentEnumerator& ranking_function,
@@ -50,6 +83,12 @@ public:
         const std::vector<FactPair>& progression_preconditions,
         bool operator_pruning);
 
+    /**
+     * @brief Lays out the match tree for lookups. Must be called once after
+     * the last insertion and before the first lookup.
+     */
+    void finalize();
+
     /**
      * @brief Obtain the applicable prohjection operators for a given abstract
      * state.
@@ -73,7 +112,13 @@ public:
     void dump(std::ostream& out) const;
 
 private:
-    void dump_recursive(std::ostream& out, Node* node) const;
+    // Calls f for every applicable operator, in depth-first order of the
+    // nodes, following the value edge of a node before its star edge.
+    template <typename F>
+    void for_each_applicable(NodeID node_id, StateRank abstract_state, F& f)
+        const;
+
+    void dump_recursive(std::ostream& out, NodeID node_id) const;
 };
 
 } // namespace probfd::pdbs
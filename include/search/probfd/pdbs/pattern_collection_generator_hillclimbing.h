@@ -3,6 +3,7 @@
 
 #include "probfd/pdbs/pattern_collection_generator.h"
 #include "probfd/pdbs/types.h"
+#include "probfd/pdbs/value_table.h"
 
 #include "probfd/fdr_types.h"
 #include "probfd/value_type.h"
@@ -36,8 +37,9 @@ class RandomWalkSampler;
 }
 
 namespace probfd::pdbs {
+class PDBCache;
 class SubCollectionFinderFactory;
-}
+} // namespace probfd::pdbs
 
 namespace probfd::pdbs {
 
@@ -52,7 +54,8 @@ class PatternCollectionGeneratorHillclimbing
     std::shared_ptr<PatternCollectionGenerator> initial_generator_;
     std::shared_ptr<SubCollectionFinderFactory> subcollection_finder_factory_;
 
-    // maximum number of states for each pdb
+    // maximum number of states for each pdb, scaled by the compression ratio
+    // of the value encoding
     const int pdb_max_size_;
     // maximum added size of all pdbs
     const int collection_max_size_;
@@ -60,6 +63,13 @@ class PatternCollectionGeneratorHillclimbing
     // minimal improvement required for hill climbing to continue search
     const int min_improvement_;
     const double max_time_;
+    // number of threads used to compute and score independent candidate PDBs
+    // concurrently
+    const unsigned num_threads_;
+    // storage format of the lookup tables of the PDBs
+    const ValueTableEncoding value_encoding_;
+    // optional on-disk cache for the lookup tables of the PDBs
+    std::shared_ptr<PDBCache> cache_;
     std::shared_ptr<utils::RandomNumberGenerator> rng_;
 
     // maximum size of the PDB search space
@@ -73,7 +83,9 @@ class PatternCollectionGeneratorHillclimbing
       relevant variable are considered as candidate patterns. If the candidate
       pattern has not been previously considered (not contained in
       generated_patterns) and if building a PDB for it does not surpass the
-      size limit, then the PDB is built and added to candidate_pdbs.
+      size limit, then the PDB is built and added to candidate_pdbs. The PDBs
+      of all new candidate patterns are built concurrently if multiple threads
+      are used.
 
       The method returns the size of the largest PDB added to candidate_pdbs.
     */
@@ -107,7 +119,8 @@ class PatternCollectionGeneratorHillclimbing
     /*
       Searches for the best improving pdb in candidate_pdbs according to the
       counting approximation and the given samples. Returns the improvement and
-      the index of the best pdb in candidate_pdbs.
+      the index of the best pdb in candidate_pdbs. Ties are broken in favour of
+      the smallest index, also if the candidates are scored concurrently.
     */
     std::pair<int, int> find_best_improving_pdb(
         utils::CountdownTimer& hill_climbing_timer,
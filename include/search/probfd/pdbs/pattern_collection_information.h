@@ -12,6 +12,11 @@
 
 namespace pdbs {
 class PatternCollectionInformation;
+class PatternDatabase;
+} // namespace pdbs
+
+namespace probfd::pdbs {
+class PDBCache;
 }
 
 namespace probfd::pdbs {
@@ -34,11 +39,15 @@ class PatternCollectionInformation {
 
     std::shared_ptr<PatternCollection> patterns_;
     std::shared_ptr<PPDBCollection> pdbs_;
+
+    // Classical PDBs used as heuristics when computing missing PDBs.
+    std::shared_ptr<std::vector<std::shared_ptr<::pdbs::PatternDatabase>>>
+        classical_pdbs_;
     std::shared_ptr<std::vector<PatternSubCollection>> subcollections_;
 
     std::shared_ptr<SubCollectionFinder> subcollection_finder_;
 
-    void create_pdbs_if_missing();
+    void create_pdbs_if_missing(unsigned num_threads, const PDBCache* cache);
     void create_pattern_cliques_if_missing();
 
     [[nodiscard]]
@@ -69,7 +78,18 @@ public:
 
     [[nodiscard]]
     std::shared_ptr<PatternCollection> get_patterns() const;
-    std::shared_ptr<PPDBCollection> get_pdbs();
+
+    /**
+     * @brief Returns the PDBs of the pattern collection, computing them first
+     * if they are missing.
+     *
+     * Missing PDBs of independent patterns are computed concurrently if
+     * \p num_threads is larger than one. If a PDB cache is given, the lookup
+     * tables of missing PDBs are loaded from the cache if present, and added to
+     * the cache otherwise.
+     */
+    std::shared_ptr<PPDBCollection>
+    get_pdbs(unsigned num_threads = 1, const PDBCache* cache = nullptr);
     std::shared_ptr<std::vector<PatternSubCollection>> get_subcollections();
     std::shared_ptr<SubCollectionFinder> get_subcollection_finder();
 };
@@ -0,0 +1,121 @@
+#ifndef PROBFD_PDBS_PDB_CACHE_H
+#define PROBFD_PDBS_PDB_CACHE_H
+
+#include "probfd/pdbs/types.h"
+#include "probfd/pdbs/value_table.h"
+
+#include "probfd/fdr_types.h"
+#include "probfd/value_type.h"
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+
+// Forward Declarations
+class State;
+
+namespace probfd {
+class ProbabilisticTaskProxy;
+}
+
+namespace probfd::pdbs {
+class ProbabilityAwarePatternDatabase;
+class StateRankingFunction;
+} // namespace probfd::pdbs
+
+namespace probfd::pdbs {
+
+/**
+ * @brief An on-disk cache for the lookup tables of probability-aware pattern
+ * databases.
+ *
+ * Each lookup table is stored in its own file in the cache directory. The file
+ * is identified by a 128-bit hash of a canonical description of the projected
+ * task, i.e., the domain sizes of the pattern variables, the set of distinct
+ * projections of the operators affecting the pattern (preconditions, outcome
+ * probabilities, effects and action costs), the projected goal, the non-goal
+ * termination cost and the abstract initial state. Variables are identified by
+ * their position in the pattern, and the description does not depend on the
+ * order of the operators, outcomes, conditions or goal facts. Equal projections
+ * of different tasks therefore share a cache entry, regardless of the indices
+ * of the pattern variables in the respective tasks.
+ *
+ * Cache files consist of a small versioned header followed by the raw value
+ * array. The key is wide enough that a cache hit is decided by the key alone.
+ *
+ * On POSIX systems, cached tables are memory-mapped read-only and used without
+ * copying, so the operating system can share them between processes and evict
+ * them under memory pressure.
+ *
+ * @note Writing cache files is safe if multiple threads or processes use the
+ * same cache directory concurrently, since every file is written under a
+ * temporary name first and then renamed atomically.
+ */
+class PDBCache {
+    std::filesystem::path directory_;
+
+public:
+    /// The 128-bit key of a cached lookup table.
+    struct Key {
+        std::uint64_t high;
+        std::uint64_t low;
+
+        friend auto operator<=>(const Key&, const Key&) = default;
+    };
+
+    /// Creates a cache in the given directory, creating it if necessary.
+    explicit PDBCache(std::filesystem::path directory);
+
+    /**
+     * @brief Computes the cache key of the projection specified by the ranking
+     * function and the abstract initial state.
+     */
+    static Key compute_key(
+        ProbabilisticTaskProxy task_proxy,
+        FDRSimpleCostFunction& task_cost_function,
+        const StateRankingFunction& ranking_function,
+        StateRank initial_state);
+
+    /**
+     * @brief Loads the lookup table with the given key.
+     *
+     * Returns std::nullopt if the table is not cached, or if the cache file is
+     * corrupted or was written with an incompatible format.
+     */
+    [[nodiscard]]
+    std::optional<ValueTable> load(const Key& key, std::size_t num_states) const;
+
+    /**
+     * @brief Stores the lookup table with the given key.
+     *
+     * Failures to write the cache file are reported, but are not fatal.
+     */
+    void store(const Key& key, std::span<const value_t> values) const;
+
+    /**
+     * @brief Returns the PDB for the given pattern, loading its lookup table
+     * from the cache if present. Otherwise, the PDB is computed by
+     * \p compute_pdb and its lookup table is added to the cache.
+     */
+    std::unique_ptr<ProbabilityAwarePatternDatabase> get_or_compute(
+        ProbabilisticTaskProxy task_proxy,
+        FDRSimpleCostFunction& task_cost_function,
+        const Pattern& pattern,
+        const State& initial_state,
+        const std::function<
+            std::unique_ptr<ProbabilityAwarePatternDatabase>()>& compute_pdb)
+        const;
+
+private:
+    [[nodiscard]]
+    std::filesystem::path get_file_path(const Key& key) const;
+};
+
+} // namespace probfd::pdbs
+
+#endif // PROBFD_PDBS_PDB_CACHE_H
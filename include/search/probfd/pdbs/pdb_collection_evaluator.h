@@ -0,0 +1,88 @@
+#ifndef PROBFD_PDBS_PDB_COLLECTION_EVALUATOR_H
+#define PROBFD_PDBS_PDB_COLLECTION_EVALUATOR_H
+
+#include "probfd/pdbs/types.h"
+
+#include "probfd/value_type.h"
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+// Forward Declarations
+class State;
+
+namespace probfd::pdbs {
+class SubCollectionFinder;
+}
+
+namespace probfd::pdbs {
+
+/**
+ * @brief Evaluates the combined heuristic of a collection of
+ * probability-aware PDBs.
+ *
+ * The result is the same as for SubCollectionFinder::evaluate. However, the
+ * patterns and ranking coefficients of all PDBs are stored in two contiguous
+ * arrays, so the values of the pattern variables are read from a state only
+ * once, without unpacking it, and the abstract ranks of all PDBs are computed
+ * from them in a single pass.
+ *
+ * Batches of states are ranked PDB by PDB, with the states in the innermost
+ * loop, so that the ranking coefficients are only loaded once per batch.
+ *
+ * The PDB collection and subcollections must not be changed after
+ * construction. The evaluation reuses internal buffers, so an evaluator must
+ * not be used by multiple threads at the same time.
+ */
+class PDBCollectionEvaluator {
+    std::shared_ptr<PPDBCollection> pdbs_;
+    std::shared_ptr<std::vector<PatternSubCollection>> subcollections_;
+    std::shared_ptr<SubCollectionFinder> subcollection_finder_;
+    value_t termination_cost_;
+
+    // The variables occurring in some pattern, in ascending order.
+    std::vector<int> used_variables_;
+
+    // The pattern variables, as indices into used_variables_, and ranking
+    // coefficients of all PDBs. The ones of the i-th PDB are in the range
+    // [offsets_[i], offsets_[i + 1]).
+    std::vector<std::size_t> variable_indices_;
+    std::vector<int> multipliers_;
+    std::vector<std::size_t> offsets_;
+
+    // Scratch buffers reused between calls.
+    mutable std::vector<int> state_values_;
+    mutable std::vector<StateRank> ranks_;
+    mutable std::vector<value_t> batch_estimates_;
+    mutable std::vector<value_t> pdb_estimates_;
+    mutable std::vector<bool> terminal_;
+
+public:
+    PDBCollectionEvaluator(
+        std::shared_ptr<PPDBCollection> pdbs,
+        std::shared_ptr<std::vector<PatternSubCollection>> subcollections,
+        std::shared_ptr<SubCollectionFinder> subcollection_finder,
+        value_t termination_cost);
+
+    /// Evaluates the heuristic on a state.
+    [[nodiscard]]
+    value_t evaluate(const State& state) const;
+
+    /**
+     * @brief Evaluates the heuristic on a batch of states and stores the
+     * heuristic value of the state pointed to by \p states[i] at position i
+     * of \p values.
+     */
+    void evaluate(
+        std::span<const State* const> states,
+        std::span<value_t> values) const;
+
+private:
+    value_t evaluate_estimates(const std::vector<value_t>& estimates) const;
+};
+
+} // namespace probfd::pdbs
+
+#endif // PROBFD_PDBS_PDB_COLLECTION_EVALUATOR_H
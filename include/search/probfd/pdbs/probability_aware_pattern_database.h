@@ -4,11 +4,13 @@
 #include "probfd/pdbs/evaluators.h"
 #include "probfd/pdbs/state_ranking_function.h"
 #include "probfd/pdbs/types.h"
+#include "probfd/pdbs/value_table.h"
 
 #include "probfd/heuristics/constant_evaluator.h"
 
 #include "probfd/fdr_types.h"
 
+#include <cstddef>
 #include <limits>
 #include <vector>
 
@@ -36,7 +38,7 @@ namespace probfd::pdbs {
  */
 class ProbabilityAwarePatternDatabase {
     StateRankingFunction ranking_function_;
-    std::vector<value_t> value_table_;
+    ValueTable value_table_;
 
     ProbabilityAwarePatternDatabase(
         ProbabilisticTaskProxy task_proxy,
@@ -50,6 +52,15 @@ public:
         StateRankingFunction ranking_function,
         std::vector<value_t> value_table);
 
+    /**
+     * @brief Construct a probability-aware pattern database from a ranking
+     * function and a precomputed lookup table, e.g. a table loaded from a PDB
+     * cache.
+     */
+    ProbabilityAwarePatternDatabase(
+        StateRankingFunction ranking_function,
+        ValueTable value_table);
+
     /**
      * @brief Construct a probability-aware pattern database for a given task
      * and pattern.
@@ -277,9 +288,22 @@ public:
     [[nodiscard]]
     const StateRankingFunction& get_state_ranking_function() const;
 
-    /// Get the abstraction mapping of the pattern database.
+    /// Get the lookup table of the pattern database.
     [[nodiscard]]
-    const std::vector<value_t>& get_value_table() const;
+    const ValueTable& get_value_table() const;
+
+    /// Get the number of bytes used by the lookup table.
+    [[nodiscard]]
+    std::size_t get_memory_usage() const;
+
+    /**
+     * @brief Re-encodes the lookup table with the given encoding. Has no
+     * effect if the lookup table is already compressed.
+     *
+     * Lossy encodings round values down, so the PDB remains admissible, but
+     * may become less informative.
+     */
+    void compress(ValueTableEncoding encoding);
 
     /// Get the number of states in this PDB's projection.
     [[nodiscard]]
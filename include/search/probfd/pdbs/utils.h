@@ -3,7 +3,10 @@
 
 #include "probfd/pdbs/types.h"
 
+#include <cstddef>
+#include <functional>
 #include <iosfwd>
+#include <memory>
 #include <vector>
 
 namespace utils {
@@ -27,6 +30,24 @@ std::vector<int> get_goals_in_random_order(
     ProbabilisticTaskProxy task_proxy,
     utils::RandomNumberGenerator& rng);
 
+/**
+ * @brief Computes \p num_pdbs pattern databases by calling \p compute_pdb for
+ * every index in [0, num_pdbs) and appends them to \p pdbs in index order.
+ *
+ * If \p num_threads is larger than one, the PDBs are computed concurrently by
+ * a pool of worker threads, so \p compute_pdb must be safe to call from
+ * multiple threads. Time limits should be enforced by \p compute_pdb, e.g.
+ * with a CountdownTimer shared by all calls. If a call throws, no further PDBs
+ * are computed, nothing is appended to \p pdbs, and the exception is
+ * rethrown.
+ */
+void compute_pdbs(
+    PPDBCollection& pdbs,
+    std::size_t num_pdbs,
+    unsigned num_threads,
+    const std::function<std::unique_ptr<ProbabilityAwarePatternDatabase>(
+        std::size_t)>& compute_pdb);
+
 /**
  * @brief Dump the PDB's projection as a dot graph to a specified path with
  * or without transition labels shown.
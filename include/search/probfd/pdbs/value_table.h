@@ -0,0 +1,244 @@
+#ifndef PROBFD_PDBS_VALUE_TABLE_H
+#define PROBFD_PDBS_VALUE_TABLE_H
+
+#include "probfd/value_type.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace probfd::pdbs {
+
+/**
+ * @brief Specifies how the values of a value table are stored.
+ *
+ * DOUBLE is exact. DICTIONARY is exact as well, unless it falls back to
+ * QUANTIZED16. FLOAT and QUANTIZED16 are lossy and always round values down,
+ * so that the decoded values remain admissible. Infinite values are
+ * represented exactly by all encodings.
+ */
+enum class ValueTableEncoding {
+    /// Stores each value as a value_t.
+    DOUBLE,
+    /// Stores each value as a 32-bit float, rounded down.
+    FLOAT,
+    /// Stores each value as a 16-bit fixed-point offset from the smallest
+    /// finite value, rounded down.
+    QUANTIZED16,
+    /// Stores the distinct values in a dictionary and each value as an 8-bit
+    /// or 16-bit dictionary index. Falls back to QUANTIZED16 if there are more
+    /// than 2^16 distinct values.
+    DICTIONARY
+};
+
+/**
+ * @brief Returns an upper bound on the number of bytes used per value by the
+ * given encoding, excluding the dictionary of the DICTIONARY encoding.
+ */
+constexpr std::size_t get_max_bytes_per_value(ValueTableEncoding encoding)
+{
+    switch (encoding) {
+    case ValueTableEncoding::DOUBLE: return sizeof(value_t);
+    case ValueTableEncoding::FLOAT: return sizeof(float);
+    case ValueTableEncoding::QUANTIZED16:
+    case ValueTableEncoding::DICTIONARY: return sizeof(std::uint16_t);
+    }
+
+    return sizeof(value_t);
+}
+
+/**
+ * @brief The lookup table of a probability-aware pattern database.
+ *
+ * A table stores its values uncompressed until it is encoded with encode().
+ * Uncompressed tables either own their values, or provide a read-only view of
+ * values that are stored elsewhere, e.g. in a memory-mapped PDB cache file. In
+ * the latter case, the table shares ownership of the underlying storage,
+ * which is released once the last table referring to it is destroyed.
+ *
+ * Values of states that were not assigned a value (NaN), i.e. states that are
+ * unreachable from the initial state of the projection, are not preserved by
+ * the QUANTIZED16 and DICTIONARY encodings.
+ */
+class ValueTable {
+    enum class Format {
+        DOUBLE,
+        FLOAT,
+        QUANTIZED16,
+        DICTIONARY8,
+        DICTIONARY16
+    };
+
+    static constexpr std::uint16_t INFINITE_CODE = 0xFFFF;
+
+    Format format_ = Format::DOUBLE;
+    std::size_t size_ = 0;
+
+    // Uncompressed values, either owned or a view.
+    std::vector<value_t> owned_values_;
+    std::shared_ptr<const void> storage_;
+    const value_t* data_ = nullptr;
+
+    // Compressed values.
+    std::vector<float> float_values_;
+    std::vector<std::uint8_t> codes8_;
+    std::vector<std::uint16_t> codes16_;
+    std::vector<value_t> dictionary_;
+    value_t offset_ = 0_vt;
+    value_t step_ = 0_vt;
+
+public:
+    ValueTable() = default;
+
+    /// Constructs an owning table of size \p size filled with \p value.
+    ValueTable(std::size_t size, value_t value)
+        : size_(size)
+        , owned_values_(size, value)
+        , data_(owned_values_.data())
+    {
+    }
+
+    /// Constructs an owning table from the given values.
+    explicit ValueTable(std::vector<value_t> values)
+        : size_(values.size())
+        , owned_values_(std::move(values))
+        , data_(owned_values_.data())
+    {
+    }
+
+    /**
+     * @brief Constructs a read-only view of \p size values starting at
+     * \p data, which are kept alive by \p storage.
+     */
+    ValueTable(
+        std::shared_ptr<const void> storage,
+        const value_t* data,
+        std::size_t size)
+        : size_(size)
+        , storage_(std::move(storage))
+        , data_(data)
+    {
+    }
+
+    ValueTable(const ValueTable& other)
+        : format_(other.format_)
+        , size_(other.size_)
+        , owned_values_(other.owned_values_)
+        , storage_(other.storage_)
+        , data_(storage_ ? other.data_ : owned_values_.data())
+        , float_values_(other.float_values_)
+        , codes8_(other.codes8_)
+        , codes16_(other.codes16_)
+        , dictionary_(other.dictionary_)
+        , offset_(other.offset_)
+        , step_(other.step_)
+    {
+    }
+
+    ValueTable(ValueTable&& other) noexcept { swap(other); }
+
+    ValueTable& operator=(ValueTable other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    void swap(ValueTable& other) noexcept
+    {
+        std::swap(format_, other.format_);
+        std::swap(size_, other.size_);
+        owned_values_.swap(other.owned_values_);
+        storage_.swap(other.storage_);
+        std::swap(data_, other.data_);
+        float_values_.swap(other.float_values_);
+        codes8_.swap(other.codes8_);
+        codes16_.swap(other.codes16_);
+        dictionary_.swap(other.dictionary_);
+        std::swap(offset_, other.offset_);
+        std::swap(step_, other.step_);
+    }
+
+    /// Checks whether the table is a view of externally stored values.
+    [[nodiscard]]
+    bool is_view() const
+    {
+        return storage_ != nullptr;
+    }
+
+    /// Checks whether the values are stored uncompressed.
+    [[nodiscard]]
+    bool is_uncompressed() const
+    {
+        return format_ == Format::DOUBLE;
+    }
+
+    [[nodiscard]]
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+    /// Returns the number of bytes used to store the values.
+    [[nodiscard]]
+    std::size_t get_memory_usage() const;
+
+    value_t operator[](std::size_t i) const
+    {
+        assert(i < size_);
+
+        switch (format_) {
+        case Format::DOUBLE: return data_[i];
+        case Format::FLOAT: return static_cast<value_t>(float_values_[i]);
+        case Format::QUANTIZED16: return decode_quantized(codes16_[i]);
+        case Format::DICTIONARY8: return dictionary_[codes8_[i]];
+        case Format::DICTIONARY16: return dictionary_[codes16_[i]];
+        }
+
+        abort();
+    }
+
+    /// Returns the uncompressed values.
+    operator std::span<const value_t>() const
+    {
+        assert(is_uncompressed());
+        return {data_, size_};
+    }
+
+    /**
+     * @brief Returns the values for modification. Only owning, uncompressed
+     * tables can be modified.
+     */
+    std::span<value_t> get_mutable_values()
+    {
+        assert(is_uncompressed() && !is_view());
+        return owned_values_;
+    }
+
+    /**
+     * @brief Re-encodes the values of an uncompressed table with the given
+     * encoding. Has no effect if the table is already compressed.
+     *
+     * Views are converted into owning tables by this operation.
+     */
+    void encode(ValueTableEncoding encoding);
+
+private:
+    [[nodiscard]]
+    value_t decode_quantized(std::uint16_t code) const
+    {
+        return code == INFINITE_CODE ? INFINITE_VALUE : offset_ + code * step_;
+    }
+
+    void encode_float();
+    void encode_quantized();
+    void encode_dictionary();
+};
+
+} // namespace probfd::pdbs
+
+#endif // PROBFD_PDBS_VALUE_TABLE_H
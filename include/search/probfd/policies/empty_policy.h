@@ -17,6 +17,12 @@ public:
         return std::nullopt;
     }
 
+    void for_each_decision(
+        std::function<void(const State&, const PolicyDecision<Action>&)>)
+        const override
+    {
+    }
+
     void print(
         std::ostream&,
         std::function<void(const State&, std::ostream&)>,
@@ -0,0 +1,134 @@
+#ifndef PROBFD_POLICIES_VECTOR_POLICY_H
+#define PROBFD_POLICIES_VECTOR_POLICY_H
+
+#include "probfd/policy.h"
+#include "probfd/state_space.h"
+#include "probfd/types.h"
+
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace probfd::policies {
+
+/**
+ * @brief A policy backed by a dense array indexed by StateID.
+ *
+ * Every state ID is mapped to the index of its decision, or to a sentinel if
+ * the policy does not specify a decision for the state. The decisions
+ * themselves are stored contiguously in insertion order, as separate arrays of
+ * state IDs, actions and Q-value bounds. Only four bytes are needed per state
+ * that is not covered by the policy.
+ *
+ * The bounds array is optional. If the policy is constructed without bounds,
+ * all decisions report the trivial interval [-infinity, infinity] and the
+ * intervals passed to emplace_decision() are discarded.
+ *
+ * Like the remaining policy types, the first decision emplaced for a state is
+ * kept.
+ */
+template <typename State, typename Action>
+class VectorPolicy : public Policy<State, Action> {
+    static constexpr std::uint32_t NO_DECISION = UINT32_MAX;
+
+    StateSpace<State, Action>* state_space_;
+    const bool store_bounds_;
+
+    std::vector<std::uint32_t> decision_indices_;
+    std::vector<StateID> state_ids_;
+    std::vector<Action> actions_;
+    std::vector<Interval> bounds_;
+
+public:
+    explicit VectorPolicy(
+        StateSpace<State, Action>* state_space,
+        std::size_t num_states = 0,
+        bool store_bounds = true)
+        : state_space_(state_space)
+        , store_bounds_(store_bounds)
+        , decision_indices_(num_states, NO_DECISION)
+    {
+    }
+
+    std::optional<PolicyDecision<Action>>
+    get_decision(const State& state) const override
+    {
+        return find_decision(state_space_->get_state_id(state));
+    }
+
+    /// Returns the decision of the given state, or std::nullopt if the policy
+    /// does not specify a decision for it.
+    std::optional<PolicyDecision<Action>>
+    find_decision(StateID state_id) const
+    {
+        if (state_id >= decision_indices_.size()) return std::nullopt;
+        const std::uint32_t index = decision_indices_[state_id];
+        if (index == NO_DECISION) return std::nullopt;
+        return get_decision_at(index);
+    }
+
+    void emplace_decision(StateID state_id, Action action, Interval interval)
+    {
+        if (state_id >= decision_indices_.size()) {
+            decision_indices_.resize(state_id + 1, NO_DECISION);
+        }
+
+        std::uint32_t& index = decision_indices_[state_id];
+
+        if (index == NO_DECISION) {
+            assert(actions_.size() < NO_DECISION);
+            index = static_cast<std::uint32_t>(actions_.size());
+            state_ids_.push_back(state_id);
+            actions_.push_back(std::move(action));
+            if (store_bounds_) bounds_.push_back(interval);
+        }
+    }
+
+    PolicyDecision<Action> operator[](StateID state_id) const
+    {
+        const std::optional decision = find_decision(state_id);
+        assert(decision);
+        return *decision;
+    }
+
+    /// Returns the number of states with a policy decision.
+    std::size_t size() const { return actions_.size(); }
+
+    /// Returns the states with a policy decision in insertion order.
+    const std::vector<StateID>& get_state_ids() const { return state_ids_; }
+
+    void for_each_decision(
+        std::function<void(const State&, const PolicyDecision<Action>&)> f)
+        const override
+    {
+        for (std::size_t i = 0; i != actions_.size(); ++i) {
+            f(state_space_->get_state(state_ids_[i]), get_decision_at(i));
+        }
+    }
+
+    void print(
+        std::ostream& out,
+        std::function<void(const State&, std::ostream&)> state_printer,
+        std::function<void(const Action&, std::ostream&)> action_printer)
+        override
+    {
+        for (std::size_t i = 0; i != actions_.size(); ++i) {
+            state_printer(state_space_->get_state(state_ids_[i]), out);
+            out << " -> ";
+            action_printer(actions_[i], out);
+            out << '\n';
+        }
+    }
+
+private:
+    PolicyDecision<Action> get_decision_at(std::size_t index) const
+    {
+        if (!store_bounds_) return PolicyDecision<Action>{actions_[index]};
+        return PolicyDecision<Action>{actions_[index], bounds_[index]};
+    }
+};
+
+} // namespace probfd::policies
+
+#endif
@@ -39,6 +39,11 @@ public:
         return decisions;
     }
 
+    /// Calls \p f for every state for which the policy specifies a decision.
+    virtual void for_each_decision(
+        std::function<void(const State&, const PolicyDecision<Action>&)> f)
+        const = 0;
+
     virtual void print(
         std::ostream& out,
         std::function<void(const State&, std::ostream&)> state_printer,
@@ -9,6 +9,8 @@
 #include "probfd/mdp.h"
 #include "probfd/type_traits.h"
 
+#include "downward/utils/timer.h"
+
 #include <deque>
 #include <limits>
 #include <memory>
@@ -454,7 +454,7 @@ void EndComponentDecomposition<State, Action>::scc_found(
 {
     auto scc = stack_ | std::views::drop(e.stck);
 
-    if (scc.size()) {
+    if (scc.size() == 1) {
         assert(s.aops.empty());
         const StateID scc_repr_id = s.stateid;
         StateInfo& info = state_infos_[scc_repr_id];
@@ -7,6 +7,8 @@
 
 namespace probfd {
 
+struct OperatorTable;
+
 /**
  * @brief Represents a probabilistic planning task with axioms and conditional
  * effects.
@@ -17,7 +19,24 @@ namespace probfd {
  * @see ProbabilisticTaskProxy
  */
 class ProbabilisticTask : public AbstractTaskBase {
+    const OperatorTable* operator_table_ = nullptr;
+
+protected:
+    /// Exposes the operators of the task in contiguous form to the task
+    /// proxies. The table must be consistent with the virtual interface.
+    /// Only a pointer to the table is stored, so a task owning the table must
+    /// not be copyable or movable.
+    void set_operator_table(const OperatorTable& table);
+
 public:
+    /// Returns the operators of the task in contiguous form, or nullptr if
+    /// they are only accessible through the virtual interface.
+    [[nodiscard]]
+    const OperatorTable* get_operator_table() const
+    {
+        return operator_table_;
+    }
+
     /// Get the cost of the probabilistic operator with index \p op_index.
     virtual value_t get_operator_cost(int op_index) const = 0;
 
@@ -10,6 +10,11 @@
 
 #include "probfd/evaluator.h"
 
+#include <algorithm>
+#include <cassert>
+#include <span>
+#include <vector>
+
 namespace probfd::quotients {
 
 template <typename State, typename Action>
@@ -18,6 +23,11 @@ class QuotientMaxHeuristic : public Evaluator<QuotientState<State, Action>> {
 
     const Evaluator<State>& original_;
 
+    // Scratch buffers for the member states of a batch.
+    mutable std::vector<State> members_;
+    mutable std::vector<const State*> member_ptrs_;
+    mutable std::vector<value_t> member_values_;
+
 public:
     explicit QuotientMaxHeuristic(const Evaluator<State>& original)
         : original_(original)
@@ -30,6 +40,38 @@ public:
             std::bind_front(&Evaluator<State>::evaluate, std::ref(original_)));
     }
 
+    // Evaluates the members of all quotient states as a single batch of the
+    // original heuristic.
+    void evaluate_batch(
+        std::span<const QState* const> states,
+        std::span<value_t> values) const override
+    {
+        assert(states.size() == values.size());
+
+        members_.clear();
+        for (const QState* state : states) {
+            state->for_each_member_state(
+                [this](param_type<State> member) {
+                    members_.push_back(member);
+                });
+        }
+
+        member_ptrs_.clear();
+        for (const State& member : members_) {
+            member_ptrs_.push_back(&member);
+        }
+
+        member_values_.resize(members_.size());
+        original_.evaluate_batch(member_ptrs_, member_values_);
+
+        auto it = member_values_.begin();
+        for (std::size_t i = 0; i != states.size(); ++i) {
+            const auto next = it + states[i]->num_members();
+            values[i] = *std::max_element(it, next);
+            it = next;
+        }
+    }
+
     void print_statistics() const final { original_.print_statistics(); }
 };
 
@@ -3,6 +3,8 @@
 
 #include "probfd/solver_interface.h" // IWYU pragma: export
 
+#include "probfd/solvers/policy_simulator.h"
+
 #include "probfd/fdr_types.h"
 #include "probfd/progress_report.h"
 #include "probfd/task_proxy.h"
@@ -27,6 +29,10 @@ namespace probfd {
 class ProbabilisticTask;
 }
 
+namespace probfd::storage {
+class SpillFileResource;
+}
+
 /// This namespace contains the solver plugins for various search algorithms.
 namespace probfd::solvers {
 
@@ -41,6 +47,9 @@ protected:
 private:
     mutable utils::LogProxy log_;
 
+    // Backs the state storage by a spill file, if enabled.
+    const std::unique_ptr<storage::SpillFileResource> spill_memory_;
+
     const std::unique_ptr<TaskStateSpace> task_mdp_;
     const std::shared_ptr<FDREvaluator> heuristic_;
 
@@ -48,10 +57,14 @@ private:
 
     const double max_time_;
     const std::string policy_filename;
+    const std::string value_filename;
     const bool print_fact_names;
 
     const int trajectories;
     const int trajectory_length;
+    const int trajectory_threads;
+    const TrajectoryOutputFormat trajectory_format;
+    const std::string trajectory_file;
     const std::shared_ptr<utils::RandomNumberGenerator> rng;
 
     bool solution_found_ = true;
@@ -0,0 +1,156 @@
+#ifndef PROBFD_SOLVERS_POLICY_SIMULATOR_H
+#define PROBFD_SOLVERS_POLICY_SIMULATOR_H
+
+#include "probfd/policy.h"
+#include "probfd/task_proxy.h"
+#include "probfd/value_type.h"
+
+#include "downward/operator_id.h"
+#include "downward/state_id.h"
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Forward Declarations
+class State;
+
+namespace probfd {
+class TaskStateSpace;
+}
+
+namespace probfd::solvers {
+
+/**
+ * @brief Specifies how the trajectories sampled by the PolicySimulator are
+ * written.
+ */
+enum class TrajectoryOutputFormat {
+    /// One text file trajectory_<i>.plan per trajectory.
+    SEPARATE_FILES,
+    /// All trajectories in one text file.
+    TEXT,
+    /// All trajectories in one binary file, see PolicySimulator.
+    BINARY,
+    /// Only the statistics are reported.
+    NONE
+};
+
+/**
+ * @brief Empirical estimates obtained by simulating a policy.
+ */
+struct SimulationStatistics {
+    unsigned long long trajectories = 0;
+    unsigned long long goal_trajectories = 0;
+    unsigned long long truncated_trajectories = 0;
+    unsigned long long steps = 0;
+
+    double cost_sum = 0.0;
+    double squared_cost_sum = 0.0;
+
+    /// Returns the average trajectory cost.
+    [[nodiscard]]
+    double get_average_cost() const;
+
+    /// Returns the half-width of the 95% confidence interval of the average
+    /// trajectory cost, based on the normal approximation.
+    [[nodiscard]]
+    double get_cost_confidence_radius() const;
+
+    /// Returns the fraction of trajectories that reached a goal state.
+    [[nodiscard]]
+    double get_goal_probability() const;
+
+    /// Returns the 95% Wilson score interval of the goal probability.
+    [[nodiscard]]
+    std::pair<double, double> get_goal_probability_interval() const;
+
+    void print(std::ostream& out) const;
+};
+
+/**
+ * @brief Monte-Carlo simulation of a policy on the input task.
+ *
+ * On construction, the part of the state space that is reachable from the
+ * initial state by following the policy is extracted once into flat arrays,
+ * i.e. the chosen operator and the cumulative outcome probabilities and
+ * successors of every state. Sampling a trajectory then only walks these
+ * arrays. It neither queries the policy nor touches the state registry, so
+ * trajectories are sampled concurrently on multiple threads.
+ *
+ * Every trajectory uses its own random number generator, which is seeded
+ * from the base seed and the index of the trajectory. The sampled
+ * trajectories therefore do not depend on the number of threads.
+ *
+ * A trajectory ends when it reaches a state without a policy decision, e.g. a
+ * goal state, or after the maximum number of steps, in which case it is
+ * truncated. Trajectories are sampled and written in batches, so the memory
+ * usage does not depend on the number of trajectories.
+ *
+ * The binary trajectory format consists of a header
+ * {char magic[8] = "PTRAJ", uint32 version, uint32 value size,
+ * uint64 number of trajectories}, followed by one record per trajectory. Each
+ * record consists of {uint32 number of steps, uint32 flags (bit 0: goal
+ * reached, bit 1: truncated), value_t cost} and one pair {int32 operator
+ * index, int32 outcome index} per step, starting in the initial state. All
+ * numbers are stored in the native byte order.
+ */
+class PolicySimulator {
+    ProbabilisticTaskProxy task_proxy_;
+    TaskStateSpace& state_space_;
+
+    // Per policy state, indexed by the position in the extraction order.
+    // The initial state comes first.
+    std::vector<::StateID> state_ids_;
+    std::vector<OperatorID> operators_;
+    std::vector<value_t> costs_;
+    std::vector<bool> is_goal_;
+
+    // Outcomes of the chosen operator of state i are found in the range
+    // [outcome_offsets_[i], outcome_offsets_[i + 1]).
+    std::vector<std::size_t> outcome_offsets_;
+    std::vector<value_t> cumulative_probabilities_;
+    std::vector<int> successors_;
+
+public:
+    using StatePrinter = std::function<void(const State&, std::ostream&)>;
+
+    /**
+     * @brief Extracts the part of the state space reachable under
+     * \p policy.
+     */
+    PolicySimulator(
+        ProbabilisticTaskProxy task_proxy,
+        TaskStateSpace& state_space,
+        const Policy<State, OperatorID>& policy);
+
+    /// Returns the number of states reachable under the policy.
+    [[nodiscard]]
+    std::size_t get_num_states() const
+    {
+        return state_ids_.size();
+    }
+
+    /**
+     * @brief Samples \p num_trajectories trajectories of at most
+     * \p max_length steps on \p num_threads threads and writes them in the
+     * given format. Since the policy may cycle without reaching a goal,
+     * \p max_length must be positive.
+     *
+     * The file name is ignored for the formats SEPARATE_FILES and NONE.
+     */
+    SimulationStatistics simulate(
+        int num_trajectories,
+        int max_length,
+        unsigned num_threads,
+        std::uint64_t seed,
+        TrajectoryOutputFormat format,
+        const std::string& filename,
+        const StatePrinter& print_state) const;
+};
+
+} // namespace probfd::solvers
+
+#endif // PROBFD_SOLVERS_POLICY_SIMULATOR_H
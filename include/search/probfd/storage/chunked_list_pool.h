@@ -0,0 +1,214 @@
+#ifndef PROBFD_STORAGE_CHUNKED_LIST_POOL_H
+#define PROBFD_STORAGE_CHUNKED_LIST_POOL_H
+
+#include "downward/algorithms/segmented_vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+namespace probfd::storage {
+
+/**
+ * @brief A pool of many small lists whose first elements are stored inline in
+ * the list handle and whose remaining elements are spilled to linked chunks of
+ * fixed size.
+ *
+ * The handle of a list holds up to INLINE_SIZE elements directly, so short
+ * lists need no chunk at all. With the default parameters and an element type
+ * of eight bytes, a handle takes 24 bytes, the size of an empty std::vector.
+ * Longer lists are extended by chunks that are allocated from one segmented
+ * array, so no heap allocation is performed per list. Chunks that become empty
+ * are recycled.
+ *
+ * Elements that do not fit into the handle are inserted into the first chunk
+ * of a list. A new first chunk is linked in front of it when it is full.
+ * Removing elements compacts the handle and every chunk in place, so the order
+ * of the elements of a list is unspecified.
+ *
+ * Since the chunks never move, lists may be extended while another list is
+ * traversed.
+ *
+ * @tparam T - The element type.
+ * @tparam INLINE_SIZE - The number of elements stored in the list handle.
+ * @tparam CHUNK_SIZE - The number of elements per chunk. By default, a chunk
+ * occupies 64 bytes.
+ */
+template <
+    typename T,
+    std::size_t INLINE_SIZE = 2,
+    std::size_t CHUNK_SIZE = std::max<std::size_t>(
+        1,
+        (64 - 2 * sizeof(std::uint32_t)) / sizeof(T))>
+class ChunkedListPool {
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    using ChunkID = std::uint32_t;
+
+    static constexpr ChunkID NO_CHUNK = std::numeric_limits<ChunkID>::max();
+
+    struct Chunk {
+        std::uint32_t size = 0;
+        ChunkID next = NO_CHUNK;
+        T elements[CHUNK_SIZE];
+    };
+
+public:
+    /// The handle of a list, stored by the owner of the list.
+    class List {
+        friend class ChunkedListPool;
+
+        T inline_elements_[INLINE_SIZE];
+        std::uint32_t num_inline_ = 0;
+        ChunkID chunks_ = NO_CHUNK;
+
+    public:
+        /// Checks whether the list is empty.
+        [[nodiscard]]
+        bool empty() const
+        {
+            return num_inline_ == 0 && chunks_ == NO_CHUNK;
+        }
+    };
+
+private:
+    segmented_vector::SegmentedVector<Chunk> chunks_;
+
+    // The released chunks, linked by their next index.
+    ChunkID free_chunks_ = NO_CHUNK;
+
+public:
+    /// Inserts an element into the list \p list.
+    void add(List& list, const T& element)
+    {
+        if (list.num_inline_ != INLINE_SIZE) {
+            list.inline_elements_[list.num_inline_++] = element;
+            return;
+        }
+
+        ChunkID& first = list.chunks_;
+
+        if (first == NO_CHUNK || chunks_[first].size == CHUNK_SIZE) {
+            const ChunkID chunk_id = allocate_chunk();
+            chunks_[chunk_id].next = first;
+            first = chunk_id;
+        }
+
+        Chunk& chunk = chunks_[first];
+        chunk.elements[chunk.size++] = element;
+    }
+
+    /**
+     * @brief Calls \p f with a span of the inline elements of \p list and
+     * with a span of the elements of every chunk of \p list.
+     *
+     * Empty spans are skipped.
+     */
+    template <typename F>
+    void for_each_chunk(const List& list, F f) const
+    {
+        if (list.num_inline_ != 0) {
+            f(std::span<const T>(list.inline_elements_, list.num_inline_));
+        }
+
+        for (ChunkID id = list.chunks_; id != NO_CHUNK; id = chunks_[id].next) {
+            const Chunk& chunk = chunks_[id];
+            f(std::span<const T>(chunk.elements, chunk.size));
+        }
+    }
+
+    /// Calls \p f for every element of \p list.
+    template <typename F>
+    void for_each(const List& list, F f) const
+    {
+        for_each_chunk(list, [&f](std::span<const T> elements) {
+            for (const T& element : elements) f(element);
+        });
+    }
+
+    /**
+     * @brief Removes all elements of \p list satisfying \p pred.
+     *
+     * The predicate must not modify this pool.
+     */
+    template <typename Predicate>
+    void erase_if(List& list, Predicate pred)
+    {
+        T* inline_end = std::remove_if(
+            list.inline_elements_,
+            list.inline_elements_ + list.num_inline_,
+            pred);
+        list.num_inline_ =
+            static_cast<std::uint32_t>(inline_end - list.inline_elements_);
+
+        ChunkID* link = &list.chunks_;
+
+        while (*link != NO_CHUNK) {
+            const ChunkID chunk_id = *link;
+            Chunk& chunk = chunks_[chunk_id];
+
+            T* end = std::remove_if(
+                chunk.elements,
+                chunk.elements + chunk.size,
+                pred);
+            chunk.size = static_cast<std::uint32_t>(end - chunk.elements);
+
+            if (chunk.size == 0) {
+                *link = chunk.next;
+                release_chunk(chunk_id);
+            } else {
+                link = &chunk.next;
+            }
+        }
+    }
+
+    /// Removes all elements of \p list and recycles its chunks.
+    void clear(List& list)
+    {
+        list.num_inline_ = 0;
+
+        while (list.chunks_ != NO_CHUNK) {
+            const ChunkID chunk_id = list.chunks_;
+            list.chunks_ = chunks_[chunk_id].next;
+            release_chunk(chunk_id);
+        }
+    }
+
+    /// Returns the number of bytes allocated for chunks.
+    [[nodiscard]]
+    std::size_t size_in_bytes() const
+    {
+        return chunks_.size() * sizeof(Chunk);
+    }
+
+private:
+    ChunkID allocate_chunk()
+    {
+        if (free_chunks_ != NO_CHUNK) {
+            const ChunkID chunk_id = free_chunks_;
+            Chunk& chunk = chunks_[chunk_id];
+            free_chunks_ = chunk.next;
+            chunk.size = 0;
+            chunk.next = NO_CHUNK;
+            return chunk_id;
+        }
+
+        assert(chunks_.size() < NO_CHUNK);
+        chunks_.push_back(Chunk());
+        return static_cast<ChunkID>(chunks_.size() - 1);
+    }
+
+    void release_chunk(ChunkID chunk_id)
+    {
+        chunks_[chunk_id].next = free_chunks_;
+        free_chunks_ = chunk_id;
+    }
+};
+
+} // namespace probfd::storage
+
+#endif // PROBFD_STORAGE_CHUNKED_LIST_POOL_H
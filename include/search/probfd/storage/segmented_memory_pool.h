@@ -1,24 +1,37 @@
 #pragma once
 
 #include <cassert>
+#include <cstddef>
 #include <memory>
+#include <memory_resource>
 #include <vector>
 
 namespace probfd::storage {
 
 template <std::size_t SEGMENT_SIZE = 16384>
 class SegmentedMemoryPool {
+    std::pmr::memory_resource* resource_;
     std::size_t space_left_ = 0;
     void* current_ = nullptr;
     std::vector<void*> segments_;
 
 public:
-    SegmentedMemoryPool() = default;
+    explicit SegmentedMemoryPool(
+        std::pmr::memory_resource* resource = std::pmr::new_delete_resource())
+        : resource_(resource)
+    {
+    }
+
+    SegmentedMemoryPool(const SegmentedMemoryPool&) = delete;
+    SegmentedMemoryPool& operator=(const SegmentedMemoryPool&) = delete;
 
     ~SegmentedMemoryPool()
     {
         for (void* segment : segments_) {
-            delete[] (reinterpret_cast<char*>(segment));
+            resource_->deallocate(
+                segment,
+                SEGMENT_SIZE,
+                alignof(std::max_align_t));
         }
     }
 
@@ -31,7 +44,8 @@ public:
 
         if (!std::align(alignof(T), size, current_, space_left_)) {
             space_left_ = SEGMENT_SIZE;
-            current_ = ::operator new[](SEGMENT_SIZE);
+            current_ =
+                resource_->allocate(SEGMENT_SIZE, alignof(std::max_align_t));
             segments_.push_back(current_);
         }
 
@@ -0,0 +1,108 @@
+#ifndef PROBFD_STORAGE_SPILL_FILE_RESOURCE_H
+#define PROBFD_STORAGE_SPILL_FILE_RESOURCE_H
+
+#include <cstddef>
+#include <filesystem>
+#include <memory_resource>
+#include <vector>
+
+namespace probfd::storage {
+
+/**
+ * @brief A monotonic memory resource that allocates its memory from a
+ * temporary file mapped into memory.
+ *
+ * The memory is backed by the file rather than by swap space, so the
+ * operating system may write it back to the file and reclaim it when memory
+ * gets scarce. It is faulted back in transparently when accessed again, so
+ * addresses of allocated objects stay valid at all times.
+ *
+ * Memory is handed out from regions of the file in allocation order. Once
+ * more than \p memory_limit bytes have been allocated after a region, the
+ * region is considered cold and the operating system is advised to write it
+ * back and release its pages. Data structures that allocate their data in
+ * order of creation, like the state registry, hence keep their most recent
+ * data in memory.
+ *
+ * Like std::pmr::monotonic_buffer_resource, deallocation is a no-op. The
+ * memory is released when the resource is destroyed. The spill file is
+ * removed from the file system immediately after its creation, so it does not
+ * outlive the process.
+ *
+ * If memory-mapped files are not supported by the operating system, the
+ * memory is allocated from the default memory resource instead.
+ */
+class SpillFileResource : public std::pmr::memory_resource {
+    struct Region {
+        std::byte* data;
+        std::size_t offset; // The offset of the region in the file.
+        std::size_t size;
+    };
+
+    std::size_t memory_limit_;
+    std::size_t region_size_;
+
+    int fd_ = -1;
+    std::size_t file_size_ = 0;
+
+    std::vector<Region> regions_;
+    std::size_t num_cold_regions_ = 0;
+
+    std::byte* current_ = nullptr;
+    std::size_t space_left_ = 0;
+
+    std::size_t allocated_bytes_ = 0;
+    std::size_t spilled_bytes_ = 0;
+
+    // Used if memory-mapped files are not supported.
+    std::pmr::monotonic_buffer_resource fallback_;
+
+public:
+    /**
+     * @brief Creates a spill file in the directory \p directory.
+     *
+     * @param directory - The directory of the spill file.
+     * @param memory_limit - The number of most recently allocated bytes that
+     * are kept in memory.
+     */
+    SpillFileResource(
+        const std::filesystem::path& directory,
+        std::size_t memory_limit);
+
+    ~SpillFileResource() override;
+
+    SpillFileResource(const SpillFileResource&) = delete;
+    SpillFileResource& operator=(const SpillFileResource&) = delete;
+
+    /// Returns the total number of bytes allocated.
+    [[nodiscard]]
+    std::size_t get_allocated_bytes() const
+    {
+        return allocated_bytes_;
+    }
+
+    /// Returns the number of bytes in regions released to the spill file.
+    [[nodiscard]]
+    std::size_t get_spilled_bytes() const
+    {
+        return spilled_bytes_;
+    }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other)
+        const noexcept override
+    {
+        return this == &other;
+    }
+
+    void add_region(std::size_t min_size);
+    void spill_cold_regions();
+};
+
+} // namespace probfd::storage
+
+#endif // PROBFD_STORAGE_SPILL_FILE_RESOURCE_H
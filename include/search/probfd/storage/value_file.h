@@ -0,0 +1,111 @@
+#ifndef PROBFD_STORAGE_VALUE_FILE_H
+#define PROBFD_STORAGE_VALUE_FILE_H
+
+#include "probfd/fdr_types.h"
+#include "probfd/interval.h"
+
+#include "downward/algorithms/int_packer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+// Forward Declarations
+class OperatorID;
+class State;
+
+namespace probfd {
+class ProbabilisticTask;
+template <typename, typename>
+class Policy;
+} // namespace probfd
+
+namespace probfd::storage {
+
+/**
+ * @brief Computes a fingerprint of the transition and cost structure of a
+ * task.
+ *
+ * Two tasks with the same fingerprint have the same state values with high
+ * probability. The fingerprint covers all parameters of the cost function,
+ * i.e., the action costs and the termination cost of non-goal states, where
+ * the goal states of the cost function are assumed to be those of the task.
+ * The initial state does not influence the fingerprint, so the values stored
+ * for one task can be reused for tasks that only differ in their initial
+ * state.
+ */
+std::uint64_t compute_task_fingerprint(
+    const ProbabilisticTask& task,
+    FDRCostFunction& cost_function);
+
+/**
+ * @brief Writes the state values and actions of a policy to a binary value
+ * file.
+ *
+ * The file is written in the native byte order and consists of a header
+ * (a magic number, the variable domain sizes of the task, the task fingerprint
+ * and the number of bins per packed state), followed by one record per policy
+ * state, sorted by packed state. A record consists of the packed state, the
+ * index of the policy operator and the bounds of the state value.
+ */
+void write_value_file(
+    const std::filesystem::path& path,
+    const ProbabilisticTask& task,
+    FDRCostFunction& cost_function,
+    const Policy<State, OperatorID>& policy);
+
+/**
+ * @brief The contents of a binary value file written by write_value_file().
+ *
+ * The records are looked up by packed state with a binary search.
+ */
+class ValueFile {
+    using Bin = int_packer::IntPacker::Bin;
+
+    std::vector<int> domain_sizes_;
+    std::uint64_t task_fingerprint_ = 0;
+    std::size_t bins_per_state_ = 0;
+
+    std::vector<Bin> states_;
+    std::vector<Interval> values_;
+
+public:
+    /// Reads the value file at the given path. Exits with a critical search
+    /// error if the file cannot be read.
+    explicit ValueFile(const std::filesystem::path& path);
+
+    /// Checks whether the file was written for a task with the same variables
+    /// as the given task, i.e., whether the packed states are compatible.
+    [[nodiscard]]
+    bool has_same_variables(const ProbabilisticTask& task) const;
+
+    [[nodiscard]]
+    std::uint64_t get_task_fingerprint() const
+    {
+        return task_fingerprint_;
+    }
+
+    /// Returns the number of stored states.
+    [[nodiscard]]
+    std::size_t size() const
+    {
+        return values_.size();
+    }
+
+    /// Returns the stored value bounds of the given packed state, or nullptr
+    /// if the state is not stored.
+    [[nodiscard]]
+    const Interval* lookup(const Bin* packed_state) const;
+
+private:
+    [[nodiscard]]
+    const Bin* get_state(std::size_t index) const
+    {
+        return states_.data() + index * bins_per_state_;
+    }
+};
+
+} // namespace probfd::storage
+
+#endif // PROBFD_STORAGE_VALUE_FILE_H
@@ -1,6 +1,7 @@
 #ifndef PROBFD_TASK_PROXY_H
 #define PROBFD_TASK_PROXY_H
 
+#include "probfd/operator_table.h"
 #include "probfd/probabilistic_task.h"
 
 #include "downward/operator_id.h"
@@ -65,6 +66,12 @@ public:
     [[nodiscard]]
     std::size_t size() const
     {
+        if (const OperatorTable* table = task_->get_operator_table()) {
+            return table->get_num_effect_conditions(
+                op_index_,
+                outcome_index_,
+                eff_index_);
+        }
         return task_->get_num_operator_outcome_effect_conditions(
             op_index_,
             outcome_index_,
@@ -75,6 +82,15 @@ public:
     FactProxy operator[](std::size_t index) const
     {
         assert(index < size());
+        if (const OperatorTable* table = task_->get_operator_table()) {
+            return FactProxy(
+                *task_,
+                table->get_effect_condition(
+                    op_index_,
+                    outcome_index_,
+                    eff_index_,
+                    static_cast<int>(index)));
+        }
         return FactProxy(
             *task_,
             task_->get_operator_outcome_effect_condition(
@@ -123,6 +139,11 @@ public:
     [[nodiscard]]
     FactProxy get_fact() const
     {
+        if (const OperatorTable* table = task_->get_operator_table()) {
+            return FactProxy(
+                *task_,
+                table->get_effect(op_index_, outcome_index_, eff_index_));
+        }
         return FactProxy(
             *task_,
             task_->get_operator_outcome_effect(
@@ -156,6 +177,9 @@ public:
     [[nodiscard]]
     std::size_t size() const
     {
+        if (const OperatorTable* table = task_->get_operator_table()) {
+            return table->get_num_effects(op_index_, outcome_index_);
+        }
         return task_->get_num_operator_outcome_effects(
             op_index_,
             outcome_index_);
@@ -195,6 +219,9 @@ public:
     [[nodiscard]]
     int get_determinization_id() const
     {
+        if (const OperatorTable* table = task_->get_operator_table()) {
+            return table->get_outcome_id(op_index_, outcome_index_);
+        }
         return task_->get_operator_outcome_id(op_index_, outcome_index_);
     }
 
@@ -213,6 +240,9 @@ public:
     [[nodiscard]]
     value_t get_probability() const
     {
+        if (const OperatorTable* table = task_->get_operator_table()) {
+            return table->get_outcome_probability(op_index_, outcome_index_);
+        }
         return task_->get_operator_outcome_probability(
             op_index_,
             outcome_index_);
@@ -238,6 +268,9 @@ public:
     [[nodiscard]]
     std::size_t size() const
     {
+        if (const OperatorTable* table = task_->get_operator_table()) {
+            return table->get_num_outcomes(op_index_);
+        }
         return task_->get_num_operator_outcomes(op_index_);
     }
 
@@ -274,8 +307,13 @@ public:
     [[nodiscard]]
     value_t get_cost() const
     {
-        return static_cast<const ProbabilisticTask*>(task)->get_operator_cost(
-            index);
+        const auto* probabilistic_task =
+            static_cast<const ProbabilisticTask*>(task);
+        if (const OperatorTable* table =
+                probabilistic_task->get_operator_table()) {
+            return table->costs[index];
+        }
+        return probabilistic_task->get_operator_cost(index);
     }
 };
 
@@ -16,6 +16,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <memory_resource>
 #include <vector>
 
 // Forward Declarations
@@ -67,7 +68,9 @@ public:
         utils::LogProxy log,
         std::shared_ptr<FDRSimpleCostFunction> cost_function,
         const std::vector<std::shared_ptr<::Evaluator>>&
-            path_dependent_evaluators = {});
+            path_dependent_evaluators = {},
+        std::pmr::memory_resource* state_memory =
+            std::pmr::get_default_resource());
 
     StateID get_state_id(const State& state) final;
     State get_state(StateID state_id) final;
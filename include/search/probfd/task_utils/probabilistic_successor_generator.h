@@ -1,7 +1,8 @@
 #ifndef PROBFD_TASK_UTILS_PROBABILISTIC_SUCCESSOR_GENERATOR_H
 #define PROBFD_TASK_UTILS_PROBABILISTIC_SUCCESSOR_GENERATOR_H
 
-#include <memory>
+#include "downward/algorithms/int_packer.h"
+
 #include <vector>
 
 // Forward Declarations
@@ -16,21 +17,27 @@ struct Transition;
 } // namespace probfd
 
 namespace probfd::successor_generator {
-class ProbabilisticGeneratorBase;
-}
 
-namespace probfd::successor_generator {
+/**
+ * @brief Generates the applicable operators of a state.
+ *
+ * The decision tree constructed by the ProbabilisticSuccessorGeneratorFactory
+ * is compiled into a flat vector of ints, which is interpreted by a single
+ * loop (see probabilistic_successor_generator_internals.h for the encoding).
+ * For registered states, the variables tested by the decision tree are read
+ * directly from the packed state buffer, so the state is not unpacked.
+ */
 class ProbabilisticSuccessorGenerator {
-    std::unique_ptr<ProbabilisticGeneratorBase> root_;
+    std::vector<int> code_;
+    int root_;
+
+    // The packer of the registered states and the locations of the
+    // variables in their packed buffers.
+    const int_packer::IntPacker* state_packer_;
+    std::vector<int_packer::IntPacker::Location> locations_;
 
 public:
     explicit ProbabilisticSuccessorGenerator(const TaskBaseProxy& task_proxy);
-    /*
-      We cannot use the default destructor (implicitly or explicitly)
-      here because GeneratorBase is a forward declaration and the
-      incomplete type cannot be destroyed.
-    */
-    ~ProbabilisticSuccessorGenerator();
 
     void generate_applicable_ops(
         const State& state,
@@ -40,6 +47,10 @@ public:
         const State& state,
         std::vector<Transition<OperatorID>>& transitions,
         TaskStateSpace& task_state_space) const;
+
+private:
+    template <typename F>
+    void for_each_applicable_operator(const State& state, F f) const;
 };
 
 } // namespace probfd::successor_generator
@@ -7,28 +7,46 @@
 #include <unordered_map>
 #include <vector>
 
-class State;
+namespace probfd::successor_generator {
 
-namespace probfd {
-class TaskStateSpace;
-template <typename>
-struct Transition;
-} // namespace probfd
+/**
+ * @brief The node types of the compiled successor generator.
+ *
+ * A compiled successor generator is a vector of ints. A node consists of its
+ * opcode followed by its payload. Children are referred to by the position of
+ * their code, NO_CHILD denotes a missing child.
+ *
+ * - FORK: [FORK, n, child_1, ..., child_n]
+ * - VECTOR_SWITCH: [VECTOR_SWITCH, var_id, child_0, ..., child_{d-1}], where
+ *   d is the domain size of the variable.
+ * - SORTED_SWITCH: [SORTED_SWITCH, var_id, k, value_1, child_1, ...,
+ *   value_k, child_k], where the values are sorted.
+ * - SINGLE_SWITCH: [SINGLE_SWITCH, var_id, value, child]
+ * - LEAF: [LEAF, n, op_id_1, ..., op_id_n]
+ */
+enum Opcode : int {
+    FORK,
+    VECTOR_SWITCH,
+    SORTED_SWITCH,
+    SINGLE_SWITCH,
+    LEAF,
+};
 
-namespace probfd::successor_generator {
+inline constexpr int NO_CHILD = -1;
 
+/**
+ * @brief Construction-time node of a successor generator, which is compiled
+ * for the lookups.
+ */
 class ProbabilisticGeneratorBase {
 public:
     virtual ~ProbabilisticGeneratorBase() = default;
 
-    virtual void generate_applicable_ops(
-        const std::vector<int>& state,
-        std::vector<OperatorID>& applicable_ops) const = 0;
-
-    virtual void generate_transitions(
-        const State& state,
-        std::vector<Transition<OperatorID>>& transitions,
-        TaskStateSpace& task_state_space) const = 0;
+    /**
+     * @brief Appends the code of this node and its children to \p code and
+     * returns the position of the node's code.
+     */
+    virtual int compile(std::vector<int>& code) const = 0;
 };
 
 class ProbabilisticGeneratorForkBinary : public ProbabilisticGeneratorBase {
@@ -40,14 +58,7 @@ public:
         std::unique_ptr<ProbabilisticGeneratorBase> generator1,
         std::unique_ptr<ProbabilisticGeneratorBase> generator2);
 
-    void generate_applicable_ops(
-        const std::vector<int>& state,
-        std::vector<OperatorID>& applicable_ops) const override;
-
-    void generate_transitions(
-        const State& state,
-        std::vector<Transition<OperatorID>>& transitions,
-        TaskStateSpace& task_state_space) const override;
+    int compile(std::vector<int>& code) const override;
 };
 
 class ProbabilisticGeneratorForkMulti : public ProbabilisticGeneratorBase {
@@ -57,14 +68,7 @@ public:
     explicit ProbabilisticGeneratorForkMulti(
         std::vector<std::unique_ptr<ProbabilisticGeneratorBase>> children);
 
-    void generate_applicable_ops(
-        const std::vector<int>& state,
-        std::vector<OperatorID>& applicable_ops) const override;
-
-    void generate_transitions(
-        const State& state,
-        std::vector<Transition<OperatorID>>& transitions,
-        TaskStateSpace& task_state_space) const override;
+    int compile(std::vector<int>& code) const override;
 };
 
 class ProbabilisticGeneratorSwitchVector : public ProbabilisticGeneratorBase {
@@ -78,14 +82,7 @@ public:
         std::vector<std::unique_ptr<ProbabilisticGeneratorBase>>&&
             generator_for_value);
 
-    void generate_applicable_ops(
-        const std::vector<int>& state,
-        std::vector<OperatorID>& applicable_ops) const override;
-
-    void generate_transitions(
-        const State& state,
-        std::vector<Transition<OperatorID>>& transitions,
-        TaskStateSpace& task_state_space) const override;
+    int compile(std::vector<int>& code) const override;
 };
 
 class ProbabilisticGeneratorSwitchHash : public ProbabilisticGeneratorBase {
@@ -99,14 +96,7 @@ public:
         std::unordered_map<int, std::unique_ptr<ProbabilisticGeneratorBase>>&&
             generator_for_value);
 
-    void generate_applicable_ops(
-        const std::vector<int>& state,
-        std::vector<OperatorID>& applicable_ops) const override;
-
-    void generate_transitions(
-        const State& state,
-        std::vector<Transition<OperatorID>>& transitions,
-        TaskStateSpace& task_state_space) const override;
+    int compile(std::vector<int>& code) const override;
 };
 
 class ProbabilisticGeneratorSwitchSingle : public ProbabilisticGeneratorBase {
@@ -120,14 +110,7 @@ public:
         int value,
         std::unique_ptr<ProbabilisticGeneratorBase> generator_for_value);
 
-    void generate_applicable_ops(
-        const std::vector<int>& state,
-        std::vector<OperatorID>& applicable_ops) const override;
-
-    void generate_transitions(
-        const State& state,
-        std::vector<Transition<OperatorID>>& transitions,
-        TaskStateSpace& task_state_space) const override;
+    int compile(std::vector<int>& code) const override;
 };
 
 class ProbabilisticGeneratorLeafVector : public ProbabilisticGeneratorBase {
@@ -137,14 +120,7 @@ public:
     explicit ProbabilisticGeneratorLeafVector(
         std::vector<OperatorID>&& applicable_operators);
 
-    void generate_applicable_ops(
-        const std::vector<int>& state,
-        std::vector<OperatorID>& applicable_ops) const override;
-
-    void generate_transitions(
-        const State& state,
-        std::vector<Transition<OperatorID>>& transitions,
-        TaskStateSpace& task_state_space) const override;
+    int compile(std::vector<int>& code) const override;
 };
 
 class ProbabilisticGeneratorLeafSingle : public ProbabilisticGeneratorBase {
@@ -153,14 +129,7 @@ class ProbabilisticGeneratorLeafSingle : public ProbabilisticGeneratorBase {
 public:
     explicit ProbabilisticGeneratorLeafSingle(OperatorID applicable_operator);
 
-    void generate_applicable_ops(
-        const std::vector<int>& state,
-        std::vector<OperatorID>& applicable_ops) const override;
-
-    void generate_transitions(
-        const State& state,
-        std::vector<Transition<OperatorID>>& transitions,
-        TaskStateSpace& task_state_space) const override;
+    int compile(std::vector<int>& code) const override;
 };
 
 } // namespace probfd::successor_generator
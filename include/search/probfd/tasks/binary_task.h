@@ -0,0 +1,64 @@
+#ifndef PROBFD_TASKS_BINARY_TASK_H
+#define PROBFD_TASKS_BINARY_TASK_H
+
+#include <iosfwd>
+#include <memory>
+#include <span>
+#include <vector>
+
+// Forward Declarations
+struct FactPair;
+
+namespace probfd {
+class ProbabilisticTask;
+}
+
+namespace probfd::tasks {
+
+/*
+  The binary task format stores a probabilistic planning task as a sequence
+  of flat arrays in the native byte order, so that it can be used in place
+  after mapping the file into memory. The file starts with a header consisting
+  of a magic number, a format version and a table of sections. Each section is
+  an array aligned to eight bytes. Nested lists (e.g., the preconditions of
+  the operators) are stored in compressed sparse row form, i.e., as an array
+  of all elements and an array of offsets, where the elements of list i are
+  found in the range [offsets[i], offsets[i + 1]).
+
+  The initial state stored in the file has been evaluated with the axioms
+  already.
+*/
+
+/// Checks whether the next bytes of the input stream are the magic number and
+/// the supported version of the binary task format. Does not consume any
+/// input. If the stream cannot be rewound, only the first byte of the magic
+/// number is checked, and the remainder is checked by read_binary_task().
+extern bool is_binary_task(std::istream& in);
+
+/**
+ * @brief Reads a task in the binary task format.
+ *
+ * If \p in is std::cin, the standard input is a regular file and the task
+ * starts at the beginning of the file, the file is mapped into memory and used
+ * in place. Otherwise, the remaining input is read into a buffer.
+ *
+ * Exits with ExitCode::SEARCH_INPUT_ERROR if the input is not a valid task of
+ * the supported format version, e.g. because it is truncated.
+ */
+extern std::unique_ptr<ProbabilisticTask> read_binary_task(std::istream& in);
+
+/**
+ * @brief Writes a task in the binary task format.
+ *
+ * The facts of the task are numbered consecutively by variable and value.
+ * The list at position i of \p mutexes contains the facts mutex with the fact
+ * with number i, excluding the facts of the same variable.
+ */
+extern void write_binary_task(
+    const ProbabilisticTask& task,
+    std::span<const std::vector<FactPair>> mutexes,
+    std::ostream& out);
+
+} // namespace probfd::tasks
+
+#endif // PROBFD_TASKS_BINARY_TASK_H
@@ -14,11 +14,17 @@ namespace probfd::tasks {
 /// The input probabilistic planning task.
 extern std::shared_ptr<ProbabilisticTask> g_root_task;
 
+/// Reads a task in the translator output format or in the binary task format
+/// (see binary_task.h).
 extern std::unique_ptr<ProbabilisticTask> read_sas_task(std::istream& in);
 extern std::shared_ptr<ProbabilisticTask> read_root_tasks(std::istream& in);
 
 extern void set_root_task(std::shared_ptr<ProbabilisticTask> task);
 
+/// Converts a task in the translator output format to the binary task format.
+extern void
+convert_sas_task_to_binary(std::istream& in, std::ostream& out);
+
 } // namespace probfd::tasks
 
 #endif
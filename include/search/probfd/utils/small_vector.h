@@ -0,0 +1,311 @@
+#ifndef PROBFD_UTILS_SMALL_VECTOR_H
+#define PROBFD_UTILS_SMALL_VECTOR_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace probfd {
+
+/**
+ * @brief A vector that stores up to \p N elements inline and only allocates
+ * heap memory if it grows beyond that.
+ *
+ * The interface is a subset of the interface of std::vector. The iterators
+ * are plain pointers.
+ *
+ * @warning Unlike for std::vector, moving or swapping a small vector whose
+ * elements are stored inline invalidates all iterators and references to its
+ * elements.
+ *
+ * @tparam T - The element type.
+ * @tparam N - The number of elements stored inline.
+ */
+template <typename T, std::size_t N>
+class SmallVector {
+    static_assert(N > 0, "The inline capacity must be positive.");
+
+    std::uint32_t size_ = 0;
+    std::uint32_t capacity_ = N;
+
+    union {
+        T* heap_;
+        alignas(T) std::byte inline_[N * sizeof(T)];
+    };
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    SmallVector() noexcept {}
+
+    SmallVector(const SmallVector& other)
+    {
+        reserve(other.size());
+        std::uninitialized_copy(other.begin(), other.end(), data());
+        size_ = other.size_;
+    }
+
+    SmallVector(SmallVector&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T>)
+    {
+        steal(other);
+    }
+
+    ~SmallVector()
+    {
+        std::destroy(begin(), end());
+        deallocate();
+    }
+
+    SmallVector& operator=(const SmallVector& other)
+    {
+        if (this != &other) {
+            clear();
+            reserve(other.size());
+            std::uninitialized_copy(other.begin(), other.end(), data());
+            size_ = other.size_;
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this != &other) {
+            std::destroy(begin(), end());
+            deallocate();
+            size_ = 0;
+            capacity_ = N;
+            steal(other);
+        }
+        return *this;
+    }
+
+    [[nodiscard]]
+    T* data()
+    {
+        return is_inline() ? std::launder(reinterpret_cast<T*>(inline_))
+                           : heap_;
+    }
+
+    [[nodiscard]]
+    const T* data() const
+    {
+        return is_inline()
+                   ? std::launder(reinterpret_cast<const T*>(inline_))
+                   : heap_;
+    }
+
+    iterator begin() { return data(); }
+    const_iterator begin() const { return data(); }
+    iterator end() { return data() + size_; }
+    const_iterator end() const { return data() + size_; }
+
+    T& operator[](std::size_t i) { return data()[i]; }
+    const T& operator[](std::size_t i) const { return data()[i]; }
+
+    T& front() { return *begin(); }
+    const T& front() const { return *begin(); }
+    T& back() { return end()[-1]; }
+    const T& back() const { return end()[-1]; }
+
+    [[nodiscard]]
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    [[nodiscard]]
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+    [[nodiscard]]
+    std::size_t capacity() const
+    {
+        return capacity_;
+    }
+
+    /// Returns whether the elements are stored inline.
+    [[nodiscard]]
+    bool is_inline() const
+    {
+        return capacity_ == N;
+    }
+
+    void reserve(std::size_t capacity)
+    {
+        if (capacity > capacity_) grow(capacity);
+    }
+
+    /// Destroys all elements. The heap memory, if any, is kept.
+    void clear()
+    {
+        std::destroy(begin(), end());
+        size_ = 0;
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if (size_ == capacity_) {
+            return grow_emplace_back(std::forward<Args>(args)...);
+        }
+
+        T* element = std::construct_at(end(), std::forward<Args>(args)...);
+        ++size_;
+        return *element;
+    }
+
+    void push_back(const T& t) { emplace_back(t); }
+    void push_back(T&& t) { emplace_back(std::move(t)); }
+
+    void pop_back()
+    {
+        assert(!empty());
+        std::destroy_at(end() - 1);
+        --size_;
+    }
+
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args)
+    {
+        const std::size_t index = pos - begin();
+        assert(index <= size_);
+
+        if (index == size_) {
+            emplace_back(std::forward<Args>(args)...);
+            return begin() + index;
+        }
+
+        // Construct first, the arguments may refer to an element.
+        T t(std::forward<Args>(args)...);
+        if (size_ == capacity_) grow(std::size_t(capacity_) * 2);
+        emplace_back(std::move(back()));
+        std::move_backward(begin() + index, end() - 2, end() - 1);
+        begin()[index] = std::move(t);
+
+        return begin() + index;
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        iterator f = begin() + (first - begin());
+        iterator l = begin() + (last - begin());
+
+        if (f != l) {
+            iterator new_end = std::move(l, end(), f);
+            std::destroy(new_end, end());
+            size_ -= static_cast<std::uint32_t>(l - f);
+        }
+
+        return f;
+    }
+
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+    void swap(SmallVector& other)
+    {
+        SmallVector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    friend bool operator==(const SmallVector& left, const SmallVector& right)
+    {
+        return std::equal(left.begin(), left.end(), right.begin(), right.end());
+    }
+
+    friend bool operator<(const SmallVector& left, const SmallVector& right)
+    {
+        return std::lexicographical_compare(
+            left.begin(),
+            left.end(),
+            right.begin(),
+            right.end());
+    }
+
+    /// Removes all elements satisfying the predicate and returns their number.
+    template <typename Predicate>
+    friend std::size_t erase_if(SmallVector& vector, Predicate pred)
+    {
+        const auto it = std::remove_if(vector.begin(), vector.end(), pred);
+        const std::size_t removed = vector.end() - it;
+        vector.erase(it, vector.end());
+        return removed;
+    }
+
+private:
+    // Constructs the new element in the new buffer before the old elements
+    // are moved, since the arguments may refer to one of them.
+    template <typename... Args>
+    T& grow_emplace_back(Args&&... args)
+    {
+        const std::size_t capacity = std::size_t(capacity_) * 2;
+        T* new_data = std::allocator<T>().allocate(capacity);
+        T* element =
+            std::construct_at(new_data + size_, std::forward<Args>(args)...);
+        std::uninitialized_move(begin(), end(), new_data);
+        std::destroy(begin(), end());
+        deallocate();
+
+        heap_ = new_data;
+        capacity_ = static_cast<std::uint32_t>(capacity);
+        ++size_;
+
+        return *element;
+    }
+
+    void grow(std::size_t capacity)
+    {
+        assert(capacity > capacity_);
+
+        T* new_data = std::allocator<T>().allocate(capacity);
+        std::uninitialized_move(begin(), end(), new_data);
+        std::destroy(begin(), end());
+        deallocate();
+
+        heap_ = new_data;
+        capacity_ = static_cast<std::uint32_t>(capacity);
+    }
+
+    void deallocate()
+    {
+        if (!is_inline()) std::allocator<T>().deallocate(heap_, capacity_);
+    }
+
+    // Takes over the elements of other, which must be empty afterwards.
+    void steal(SmallVector& other)
+    {
+        if (other.is_inline()) {
+            std::uninitialized_move(other.begin(), other.end(), data());
+            size_ = other.size_;
+            other.clear();
+        } else {
+            heap_ = other.heap_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.size_ = 0;
+            other.capacity_ = N;
+        }
+    }
+};
+
+} // namespace probfd
+
+#endif // PROBFD_UTILS_SMALL_VECTOR_H
@@ -0,0 +1,116 @@
+#ifndef PROBFD_UTILS_THREAD_POOL_H
+#define PROBFD_UTILS_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace probfd {
+
+/**
+ * @brief A fixed-size work-stealing thread pool.
+ *
+ * Every worker owns a task deque. Tasks submitted by a worker are pushed to
+ * the back of its own deque and are also popped from there, so that dependent
+ * work stays on the same core. Tasks submitted by other threads are
+ * distributed round-robin. Idle workers steal from the front of the deques
+ * of the other workers.
+ *
+ * If a task throws, the first exception is stored, all remaining tasks are
+ * discarded without being run and the exception is rethrown by wait().
+ */
+class ThreadPool {
+    using Task = std::function<void()>;
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> workers_;
+
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cv_;
+    std::atomic<std::ptrdiff_t> queued_ = 0;
+    bool stop_ = false;
+
+    std::mutex done_mutex_;
+    std::condition_variable done_cv_;
+    std::atomic<std::size_t> unfinished_ = 0;
+
+    std::atomic<bool> cancelled_ = false;
+    std::exception_ptr exception_;
+
+    std::atomic<unsigned> next_queue_ = 0;
+
+public:
+    /**
+     * @brief Starts a pool with \p num_threads worker threads.
+     */
+    explicit ThreadPool(unsigned num_threads);
+
+    /**
+     * @brief Discards all pending tasks and joins the worker threads.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Schedules a task for execution.
+     *
+     * May be called from within a running task.
+     */
+    void submit(Task task);
+
+    /**
+     * @brief Blocks until all submitted tasks have finished.
+     *
+     * Rethrows the first exception thrown by a task, if any. Must not be
+     * called from within a task.
+     */
+    void wait();
+
+    /**
+     * @brief Returns the number of worker threads.
+     */
+    [[nodiscard]]
+    unsigned get_num_threads() const;
+
+    /**
+     * @brief Returns the hardware concurrency, or one if unknown.
+     */
+    static unsigned get_hardware_concurrency();
+
+private:
+    void worker_loop(unsigned index);
+    bool try_pop(unsigned index, Task& task);
+    void run_task(Task& task);
+    void finish_task();
+};
+
+/**
+ * @brief Runs \p f(i) for every i in [0, \p n) on the thread pool and waits
+ * for completion.
+ */
+template <typename F>
+void parallel_for(ThreadPool& pool, std::size_t n, F f)
+{
+    for (std::size_t i = 0; i != n; ++i) {
+        pool.submit([&f, i] { f(i); });
+    }
+    pool.wait();
+}
+
+} // namespace probfd
+
+#endif // PROBFD_UTILS_THREAD_POOL_H
@@ -0,0 +1,217 @@
+#include "benchmarks/benchmark.h"
+#include "benchmarks/utils.h"
+
+#include "probfd/algorithms/heuristic_depth_first_search.h"
+#include "probfd/algorithms/lrtdp.h"
+#include "probfd/algorithms/ta_topological_value_iteration.h"
+
+#include "probfd/preprocessing/end_component_decomposition.h"
+
+#include "probfd/heuristics/constant_evaluator.h"
+
+#include "probfd/policy_pickers/arbitrary_tiebreaker.h"
+
+#include "probfd/successor_samplers/uniform_successor_sampler.h"
+
+#include "probfd/progress_report.h"
+#include "probfd/ssp_cost_function.h"
+#include "probfd/task_proxy.h"
+#include "probfd/task_state_space.h"
+
+#include "downward/utils/logging.h"
+#include "downward/utils/rng.h"
+
+#include <iostream>
+#include <limits>
+#include <memory>
+
+using namespace probfd;
+using namespace benchmarks;
+
+namespace {
+
+constexpr double INF_TIME = std::numeric_limits<double>::infinity();
+
+const State& get_initial_state(TaskStateSpace& mdp)
+{
+    return mdp.get_initial_state();
+}
+
+int get_initial_state(SyntheticMDP&)
+{
+    return 0;
+}
+
+// Returns a function creating a fresh state space for the benchmarked task.
+auto get_task_state_space_factory(BenchmarkState& state)
+{
+    std::shared_ptr<ProbabilisticTask> task = load_task(state);
+    auto cost_function =
+        std::make_shared<SSPCostFunction>(ProbabilisticTaskProxy(*task));
+
+    return [task, cost_function] {
+        return std::make_unique<TaskStateSpace>(
+            task,
+            utils::get_silent_log(),
+            cost_function);
+    };
+}
+
+// Returns a function creating the synthetic MDP of the benchmarked size.
+auto get_synthetic_mdp_factory(BenchmarkState& state)
+{
+    return [&state] {
+        return std::make_unique<SyntheticMDP>(create_synthetic_mdp(state));
+    };
+}
+
+template <typename State, typename Action>
+void benchmark_ta_tvi(BenchmarkState& state, const auto& create_mdp)
+{
+    using namespace algorithms::ta_topological_vi;
+
+    heuristics::BlindEvaluator<State> heuristic;
+
+    while (state.keep_running()) {
+        state.pause_timing();
+        auto mdp = create_mdp();
+        TATopologicalValueIteration<State, Action> tvi;
+        state.resume_timing();
+
+        tvi.solve(
+            *mdp,
+            heuristic,
+            get_initial_state(*mdp),
+            ProgressReport(0.0_vt, std::cout, false),
+            INF_TIME);
+
+        const Statistics statistics = tvi.get_statistics();
+        state.add_counter("states", statistics.expanded_states);
+        state.add_counter("backups", statistics.bellman_backups);
+    }
+}
+
+template <typename State, typename Action>
+void benchmark_ecd(BenchmarkState& state, const auto& create_mdp)
+{
+    using namespace preprocessing;
+
+    // ECD does not count the states it visits, so count them once up front.
+    unsigned long long transitions = 0;
+    const unsigned long long num_states = [&] {
+        auto mdp = create_mdp();
+        return explore_state_space<State, Action>(
+            *mdp,
+            get_initial_state(*mdp),
+            transitions);
+    }();
+
+    while (state.keep_running()) {
+        state.pause_timing();
+        auto mdp = create_mdp();
+        EndComponentDecomposition<State, Action> ecd(false);
+        state.resume_timing();
+
+        auto quotient =
+            ecd.build_quotient_system(*mdp, nullptr, get_initial_state(*mdp));
+
+        state.add_counter("states", num_states);
+    }
+}
+
+template <typename State, typename Action>
+void run_heuristic_search(
+    BenchmarkState& state,
+    auto& mdp,
+    auto& algorithm)
+{
+    heuristics::BlindEvaluator<State> heuristic;
+
+    algorithm.solve(
+        mdp,
+        heuristic,
+        get_initial_state(mdp),
+        ProgressReport(0.0_vt, std::cout, false),
+        INF_TIME);
+
+    const auto& statistics = algorithm.get_heuristic_search_statistics();
+    state.add_counter("states", statistics.evaluated_states);
+    state.add_counter("backups", statistics.backups);
+}
+
+template <typename State, typename Action>
+void benchmark_lrtdp(BenchmarkState& state, const auto& create_mdp)
+{
+    using namespace algorithms::lrtdp;
+
+    while (state.keep_running()) {
+        state.pause_timing();
+        auto mdp = create_mdp();
+        LRTDP<State, Action, false> lrtdp(
+            std::make_shared<
+                policy_pickers::ArbitraryTiebreaker<State, Action>>(true),
+            TrialTerminationCondition::TERMINAL,
+            std::make_shared<
+                successor_samplers::UniformSuccessorSampler<Action>>(
+                std::make_shared<utils::RandomNumberGenerator>(42)));
+        state.resume_timing();
+
+        run_heuristic_search<State, Action>(state, *mdp, lrtdp);
+    }
+}
+
+template <typename State, typename Action>
+void benchmark_ilao(BenchmarkState& state, const auto& create_mdp)
+{
+    using namespace algorithms::heuristic_depth_first_search;
+
+    while (state.keep_running()) {
+        state.pause_timing();
+        auto mdp = create_mdp();
+        HeuristicDepthFirstSearch<State, Action, false> ilao(
+            std::make_shared<
+                policy_pickers::ArbitraryTiebreaker<State, Action>>(true),
+            false,
+            false,
+            BacktrackingUpdateType::SINGLE,
+            false,
+            false,
+            true,
+            false);
+        state.resume_timing();
+
+        run_heuristic_search<State, Action>(state, *mdp, ilao);
+    }
+}
+
+} // namespace
+
+#define PROBFD_TASK_BENCHMARK(name, function)                                  \
+    PROBFD_BENCHMARK(                                                          \
+        name,                                                                  \
+        "gripper_example.sas",                                                 \
+        "pblocksworld_example.sas",                                            \
+        "test1.sas")                                                           \
+    {                                                                          \
+        function<State, OperatorID>(                                           \
+            state,                                                             \
+            get_task_state_space_factory(state));                              \
+    }
+
+#define PROBFD_SYNTHETIC_BENCHMARK(name, function, ...)                        \
+    PROBFD_BENCHMARK(name, __VA_ARGS__)                                        \
+    {                                                                          \
+        function<int, int>(state, get_synthetic_mdp_factory(state));           \
+    }
+
+PROBFD_TASK_BENCHMARK(ta_tvi, benchmark_ta_tvi)
+PROBFD_TASK_BENCHMARK(ecd, benchmark_ecd)
+PROBFD_TASK_BENCHMARK(lrtdp, benchmark_lrtdp)
+PROBFD_TASK_BENCHMARK(ilao, benchmark_ilao)
+
+// Heuristic search with the blind heuristic needs many trials to propagate the
+// goal distance through the synthetic MDP, so it is run on smaller instances.
+PROBFD_SYNTHETIC_BENCHMARK(synthetic_ta_tvi, benchmark_ta_tvi, "1000", "10000")
+PROBFD_SYNTHETIC_BENCHMARK(synthetic_ecd, benchmark_ecd, "10000", "100000")
+PROBFD_SYNTHETIC_BENCHMARK(synthetic_lrtdp, benchmark_lrtdp, "1000", "3000")
+PROBFD_SYNTHETIC_BENCHMARK(synthetic_ilao, benchmark_ilao, "1000", "3000")
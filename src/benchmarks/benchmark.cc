@@ -0,0 +1,172 @@
+#include "benchmarks/benchmark.h"
+
+#include "downward/utils/system.h"
+
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string_view>
+#include <utility>
+
+namespace benchmarks {
+
+namespace {
+
+struct RegisteredBenchmark {
+    std::string name;
+    std::string argument;
+    BenchmarkFunction function;
+};
+
+std::vector<RegisteredBenchmark>& get_registry()
+{
+    static std::vector<RegisteredBenchmark> registry;
+    return registry;
+}
+
+void print_usage(std::string_view program)
+{
+    std::cerr << "Usage: " << program
+              << " [--filter <substring>] [--repetitions <n>]"
+                 " [--resources <directory>] [--list]"
+              << std::endl;
+}
+
+std::string format_rate(double rate)
+{
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(0) << rate;
+    return out.str();
+}
+
+} // namespace
+
+BenchmarkState::BenchmarkState(
+    std::string argument,
+    std::filesystem::path resources_directory,
+    int repetitions)
+    : argument_(std::move(argument))
+    , resources_directory_(std::move(resources_directory))
+    , repetitions_(repetitions)
+    , remaining_(repetitions)
+{
+}
+
+bool BenchmarkState::keep_running()
+{
+    if (remaining_ == 0) {
+        pause_timing();
+        return false;
+    }
+
+    if (remaining_-- == repetitions_) resume_timing();
+    return true;
+}
+
+void BenchmarkState::pause_timing()
+{
+    if (!running_) return;
+    elapsed_ += Clock::now() - start_;
+    running_ = false;
+}
+
+void BenchmarkState::resume_timing()
+{
+    if (running_) return;
+    start_ = Clock::now();
+    running_ = true;
+}
+
+void BenchmarkState::add_counter(
+    const std::string& name,
+    unsigned long long count)
+{
+    counters_[name] += count;
+}
+
+double BenchmarkState::get_elapsed_seconds() const
+{
+    return std::chrono::duration<double>(elapsed_).count();
+}
+
+BenchmarkRegistration::BenchmarkRegistration(
+    const std::string& name,
+    BenchmarkFunction function,
+    const std::vector<std::string>& arguments)
+{
+    for (const std::string& argument : arguments) {
+        get_registry().emplace_back(name, argument, function);
+    }
+}
+
+int run_benchmarks(int argc, const char* const* argv)
+{
+    std::string filter;
+    int repetitions = 5;
+    std::filesystem::path resources_directory = "resources";
+    bool list_only = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--list") {
+            list_only = true;
+        } else if (i + 1 < argc && arg == "--filter") {
+            filter = argv[++i];
+        } else if (i + 1 < argc && arg == "--repetitions") {
+            repetitions = std::atoi(argv[++i]);
+        } else if (i + 1 < argc && arg == "--resources") {
+            resources_directory = argv[++i];
+        } else {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (repetitions <= 0) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    for (const auto& [name, argument, function] : get_registry()) {
+        const std::string full_name = name + "/" + argument;
+        if (full_name.find(filter) == std::string::npos) continue;
+
+        if (list_only) {
+            std::cout << full_name << std::endl;
+            continue;
+        }
+
+        BenchmarkState state(argument, resources_directory, repetitions);
+
+        try {
+            function(state);
+        } catch (const std::exception& e) {
+            std::cout << std::left << std::setw(48) << full_name
+                      << " FAILED: " << e.what() << std::endl;
+            continue;
+        }
+
+        const double seconds = state.get_elapsed_seconds();
+
+        std::cout << std::left << std::setw(48) << full_name << std::right
+                  << std::setw(4) << state.get_repetitions() << " x "
+                  << std::fixed << std::setprecision(6)
+                  << seconds / state.get_repetitions() << "s";
+
+        for (const auto& [counter, count] : state.get_counters()) {
+            std::cout << "  " << format_rate(count / seconds) << " " << counter
+                      << "/s";
+        }
+
+        // The peak memory is process-wide, run benchmarks in isolation with
+        // --filter to attribute it to a single benchmark.
+        std::cout << "  peak " << utils::get_peak_memory_in_kb() << " KB"
+                  << std::endl;
+    }
+
+    return 0;
+}
+
+} // namespace benchmarks
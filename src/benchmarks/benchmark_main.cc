@@ -0,0 +1,6 @@
+#include "benchmarks/benchmark.h"
+
+int main(int argc, char** argv)
+{
+    return benchmarks::run_benchmarks(argc, argv);
+}
@@ -0,0 +1,250 @@
+#include "benchmarks/benchmark.h"
+#include "benchmarks/utils.h"
+
+#include "probfd/pdbs/pdb_collection_evaluator.h"
+#include "probfd/pdbs/probability_aware_pattern_database.h"
+#include "probfd/pdbs/projection_operator.h"
+#include "probfd/pdbs/projection_state_space.h"
+#include "probfd/pdbs/state_ranking_function.h"
+#include "probfd/pdbs/trivial_finder.h"
+
+#include "probfd/ssp_cost_function.h"
+#include "probfd/task_proxy.h"
+#include "probfd/task_state_space.h"
+
+#include "downward/utils/logging.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+using namespace probfd;
+using namespace probfd::pdbs;
+using namespace benchmarks;
+
+namespace {
+
+// Returns the largest prefix of the variables of the task whose projection has
+// at most max_states abstract states.
+Pattern get_benchmark_pattern(
+    ProbabilisticTaskProxy task_proxy,
+    unsigned long long max_states = 1000000)
+{
+    Pattern pattern;
+    unsigned long long num_states = 1;
+
+    for (const VariableProxy var : task_proxy.get_variables()) {
+        num_states *= var.get_domain_size();
+        if (num_states > max_states) break;
+        pattern.push_back(var.get_id());
+    }
+
+    return pattern;
+}
+
+// Builds the PDBs of all pairs of consecutive variables, combined by taking
+// the maximum.
+PDBCollectionEvaluator create_benchmark_collection(
+    ProbabilisticTaskProxy task_proxy,
+    FDRSimpleCostFunction& cost_function)
+{
+    auto patterns = std::make_shared<PatternCollection>();
+    const int num_variables =
+        static_cast<int>(task_proxy.get_variables().size());
+    for (int var = 0; var + 1 < num_variables; ++var) {
+        patterns->push_back({var, var + 1});
+    }
+
+    const State initial_state = task_proxy.get_initial_state();
+
+    auto pdbs = std::make_shared<PPDBCollection>();
+    for (const Pattern& pattern : *patterns) {
+        pdbs->push_back(std::make_unique<ProbabilityAwarePatternDatabase>(
+            task_proxy,
+            cost_function,
+            pattern,
+            initial_state));
+    }
+
+    auto finder = std::make_shared<TrivialFinder>();
+    auto subcollections = finder->compute_subcollections(*patterns);
+
+    return PDBCollectionEvaluator(
+        std::move(pdbs),
+        std::move(subcollections),
+        std::move(finder),
+        cost_function.get_non_goal_termination_cost());
+}
+
+// Returns all reachable states of the task. They are packed, as during search.
+std::vector<State> get_reachable_states(TaskStateSpace& mdp)
+{
+    unsigned long long transitions = 0;
+    const unsigned long long num_states =
+        explore_state_space(mdp, mdp.get_initial_state(), transitions);
+
+    // The state space registers exactly the reachable states, in order.
+    std::vector<State> states;
+    states.reserve(num_states);
+    for (unsigned long long i = 0; i != num_states; ++i) {
+        states.push_back(mdp.get_state(probfd::StateID(i)));
+    }
+
+    return states;
+}
+
+} // namespace
+
+PROBFD_BENCHMARK(
+    match_tree_construction,
+    "gripper_example.sas",
+    "pblocksworld_example.sas",
+    "test1.sas")
+{
+    auto task = load_task(state);
+    ProbabilisticTaskProxy task_proxy(*task);
+    SSPCostFunction cost_function(task_proxy);
+
+    const StateRankingFunction ranking_function(
+        task_proxy.get_variables(),
+        get_benchmark_pattern(task_proxy));
+
+    while (state.keep_running()) {
+        ProjectionStateSpace projection(
+            task_proxy,
+            cost_function,
+            ranking_function,
+            false);
+
+        state.add_counter("operators", task_proxy.get_operators().size());
+    }
+}
+
+PROBFD_BENCHMARK(
+    match_tree_lookup,
+    "gripper_example.sas",
+    "pblocksworld_example.sas",
+    "test1.sas")
+{
+    auto task = load_task(state);
+    ProbabilisticTaskProxy task_proxy(*task);
+    SSPCostFunction cost_function(task_proxy);
+
+    const StateRankingFunction ranking_function(
+        task_proxy.get_variables(),
+        get_benchmark_pattern(task_proxy));
+
+    ProjectionStateSpace projection(
+        task_proxy,
+        cost_function,
+        ranking_function,
+        false);
+
+    std::vector<const ProjectionOperator*> aops;
+
+    while (state.keep_running()) {
+        unsigned long long num_applicable = 0;
+
+        for (unsigned int s = 0; s != ranking_function.num_states(); ++s) {
+            aops.clear();
+            projection.generate_applicable_actions(StateRank(s), aops);
+            num_applicable += aops.size();
+        }
+
+        state.add_counter("states", ranking_function.num_states());
+        state.add_counter("operators", num_applicable);
+    }
+}
+
+PROBFD_BENCHMARK(
+    pdb_construction,
+    "gripper_example.sas",
+    "pblocksworld_example.sas",
+    "test1.sas")
+{
+    auto task = load_task(state);
+    ProbabilisticTaskProxy task_proxy(*task);
+    SSPCostFunction cost_function(task_proxy);
+
+    const Pattern pattern = get_benchmark_pattern(task_proxy);
+    const State initial_state = task_proxy.get_initial_state();
+
+    while (state.keep_running()) {
+        ProbabilityAwarePatternDatabase pdb(
+            task_proxy,
+            cost_function,
+            pattern,
+            initial_state);
+
+        state.add_counter("abstract_states", pdb.num_states());
+    }
+}
+
+PROBFD_BENCHMARK(
+    pdb_collection_evaluation,
+    "gripper_example.sas",
+    "pblocksworld_example.sas",
+    "test1.sas")
+{
+    auto task = load_task(state);
+    ProbabilisticTaskProxy task_proxy(*task);
+    auto cost_function = std::make_shared<SSPCostFunction>(task_proxy);
+
+    const PDBCollectionEvaluator evaluator =
+        create_benchmark_collection(task_proxy, *cost_function);
+
+    TaskStateSpace mdp(task, utils::get_silent_log(), cost_function);
+    const std::vector<State> states = get_reachable_states(mdp);
+
+    while (state.keep_running()) {
+        unsigned long long dead_ends = 0;
+        for (const State& s : states) {
+            if (evaluator.evaluate(s) == INFINITE_VALUE) ++dead_ends;
+        }
+
+        state.add_counter("states", states.size());
+        state.add_counter("dead_ends", dead_ends);
+    }
+}
+
+PROBFD_BENCHMARK(
+    pdb_collection_batch_evaluation,
+    "gripper_example.sas",
+    "pblocksworld_example.sas",
+    "test1.sas")
+{
+    auto task = load_task(state);
+    ProbabilisticTaskProxy task_proxy(*task);
+    auto cost_function = std::make_shared<SSPCostFunction>(task_proxy);
+
+    const PDBCollectionEvaluator evaluator =
+        create_benchmark_collection(task_proxy, *cost_function);
+
+    TaskStateSpace mdp(task, utils::get_silent_log(), cost_function);
+    const std::vector<State> states = get_reachable_states(mdp);
+
+    // Batches of the size of a typical set of successors.
+    constexpr std::size_t BATCH_SIZE = 16;
+
+    std::vector<const State*> state_ptrs;
+    for (const State& s : states) state_ptrs.push_back(&s);
+    std::vector<value_t> values(BATCH_SIZE);
+
+    while (state.keep_running()) {
+        unsigned long long dead_ends = 0;
+        for (std::size_t i = 0; i < states.size(); i += BATCH_SIZE) {
+            const std::size_t n = std::min(BATCH_SIZE, states.size() - i);
+            evaluator.evaluate(
+                std::span(state_ptrs).subspan(i, n),
+                std::span(values).first(n));
+            dead_ends += std::ranges::count(
+                std::span(values).first(n),
+                INFINITE_VALUE);
+        }
+
+        state.add_counter("states", states.size());
+        state.add_counter("dead_ends", dead_ends);
+    }
+}
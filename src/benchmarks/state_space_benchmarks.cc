@@ -0,0 +1,82 @@
+#include "benchmarks/benchmark.h"
+#include "benchmarks/utils.h"
+
+#include "probfd/caching_task_state_space.h"
+#include "probfd/ssp_cost_function.h"
+#include "probfd/task_proxy.h"
+#include "probfd/task_state_space.h"
+
+#include "downward/utils/logging.h"
+
+using namespace probfd;
+using namespace benchmarks;
+
+PROBFD_BENCHMARK(
+    task_state_space,
+    "gripper_example.sas",
+    "pblocksworld_example.sas",
+    "test1.sas")
+{
+    auto task = load_task(state);
+    auto cost_function =
+        std::make_shared<SSPCostFunction>(ProbabilisticTaskProxy(*task));
+
+    while (state.keep_running()) {
+        state.pause_timing();
+        TaskStateSpace mdp(task, utils::get_silent_log(), cost_function);
+        state.resume_timing();
+
+        unsigned long long transitions = 0;
+        const unsigned long long states =
+            explore_state_space(mdp, mdp.get_initial_state(), transitions);
+
+        state.add_counter("states", states);
+        state.add_counter("transitions", transitions);
+    }
+}
+
+PROBFD_BENCHMARK(
+    caching_task_state_space,
+    "gripper_example.sas",
+    "pblocksworld_example.sas",
+    "test1.sas")
+{
+    auto task = load_task(state);
+    auto cost_function =
+        std::make_shared<SSPCostFunction>(ProbabilisticTaskProxy(*task));
+
+    while (state.keep_running()) {
+        state.pause_timing();
+        CachingTaskStateSpace mdp(
+            task,
+            utils::get_silent_log(),
+            cost_function,
+            {});
+        state.resume_timing();
+
+        // The second exploration is served from the transition cache.
+        unsigned long long transitions = 0;
+        unsigned long long states = 0;
+        for (int i = 0; i != 2; ++i) {
+            states +=
+                explore_state_space(mdp, mdp.get_initial_state(), transitions);
+        }
+
+        state.add_counter("states", states);
+        state.add_counter("transitions", transitions);
+    }
+}
+
+PROBFD_BENCHMARK(synthetic_state_space, "10000", "100000")
+{
+    SyntheticMDP mdp = create_synthetic_mdp(state);
+
+    while (state.keep_running()) {
+        unsigned long long transitions = 0;
+        const unsigned long long states =
+            explore_state_space<int, int>(mdp, 0, transitions);
+
+        state.add_counter("states", states);
+        state.add_counter("transitions", transitions);
+    }
+}
@@ -0,0 +1,144 @@
+#include "benchmarks/synthetic_mdp.h"
+
+#include "probfd/distribution.h"
+#include "probfd/transition.h"
+
+#include "downward/utils/hash.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace benchmarks {
+
+using probfd::Distribution;
+using probfd::StateID;
+using probfd::Transition;
+using probfd::value_t;
+
+using probfd::INFINITE_VALUE;
+using probfd::operator""_vt;
+
+SyntheticMDP::SyntheticMDP(
+    int num_states,
+    int num_actions,
+    int num_outcomes,
+    int window,
+    std::uint64_t seed)
+    : num_states_(num_states)
+    , num_actions_(num_actions)
+    , num_outcomes_(num_outcomes)
+    , window_(window)
+    , seed_(seed)
+{
+    assert(num_states >= 2 && num_actions >= 2);
+    assert(num_outcomes >= 1 && window >= 1);
+}
+
+StateID SyntheticMDP::get_state_id(int state)
+{
+    return state;
+}
+
+int SyntheticMDP::get_state(StateID state_id)
+{
+    return static_cast<int>(state_id.id);
+}
+
+void SyntheticMDP::generate_applicable_actions(
+    int state,
+    std::vector<int>& result)
+{
+    if (is_goal(state)) return;
+
+    for (int action = 0; action != num_actions_; ++action) {
+        result.push_back(action);
+    }
+}
+
+void SyntheticMDP::generate_action_transitions(
+    int state,
+    int action,
+    Distribution<StateID>& result)
+{
+    const int last_state = num_states_ - 1;
+
+    if (action == num_actions_ - 1) {
+        result.add_probability(std::min(state ^ 1, last_state), 1_vt);
+        return;
+    }
+
+    const std::uint64_t progress_hash = get_hash(state, action, 0);
+    const int progress = state + 1 + static_cast<int>(progress_hash % window_);
+
+    // Outcome weights are in [4, 7] for the progress outcome and in [1, 4]
+    // otherwise, normalized afterwards.
+    result.add_probability(
+        std::min(progress, last_state),
+        static_cast<value_t>(4 + (progress_hash >> 32) % 4));
+
+    const int block_start = state - state % window_;
+
+    for (int outcome = 1; outcome != num_outcomes_; ++outcome) {
+        const std::uint64_t hash = get_hash(state, action, outcome);
+        const int successor = std::min(
+            block_start + static_cast<int>(hash % window_),
+            last_state);
+        result.add_probability(
+            successor,
+            static_cast<value_t>(1 + (hash >> 32) % 4));
+    }
+
+    result.normalize();
+}
+
+void SyntheticMDP::generate_all_transitions(
+    int state,
+    std::vector<int>& aops,
+    std::vector<Distribution<StateID>>& successors)
+{
+    generate_applicable_actions(state, aops);
+    successors.resize(aops.size());
+
+    for (size_t i = 0; i != aops.size(); ++i) {
+        generate_action_transitions(state, aops[i], successors[i]);
+    }
+}
+
+void SyntheticMDP::generate_all_transitions(
+    int state,
+    std::vector<Transition<int>>& transitions)
+{
+    if (is_goal(state)) return;
+
+    for (int action = 0; action != num_actions_; ++action) {
+        Transition<int>& t = transitions.emplace_back(action);
+        generate_action_transitions(state, action, t.successor_dist);
+    }
+}
+
+value_t SyntheticMDP::get_action_cost(int action)
+{
+    return static_cast<value_t>(1 + action % 3);
+}
+
+bool SyntheticMDP::is_goal(int state) const
+{
+    return state == num_states_ - 1;
+}
+
+value_t SyntheticMDP::get_non_goal_termination_cost() const
+{
+    return INFINITE_VALUE;
+}
+
+std::uint64_t SyntheticMDP::get_hash(int state, int action, int outcome) const
+{
+    utils::HashState hash_state;
+    utils::feed(hash_state, seed_);
+    utils::feed(hash_state, state);
+    utils::feed(hash_state, action);
+    utils::feed(hash_state, outcome);
+    return hash_state.get_hash64();
+}
+
+} // namespace benchmarks
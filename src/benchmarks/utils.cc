@@ -0,0 +1,43 @@
+#include "benchmarks/utils.h"
+
+#include "benchmarks/benchmark.h"
+
+#include "probfd/tasks/root_task.h"
+
+#include "probfd/task_proxy.h"
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace benchmarks {
+
+std::shared_ptr<probfd::ProbabilisticTask>
+load_task(const BenchmarkState& state)
+{
+    const std::filesystem::path path =
+        state.get_resource_path(state.get_argument());
+
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("could not open " + path.string());
+    }
+
+    std::shared_ptr<probfd::ProbabilisticTask> task =
+        probfd::tasks::read_sas_task(file);
+    probfd::tasks::set_root_task(task);
+
+    return task;
+}
+
+int get_int_argument(const BenchmarkState& state)
+{
+    return std::stoi(state.get_argument());
+}
+
+SyntheticMDP create_synthetic_mdp(const BenchmarkState& state)
+{
+    return SyntheticMDP(get_int_argument(state), 4, 3, 16, 42);
+}
+
+} // namespace benchmarks
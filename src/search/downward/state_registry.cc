@@ -7,12 +7,16 @@
 
 using namespace std;
 
-StateRegistry::StateRegistry(const TaskBaseProxy& task_proxy)
+StateRegistry::StateRegistry(
+    const TaskBaseProxy& task_proxy,
+    std::pmr::memory_resource* memory)
     : task_proxy(task_proxy)
     , state_packer(task_properties::g_state_packers[task_proxy])
     , axiom_evaluator(g_axiom_evaluators[task_proxy])
     , num_variables(task_proxy.get_variables().size())
-    , state_data_pool(get_bins_per_state())
+    , state_data_pool(
+          get_bins_per_state(),
+          std::pmr::polymorphic_allocator<PackedStateBin>(memory))
     , registered_states(
           StateIDSemanticHash(state_data_pool, get_bins_per_state()),
           StateIDSemanticEqual(state_data_pool, get_bins_per_state()))
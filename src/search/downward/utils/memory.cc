@@ -1,26 +1,51 @@
 #include "downward/utils/memory.h"
 
+#include <atomic>
 #include <cassert>
 #include <iostream>
+#include <mutex>
 
 using namespace std;
 
 namespace utils {
-static char* extra_memory_padding = nullptr;
-static bool has_gone_out_of_memory = false;
+/*
+  The padding may be queried by concurrent refinement loops and released
+  by the out-of-memory handler of any thread, so all accesses are
+  synchronized.
+*/
+static mutex extra_memory_padding_mutex;
+static atomic<char*> extra_memory_padding = nullptr;
+static atomic<bool> has_gone_out_of_memory = false;
 
 // Save standard out-of-memory handler.
 static void (*standard_out_of_memory_handler)() = nullptr;
 
+static void release_extra_memory_padding_locked()
+{
+    assert(extra_memory_padding);
+    delete[] extra_memory_padding.exchange(nullptr);
+    assert(standard_out_of_memory_handler);
+    set_new_handler(standard_out_of_memory_handler);
+}
+
 static void continuing_out_of_memory_handler()
 {
-    release_extra_memory_padding();
+    {
+        lock_guard lock(extra_memory_padding_mutex);
+        /*
+          Another thread may have released the padding after this thread
+          failed to allocate. The allocation is simply retried then.
+        */
+        if (!extra_memory_padding) return;
+        release_extra_memory_padding_locked();
+    }
     cout << "Failed to allocate memory. Released extra memory padding." << endl;
     has_gone_out_of_memory = true;
 }
 
 void reserve_extra_memory_padding(int memory_in_mb)
 {
+    lock_guard lock(extra_memory_padding_mutex);
     assert(!extra_memory_padding);
     extra_memory_padding = new char[memory_in_mb * 1024 * 1024];
     standard_out_of_memory_handler =
@@ -30,11 +55,8 @@ void reserve_extra_memory_padding(int memory_in_mb)
 
 void release_extra_memory_padding()
 {
-    assert(extra_memory_padding);
-    delete[] extra_memory_padding;
-    extra_memory_padding = nullptr;
-    assert(standard_out_of_memory_handler);
-    set_new_handler(standard_out_of_memory_handler);
+    lock_guard lock(extra_memory_padding_mutex);
+    release_extra_memory_padding_locked();
 }
 
 bool extra_memory_padding_is_reserved()
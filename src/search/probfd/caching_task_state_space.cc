@@ -30,12 +30,15 @@ CachingTaskStateSpace::CachingTaskStateSpace(
     std::shared_ptr<ProbabilisticTask> task,
     utils::LogProxy log,
     std::shared_ptr<FDRSimpleCostFunction> cost_function,
-    const std::vector<std::shared_ptr<::Evaluator>>& path_dependent_evaluators)
+    const std::vector<std::shared_ptr<::Evaluator>>& path_dependent_evaluators,
+    std::pmr::memory_resource* state_memory)
     : TaskStateSpace(
           std::move(task),
           std::move(log),
           std::move(cost_function),
-          path_dependent_evaluators)
+          path_dependent_evaluators,
+          state_memory)
+    , cache_data_(state_memory)
 {
 }
 
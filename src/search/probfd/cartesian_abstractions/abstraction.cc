@@ -122,6 +122,12 @@ value_t Abstraction::get_cost(int op_index) const
     return operator_costs_[op_index];
 }
 
+void Abstraction::set_operator_costs(std::vector<value_t> operator_costs)
+{
+    assert(operator_costs.size() == operator_costs_.size());
+    operator_costs_ = std::move(operator_costs);
+}
+
 const AbstractState& Abstraction::get_initial_state() const
 {
     return *states_[init_id_];
@@ -58,10 +58,10 @@ std::optional<Flaw> AdaptiveFlawGenerator::generate_flaw(
     return std::nullopt;
 }
 
-void AdaptiveFlawGenerator::notify_split()
+void AdaptiveFlawGenerator::notify_split(int v1_id, int v2_id)
 {
     for (size_t i = current_generator_; i != generators_.size(); ++i) {
-        generators_[i]->notify_split();
+        generators_[i]->notify_split(v1_id, v2_id);
     }
 }
 
@@ -37,6 +37,8 @@ namespace probfd::cartesian_abstractions {
 
 CEGARResult::~CEGARResult() = default;
 
+CEGARResult& CEGARResult::operator=(CEGARResult&&) noexcept = default;
+
 CEGAR::CEGAR(
     int max_states,
     int max_non_looping_transitions,
@@ -58,6 +60,15 @@ CEGAR::~CEGAR() = default;
 
 CEGARResult
 CEGAR::run_refinement_loop(const shared_ptr<ProbabilisticTask>& task)
+{
+    std::unique_ptr<SplitSelector> split_selector =
+        split_selector_factory_->create_split_selector(task);
+    return run_refinement_loop(task, *split_selector);
+}
+
+CEGARResult CEGAR::run_refinement_loop(
+    const shared_ptr<ProbabilisticTask>& task,
+    SplitSelector& split_selector)
 {
     if (log_.is_at_least_normal()) {
         log_ << "Start building abstraction." << endl;
@@ -72,8 +83,6 @@ CEGAR::run_refinement_loop(const shared_ptr<ProbabilisticTask>& task)
 
     std::unique_ptr<FlawGenerator> flaw_generator =
         flaw_generator_factory_->create_flaw_generator();
-    std::unique_ptr<SplitSelector> split_selector =
-        split_selector_factory_->create_split_selector(task);
 
     // Limit the time for building the abstraction.
     utils::CountdownTimer timer(max_time_);
@@ -138,7 +147,7 @@ CEGAR::run_refinement_loop(const shared_ptr<ProbabilisticTask>& task)
 
             refine_abstraction(
                 *flaw_generator,
-                *split_selector,
+                split_selector,
                 *refinement_hierarchy,
                 *abstraction,
                 *heuristic,
@@ -278,9 +287,13 @@ void CEGAR::refine_abstraction(
     const std::vector<int>& wanted)
 {
     int id = abstract_state.get_id();
-    abstraction.refine(refinement_hierarchy, abstract_state, split_var, wanted);
+    const auto [v1_id, v2_id] = abstraction.refine(
+        refinement_hierarchy,
+        abstract_state,
+        split_var,
+        wanted);
     heuristic.on_split(id);
-    flaw_generator.notify_split();
+    flaw_generator.notify_split(v1_id, v2_id);
 }
 
 } // namespace probfd::cartesian_abstractions
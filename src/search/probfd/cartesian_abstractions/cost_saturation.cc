@@ -4,13 +4,17 @@
 #include "probfd/cartesian_abstractions/cartesian_heuristic_function.h"
 #include "probfd/cartesian_abstractions/cegar.h"
 #include "probfd/cartesian_abstractions/distances.h"
+#include "probfd/cartesian_abstractions/evaluators.h"
 #include "probfd/cartesian_abstractions/probabilistic_transition_system.h"
+#include "probfd/cartesian_abstractions/split_selector.h"
 #include "probfd/cartesian_abstractions/subtask_generators.h"
 
 #include "probfd/task_utils/task_properties.h"
 
 #include "probfd/tasks/modified_operator_costs_task.h"
 
+#include "probfd/utils/thread_pool.h"
+
 #include "probfd/task_proxy.h"
 
 #include "downward/task_utils/task_properties.h"
@@ -19,9 +23,12 @@
 #include "downward/utils/memory.h"
 #include "downward/utils/timer.h"
 
+#include "downward/axioms.h"
 #include "downward/task_proxy.h"
 
+#include <algorithm>
 #include <cassert>
+#include <mutex>
 #include <ostream>
 #include <utility>
 
@@ -102,6 +109,7 @@ CostSaturation::CostSaturation(
     int max_non_looping_transitions,
     double max_time,
     bool use_general_costs,
+    int num_threads,
     utils::LogProxy log)
     : subtask_generators_(subtask_generators)
     , flaw_generator_factory_(std::move(flaw_generator_factory))
@@ -110,6 +118,7 @@ CostSaturation::CostSaturation(
     , max_non_looping_transitions_(max_non_looping_transitions)
     , max_time_(max_time)
     , use_general_costs_(use_general_costs)
+    , num_threads_(num_threads)
     , log_(std::move(log))
     , num_abstractions_(0)
     , num_states_(0)
@@ -148,7 +157,11 @@ vector<CartesianHeuristicFunction> CostSaturation::generate_heuristic_functions(
     for (const shared_ptr<SubtaskGenerator>& subtask_generator :
          subtask_generators_) {
         SharedTasks subtasks = subtask_generator->get_subtasks(task, log_);
-        build_abstractions(subtasks, timer, should_abort);
+        if (num_threads_ > 1 && subtasks.size() > 1) {
+            build_abstractions_concurrently(subtasks, timer, should_abort);
+        } else {
+            build_abstractions(subtasks, timer, should_abort);
+        }
         if (should_abort()) break;
     }
     if (utils::extra_memory_padding_is_reserved())
@@ -227,32 +240,169 @@ void CostSaturation::build_abstractions(
             split_selector_factory_,
             log_);
 
-        auto [refinement_hierarchy, abstraction, heuristic] =
-            cegar.run_refinement_loop(subtask);
+        CEGARResult result = cegar.run_refinement_loop(subtask);
+        add_abstraction(result, false);
 
-        ++num_abstractions_;
-        num_states_ += abstraction->get_num_states();
-        num_non_looping_transitions_ +=
-            abstraction->get_transition_system().get_num_non_loops();
-        assert(num_states_ <= max_states_);
+        if (should_abort()) break;
 
-        vector<value_t> goal_distances =
-            compute_distances(*abstraction, *heuristic);
-        vector<value_t> saturated_costs = compute_saturated_costs(
-            abstraction->get_transition_system(),
-            goal_distances,
-            use_general_costs_);
+        --rem_subtasks;
+    }
+}
 
-        heuristic_functions_.emplace_back(
-            std::move(refinement_hierarchy),
-            std::move(goal_distances));
+void CostSaturation::build_abstractions_concurrently(
+    const vector<shared_ptr<ProbabilisticTask>>& subtasks,
+    const utils::CountdownTimer& timer,
+    function<bool()> should_abort)
+{
+    const int num_subtasks = static_cast<int>(subtasks.size());
+    const unsigned num_threads = min<unsigned>(num_threads_, num_subtasks);
 
-        reduce_remaining_costs(saturated_costs);
+    const vector<value_t> refinement_costs = remaining_costs_;
 
-        if (should_abort()) break;
+    vector<shared_ptr<ProbabilisticTask>> cost_tasks;
+    for (shared_ptr<ProbabilisticTask> subtask : subtasks) {
+        cost_tasks.push_back(get_remaining_costs_task(subtask));
 
-        --rem_subtasks;
+        /*
+          The per-task information is created lazily and is not thread-safe,
+          so create the entries used during refinement up front.
+        */
+        TaskBaseProxy task_proxy(*cost_tasks.back());
+        ::task_properties::g_state_packers[task_proxy];
+        g_axiom_evaluators[task_proxy];
+    }
+
+    assert(num_states_ < max_states_);
+
+    /*
+      The state and transition limits are shared by the refinement loops.
+      When a loop starts, it reserves an equal share of the budget that is not
+      reserved by other loops, and when it finishes, it returns the unused
+      part of its share, so that the loops started later can use it. Unused
+      time is passed on in the same way, since it remains on the timer.
+    */
+    mutex budget_mutex;
+    int unreserved_states = max_states_ - num_states_;
+    int unreserved_transitions =
+        max_non_looping_transitions_ - num_non_looping_transitions_;
+    int num_unstarted = num_subtasks;
+
+    if (log_.is_at_least_normal()) {
+        log_ << "Refining " << num_subtasks << " abstractions with "
+             << num_threads << " threads." << endl;
+    }
+
+    /*
+      The split selectors are created up front and in subtask order, so
+      every refinement loop gets its own selector and random split choices do
+      not depend on the thread schedule.
+    */
+    vector<unique_ptr<SplitSelector>> split_selectors;
+    for (const shared_ptr<ProbabilisticTask>& cost_task : cost_tasks) {
+        split_selectors.push_back(
+            split_selector_factory_->create_independent_split_selector(
+                cost_task));
     }
+
+    vector<CEGARResult> results(num_subtasks);
+
+    ThreadPool pool(num_threads);
+    parallel_for(pool, num_subtasks, [&](size_t i) {
+        int max_states;
+        int max_non_looping_transitions;
+        double max_time;
+
+        {
+            lock_guard<mutex> lock(budget_mutex);
+            max_states = max(1, unreserved_states / num_unstarted);
+            max_non_looping_transitions =
+                max(1, unreserved_transitions / num_unstarted);
+            /*
+              The refinement loops measure the CPU time of the whole process,
+              which advances up to num_threads times faster than the
+              wall-clock time while all threads are busy. Scale the budget of
+              each loop accordingly, so that each remaining round of loops
+              gets its share of the remaining time.
+            */
+            const int num_rounds =
+                (num_unstarted + num_threads - 1) / num_threads;
+            max_time = timer.get_remaining_time() / num_rounds * num_threads;
+            unreserved_states -= max_states;
+            unreserved_transitions -= max_non_looping_transitions;
+            --num_unstarted;
+        }
+
+        // The refinement loops run silently, since their output would mix.
+        CEGAR cegar(
+            max_states,
+            max_non_looping_transitions,
+            max_time,
+            flaw_generator_factory_,
+            split_selector_factory_,
+            utils::get_silent_log());
+        results[i] =
+            cegar.run_refinement_loop(cost_tasks[i], *split_selectors[i]);
+
+        const Abstraction& abstraction = *results[i].abstraction;
+        lock_guard<mutex> lock(budget_mutex);
+        unreserved_states += max_states - abstraction.get_num_states();
+        unreserved_transitions +=
+            max_non_looping_transitions -
+            abstraction.get_transition_system().get_num_non_loops();
+    });
+
+    for (int i = 0; i != num_subtasks; ++i) {
+        /*
+          All abstractions were refined for the same costs, but the previous
+          abstractions may have consumed some of them in the meantime.
+        */
+        add_abstraction(results[i], remaining_costs_ != refinement_costs);
+
+        if (should_abort()) {
+            const int num_dropped = num_subtasks - i - 1;
+            if (num_dropped > 0 && log_.is_at_least_normal()) {
+                log_ << "Limits reached, dropping " << num_dropped << " of "
+                     << num_subtasks << " refined abstractions." << endl;
+            }
+            break;
+        }
+    }
+}
+
+void CostSaturation::add_abstraction(CEGARResult& result, bool reset_distances)
+{
+    auto& [refinement_hierarchy, abstraction, heuristic] = result;
+
+    ++num_abstractions_;
+    num_states_ += abstraction->get_num_states();
+    num_non_looping_transitions_ +=
+        abstraction->get_transition_system().get_num_non_loops();
+    assert(num_states_ <= max_states_);
+
+    if (reset_distances) {
+        /*
+          The goal distance estimates of the refinement loop are only lower
+          bounds for the costs the abstraction was refined for. Recompute the
+          goal distances from scratch for the remaining costs.
+        */
+        abstraction->set_operator_costs(remaining_costs_);
+        for (int i = 0; i != abstraction->get_num_states(); ++i) {
+            heuristic->set_h_value(i, 0_vt);
+        }
+    }
+
+    vector<value_t> goal_distances =
+        compute_distances(*abstraction, *heuristic);
+    vector<value_t> saturated_costs = compute_saturated_costs(
+        abstraction->get_transition_system(),
+        goal_distances,
+        use_general_costs_);
+
+    heuristic_functions_.emplace_back(
+        std::move(refinement_hierarchy),
+        std::move(goal_distances));
+
+    reduce_remaining_costs(saturated_costs);
 }
 
 void CostSaturation::print_statistics(utils::Duration init_time) const
@@ -4,6 +4,7 @@
 #include "probfd/cartesian_abstractions/abstraction.h"
 #include "probfd/cartesian_abstractions/evaluators.h"
 #include "probfd/cartesian_abstractions/probabilistic_transition.h"
+#include "probfd/cartesian_abstractions/probabilistic_transition_system.h"
 
 #include "probfd/algorithms/trap_aware_dfhs.h"
 
@@ -11,22 +12,26 @@
 
 #include "probfd/quotients/quotient_system.h"
 
+#include "probfd/utils/guards.h"
+
 #include "probfd/policy.h"
 #include "probfd/progress_report.h"
 #include "probfd/value_type.h"
 
 #include "downward/utils/countdown_timer.h"
 
+#include <algorithm>
 #include <optional>
 
 using namespace std;
 
 namespace probfd::cartesian_abstractions {
 
-ILAOPolicyGenerator::ILAOPolicyGenerator()
+ILAOPolicyGenerator::ILAOPolicyGenerator(bool incremental_distances)
     : picker_(new policy_pickers::ArbitraryTiebreaker<
               quotients::QuotientState<int, const ProbabilisticTransition*>,
               quotients::QuotientAction<const ProbabilisticTransition*>>(true))
+    , incremental_distances_(incremental_distances)
 {
 }
 
@@ -36,6 +41,10 @@ unique_ptr<Solution> ILAOPolicyGenerator::find_solution(
     CartesianHeuristic& heuristic,
     utils::CountdownTimer& timer)
 {
+    if (incremental_distances_) {
+        update_distances(abstraction, heuristic, timer);
+    }
+
     // TODO: ideally, this object should not be recreated each time, in
     // particular the storage for the search state. Needs some way to clear
     // the search state.
@@ -63,13 +72,123 @@ unique_ptr<Solution> ILAOPolicyGenerator::find_solution(
         report,
         timer.get_remaining_time());
 
-    for (int i = 0; i != abstraction.get_num_states(); ++i) {
-        if (hdfs.was_visited(i)) {
-            heuristic.set_h_value(i, hdfs.lookup_value(i));
+    if (!incremental_distances_) {
+        for (int i = 0; i != abstraction.get_num_states(); ++i) {
+            if (hdfs.was_visited(i)) {
+                heuristic.set_h_value(i, hdfs.lookup_value(i));
+            }
         }
+    } else if (policy) {
+        /*
+          The estimates are propagated by update_distances() after the next
+          split, so it suffices to store the values of the policy states
+          instead of scanning all abstract states.
+        */
+        policy->for_each_decision(
+            [&](const int& state_id,
+                const PolicyDecision<const ProbabilisticTransition*>&
+                    decision) {
+                const value_t h = heuristic.get_h_value(state_id);
+                heuristic.set_h_value(
+                    state_id,
+                    std::max(h, decision.q_value_interval.lower));
+            });
     }
 
     return policy;
 }
 
+void ILAOPolicyGenerator::notify_split(int v1_id, int v2_id)
+{
+    if (incremental_distances_) {
+        split_states_.push_back(v1_id);
+        split_states_.push_back(v2_id);
+    }
+}
+
+void ILAOPolicyGenerator::update_distances(
+    Abstraction& abstraction,
+    CartesianHeuristic& heuristic,
+    utils::CountdownTimer& timer)
+{
+    const ProbabilisticTransitionSystem& transition_system =
+        abstraction.get_transition_system();
+    const auto& outgoing = transition_system.get_outgoing_transitions();
+    const auto& incoming = transition_system.get_incoming_transitions();
+    const Goals& goals = abstraction.get_goals();
+
+    is_queued_.resize(abstraction.get_num_states(), false);
+
+    for (const int state_id : split_states_) {
+        enqueue(state_id);
+    }
+
+    split_states_.clear();
+
+    // Exception safety (timeout)
+    scope_exit guard([&] {
+        for (const int state_id : update_queue_) {
+            is_queued_[state_id] = false;
+        }
+        update_queue_.clear();
+    });
+
+    /*
+      A Bellman backup of an admissible estimate is admissible, so the
+      estimates stay lower bounds on the goal distances. They only increase,
+      hence the propagation terminates once no estimate increases by more
+      than epsilon.
+    */
+    while (!update_queue_.empty()) {
+        timer.throw_if_expired();
+
+        const int state_id = update_queue_.front();
+        update_queue_.pop_front();
+        is_queued_[state_id] = false;
+
+        if (goals.contains(state_id)) continue;
+
+        value_t best = abstraction.get_non_goal_termination_cost();
+
+        for (const ProbabilisticTransition* transition : outgoing[state_id]) {
+            const int op_id = transition->op_id;
+            value_t q_value = abstraction.get_cost(op_id);
+
+            for (size_t i = 0; i != transition->target_ids.size(); ++i) {
+                const value_t succ_h =
+                    heuristic.get_h_value(transition->target_ids[i]);
+                if (succ_h == INFINITE_VALUE) {
+                    q_value = INFINITE_VALUE;
+                    break;
+                }
+                const value_t probability =
+                    transition_system.get_probability(op_id, i);
+                q_value += probability * succ_h;
+            }
+
+            best = std::min(best, q_value);
+        }
+
+        const value_t old_h = heuristic.get_h_value(state_id);
+
+        if (best == INFINITE_VALUE ? old_h != INFINITE_VALUE
+                                   : is_approx_greater(best, old_h)) {
+            heuristic.set_h_value(state_id, best);
+
+            for (const ProbabilisticTransition* transition :
+                 incoming[state_id]) {
+                enqueue(transition->source_id);
+            }
+        }
+    }
+}
+
+void ILAOPolicyGenerator::enqueue(int state_id)
+{
+    if (!is_queued_[state_id]) {
+        is_queued_[state_id] = true;
+        update_queue_.push_back(state_id);
+    }
+}
+
 } // namespace probfd::cartesian_abstractions
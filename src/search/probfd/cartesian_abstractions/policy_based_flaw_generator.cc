@@ -101,8 +101,9 @@ std::optional<Flaw> PolicyBasedFlawGenerator::generate_flaw(
     return flaw;
 }
 
-void PolicyBasedFlawGenerator::notify_split()
+void PolicyBasedFlawGenerator::notify_split(int v1_id, int v2_id)
 {
+    policy_generator_->notify_split(v1_id, v2_id);
 }
 
 void PolicyBasedFlawGenerator::print_statistics(utils::LogProxy& log)
@@ -114,15 +115,18 @@ void PolicyBasedFlawGenerator::print_statistics(utils::LogProxy& log)
     }
 }
 
-ILAOFlawGeneratorFactory::ILAOFlawGeneratorFactory(int max_search_states)
+ILAOFlawGeneratorFactory::ILAOFlawGeneratorFactory(
+    int max_search_states,
+    bool incremental_distances)
     : max_search_states_(max_search_states)
+    , incremental_distances_(incremental_distances)
 {
 }
 
 std::unique_ptr<FlawGenerator> ILAOFlawGeneratorFactory::create_flaw_generator()
 {
     return std::make_unique<PolicyBasedFlawGenerator>(
-        new ILAOPolicyGenerator(),
+        new ILAOPolicyGenerator(incremental_distances_),
         new CompletePolicyFlawFinder(max_search_states_));
 }
 
@@ -140,6 +144,14 @@ public:
             "search before giving up",
             "infinity",
             plugins::Bounds("1", "infinity"));
+        add_option<bool>(
+            "incremental_distances",
+            "update the goal distance estimates incrementally after each "
+            "split, starting from the two new abstract states and visiting "
+            "only the states whose estimates increase. ILAO* then starts from "
+            "these estimates and no longer scans all abstract states to store "
+            "its results.",
+            "false");
     }
 
     [[nodiscard]]
@@ -148,7 +160,8 @@ public:
         const override
     {
         return make_shared<ILAOFlawGeneratorFactory>(
-            opts.get<int>("max_search_states"));
+            opts.get<int>("max_search_states"),
+            opts.get<bool>("incremental_distances"));
     }
 };
 
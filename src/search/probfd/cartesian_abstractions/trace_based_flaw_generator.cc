@@ -145,7 +145,7 @@ optional<Flaw> TraceBasedFlawGenerator::find_flaw(
         get_cartesian_set(domain_sizes, task_proxy.get_goals()));
 }
 
-void TraceBasedFlawGenerator::notify_split()
+void TraceBasedFlawGenerator::notify_split(int, int)
 {
     trace_generator_->notify_split();
 }
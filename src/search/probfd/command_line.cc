@@ -212,8 +212,11 @@ string usage(const string& progname)
     return "usage: \n" + progname +
            " [OPTIONS] --search SEARCH < OUTPUT\n\n"
            "* SEARCH (SearchAlgorithm): configuration of the search algorithm\n"
-           "* OUTPUT (filename): translator output\n\n"
+           "* OUTPUT (filename): translator output or binary task\n\n"
            "Options:\n"
+           "--write-binary-task FILE\n"
+           "    Converts the translator output to the binary task format,\n"
+           "    writes it to FILE and exits. Must be the only option.\n"
            "--maxprob\n"
            "    Use the MaxProb cost model, specifying a termination cost\n"
            "    of -1 for goal states and 0 otherwise, an no action costs.\n"
@@ -29,7 +29,8 @@ static vector<CartesianHeuristicFunction> generate_heuristic_functions(
     int max_states,
     int max_transitions,
     double max_time,
-    bool use_general_costs)
+    bool use_general_costs,
+    int num_threads)
 {
     if (log.is_at_least_normal()) {
         log << "Initializing additive Cartesian heuristic..." << endl;
@@ -43,6 +44,7 @@ static vector<CartesianHeuristicFunction> generate_heuristic_functions(
         max_transitions,
         max_time,
         use_general_costs,
+        num_threads,
         log);
 
     return cost_saturation.generate_heuristic_functions(task);
@@ -57,7 +59,8 @@ AdditiveCartesianHeuristic::AdditiveCartesianHeuristic(
     int max_states,
     int max_transitions,
     double max_time,
-    bool use_general_costs)
+    bool use_general_costs,
+    int num_threads)
     : TaskDependentHeuristic(std::move(task), std::move(log))
     , heuristic_functions_(generate_heuristic_functions(
           this->task_,
@@ -68,7 +71,8 @@ AdditiveCartesianHeuristic::AdditiveCartesianHeuristic(
           max_states,
           max_transitions,
           max_time,
-          use_general_costs))
+          use_general_costs,
+          num_threads))
 {
 }
 
@@ -99,6 +103,7 @@ class AdditiveCartesianHeuristicFactory : public TaskEvaluatorFactory {
     const int max_transitions;
     const double max_time;
     const bool use_general_costs;
+    const int num_threads;
 
 public:
     explicit AdditiveCartesianHeuristicFactory(const plugins::Options& opts);
@@ -121,6 +126,7 @@ AdditiveCartesianHeuristicFactory::AdditiveCartesianHeuristicFactory(
     , max_transitions(opts.get<int>("max_transitions"))
     , max_time(opts.get<double>("max_time"))
     , use_general_costs(opts.get<bool>("use_general_costs"))
+    , num_threads(opts.get<int>("threads"))
 {
 }
 
@@ -138,7 +144,8 @@ AdditiveCartesianHeuristicFactory::create_evaluator(
         max_states,
         max_transitions,
         max_time,
-        use_general_costs);
+        use_general_costs,
+        num_threads);
 }
 
 class AdditiveCartesianHeuristicFactoryFeature
@@ -185,6 +192,19 @@ public:
             "use_general_costs",
             "allow negative costs in cost partitioning",
             "true");
+        add_option<int>(
+            "threads",
+            "Number of threads used to refine the abstractions of the "
+            "subtasks of one subtask generator concurrently. The abstractions "
+            "are refined for the same costs and saturated in order afterwards, "
+            "which keeps the heuristic admissible. With more than one thread, "
+            "the output of the refinement loops is suppressed. The max_time "
+            "limit measures the CPU time summed over all threads. The "
+            "concurrent refinement loops are given a proportionally larger "
+            "CPU time budget, so the overall wall-clock limit is the same as "
+            "for a single thread.",
+            "1",
+            plugins::Bounds("1", "infinity"));
         TaskDependentHeuristic::add_options_to_feature(*this);
 
         document_language_support("action costs", "supported");
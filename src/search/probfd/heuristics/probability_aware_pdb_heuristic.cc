@@ -2,6 +2,8 @@
 
 #include "probfd/pdbs/pattern_collection_generator.h"
 #include "probfd/pdbs/pattern_collection_information.h"
+#include "probfd/pdbs/pdb_cache.h"
+#include "probfd/pdbs/pdb_collection_evaluator.h"
 #include "probfd/pdbs/probability_aware_pattern_database.h"
 
 #include "probfd/cost_function.h"
@@ -14,6 +16,7 @@
 #include "downward/plugins/plugin.h"
 
 #include <algorithm>
+#include <string>
 
 using namespace probfd::pdbs;
 
@@ -24,6 +27,9 @@ ProbabilityAwarePDBHeuristic::ProbabilityAwarePDBHeuristic(
     std::shared_ptr<FDRCostFunction> task_cost_function,
     std::shared_ptr<PatternCollectionGenerator> generator,
     double max_time_dominance_pruning,
+    unsigned num_threads,
+    std::shared_ptr<PDBCache> cache,
+    ValueTableEncoding value_encoding,
     utils::LogProxy log)
     : TaskDependentHeuristic(std::move(task), std::move(log))
     , termination_cost_(task_cost_function->get_non_goal_termination_cost())
@@ -38,7 +44,11 @@ ProbabilityAwarePDBHeuristic::ProbabilityAwarePDBHeuristic(
     std::shared_ptr<std::vector<pdbs::Pattern>> patterns =
         pattern_collection_info.get_patterns();
 
-    this->pdbs_ = pattern_collection_info.get_pdbs();
+    this->pdbs_ = pattern_collection_info.get_pdbs(num_threads, cache.get());
+
+    for (const auto& pdb : *pdbs_) {
+        pdb->compress(value_encoding);
+    }
     this->subcollections_ = pattern_collection_info.get_subcollections();
     this->subcollection_finder_ =
         pattern_collection_info.get_subcollection_finder();
@@ -59,6 +69,12 @@ ProbabilityAwarePDBHeuristic::ProbabilityAwarePDBHeuristic(
         dominance_pruning_time = timer();
     }
 
+    collection_evaluator_ = std::make_unique<PDBCollectionEvaluator>(
+        pdbs_,
+        subcollections_,
+        subcollection_finder_,
+        termination_cost_);
+
     if (log_.is_at_least_normal()) {
         // Gather statistics.
         const double construction_time = construction_timer();
@@ -66,12 +82,14 @@ ProbabilityAwarePDBHeuristic::ProbabilityAwarePDBHeuristic(
         size_t largest_pattern = 0;
         size_t variables = 0;
         size_t abstract_states = 0;
+        size_t lookup_table_bytes = 0;
 
         for (const auto& pdb : *pdbs_) {
             size_t vars = pdb->get_pattern().size();
             largest_pattern = std::max(largest_pattern, vars);
             variables += vars;
             abstract_states += pdb->num_states();
+            lookup_table_bytes += pdb->get_memory_usage();
         }
 
         size_t total_subcollections_size = 0;
@@ -95,6 +113,8 @@ ProbabilityAwarePDBHeuristic::ProbabilityAwarePDBHeuristic(
              << "  Total number of PDBs: " << pdbs_->size() << "\n"
              << "  Total number of variables: " << variables << "\n"
              << "  Total number of abstract states: " << abstract_states << "\n"
+             << "  Total size of lookup tables: " << lookup_table_bytes
+             << " bytes\n"
              << "  Average number of variables per PDB: " << avg_variables
              << "\n"
              << "  Average number of abstract states per PDB: "
@@ -115,10 +135,18 @@ ProbabilityAwarePDBHeuristic::ProbabilityAwarePDBHeuristic(
     }
 }
 
+ProbabilityAwarePDBHeuristic::~ProbabilityAwarePDBHeuristic() = default;
+
 value_t ProbabilityAwarePDBHeuristic::evaluate(const State& state) const
 {
-    return subcollection_finder_
-        ->evaluate(*pdbs_, *subcollections_, state, termination_cost_);
+    return collection_evaluator_->evaluate(state);
+}
+
+void ProbabilityAwarePDBHeuristic::evaluate_batch(
+    std::span<const State* const> states,
+    std::span<value_t> values) const
+{
+    collection_evaluator_->evaluate(states, values);
 }
 
 namespace {
@@ -126,6 +154,9 @@ namespace {
 class ProbabilityAwarePDBHeuristicFactory : public TaskEvaluatorFactory {
     const std::shared_ptr<PatternCollectionGenerator> patterns_;
     const double time_dominance_pruning_;
+    const unsigned num_threads_;
+    const std::shared_ptr<PDBCache> cache_;
+    const ValueTableEncoding value_encoding_;
     const utils::LogProxy log_;
 
 public:
@@ -141,6 +172,12 @@ ProbabilityAwarePDBHeuristicFactory::ProbabilityAwarePDBHeuristicFactory(
     : patterns_(
           opts.get<std::shared_ptr<PatternCollectionGenerator>>("patterns"))
     , time_dominance_pruning_(opts.get<double>("max_time_dominance_pruning"))
+    , num_threads_(opts.get<int>("threads"))
+    , cache_(
+          opts.get<std::string>("cache_dir").empty()
+              ? nullptr
+              : std::make_shared<PDBCache>(opts.get<std::string>("cache_dir")))
+    , value_encoding_(opts.get<ValueTableEncoding>("value_encoding"))
     , log_(utils::get_log_from_options(opts))
 {
 }
@@ -155,6 +192,9 @@ ProbabilityAwarePDBHeuristicFactory::create_evaluator(
         task_cost_function,
         patterns_,
         time_dominance_pruning_,
+        num_threads_,
+        cache_,
+        value_encoding_,
         log_);
 }
 
@@ -185,6 +225,27 @@ public:
             "",
             "classical_generator(generator=systematic(pattern_max_size=2))");
         add_option<double>("max_time_dominance_pruning", "", "0.0");
+        add_option<int>(
+            "threads",
+            "Number of threads used to compute the PDBs of independent "
+            "patterns concurrently.",
+            "1",
+            plugins::Bounds("1", "infinity"));
+        add_option<ValueTableEncoding>(
+            "value_encoding",
+            "Storage format of the PDB lookup tables. The double and dictionary "
+            "formats are exact, unless dictionary falls back to quantized16. "
+            "The lossy formats float and quantized16 round the values down, "
+            "so the heuristic remains admissible, but is not necessarily "
+            "consistent.",
+            "double");
+        add_option<std::string>(
+            "cache_dir",
+            "Directory of an on-disk cache for the PDB lookup tables. If "
+            "non-empty, the lookup tables are loaded from this directory if "
+            "they were computed before for the same projection, and are "
+            "stored in it otherwise.",
+            "\"\"");
     }
 };
 
@@ -0,0 +1,220 @@
+#include "probfd/heuristics/stored_value_heuristic.h"
+
+#include "probfd/storage/value_file.h"
+
+#include "probfd/task_evaluator_factory.h"
+#include "probfd/task_proxy.h"
+
+#include "downward/task_utils/task_properties.h"
+
+#include "downward/utils/logging.h"
+
+#include "downward/plugins/options.h"
+#include "downward/plugins/plugin.h"
+
+#include "downward/state_registry.h"
+#include "downward/task_proxy.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <utility>
+
+namespace probfd::heuristics {
+
+StoredValueHeuristic::StoredValueHeuristic(
+    std::shared_ptr<storage::ValueFile> value_file,
+    std::unique_ptr<FDREvaluator> heuristic,
+    const int_packer::IntPacker& state_packer)
+    : value_file_(std::move(value_file))
+    , heuristic_(std::move(heuristic))
+    , state_packer_(state_packer)
+    , packed_buffer_(state_packer.get_num_bins())
+{
+}
+
+StoredValueHeuristic::~StoredValueHeuristic() = default;
+
+value_t StoredValueHeuristic::evaluate(const State& state) const
+{
+    return combine(state, heuristic_->evaluate(state));
+}
+
+void StoredValueHeuristic::evaluate_batch(
+    std::span<const State* const> states,
+    std::span<value_t> values) const
+{
+    assert(states.size() == values.size());
+    heuristic_->evaluate_batch(states, values);
+
+    for (std::size_t i = 0; i != states.size(); ++i) {
+        values[i] = combine(*states[i], values[i]);
+    }
+}
+
+void StoredValueHeuristic::print_statistics() const
+{
+    std::cout << "  Stored values: " << value_file_->size() << std::endl;
+    std::cout << "  Evaluations with stored value: " << num_stored_values_
+              << " of " << num_lookups_ << std::endl;
+    heuristic_->print_statistics();
+}
+
+value_t StoredValueHeuristic::combine(const State& state, value_t estimate)
+    const
+{
+    ++num_lookups_;
+
+    const StateRegistry* registry = state.get_registry();
+    const Bin* packed_state;
+
+    if (registry && &registry->get_state_packer() == &state_packer_) {
+        packed_state = state.get_buffer();
+    } else {
+        state.unpack();
+        const std::vector<int>& values = state.get_unpacked_values();
+        for (std::size_t var = 0; var != values.size(); ++var) {
+            state_packer_.set(packed_buffer_.data(), var, values[var]);
+        }
+        packed_state = packed_buffer_.data();
+    }
+
+    const Interval* stored = value_file_->lookup(packed_state);
+    if (!stored) return estimate;
+
+    ++num_stored_values_;
+    return std::max(estimate, stored->lower);
+}
+
+bool can_use_stored_values(
+    const storage::ValueFile& value_file,
+    const ProbabilisticTask& task,
+    FDRCostFunction& cost_function,
+    bool require_same_task,
+    utils::LogProxy& log)
+{
+    if (!value_file.has_same_variables(task)) {
+        if (log.is_warning()) {
+            log << "The value file was written for a task with different "
+                   "variables and is ignored."
+                << std::endl;
+        }
+        return false;
+    }
+
+    if (value_file.get_task_fingerprint() ==
+        storage::compute_task_fingerprint(task, cost_function)) {
+        return true;
+    }
+
+    if (require_same_task) {
+        if (log.is_warning()) {
+            log << "The value file was written for a task with different "
+                   "transitions or costs and is ignored."
+                << std::endl;
+        }
+        return false;
+    }
+
+    if (log.is_warning()) {
+        log << "The value file was written for a task with different "
+               "transitions or costs. The stored values may be "
+               "inadmissible."
+            << std::endl;
+    }
+
+    return true;
+}
+
+namespace {
+
+class StoredValueHeuristicFactory : public TaskEvaluatorFactory {
+    const std::shared_ptr<storage::ValueFile> value_file_;
+    const std::shared_ptr<TaskEvaluatorFactory> heuristic_factory_;
+    const bool require_same_task_;
+    utils::LogProxy log_;
+
+public:
+    explicit StoredValueHeuristicFactory(const plugins::Options& opts);
+
+    std::unique_ptr<FDREvaluator> create_evaluator(
+        std::shared_ptr<ProbabilisticTask> task,
+        std::shared_ptr<FDRCostFunction> task_cost_function) override;
+};
+
+StoredValueHeuristicFactory::StoredValueHeuristicFactory(
+    const plugins::Options& opts)
+    : value_file_(std::make_shared<storage::ValueFile>(
+          opts.get<std::string>("file")))
+    , heuristic_factory_(
+          opts.get<std::shared_ptr<TaskEvaluatorFactory>>("eval"))
+    , require_same_task_(opts.get<bool>("require_same_task"))
+    , log_(utils::get_log_from_options(opts))
+{
+}
+
+std::unique_ptr<FDREvaluator> StoredValueHeuristicFactory::create_evaluator(
+    std::shared_ptr<ProbabilisticTask> task,
+    std::shared_ptr<FDRCostFunction> task_cost_function)
+{
+    auto heuristic =
+        heuristic_factory_->create_evaluator(task, task_cost_function);
+
+    if (!can_use_stored_values(
+            *value_file_,
+            *task,
+            *task_cost_function,
+            require_same_task_,
+            log_)) {
+        return heuristic;
+    }
+
+    return std::make_unique<StoredValueHeuristic>(
+        value_file_,
+        std::move(heuristic),
+        task_properties::g_state_packers[ProbabilisticTaskProxy(*task)]);
+}
+
+class StoredValueHeuristicFactoryFeature
+    : public plugins::
+          TypedFeature<TaskEvaluatorFactory, StoredValueHeuristicFactory> {
+public:
+    StoredValueHeuristicFactoryFeature()
+        : TypedFeature("init_values")
+    {
+        document_title("Stored state values");
+        document_synopsis(
+            "Initializes the state values with the values stored in a value "
+            "file written by a previous solver run (see the option "
+            "value_file of the MDP solvers). The maximum of the stored lower "
+            "bound and the estimate of the underlying heuristic is returned "
+            "for stored states.");
+
+        document_property(
+            "admissible",
+            "yes, if the underlying heuristic is admissible and the value file "
+            "was written for the same task (up to the initial state)");
+        document_property("consistent", "no");
+        document_property("safe", "if the underlying heuristic is safe");
+
+        add_option<std::string>("file", "The value file.");
+        add_option<std::shared_ptr<TaskEvaluatorFactory>>(
+            "eval",
+            "The heuristic used for states without a stored value.",
+            "blind_eval()");
+        add_option<bool>(
+            "require_same_task",
+            "Ignore the value file if it was written for a task with different "
+            "transitions or costs, since the stored values are not "
+            "necessarily admissible for the current task in this case.",
+            "true");
+        utils::add_log_options_to_feature(*this);
+    }
+};
+
+} // namespace
+
+static plugins::FeaturePlugin<StoredValueHeuristicFactoryFeature> _plugin;
+
+} // namespace probfd::heuristics
@@ -9,6 +9,7 @@
 #include "probfd/pdbs/projection_state_space.h"
 #include "probfd/pdbs/projection_transformation.h"
 #include "probfd/pdbs/utils.h"
+#include "probfd/pdbs/value_table.h"
 
 #include "probfd/multi_policy.h"
 #include "probfd/task_proxy.h"
@@ -222,7 +223,7 @@ void SingleCEGAR::refine(
     }
 
     // compute new solution
-    std::vector<value_t> prev_distances = std::move(distances);
+    const ValueTable prev_distances(std::move(distances));
 
     transformation = ProjectionTransformation(
         task_proxy,
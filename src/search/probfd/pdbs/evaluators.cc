@@ -70,7 +70,7 @@ value_t DeadendPDBEvaluator::evaluate(StateRank state) const
 }
 
 IncrementalPPDBEvaluator::IncrementalPPDBEvaluator(
-    const std::vector<value_t>& value_table,
+    const ValueTable& value_table,
     const StateRankingFunction& mapper,
     int add_var)
     : value_table_(value_table)
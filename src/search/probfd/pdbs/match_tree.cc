@@ -11,7 +11,6 @@
 
 #include <cassert>
 #include <ostream>
-#include <stack>
 #include <utility>
 
 using namespace std;
@@ -69,6 +68,8 @@ void MatchTree::insert(
     const vector<FactPair>& progression_preconditions,
     bool operator_pruning)
 {
+    assert(nodes_.empty());
+
     std::unique_ptr<Node>* node = &root_;
     auto precondition_it = progression_preconditions.begin();
     const auto precondition_end = progression_preconditions.end();
@@ -131,121 +132,153 @@ void MatchTree::insert(
     projection_operators_.push_back(std::move(op));
 }
 
-void MatchTree::get_applicable_operators(
-    StateRank abstract_state_rank,
-    vector<const ProjectionOperator*>& operator_ids) const
+void MatchTree::finalize()
 {
+    assert(nodes_.empty());
+
     if (!root_) return;
 
-    assert(nodes_.empty());
-    nodes_.push(root_.get());
+    std::vector<ProjectionOperator> operators;
+    operators.reserve(projection_operators_.size());
 
-    while (!nodes_.empty()) {
-        Node* node = nodes_.top();
-        nodes_.pop();
+    // The nodes in breadth-first order. The position of a node is its ID.
+    std::vector<const Node*> queue;
+    queue.push_back(root_.get());
 
+    for (size_t i = 0; i != queue.size(); ++i) {
+        const Node* node = queue[i];
+        FlatNode& flat_node = nodes_.emplace_back();
+
+        flat_node.operators_begin = static_cast<uint32_t>(operators.size());
         for (size_t op_index : node->applicable_operator_ids) {
-            operator_ids.push_back(projection_operators_.data() + op_index);
+            operators.push_back(std::move(projection_operators_[op_index]));
         }
+        flat_node.operators_end = static_cast<uint32_t>(operators.size());
 
         if (node->is_leaf_node()) continue;
 
-        int temp = abstract_state_rank / node->var_multiplier;
-        int val = temp % node->var_domain_size;
+        flat_node.var_id = node->var_id;
+        flat_node.var_multiplier = node->var_multiplier;
+        flat_node.var_domain_size = node->var_domain_size;
+        flat_node.first_edge = static_cast<uint32_t>(edges_.size());
 
-        if (node->star_successor) {
-            // Always follow the star edge, if it exists.
-            nodes_.push(node->star_successor.get());
+        for (const auto& successor : node->successors) {
+            if (successor) {
+                edges_.push_back(static_cast<NodeID>(queue.size()));
+                queue.push_back(successor.get());
+            } else {
+                edges_.push_back(NO_NODE);
+            }
         }
 
-        if (node->successors[val]) {
-            // Follow the correct successor edge, if it exists.
-            nodes_.push(node->successors[val].get());
+        if (node->star_successor) {
+            flat_node.star_successor = static_cast<NodeID>(queue.size());
+            queue.push_back(node->star_successor.get());
         }
     }
+
+    assert(operators.size() == projection_operators_.size());
+
+    projection_operators_ = std::move(operators);
+    root_.reset();
 }
 
-void MatchTree::generate_all_transitions(
+template <typename F>
+void MatchTree::for_each_applicable(
+    NodeID node_id,
     StateRank abstract_state_rank,
-    std::vector<Transition<const ProjectionOperator*>>& transitions,
-    ProjectionStateSpace& state_space) const
+    F& f) const
 {
-    if (!root_) return;
+    do {
+        const FlatNode& node = nodes_[node_id];
 
-    /*
-      Note: different from the code that builds the match tree, we do
-      the test if node == 0 *before* calling traverse rather than *at
-      the start* of traverse since this turned out to be faster in
-      some informal experiments.
-     */
+        for (uint32_t i = node.operators_begin; i != node.operators_end; ++i) {
+            f(projection_operators_.data() + i);
+        }
 
-    assert(nodes_.empty());
-    nodes_.push(root_.get());
+        if (node.var_domain_size == 0) return;
 
-    while (!nodes_.empty()) {
-        Node* node = nodes_.top();
-        nodes_.pop();
+        int temp = abstract_state_rank / node.var_multiplier;
+        int val = temp % node.var_domain_size;
 
-        for (size_t op_index : node->applicable_operator_ids) {
-            auto* op = projection_operators_.data() + op_index;
-            auto& t = transitions.emplace_back(op);
-            state_space.generate_action_transitions(
-                abstract_state_rank,
-                op,
-                t.successor_dist);
+        const NodeID successor = edges_[node.first_edge + val];
+
+        if (successor != NO_NODE) {
+            // Follow the correct successor edge, if it exists.
+            for_each_applicable(successor, abstract_state_rank, f);
         }
 
-        if (node->is_leaf_node()) continue;
+        // Always follow the star edge, if it exists.
+        node_id = node.star_successor;
+    } while (node_id != NO_NODE);
+}
 
-        int temp = abstract_state_rank / node->var_multiplier;
-        int val = temp % node->var_domain_size;
+void MatchTree::get_applicable_operators(
+    StateRank abstract_state_rank,
+    vector<const ProjectionOperator*>& operator_ids) const
+{
+    assert(!root_);
 
-        if (node->star_successor) {
-            // Always follow the star edge, if it exists.
-            nodes_.push(node->star_successor.get());
-        }
+    if (nodes_.empty()) return;
 
-        if (node->successors[val]) {
-            // Follow the correct successor edge, if it exists.
-            nodes_.push(node->successors[val].get());
-        }
-    }
+    auto add_operator = [&](const ProjectionOperator* op) {
+        operator_ids.push_back(op);
+    };
+
+    for_each_applicable(0, abstract_state_rank, add_operator);
 }
 
-void MatchTree::dump_recursive(std::ostream& out, Node* node) const
+void MatchTree::generate_all_transitions(
+    StateRank abstract_state_rank,
+    std::vector<Transition<const ProjectionOperator*>>& transitions,
+    ProjectionStateSpace& state_space) const
 {
-    if (!node) {
-        // Node is the root node.
-        out << "Empty MatchTree" << endl;
-        return;
-    }
+    assert(!root_);
+
+    if (nodes_.empty()) return;
+
+    auto add_transition = [&](const ProjectionOperator* op) {
+        auto& t = transitions.emplace_back(op);
+        state_space.generate_action_transitions(
+            abstract_state_rank,
+            op,
+            t.successor_dist);
+    };
+
+    for_each_applicable(0, abstract_state_rank, add_transition);
+}
+
+void MatchTree::dump_recursive(std::ostream& out, NodeID node_id) const
+{
+    const FlatNode& node = nodes_[node_id];
+
     out << endl;
-    out << "node->var_id = " << node->var_id << endl;
+    out << "node->var_id = " << node.var_id << endl;
     out << "Number of applicable operators at this node: "
-        << node->applicable_operator_ids.size() << endl;
-    for (const size_t op_index : node->applicable_operator_ids) {
-        out << "ProjectionOperator #" << op_index << endl;
+        << node.operators_end - node.operators_begin << endl;
+    for (uint32_t i = node.operators_begin; i != node.operators_end; ++i) {
+        out << "ProjectionOperator #" << i << endl;
     }
-    if (node->is_leaf_node()) {
+    if (node.var_domain_size == 0) {
         out << "leaf node." << endl;
-        assert(node->successors.empty());
-        assert(!node->star_successor);
+        assert(node.star_successor == NO_NODE);
     } else {
-        for (int val = 0; val < node->var_domain_size; ++val) {
-            if (node->successors[val]) {
+        for (int val = 0; val < node.var_domain_size; ++val) {
+            const NodeID successor = edges_[node.first_edge + val];
+            if (successor != NO_NODE) {
                 out << "recursive call for child with value " << val << endl;
-                dump_recursive(out, node->successors[val].get());
+                dump_recursive(out, successor);
                 out << "back from recursive call (for successors[" << val
-                    << "]) to node with var_id = " << node->var_id << endl;
+                    << "]) to node with var_id = " << node.var_id << endl;
             } else {
                 out << "no child for value " << val << endl;
             }
         }
-        if (node->star_successor) {
+        if (node.star_successor != NO_NODE) {
             out << "recursive call for star_successor" << endl;
-            dump_recursive(out, node->star_successor.get());
+            dump_recursive(out, node.star_successor);
             out << "back from recursive call (for star_successor) "
-                << "to node with var_id = " << node->var_id << endl;
+                << "to node with var_id = " << node.var_id << endl;
         } else {
             out << "no star_successor" << endl;
         }
@@ -254,7 +287,12 @@ void MatchTree::dump_recursive(std::ostream& out, Node* node) const
 
 void MatchTree::dump(std::ostream& out) const
 {
-    dump_recursive(out, root_.get());
+    if (nodes_.empty()) {
+        out << "Empty MatchTree" << endl;
+        return;
+    }
+
+    dump_recursive(out, 0);
 }
 
 } // namespace probfd::pdbs
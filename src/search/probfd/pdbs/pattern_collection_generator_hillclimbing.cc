@@ -1,8 +1,10 @@
 #include "probfd/pdbs/pattern_collection_generator_hillclimbing.h"
 
 #include "probfd/pdbs/pattern_collection_information.h"
+#include "probfd/pdbs/pdb_cache.h"
 #include "probfd/pdbs/probability_aware_pattern_database.h"
 #include "probfd/pdbs/subcollection_finder_factory.h"
+#include "probfd/pdbs/utils.h"
 
 #include "probfd/cost_function.h"
 #include "probfd/task_proxy.h"
@@ -11,6 +13,8 @@
 #include "probfd/task_utils/sampling.h"
 #include "probfd/task_utils/task_properties.h"
 
+#include "probfd/utils/thread_pool.h"
+
 #include "downward/algorithms/dynamic_bitset.h"
 
 #include "downward/utils/collections.h"
@@ -26,6 +30,8 @@
 #include <cassert>
 #include <iostream>
 #include <iterator>
+#include <limits>
+#include <string>
 #include <utility>
 
 using namespace utils;
@@ -44,17 +50,41 @@ static std::vector<int> get_goal_variables(const TaskBaseProxy& task_proxy)
     return goal_vars;
 }
 
-static unsigned long long compute_total_pdb_size(const PPDBCollection& pdbs)
+/*
+  The size of a PDB is measured in multiples of the size of an uncompressed
+  lookup table entry, so that compressed PDBs take up proportionally less of
+  the collection size limit.
+*/
+static long long get_pdb_size(const ProbabilityAwarePatternDatabase& pdb)
 {
-    unsigned long long size = 0;
+    return static_cast<long long>(
+        (pdb.get_memory_usage() + sizeof(value_t) - 1) / sizeof(value_t));
+}
+
+static long long compute_total_pdb_size(const PPDBCollection& pdbs)
+{
+    long long size = 0;
 
     for (const auto& pdb : pdbs) {
-        size += pdb->num_states();
+        size += get_pdb_size(*pdb);
     }
 
     return size;
 }
 
+/*
+  The PDB size limit refers to uncompressed lookup tables. Compressed lookup
+  tables allow proportionally more abstract states.
+*/
+static int get_max_pdb_states(int max_size, ValueTableEncoding encoding)
+{
+    const auto factor = static_cast<long long>(
+        sizeof(value_t) / get_max_bytes_per_value(encoding));
+    return static_cast<int>(std::min<long long>(
+        max_size * factor,
+        std::numeric_limits<int>::max()));
+}
+
 /*
   When growing a pattern, we only want to consider successor patterns
   that are *interesting*. A pattern is interesting if the subgraph of
@@ -144,7 +174,7 @@ class PatternCollectionGeneratorHillclimbing::IncrementalPPDBs {
 
     std::shared_ptr<SubCollectionFinder> subcollection_finder;
 
-    // The sum of all abstract state sizes of all pdbs in the collection.
+    // The sum of the sizes of all pdbs in the collection (see get_pdb_size).
     long long size;
 
     // Adds a PDB for pattern but does not recompute pattern_subcollections.
@@ -164,7 +194,10 @@ public:
         const ProbabilisticTaskProxy& task_proxy,
         std::shared_ptr<FDRSimpleCostFunction> task_cost_function,
         PatternCollectionInformation& initial_patterns,
-        std::shared_ptr<SubCollectionFinder> subcollection_finder);
+        std::shared_ptr<SubCollectionFinder> subcollection_finder,
+        unsigned num_threads,
+        const PDBCache* cache,
+        ValueTableEncoding value_encoding);
 
     // Adds a new PDB to the collection and recomputes pattern_subcollections.
     void add_pdb(const std::shared_ptr<ProbabilityAwarePatternDatabase>& pdb);
@@ -229,15 +262,23 @@ PatternCollectionGeneratorHillclimbing::IncrementalPPDBs::IncrementalPPDBs(
     const ProbabilisticTaskProxy& task_proxy,
     std::shared_ptr<FDRSimpleCostFunction> task_cost_function,
     PatternCollectionInformation& initial_patterns,
-    std::shared_ptr<SubCollectionFinder> subcollection_finder)
+    std::shared_ptr<SubCollectionFinder> subcollection_finder,
+    unsigned num_threads,
+    const PDBCache* cache,
+    ValueTableEncoding value_encoding)
     : task_proxy(task_proxy)
     , task_cost_function(std::move(task_cost_function))
     , patterns(initial_patterns.get_patterns())
-    , pattern_databases(initial_patterns.get_pdbs())
+    , pattern_databases(initial_patterns.get_pdbs(num_threads, cache))
     , pattern_subcollections(initial_patterns.get_subcollections())
     , subcollection_finder(std::move(subcollection_finder))
-    , size(compute_total_pdb_size(*pattern_databases))
+    , size(0)
 {
+    for (const auto& pdb : *pattern_databases) {
+        pdb->compress(value_encoding);
+    }
+
+    size = compute_total_pdb_size(*pattern_databases);
 }
 
 void PatternCollectionGeneratorHillclimbing::IncrementalPPDBs::
@@ -249,7 +290,7 @@ void PatternCollectionGeneratorHillclimbing::IncrementalPPDBs::
             *task_cost_function,
             pattern,
             initial_state));
-    size += pdb->num_states();
+    size += get_pdb_size(*pdb);
 }
 
 void PatternCollectionGeneratorHillclimbing::IncrementalPPDBs::add_pdb(
@@ -257,7 +298,7 @@ void PatternCollectionGeneratorHillclimbing::IncrementalPPDBs::add_pdb(
 {
     patterns->push_back(pdb->get_pattern());
     auto& new_pdb = pattern_databases->emplace_back(pdb);
-    size += new_pdb->num_states();
+    size += get_pdb_size(*new_pdb);
     recompute_pattern_subcollections();
 }
 
@@ -394,11 +435,19 @@ PatternCollectionGeneratorHillclimbing::PatternCollectionGeneratorHillclimbing(
     , subcollection_finder_factory_(
           opts.get<std::shared_ptr<SubCollectionFinderFactory>>(
               "subcollection_finder_factory"))
-    , pdb_max_size_(opts.get<int>("pdb_max_size"))
+    , pdb_max_size_(get_max_pdb_states(
+          opts.get<int>("pdb_max_size"),
+          opts.get<ValueTableEncoding>("value_encoding")))
     , collection_max_size_(opts.get<int>("collection_max_size"))
     , num_samples_(opts.get<int>("num_samples"))
     , min_improvement_(opts.get<int>("min_improvement"))
     , max_time_(opts.get<double>("max_time"))
+    , num_threads_(opts.get<int>("threads"))
+    , value_encoding_(opts.get<ValueTableEncoding>("value_encoding"))
+    , cache_(
+          opts.get<std::string>("cache_dir").empty()
+              ? nullptr
+              : std::make_shared<PDBCache>(opts.get<std::string>("cache_dir")))
     , rng_(utils::parse_rng_from_options(opts))
     , remaining_states_(opts.get<int>("search_space_max_size"))
     , num_rejected_(0)
@@ -428,6 +477,12 @@ unsigned int PatternCollectionGeneratorHillclimbing::generate_candidate_pdbs(
     unsigned int pdb_size = pdb.num_states();
     unsigned int max_pdb_size = 0;
 
+    const State initial_state = task_proxy.get_initial_state();
+    initial_state.unpack();
+
+    // Variables whose addition to the pattern yields a new candidate.
+    std::vector<int> new_vars;
+
     for (int pattern_var : pattern) {
         assert(utils::in_bounds(pattern_var, relevant_neighbours));
         const std::vector<int>& connected_vars =
@@ -485,24 +540,61 @@ unsigned int PatternCollectionGeneratorHillclimbing::generate_candidate_pdbs(
 
             /*
                 If we haven't seen this pattern before, generate a PDB
-                for it and add it to candidate_pdbs if its size does not
-                surpass the size limit.
+                for it and add it to candidate_pdbs. The states of the PDB
+                are reserved from the search space budget up-front, so
+                that the size checks do not depend on the order in which
+                the PDBs are built.
             */
-            auto& new_pdb =
-                candidate_pdbs.emplace_back(new ProbabilityAwarePatternDatabase(
-                    task_proxy,
-                    task_cost_function,
-                    pdb,
-                    rel_var_id,
-                    task_proxy.get_initial_state(),
-                    true,
-                    hill_climbing_timer.get_remaining_time()));
-            const unsigned int num_states = new_pdb->num_states();
-            max_pdb_size = std::max(max_pdb_size, num_states);
-            remaining_states_ -= num_states;
+            new_vars.push_back(rel_var_id);
+            remaining_states_ -= static_cast<int>(pdb_size) * rel_var_size;
         }
     }
 
+    const std::size_t first_new = candidate_pdbs.size();
+
+    compute_pdbs(candidate_pdbs, new_vars.size(), num_threads_, [&](size_t i) {
+        /*
+          All workers share the hill climbing time limit. The construction
+          gets the remaining time of the shared timer when it starts. Both
+          timers measure the CPU time of the process, so the construction
+          times out as soon as the shared limit is exceeded.
+        */
+        hill_climbing_timer.throw_if_expired();
+
+        auto compute_pdb = [&] {
+            return std::make_unique<ProbabilityAwarePatternDatabase>(
+                task_proxy,
+                task_cost_function,
+                pdb,
+                new_vars[i],
+                initial_state,
+                true,
+                hill_climbing_timer.get_remaining_time());
+        };
+
+        std::unique_ptr<ProbabilityAwarePatternDatabase> new_pdb;
+
+        if (cache_) {
+            new_pdb = cache_->get_or_compute(
+                task_proxy,
+                task_cost_function,
+                extended_pattern(pdb.get_pattern(), new_vars[i]),
+                initial_state,
+                compute_pdb);
+        } else {
+            new_pdb = compute_pdb();
+        }
+
+        new_pdb->compress(value_encoding_);
+
+        return new_pdb;
+    });
+
+    for (std::size_t i = first_new; i != candidate_pdbs.size(); ++i) {
+        const unsigned int num_states = candidate_pdbs[i]->num_states();
+        max_pdb_size = std::max(max_pdb_size, num_states);
+    }
+
     return max_pdb_size;
 }
 
@@ -548,13 +640,10 @@ PatternCollectionGeneratorHillclimbing::find_best_improving_pdb(
       We require that a pattern must have an improvement of at least one in
       order to be taken into account.
     */
-    int improvement = 0;
-    int best_pdb_index = -1;
+    // Candidates that are evaluated, in increasing index order.
+    std::vector<std::size_t> evaluated;
 
-    // Iterate over all candidates and search for the best improving pattern/pdb
     for (size_t i = 0; i < candidate_pdbs.size(); ++i) {
-        hill_climbing_timer.throw_if_expired();
-
         const auto& pdb = candidate_pdbs[i];
         if (!pdb) {
             /* candidate pattern is too large or has already been added to
@@ -565,32 +654,67 @@ PatternCollectionGeneratorHillclimbing::find_best_improving_pdb(
           If a candidate's size added to the current collection's size exceeds
           the maximum collection size, then forget the pdb.
         */
-        int combined_size = current_pdbs.get_size() + pdb->num_states();
+        const long long combined_size =
+            current_pdbs.get_size() + get_pdb_size(*pdb);
         if (combined_size > collection_max_size_) {
             candidate_pdbs[i] = nullptr;
             continue;
         }
 
-        /*
-          Calculate the "counting approximation" for all sample states: count
-          the number of samples for which the current pattern collection
-          heuristic would be improved if the new pattern was included into it.
-        */
-        /*
-          TODO: The original implementation by Haslum et al. uses m/t as a
-          statistical confidence interval to stop the A*-search (which they use,
-          see above) earlier.
-        */
-        const int count =
-            current_pdbs.count_improvements(*pdb, samples, termination_cost);
+        evaluated.push_back(i);
+    }
+
+    /*
+      Calculate the "counting approximation" for all sample states: count
+      the number of samples for which the current pattern collection
+      heuristic would be improved if the new pattern was included into it.
+      The candidates are scored independently, so this is done concurrently
+      if multiple threads are used.
+    */
+    /*
+      TODO: The original implementation by Haslum et al. uses m/t as a
+      statistical confidence interval to stop the A*-search (which they use,
+      see above) earlier.
+    */
+    std::vector<int> counts(evaluated.size());
+
+    auto score = [&](std::size_t j) {
+        hill_climbing_timer.throw_if_expired();
+        counts[j] = current_pdbs.count_improvements(
+            *candidate_pdbs[evaluated[j]],
+            samples,
+            termination_cost);
+    };
+
+    if (num_threads_ <= 1 || evaluated.size() <= 1) {
+        for (std::size_t j = 0; j != evaluated.size(); ++j) {
+            score(j);
+        }
+    } else {
+        ThreadPool pool(static_cast<unsigned>(
+            std::min<std::size_t>(num_threads_, evaluated.size())));
+        parallel_for(pool, evaluated.size(), score);
+    }
+
+    /*
+      The best candidate is the first one with the maximal count, as in the
+      sequential evaluation order, so the result does not depend on the
+      number of threads.
+    */
+    int improvement = 0;
+    int best_pdb_index = -1;
+
+    for (std::size_t j = 0; j != evaluated.size(); ++j) {
+        const int count = counts[j];
 
         if (count > improvement) {
             improvement = count;
-            best_pdb_index = i;
+            best_pdb_index = static_cast<int>(evaluated[j]);
         }
 
         if (log_.is_at_least_verbose() && count > 0) {
-            std::cout << "pattern: " << candidate_pdbs[i]->get_pattern()
+            std::cout << "pattern: "
+                      << candidate_pdbs[evaluated[j]]->get_pattern()
                       << " - improvement: " << count << std::endl;
         }
     }
@@ -777,7 +901,10 @@ PatternCollectionInformation PatternCollectionGeneratorHillclimbing::generate(
         task_proxy,
         task_cost_function,
         collection,
-        subcollection_finder);
+        subcollection_finder,
+        num_threads_,
+        cache_.get(),
+        value_encoding_);
 
     if (log_.is_at_least_normal()) {
         std::cout << "Done calculating initial pattern collection: " << timer
@@ -816,12 +943,16 @@ static void add_hillclimbing_options(plugins::Feature& feature)
 
     feature.add_option<int>(
         "pdb_max_size",
-        "maximal number of states per pattern database ",
+        "maximal number of states per pattern database. If the lookup tables "
+        "are compressed (see value_encoding), the limit is scaled by the "
+        "compression ratio",
         "2M",
         plugins::Bounds("1", "infinity"));
     feature.add_option<int>(
         "collection_max_size",
-        "maximal number of states in the pattern collection",
+        "maximal size of the pattern collection, measured in uncompressed "
+        "lookup table entries, i.e., the number of bytes of all lookup tables "
+        "divided by the size of an uncompressed value",
         "10M",
         plugins::Bounds("1", "infinity"));
     feature.add_option<int>(
@@ -848,9 +979,35 @@ static void add_hillclimbing_options(plugins::Feature& feature)
         "collection via hill climbing. If set to 0, no hill climbing "
         "is performed at all. Note that this limit only affects hill "
         "climbing. Use max_time_dominance_pruning to limit the time "
-        "spent for pruning dominated patterns.",
+        "spent for pruning dominated patterns. The time is measured in "
+        "process CPU time, which accumulates over all threads, so with "
+        "multiple threads the limit is reached sooner in wall-clock time.",
         "infinity",
         plugins::Bounds("0.0", "infinity"));
+    feature.add_option<int>(
+        "threads",
+        "number of threads used to compute the PDBs of independent candidate "
+        "patterns and to score the candidates on the samples concurrently. "
+        "Unless max_time is reached, the resulting pattern collection does "
+        "not depend on the number of threads. All threads share the max_time "
+        "limit, which measures the CPU time summed over all threads, so with "
+        "N threads it may be reached up to N times sooner in wall-clock "
+        "time",
+        "1",
+        plugins::Bounds("1", "infinity"));
+    feature.add_option<ValueTableEncoding>(
+        "value_encoding",
+        "storage format of the lookup tables of the PDBs. The double and "
+        "dictionary formats are exact, unless dictionary falls back to "
+        "quantized16. The lossy formats float and quantized16 round the "
+        "values down, so the PDBs remain admissible",
+        "double");
+    feature.add_option<std::string>(
+        "cache_dir",
+        "directory of an on-disk cache for the lookup tables of the PDBs. If "
+        "non-empty, the lookup tables of previously computed projections are "
+        "loaded from this directory instead of being recomputed",
+        "\"\"");
 
     add_pattern_collection_generator_options_to_feature(feature);
     utils::add_rng_options(feature);
@@ -1,15 +1,19 @@
 #include "probfd/pdbs/pattern_collection_information.h"
 
+#include "probfd/pdbs/pdb_cache.h"
 #include "probfd/pdbs/probability_aware_pattern_database.h"
 #include "probfd/pdbs/trivial_finder.h"
+#include "probfd/pdbs/utils.h"
 
 #include "downward/pdbs/pattern_collection_information.h"
+#include "downward/pdbs/pattern_database.h"
 
 #include "downward/utils/collections.h"
 #include "downward/utils/timer.h"
 
 #include <cassert>
 #include <iostream>
+#include <memory>
 #include <utility>
 
 using namespace std;
@@ -26,21 +30,9 @@ PatternCollectionInformation::PatternCollectionInformation(
     , patterns_(det_info.get_patterns())
     , subcollection_finder_(std::move(arg_subcollection_finder))
 {
-    auto pdbs = det_info.get_pdbs();
-
-    if (!pdbs) {
-        return;
-    }
-
-    pdbs_ = make_shared<PPDBCollection>();
-
-    for (size_t i = 0; i != pdbs->size(); ++i) {
-        pdbs_->emplace_back(new ProbabilityAwarePatternDatabase(
-            task_proxy_,
-            *task_cost_function_,
-            *pdbs->operator[](i),
-            task_proxy_.get_initial_state()));
-    }
+    // The probability-aware PDBs are computed on demand, using the classical
+    // PDBs as heuristics.
+    classical_pdbs_ = det_info.get_pdbs();
 }
 
 PatternCollectionInformation::PatternCollectionInformation(
@@ -98,20 +90,55 @@ bool PatternCollectionInformation::information_is_valid() const
     return true;
 }
 
-void PatternCollectionInformation::create_pdbs_if_missing()
+void PatternCollectionInformation::create_pdbs_if_missing(
+    unsigned num_threads,
+    const PDBCache* cache)
 {
     assert(patterns_);
     if (!pdbs_) {
         utils::Timer timer;
         cout << "Computing PDBs for pattern collection..." << endl;
-        pdbs_ = make_shared<PPDBCollection>();
-        for (const Pattern& pattern : *patterns_) {
-            pdbs_->emplace_back(new ProbabilityAwarePatternDatabase(
+
+        auto pdbs = make_shared<PPDBCollection>();
+        const State initial_state = task_proxy_.get_initial_state();
+        initial_state.unpack();
+
+        auto compute_pdb = [&](size_t i) {
+            if (classical_pdbs_) {
+                return make_unique<ProbabilityAwarePatternDatabase>(
+                    task_proxy_,
+                    *task_cost_function_,
+                    *(*classical_pdbs_)[i],
+                    initial_state);
+            }
+
+            return make_unique<ProbabilityAwarePatternDatabase>(
                 task_proxy_,
                 *task_cost_function_,
-                pattern,
-                task_proxy_.get_initial_state()));
+                (*patterns_)[i],
+                initial_state);
+        };
+
+        const size_t num_pdbs =
+            classical_pdbs_ ? classical_pdbs_->size() : patterns_->size();
+
+        if (cache) {
+            compute_pdbs(*pdbs, num_pdbs, num_threads, [&](size_t i) {
+                return cache->get_or_compute(
+                    task_proxy_,
+                    *task_cost_function_,
+                    classical_pdbs_ ? (*classical_pdbs_)[i]->get_pattern()
+                                    : (*patterns_)[i],
+                    initial_state,
+                    [&] { return compute_pdb(i); });
+            });
+        } else {
+            compute_pdbs(*pdbs, num_pdbs, num_threads, compute_pdb);
         }
+
+        pdbs_ = std::move(pdbs);
+        classical_pdbs_ = nullptr;
+
         cout << "Done computing PDBs for pattern collection: " << timer << endl;
     }
 }
@@ -148,9 +175,12 @@ shared_ptr<PatternCollection> PatternCollectionInformation::get_patterns() const
     return patterns_;
 }
 
-shared_ptr<PPDBCollection> PatternCollectionInformation::get_pdbs()
+shared_ptr<PPDBCollection>
+PatternCollectionInformation::get_pdbs(
+    unsigned num_threads,
+    const PDBCache* cache)
 {
-    create_pdbs_if_missing();
+    create_pdbs_if_missing(num_threads, cache);
     return pdbs_;
 }
 
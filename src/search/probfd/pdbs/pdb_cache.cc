@@ -0,0 +1,358 @@
+#include "probfd/pdbs/pdb_cache.h"
+
+#include "probfd/pdbs/probability_aware_pattern_database.h"
+#include "probfd/pdbs/state_ranking_function.h"
+
+#include "probfd/cost_function.h"
+#include "probfd/task_proxy.h"
+
+#include "downward/utils/hash.h"
+#include "downward/utils/system.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <span>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace probfd::pdbs {
+
+namespace {
+
+constexpr char MAGIC[8] = {'P', 'P', 'D', 'B', 'V', 'T', '\0', '\0'};
+constexpr std::uint32_t FORMAT_VERSION = 3;
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t value_size;
+    std::uint64_t key_high;
+    std::uint64_t key_low;
+    std::uint64_t num_states;
+};
+
+static_assert(sizeof(FileHeader) % alignof(value_t) == 0);
+
+bool is_valid_header(
+    const FileHeader& header,
+    const PDBCache::Key& key,
+    std::size_t num_states)
+{
+    return std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 &&
+           header.version == FORMAT_VERSION &&
+           header.value_size == sizeof(value_t) &&
+           header.key_high == key.high && header.key_low == key.low &&
+           header.num_states == num_states;
+}
+
+// Two independently seeded 64-bit hashes of the same input.
+class WideHashState {
+    utils::HashState high_;
+    utils::HashState low_;
+
+public:
+    WideHashState() { utils::feed(low_, 0x9e3779b97f4a7c15ULL); }
+
+    template <typename T>
+    void feed(const T& value)
+    {
+        utils::feed(high_, value);
+        utils::feed(low_, value);
+    }
+
+    void feed(value_t value) { feed(std::bit_cast<std::uint64_t>(value)); }
+
+    void feed(const PDBCache::Key& key)
+    {
+        feed(key.high);
+        feed(key.low);
+    }
+
+    PDBCache::Key get_key() { return {high_.get_hash64(), low_.get_hash64()}; }
+};
+
+// Returns the facts of the pattern variables among the given facts, with
+// variables replaced by their position in the pattern, in sorted order.
+template <typename Facts, typename GetPair>
+std::vector<std::pair<int, int>> project_facts(
+    const Facts& facts,
+    const std::vector<int>& pattern_index,
+    GetPair get_pair)
+{
+    std::vector<std::pair<int, int>> projected;
+    for (const auto& fact : facts) {
+        const auto [var, value] = get_pair(fact);
+        if (pattern_index[var] == -1) continue;
+        projected.emplace_back(pattern_index[var], value);
+    }
+    std::ranges::sort(projected);
+    return projected;
+}
+
+void feed_facts(
+    WideHashState& hash_state,
+    const std::vector<std::pair<int, int>>& facts)
+{
+    hash_state.feed(facts.size());
+    for (const auto& [var, value] : facts) {
+        hash_state.feed(var);
+        hash_state.feed(value);
+    }
+}
+
+} // namespace
+
+PDBCache::PDBCache(std::filesystem::path directory)
+    : directory_(std::move(directory))
+{
+    std::error_code ec;
+    std::filesystem::create_directories(directory_, ec);
+    if (ec) {
+        std::cerr << "Could not create PDB cache directory " << directory_
+                  << ": " << ec.message() << std::endl;
+    }
+}
+
+auto PDBCache::compute_key(
+    ProbabilisticTaskProxy task_proxy,
+    FDRSimpleCostFunction& task_cost_function,
+    const StateRankingFunction& ranking_function,
+    StateRank initial_state) -> Key
+{
+    const Pattern& pattern = ranking_function.get_pattern();
+    const VariablesProxy variables = task_proxy.get_variables();
+
+    // Variables are identified by their position in the pattern.
+    std::vector<int> pattern_index(variables.size(), -1);
+    for (size_t i = 0; i != pattern.size(); ++i) {
+        pattern_index[pattern[i]] = static_cast<int>(i);
+    }
+
+    auto get_fact_pair = [](const FactProxy& fact) { return fact.get_pair(); };
+    auto get_effect_pair = [](const auto& effect) {
+        return effect.get_fact().get_pair();
+    };
+
+    // Operators that do not affect the pattern only induce self-loops in the
+    // projection and are ignored. Duplicate operator projections do not
+    // change the projection either. The outcome and operator keys are sorted
+    // to be independent of their order in the task.
+    std::vector<Key> operator_keys;
+    std::vector<Key> outcome_keys;
+
+    for (const ProbabilisticOperatorProxy op : task_proxy.get_operators()) {
+        bool affects_pattern = false;
+        outcome_keys.clear();
+
+        for (const ProbabilisticOutcomeProxy outcome : op.get_outcomes()) {
+            const auto effects = project_facts(
+                outcome.get_effects(),
+                pattern_index,
+                get_effect_pair);
+            if (!effects.empty()) affects_pattern = true;
+
+            WideHashState outcome_hash;
+            outcome_hash.feed(outcome.get_probability());
+            feed_facts(outcome_hash, effects);
+            outcome_keys.push_back(outcome_hash.get_key());
+        }
+
+        if (!affects_pattern) continue;
+
+        std::ranges::sort(outcome_keys);
+
+        WideHashState op_hash;
+        op_hash.feed(
+            task_cost_function.get_action_cost(OperatorID(op.get_id())));
+        feed_facts(
+            op_hash,
+            project_facts(op.get_preconditions(), pattern_index, get_fact_pair));
+        op_hash.feed(outcome_keys.size());
+        for (const Key& outcome_key : outcome_keys) op_hash.feed(outcome_key);
+
+        operator_keys.push_back(op_hash.get_key());
+    }
+
+    std::ranges::sort(operator_keys);
+    const auto duplicates = std::ranges::unique(operator_keys);
+    operator_keys.erase(duplicates.begin(), duplicates.end());
+
+    WideHashState hash_state;
+
+    hash_state.feed(pattern.size());
+    for (const int var : pattern) {
+        hash_state.feed(variables[var].get_domain_size());
+    }
+
+    hash_state.feed(operator_keys.size());
+    for (const Key& operator_key : operator_keys) hash_state.feed(operator_key);
+
+    feed_facts(
+        hash_state,
+        project_facts(task_proxy.get_goals(), pattern_index, get_fact_pair));
+
+    hash_state.feed(task_cost_function.get_non_goal_termination_cost());
+    hash_state.feed(initial_state);
+
+    return hash_state.get_key();
+}
+
+std::filesystem::path PDBCache::get_file_path(const Key& key) const
+{
+    std::ostringstream name;
+    name << std::hex << std::setfill('0') << std::setw(16) << key.high
+         << std::setw(16) << key.low << ".ppdb";
+    return directory_ / name.str();
+}
+
+std::optional<ValueTable>
+PDBCache::load(const Key& key, std::size_t num_states) const
+{
+    const std::filesystem::path path = get_file_path(key);
+    const std::size_t file_size =
+        sizeof(FileHeader) + num_states * sizeof(value_t);
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) return std::nullopt;
+
+    struct stat file_stat;
+    if (::fstat(fd, &file_stat) != 0 ||
+        static_cast<std::size_t>(file_stat.st_size) != file_size) {
+        ::close(fd);
+        return std::nullopt;
+    }
+
+    void* address = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // The mapping stays valid after closing the file descriptor.
+    ::close(fd);
+
+    if (address == MAP_FAILED) return std::nullopt;
+
+    std::shared_ptr<const void> mapping(address, [file_size](void* p) {
+        ::munmap(p, file_size);
+    });
+
+    const auto* bytes = static_cast<const char*>(address);
+
+    FileHeader header;
+    std::memcpy(&header, bytes, sizeof(FileHeader));
+    if (!is_valid_header(header, key, num_states)) return std::nullopt;
+
+    const auto* values =
+        reinterpret_cast<const value_t*>(bytes + sizeof(FileHeader));
+
+    return ValueTable(std::move(mapping), values, num_states);
+#else
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return std::nullopt;
+
+    FileHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(FileHeader)) ||
+        !is_valid_header(header, key, num_states)) {
+        return std::nullopt;
+    }
+
+    std::vector<value_t> values(num_states);
+    if (!file.read(
+            reinterpret_cast<char*>(values.data()),
+            static_cast<std::streamsize>(file_size - sizeof(FileHeader)))) {
+        return std::nullopt;
+    }
+
+    return ValueTable(std::move(values));
+#endif
+}
+
+void PDBCache::store(const Key& key, std::span<const value_t> values) const
+{
+    static std::atomic<unsigned> next_file_id = 0;
+
+    const std::filesystem::path path = get_file_path(key);
+
+    // Write to a file name unique to this process and call first, then
+    // rename the file so that readers never see partially written files.
+    std::filesystem::path tmp_path = path;
+    tmp_path += "." + std::to_string(utils::get_process_id()) + "." +
+                std::to_string(next_file_id.fetch_add(1)) + ".tmp";
+
+    FileHeader header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FORMAT_VERSION;
+    header.value_size = sizeof(value_t);
+    header.key_high = key.high;
+    header.key_low = key.low;
+    header.num_states = values.size();
+
+    {
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+        file.write(
+            reinterpret_cast<const char*>(values.data()),
+            static_cast<std::streamsize>(values.size_bytes()));
+
+        if (!file.flush()) {
+            std::cerr << "Could not write PDB cache file " << tmp_path
+                      << std::endl;
+            file.close();
+            std::error_code ec;
+            std::filesystem::remove(tmp_path, ec);
+            return;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+        std::cerr << "Could not write PDB cache file " << path << ": "
+                  << ec.message() << std::endl;
+        std::filesystem::remove(tmp_path, ec);
+    }
+}
+
+std::unique_ptr<ProbabilityAwarePatternDatabase> PDBCache::get_or_compute(
+    ProbabilisticTaskProxy task_proxy,
+    FDRSimpleCostFunction& task_cost_function,
+    const Pattern& pattern,
+    const State& initial_state,
+    const std::function<std::unique_ptr<ProbabilityAwarePatternDatabase>()>&
+        compute_pdb) const
+{
+    StateRankingFunction ranking_function(task_proxy.get_variables(), pattern);
+
+    const Key key = compute_key(
+        task_proxy,
+        task_cost_function,
+        ranking_function,
+        ranking_function.get_abstract_rank(initial_state));
+
+    if (auto table = load(key, ranking_function.num_states())) {
+        return std::make_unique<ProbabilityAwarePatternDatabase>(
+            std::move(ranking_function),
+            std::move(*table));
+    }
+
+    auto pdb = compute_pdb();
+    assert(pdb->get_pattern() == pattern);
+    store(key, pdb->get_value_table());
+    return pdb;
+}
+
+} // namespace probfd::pdbs
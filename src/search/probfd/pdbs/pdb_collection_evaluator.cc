@@ -0,0 +1,171 @@
+#include "probfd/pdbs/pdb_collection_evaluator.h"
+
+#include "probfd/pdbs/probability_aware_pattern_database.h"
+#include "probfd/pdbs/subcollection_finder.h"
+
+#include "downward/task_proxy.h"
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+namespace probfd::pdbs {
+
+PDBCollectionEvaluator::PDBCollectionEvaluator(
+    std::shared_ptr<PPDBCollection> pdbs,
+    std::shared_ptr<std::vector<PatternSubCollection>> subcollections,
+    std::shared_ptr<SubCollectionFinder> subcollection_finder,
+    value_t termination_cost)
+    : pdbs_(std::move(pdbs))
+    , subcollections_(std::move(subcollections))
+    , subcollection_finder_(std::move(subcollection_finder))
+    , termination_cost_(termination_cost)
+{
+    for (const auto& pdb : *pdbs_) {
+        const Pattern& pattern = pdb->get_pattern();
+        used_variables_.insert(
+            used_variables_.end(),
+            pattern.begin(),
+            pattern.end());
+    }
+
+    std::ranges::sort(used_variables_);
+    const auto duplicates = std::ranges::unique(used_variables_);
+    used_variables_.erase(duplicates.begin(), duplicates.end());
+
+    offsets_.reserve(pdbs_->size() + 1);
+    offsets_.push_back(0);
+
+    for (const auto& pdb : *pdbs_) {
+        const StateRankingFunction& ranking_function =
+            pdb->get_state_ranking_function();
+        const Pattern& pattern = ranking_function.get_pattern();
+
+        for (std::size_t i = 0; i != pattern.size(); ++i) {
+            const auto it =
+                std::ranges::lower_bound(used_variables_, pattern[i]);
+            variable_indices_.push_back(it - used_variables_.begin());
+            multipliers_.push_back(
+                static_cast<int>(ranking_function.get_multiplier(i)));
+        }
+
+        offsets_.push_back(variable_indices_.size());
+    }
+
+    state_values_.resize(used_variables_.size());
+    pdb_estimates_.resize(pdbs_->size());
+}
+
+value_t PDBCollectionEvaluator::evaluate(const State& state) const
+{
+    if (pdbs_->empty()) return 0_vt;
+
+    for (std::size_t v = 0; v != used_variables_.size(); ++v) {
+        state_values_[v] = state[used_variables_[v]].get_value();
+    }
+
+    for (std::size_t i = 0; i != pdbs_->size(); ++i) {
+        StateRank rank = 0;
+        for (std::size_t k = offsets_[i]; k != offsets_[i + 1]; ++k) {
+            rank += multipliers_[k] * state_values_[variable_indices_[k]];
+        }
+
+        const value_t estimate = (*pdbs_)[i]->lookup_estimate(rank);
+
+        if (estimate == termination_cost_) {
+            return estimate;
+        }
+
+        pdb_estimates_[i] = estimate;
+    }
+
+    return evaluate_estimates(pdb_estimates_);
+}
+
+void PDBCollectionEvaluator::evaluate(
+    std::span<const State* const> states,
+    std::span<value_t> values) const
+{
+    assert(states.size() == values.size());
+
+    if (pdbs_->empty()) {
+        std::ranges::fill(values, 0_vt);
+        return;
+    }
+
+    const std::size_t num_states = states.size();
+
+    // The value of the v-th used variable in state j is at position
+    // v * num_states + j.
+    state_values_.resize(used_variables_.size() * num_states);
+
+    for (std::size_t j = 0; j != num_states; ++j) {
+        const State& state = *states[j];
+        for (std::size_t v = 0; v != used_variables_.size(); ++v) {
+            state_values_[v * num_states + j] =
+                state[used_variables_[v]].get_value();
+        }
+    }
+
+    // The estimate of PDB i for state j is at position i * num_states + j.
+    batch_estimates_.resize(pdbs_->size() * num_states);
+    ranks_.resize(num_states);
+    terminal_.assign(num_states, false);
+
+    for (std::size_t i = 0; i != pdbs_->size(); ++i) {
+        std::ranges::fill(ranks_, 0);
+
+        for (std::size_t k = offsets_[i]; k != offsets_[i + 1]; ++k) {
+            const int* var_values =
+                state_values_.data() + variable_indices_[k] * num_states;
+            const int multiplier = multipliers_[k];
+
+            for (std::size_t j = 0; j != num_states; ++j) {
+                ranks_[j] += multiplier * var_values[j];
+            }
+        }
+
+        const ProbabilityAwarePatternDatabase& pdb = *(*pdbs_)[i];
+        value_t* estimates = batch_estimates_.data() + i * num_states;
+
+        for (std::size_t j = 0; j != num_states; ++j) {
+            const value_t estimate = pdb.lookup_estimate(ranks_[j]);
+            estimates[j] = estimate;
+            if (estimate == termination_cost_) terminal_[j] = true;
+        }
+    }
+
+    for (std::size_t j = 0; j != num_states; ++j) {
+        if (terminal_[j]) {
+            values[j] = termination_cost_;
+            continue;
+        }
+
+        for (std::size_t i = 0; i != pdbs_->size(); ++i) {
+            pdb_estimates_[i] = batch_estimates_[i * num_states + j];
+        }
+
+        values[j] = evaluate_estimates(pdb_estimates_);
+    }
+}
+
+value_t PDBCollectionEvaluator::evaluate_estimates(
+    const std::vector<value_t>& estimates) const
+{
+    // Get lowest additive subcollection value
+    auto transformer = [&, this](const std::vector<int>& subcollection) {
+        return subcollection_finder_->evaluate_subcollection(
+            estimates,
+            subcollection);
+    };
+
+    return std::transform_reduce(
+        subcollections_->begin(),
+        subcollections_->end(),
+        0_vt,
+        static_cast<const value_t& (*)(const value_t&, const value_t&)>(
+            std::max<value_t>),
+        transformer);
+}
+
+} // namespace probfd::pdbs
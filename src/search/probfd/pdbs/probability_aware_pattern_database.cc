@@ -11,6 +11,7 @@
 #include "downward/utils/collections.h"
 #include "downward/utils/countdown_timer.h"
 
+#include <cassert>
 #include <limits>
 #include <utility>
 
@@ -43,6 +44,15 @@ ProbabilityAwarePatternDatabase::ProbabilityAwarePatternDatabase(
 {
 }
 
+ProbabilityAwarePatternDatabase::ProbabilityAwarePatternDatabase(
+    StateRankingFunction ranking_function,
+    ValueTable value_table)
+    : ranking_function_(std::move(ranking_function))
+    , value_table_(std::move(value_table))
+{
+    assert(value_table_.size() == ranking_function_.num_states());
+}
+
 ProbabilityAwarePatternDatabase::ProbabilityAwarePatternDatabase(
     ProbabilisticTaskProxy task_proxy,
     FDRSimpleCostFunction& task_cost_function,
@@ -64,7 +74,7 @@ ProbabilityAwarePatternDatabase::ProbabilityAwarePatternDatabase(
         mdp,
         ranking_function_.get_abstract_rank(initial_state),
         heuristic,
-        value_table_,
+        value_table_.get_mutable_values(),
         timer.get_remaining_time());
 }
 
@@ -76,7 +86,12 @@ ProbabilityAwarePatternDatabase::ProbabilityAwarePatternDatabase(
     double max_time)
     : ProbabilityAwarePatternDatabase(std::move(ranking_function))
 {
-    compute_value_table(mdp, initial_state, heuristic, value_table_, max_time);
+    compute_value_table(
+        mdp,
+        initial_state,
+        heuristic,
+        value_table_.get_mutable_values(),
+        max_time);
 }
 
 ProbabilityAwarePatternDatabase::ProbabilityAwarePatternDatabase(
@@ -145,7 +160,7 @@ ProbabilityAwarePatternDatabase::ProbabilityAwarePatternDatabase(
             pdb.get_value_table(),
             ranking_function_,
             add_var),
-        value_table_,
+        value_table_.get_mutable_values(),
         timer.get_remaining_time());
 }
 
@@ -165,7 +180,7 @@ ProbabilityAwarePatternDatabase::ProbabilityAwarePatternDatabase(
             pdb.get_value_table(),
             ranking_function_,
             add_var),
-        value_table_,
+        value_table_.get_mutable_values(),
         max_time);
 }
 
@@ -197,7 +212,7 @@ ProbabilityAwarePatternDatabase::ProbabilityAwarePatternDatabase(
             left,
             right,
             task_cost_function.get_non_goal_termination_cost()),
-        value_table_,
+        value_table_.get_mutable_values(),
         timer.get_remaining_time());
 }
 
@@ -218,7 +233,7 @@ ProbabilityAwarePatternDatabase::ProbabilityAwarePatternDatabase(
             left,
             right,
             mdp.get_non_goal_termination_cost()),
-        value_table_,
+        value_table_.get_mutable_values(),
         max_time);
 }
 
@@ -233,12 +248,21 @@ ProbabilityAwarePatternDatabase::get_state_ranking_function() const
     return ranking_function_;
 }
 
-const std::vector<value_t>&
-ProbabilityAwarePatternDatabase::get_value_table() const
+const ValueTable& ProbabilityAwarePatternDatabase::get_value_table() const
 {
     return value_table_;
 }
 
+std::size_t ProbabilityAwarePatternDatabase::get_memory_usage() const
+{
+    return value_table_.get_memory_usage();
+}
+
+void ProbabilityAwarePatternDatabase::compress(ValueTableEncoding encoding)
+{
+    value_table_.encode(encoding);
+}
+
 unsigned int ProbabilityAwarePatternDatabase::num_states() const
 {
     return ranking_function_.num_states();
@@ -252,6 +252,8 @@ ProjectionStateSpace::ProjectionStateSpace(
         } while (next_precondition(operator_info.missing_info, precondition));
     }
 
+    match_tree_.finalize();
+
     const GoalsProxy task_goals = task_proxy.get_goals();
 
     std::vector<int> non_goal_vars;
@@ -7,6 +7,7 @@
 #include "probfd/task_utils/task_properties.h"
 
 #include "probfd/utils/graph_visualization.h"
+#include "probfd/utils/thread_pool.h"
 
 #include "downward/utils/rng.h"
 
@@ -32,6 +33,35 @@ Pattern extended_pattern(const Pattern& pattern, int add_var)
     return added;
 }
 
+void compute_pdbs(
+    PPDBCollection& pdbs,
+    std::size_t num_pdbs,
+    unsigned num_threads,
+    const std::function<std::unique_ptr<ProbabilityAwarePatternDatabase>(
+        std::size_t)>& compute_pdb)
+{
+    std::vector<std::unique_ptr<ProbabilityAwarePatternDatabase>> results(
+        num_pdbs);
+
+    if (num_threads <= 1 || num_pdbs <= 1) {
+        for (std::size_t i = 0; i != num_pdbs; ++i) {
+            results[i] = compute_pdb(i);
+        }
+    } else {
+        ThreadPool pool(static_cast<unsigned>(
+            std::min<std::size_t>(num_threads, num_pdbs)));
+
+        parallel_for(pool, num_pdbs, [&](std::size_t i) {
+            results[i] = compute_pdb(i);
+        });
+    }
+
+    pdbs.reserve(pdbs.size() + num_pdbs);
+    for (auto& pdb : results) {
+        pdbs.emplace_back(std::move(pdb));
+    }
+}
+
 std::vector<int> get_goals_in_random_order(
     ProbabilisticTaskProxy task_proxy,
     utils::RandomNumberGenerator& rng)
@@ -0,0 +1,168 @@
+#include "probfd/pdbs/value_table.h"
+
+#include "downward/plugins/plugin.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace probfd::pdbs {
+
+std::size_t ValueTable::get_memory_usage() const
+{
+    switch (format_) {
+    case Format::DOUBLE: return size_ * sizeof(value_t);
+    case Format::FLOAT: return size_ * sizeof(float);
+    case Format::QUANTIZED16: return size_ * sizeof(std::uint16_t);
+    case Format::DICTIONARY8:
+        return size_ * sizeof(std::uint8_t) +
+               dictionary_.size() * sizeof(value_t);
+    case Format::DICTIONARY16:
+        return size_ * sizeof(std::uint16_t) +
+               dictionary_.size() * sizeof(value_t);
+    }
+
+    abort();
+}
+
+void ValueTable::encode(ValueTableEncoding encoding)
+{
+    if (!is_uncompressed()) return;
+
+    switch (encoding) {
+    case ValueTableEncoding::DOUBLE:
+        if (is_view()) {
+            owned_values_.assign(data_, data_ + size_);
+            storage_ = nullptr;
+            data_ = owned_values_.data();
+        }
+        return;
+    case ValueTableEncoding::FLOAT: encode_float(); break;
+    case ValueTableEncoding::QUANTIZED16: encode_quantized(); break;
+    case ValueTableEncoding::DICTIONARY: encode_dictionary(); break;
+    }
+
+    owned_values_ = std::vector<value_t>();
+    storage_ = nullptr;
+    data_ = nullptr;
+}
+
+void ValueTable::encode_float()
+{
+    float_values_.resize(size_);
+
+    for (std::size_t i = 0; i != size_; ++i) {
+        const value_t value = data_[i];
+        auto f = static_cast<float>(value);
+
+        // Round down to stay admissible.
+        if (static_cast<value_t>(f) > value) {
+            f = std::nextafter(f, -std::numeric_limits<float>::infinity());
+        }
+
+        float_values_[i] = f;
+    }
+
+    format_ = Format::FLOAT;
+}
+
+void ValueTable::encode_quantized()
+{
+    constexpr std::uint16_t MAX_CODE = INFINITE_CODE - 1;
+
+    value_t min = INFINITE_VALUE;
+    value_t max = -INFINITE_VALUE;
+
+    for (std::size_t i = 0; i != size_; ++i) {
+        const value_t value = data_[i];
+        if (std::isfinite(value)) {
+            min = std::min(min, value);
+            max = std::max(max, value);
+        }
+    }
+
+    offset_ = min == INFINITE_VALUE ? 0_vt : min;
+    step_ = min < max ? (max - min) / MAX_CODE : 0_vt;
+
+    codes16_.resize(size_);
+
+    for (std::size_t i = 0; i != size_; ++i) {
+        const value_t value = data_[i];
+
+        if (value == INFINITE_VALUE) {
+            codes16_[i] = INFINITE_CODE;
+            continue;
+        }
+
+        if (std::isnan(value) || step_ == 0_vt) {
+            codes16_[i] = 0;
+            continue;
+        }
+
+        auto code = static_cast<std::uint16_t>(
+            std::min<value_t>(std::floor((value - offset_) / step_), MAX_CODE));
+
+        // Compensate rounding errors, the decoded value must not be larger.
+        while (code != 0 && decode_quantized(code) > value) {
+            --code;
+        }
+
+        codes16_[i] = code;
+    }
+
+    format_ = Format::QUANTIZED16;
+}
+
+void ValueTable::encode_dictionary()
+{
+    std::vector<value_t> dictionary;
+
+    for (std::size_t i = 0; i != size_; ++i) {
+        if (!std::isnan(data_[i])) dictionary.push_back(data_[i]);
+    }
+
+    std::ranges::sort(dictionary);
+    const auto [first, last] = std::ranges::unique(dictionary);
+    dictionary.erase(first, last);
+
+    if (dictionary.size() > std::size_t(1) << 16) {
+        encode_quantized();
+        return;
+    }
+
+    if (dictionary.empty()) dictionary.push_back(0_vt);
+
+    auto get_index = [&](value_t value) {
+        if (std::isnan(value)) return std::size_t(0);
+        return static_cast<std::size_t>(
+            std::ranges::lower_bound(dictionary, value) - dictionary.begin());
+    };
+
+    if (dictionary.size() <= std::size_t(1) << 8) {
+        codes8_.resize(size_);
+        for (std::size_t i = 0; i != size_; ++i) {
+            codes8_[i] = static_cast<std::uint8_t>(get_index(data_[i]));
+        }
+        format_ = Format::DICTIONARY8;
+    } else {
+        codes16_.resize(size_);
+        for (std::size_t i = 0; i != size_; ++i) {
+            codes16_[i] = static_cast<std::uint16_t>(get_index(data_[i]));
+        }
+        format_ = Format::DICTIONARY16;
+    }
+
+    dictionary_ = std::move(dictionary);
+}
+
+static plugins::TypedEnumPlugin<ValueTableEncoding> _enum_plugin(
+    {{"double", "stores each value with full precision"},
+     {"float", "stores each value as a 32-bit float, rounded down"},
+     {"quantized16",
+      "stores each value as a 16-bit fixed-point number, rounded down"},
+     {"dictionary",
+      "stores each distinct value once and each state's value as an 8-bit or "
+      "16-bit index, or falls back to quantized16 if there are more than "
+      "65536 distinct values"}});
+
+} // namespace probfd::pdbs
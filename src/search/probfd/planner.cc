@@ -11,6 +11,7 @@
 #include "probfd/task_utils/task_properties.h"
 #include "probfd/tasks/root_task.h"
 
+#include <fstream>
 #include <iostream>
 
 using namespace std;
@@ -27,6 +28,22 @@ int main(int argc, const char** argv)
         utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
     }
 
+    if (static_cast<string>(argv[1]) == "--write-binary-task") {
+        if (argc != 3) {
+            utils::g_log << usage(argv[0]) << endl;
+            utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+        }
+
+        utils::g_log << "converting input to binary task " << argv[2] << "..."
+                     << endl;
+        {
+            ofstream out(argv[2], ios::binary);
+            probfd::tasks::convert_sas_task_to_binary(cin, out);
+        }
+        utils::g_log << "done converting input!" << endl;
+        utils::exit_with(ExitCode::SUCCESS);
+    }
+
     bool unit_cost = false;
     if (static_cast<string>(argv[1]) != "--help") {
         utils::g_log << "reading input..." << endl;
@@ -1,9 +1,20 @@
 #include "probfd/probabilistic_task.h"
 
+#include "probfd/operator_table.h"
+
 #include "downward/plugins/plugin.h"
 
 namespace probfd {
 
+static_assert(sizeof(std::int32_t) == sizeof(int));
+
+void ProbabilisticTask::set_operator_table(const OperatorTable& table)
+{
+    operator_table_ = &table;
+    precondition_offsets = table.precondition_offsets.data();
+    contiguous_preconditions = table.preconditions.data();
+}
+
 static class ProbabilisticTaskCategoryPlugin
     : public plugins::TypedCategoryPlugin<ProbabilisticTask> {
 public:
@@ -0,0 +1,84 @@
+#include "probfd/solvers/mdp_solver.h"
+
+#include "probfd/algorithms/flat_value_iteration.h"
+
+#include "downward/plugins/plugin.h"
+
+#include "downward/operator_id.h"
+#include "downward/task_proxy.h"
+
+#include <memory>
+#include <string>
+
+namespace probfd::solvers {
+namespace {
+
+using namespace algorithms::flat_vi;
+using namespace plugins;
+
+class FlatVISolver : public MDPSolver {
+    const bool topological_;
+    const bool interval_;
+
+public:
+    explicit FlatVISolver(const Options& opts)
+        : MDPSolver(opts)
+        , topological_(opts.get<bool>("topological"))
+        , interval_(opts.get<bool>("interval"))
+    {
+    }
+
+    std::string get_algorithm_name() const override
+    {
+        return "flat_value_iteration";
+    }
+
+    std::unique_ptr<FDRMDPAlgorithm> create_algorithm() override
+    {
+        if (interval_) {
+            return std::make_unique<
+                FlatValueIteration<State, OperatorID, true>>(
+                false,
+                topological_);
+        }
+
+        return std::make_unique<FlatValueIteration<State, OperatorID, false>>(
+            false,
+            topological_);
+    }
+};
+
+class FlatVISolverFeature
+    : public TypedFeature<SolverInterface, FlatVISolver> {
+public:
+    FlatVISolverFeature()
+        : TypedFeature<SolverInterface, FlatVISolver>("flat_value_iteration")
+    {
+        document_title("Value Iteration on a flat explicit MDP snapshot.");
+        document_synopsis(
+            "Explores the reachable state space once and stores it in "
+            "contiguous arrays. Value iteration then runs directly on these "
+            "arrays, without further state space queries.");
+
+        MDPSolver::add_options_to_feature(*this);
+
+        add_option<bool>(
+            "topological",
+            "Whether the SCCs of the state space are solved in reverse "
+            "topological order. Otherwise, Gauss-Seidel sweeps over the "
+            "whole state space are performed.",
+            "true");
+        add_option<bool>(
+            "interval",
+            "Whether lower and upper bounds are computed (interval "
+            "iteration). In this case, traps are collapsed by an end component "
+            "decomposition before the snapshot is taken.",
+            "false");
+    }
+};
+
+} // namespace
+
+static FeaturePlugin<FlatVISolverFeature> _plugin;
+
+} // namespace probfd::solvers
@@ -2,10 +2,11 @@
 
 #include "probfd/tasks/root_task.h"
 
-#include "probfd/task_utils/task_properties.h"
-
 #include "probfd/caching_task_state_space.h"
 
+#include "probfd/storage/spill_file_resource.h"
+#include "probfd/storage/value_file.h"
+
 #include "probfd/evaluator.h"
 #include "probfd/interval.h"
 #include "probfd/mdp_algorithm.h"
@@ -23,7 +24,9 @@
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <memory_resource>
 #include <optional>
+#include <string>
 
 class Evaluator;
 class State;
@@ -37,12 +40,34 @@ namespace probfd::solvers {
 
 using namespace plugins;
 
+static std::unique_ptr<storage::SpillFileResource>
+create_spill_memory(const Options& opts)
+{
+    const auto directory = opts.get<std::string>("spill_directory");
+    if (directory.empty()) return nullptr;
+
+    const std::size_t memory_limit =
+        static_cast<std::size_t>(opts.get<int>("spill_memory_limit")) << 20;
+
+    return std::make_unique<storage::SpillFileResource>(
+        directory,
+        memory_limit);
+}
+
+static std::pmr::memory_resource*
+get_state_memory(storage::SpillFileResource* spill_memory)
+{
+    if (spill_memory) return spill_memory;
+    return std::pmr::get_default_resource();
+}
+
 MDPSolver::MDPSolver(const Options& opts)
     : task_(tasks::g_root_task)
     , task_cost_function_(
           opts.get<std::shared_ptr<TaskCostFunctionFactory>>("costs")
               ->create_cost_function(task_))
     , log_(utils::get_log_from_options(opts))
+    , spill_memory_(create_spill_memory(opts))
     , task_mdp_(
           opts.get<bool>("cache")
               ? new CachingTaskStateSpace(
@@ -50,13 +75,15 @@ MDPSolver::MDPSolver(const Options& opts)
                     log_,
                     task_cost_function_,
                     opts.get_list<std::shared_ptr<::Evaluator>>(
-                        "path_dependent_evaluators"))
+                        "path_dependent_evaluators"),
+                    get_state_memory(spill_memory_.get()))
               : new TaskStateSpace(
                     task_,
                     log_,
                     task_cost_function_,
                     opts.get_list<std::shared_ptr<::Evaluator>>(
-                        "path_dependent_evaluators")))
+                        "path_dependent_evaluators"),
+                    get_state_memory(spill_memory_.get())))
     , heuristic_(opts.get<std::shared_ptr<TaskEvaluatorFactory>>("eval")
                      ->create_evaluator(task_, task_cost_function_))
     , progress_(
@@ -67,9 +94,14 @@ MDPSolver::MDPSolver(const Options& opts)
           opts.get<bool>("report_enabled"))
     , max_time_(opts.get<double>("max_time"))
     , policy_filename(opts.get<std::string>("policy_file"))
+    , value_filename(opts.get<std::string>("value_file"))
     , print_fact_names(opts.get<bool>("print_fact_names"))
     , trajectories(opts.get<int>("trajectories"))
     , trajectory_length(opts.get<int>("trajectory_length"))
+    , trajectory_threads(opts.get<int>("trajectory_threads"))
+    , trajectory_format(
+          opts.get<TrajectoryOutputFormat>("trajectory_format"))
+    , trajectory_file(opts.get<std::string>("trajectory_file"))
     , rng(utils::parse_rng_from_options(opts))
 {
     progress_.register_print([&ss = *this->task_mdp_](std::ostream& out) {
@@ -142,59 +174,34 @@ void MDPSolver::solve()
                 policy->print(out, print_state, print_action);
             }
 
-            {
-                ProbabilisticTaskProxy task_proxy(*task_);
-                ProbabilisticOperatorsProxy operators =
-                    task_proxy.get_operators();
-
-                StateRegistry& state_registry = task_mdp_->get_state_registry();
-
-                for (int i = 0; i < trajectories; ++i) {
-                    std::ofstream out(
-                        std::string("trajectory_") + std::to_string(i) +
-                        ".plan");
-
-                    State state = state_registry.get_initial_state();
-                    value_t plan_cost = 0;
-                    int step = 0;
-
-                    while (auto decision = policy->get_decision(state)) {
-                        auto op = operators[decision->action];
-
-                        // Sample outcome
-                        int outcome_index = 0;
-                        value_t prob_sum = 0_vt;
-
-                        // Ramdom number p in [0, 1)
-                        double p = rng->random();
-                        for (;;) {
-                            prob_sum += op.get_outcomes()[outcome_index]
-                                            .get_probability();
-                            if (p <= prob_sum) break;
-                            ++outcome_index;
-                        }
-
-                        auto outcome = op.get_outcomes()[outcome_index];
-
-			print_state(state, out);
-			out << "(" << op.get_name() << " [outcome "
-                            << outcome_index << "])" << endl;
-
-                        state = state_registry.get_successor_state(
-                            state,
-                            outcome.get_effects());
-                        plan_cost += op.get_cost();
-
-                        if (++step == trajectory_length) break;
-                    }
+            if (!value_filename.empty()) {
+                storage::write_value_file(
+                    value_filename,
+                    *task_,
+                    *task_cost_function_,
+                    *policy);
+            }
 
-                    print_state(state, out);
-		    out << "; cost = " << plan_cost << " ("
-                        << (task_properties::is_unit_cost(task_proxy)
-                                ? "unit cost"
-                                : "general cost")
-                        << ")" << endl;
-                }
+            if (trajectories > 0) {
+                PolicySimulator simulator(
+                    ProbabilisticTaskProxy(*task_),
+                    *task_mdp_,
+                    *policy);
+
+                const SimulationStatistics statistics = simulator.simulate(
+                    trajectories,
+                    trajectory_length,
+                    trajectory_threads,
+                    rng->random(std::numeric_limits<int>::max()),
+                    trajectory_format,
+                    trajectory_file,
+                    print_state);
+
+                std::cout << std::endl;
+                std::cout << "Policy simulation:" << std::endl;
+                std::cout << "  Policy state(s): "
+                          << simulator.get_num_states() << std::endl;
+                statistics.print(std::cout);
             }
         }
 
@@ -204,6 +211,15 @@ void MDPSolver::solve()
                   << task_mdp_->get_num_registered_states() << std::endl;
         task_mdp_->print_statistics();
 
+        if (spill_memory_) {
+            std::cout << "  Spill file allocations: "
+                      << spill_memory_->get_allocated_bytes() << " bytes"
+                      << std::endl;
+            std::cout << "  Spilled to disk: "
+                      << spill_memory_->get_spilled_bytes() << " bytes"
+                      << std::endl;
+        }
+
         std::cout << std::endl;
         std::cout << "Algorithm " << get_algorithm_name()
                   << " statistics:" << std::endl;
@@ -229,6 +245,18 @@ void MDPSolver::add_options_to_feature(Feature& feature)
         "",
         "blind_eval()");
     feature.add_option<bool>("cache", "", "false");
+    feature.add_option<std::string>(
+        "spill_directory",
+        "Directory of a temporary file backing the storage of the registered "
+        "states. State data that was not accessed recently is written to this "
+        "file and released from main memory. Disabled if empty.",
+        "\"\"");
+    feature.add_option<int>(
+        "spill_memory_limit",
+        "Amount of most recently allocated state data (in MiB) that is kept in "
+        "main memory if spill_directory is set.",
+        "1024",
+        Bounds("1", "infinity"));
     feature.add_list_option<std::shared_ptr<::Evaluator>>(
         "path_dependent_evaluators",
         "",
@@ -237,12 +265,49 @@ void MDPSolver::add_options_to_feature(Feature& feature)
     feature.add_option<bool>("report_enabled", "", "true");
     feature.add_option<double>("max_time", "", "infinity");
     feature.add_option<std::string>("policy_file", "", "\"my_policy.policy\"");
+    feature.add_option<std::string>(
+        "value_file",
+        "Binary file to which the state values and actions of the computed "
+        "policy are written, keyed by packed state. The file can be used to "
+        "initialize the state values of later runs with init_values(). "
+        "Disabled if empty.",
+        "\"\"");
     feature.add_option<bool>("print_fact_names", "", "true");
-    feature.add_option<int>("trajectories", "", "0");
-    feature.add_option<int>("trajectory_length", "", "100");
+    feature.add_option<int>(
+        "trajectories",
+        "Number of trajectories sampled from the computed policy.",
+        "0");
+    feature.add_option<int>(
+        "trajectory_length",
+        "Maximal number of steps of a sampled trajectory. Trajectories that "
+        "do not reach a terminal state within this number of steps are "
+        "truncated.",
+        "100",
+        Bounds("1", "infinity"));
+    feature.add_option<int>(
+        "trajectory_threads",
+        "Number of threads used to sample the trajectories. The sampled "
+        "trajectories do not depend on this number.",
+        "1",
+        Bounds("1", "infinity"));
+    feature.add_option<TrajectoryOutputFormat>(
+        "trajectory_format",
+        "Output format of the sampled trajectories.",
+        "separate_files");
+    feature.add_option<std::string>(
+        "trajectory_file",
+        "Output file of the sampled trajectories for the formats text and "
+        "binary.",
+        "\"trajectories.plan\"");
     utils::add_rng_options(feature);
 
     utils::add_log_options_to_feature(feature);
 }
 
+static TypedEnumPlugin<TrajectoryOutputFormat> _enum_plugin(
+    {{"separate_files", "one text file trajectory_<i>.plan per trajectory"},
+     {"text", "all trajectories in a single text file"},
+     {"binary", "all trajectories in a single binary file"},
+     {"none", "only report the simulation statistics"}});
+
 } // namespace probfd::solvers
@@ -0,0 +1,352 @@
+#include "probfd/solvers/policy_simulator.h"
+
+#include "probfd/task_utils/task_properties.h"
+
+#include "probfd/utils/thread_pool.h"
+
+#include "probfd/task_state_space.h"
+
+#include "downward/utils/hash.h"
+#include "downward/utils/rng.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+
+namespace probfd::solvers {
+
+namespace {
+
+constexpr char MAGIC[8] = {'P', 'T', 'R', 'A', 'J', '\0', '\0', '\0'};
+constexpr std::uint32_t FORMAT_VERSION = 1;
+
+// Trajectories are sampled and written in batches of this size.
+constexpr int BATCH_SIZE = 1024;
+
+// The 97.5% quantile of the standard normal distribution.
+constexpr double Z_95 = 1.959963984540054;
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t value_size;
+    std::uint64_t num_trajectories;
+};
+
+struct RecordHeader {
+    std::uint32_t num_steps;
+    std::uint32_t flags;
+    value_t cost;
+};
+
+struct Step {
+    int state;
+    int outcome;
+};
+
+struct Trajectory {
+    std::vector<Step> steps;
+    int final_state = 0;
+    value_t cost = 0_vt;
+    bool truncated = false;
+};
+
+int get_trajectory_seed(std::uint64_t seed, int trajectory)
+{
+    utils::HashState hash_state;
+    utils::feed(hash_state, seed);
+    utils::feed(hash_state, trajectory);
+    return static_cast<int>(hash_state.get_hash32() >> 1);
+}
+
+template <typename T>
+void write_binary(std::ostream& out, const T& t)
+{
+    out.write(reinterpret_cast<const char*>(&t), sizeof(T));
+}
+
+} // namespace
+
+double SimulationStatistics::get_average_cost() const
+{
+    return trajectories == 0 ? 0.0 : cost_sum / trajectories;
+}
+
+double SimulationStatistics::get_cost_confidence_radius() const
+{
+    if (trajectories < 2) return INFINITE_VALUE;
+
+    const double n = static_cast<double>(trajectories);
+    const double mean = cost_sum / n;
+    const double variance =
+        std::max(0.0, (squared_cost_sum - n * mean * mean) / (n - 1));
+
+    return Z_95 * std::sqrt(variance / n);
+}
+
+double SimulationStatistics::get_goal_probability() const
+{
+    return trajectories == 0
+               ? 0.0
+               : static_cast<double>(goal_trajectories) / trajectories;
+}
+
+std::pair<double, double>
+SimulationStatistics::get_goal_probability_interval() const
+{
+    if (trajectories == 0) return {0.0, 1.0};
+
+    const double n = static_cast<double>(trajectories);
+    const double p = get_goal_probability();
+    const double z2 = Z_95 * Z_95;
+
+    const double center = (p + z2 / (2 * n)) / (1 + z2 / n);
+    const double radius =
+        Z_95 / (1 + z2 / n) * std::sqrt(p * (1 - p) / n + z2 / (4 * n * n));
+
+    return {std::max(0.0, center - radius), std::min(1.0, center + radius)};
+}
+
+void SimulationStatistics::print(std::ostream& out) const
+{
+    const auto [goal_lower, goal_upper] = get_goal_probability_interval();
+
+    out << "  Trajectories: " << trajectories << std::endl;
+    out << "  Truncated trajectories: " << truncated_trajectories << std::endl;
+    out << "  Average trajectory length: "
+        << (trajectories == 0 ? 0.0
+                              : static_cast<double>(steps) / trajectories)
+        << std::endl;
+    out << "  Goal probability: " << get_goal_probability()
+        << " (95% confidence interval: [" << goal_lower << ", " << goal_upper
+        << "])" << std::endl;
+    out << "  Average cost: " << get_average_cost()
+        << " (95% confidence interval: +/- " << get_cost_confidence_radius()
+        << ")" << std::endl;
+}
+
+PolicySimulator::PolicySimulator(
+    ProbabilisticTaskProxy task_proxy,
+    TaskStateSpace& state_space,
+    const Policy<State, OperatorID>& policy)
+    : task_proxy_(task_proxy)
+    , state_space_(state_space)
+{
+    StateRegistry& state_registry = state_space.get_state_registry();
+    ProbabilisticOperatorsProxy operators = task_proxy.get_operators();
+
+    // Maps registry state IDs to the index of the state in the arrays.
+    std::vector<int> index_of;
+
+    auto get_index = [&](const State& state) {
+        const int id = state.get_id().get_value();
+        if (static_cast<std::size_t>(id) >= index_of.size()) {
+            index_of.resize(id + 1, -1);
+        }
+
+        int& index = index_of[id];
+        if (index == -1) {
+            index = static_cast<int>(state_ids_.size());
+            state_ids_.push_back(state.get_id());
+        }
+
+        return index;
+    };
+
+    get_index(state_space.get_initial_state());
+    outcome_offsets_.push_back(0);
+
+    // The state IDs double as the queue of states to expand.
+    for (std::size_t i = 0; i != state_ids_.size(); ++i) {
+        const State state = state_registry.lookup_state(state_ids_[i]);
+
+        is_goal_.push_back(state_space.is_goal(state));
+
+        const std::optional decision = policy.get_decision(state);
+
+        if (!decision) {
+            operators_.push_back(OperatorID::no_operator);
+            costs_.push_back(0_vt);
+            outcome_offsets_.push_back(cumulative_probabilities_.size());
+            continue;
+        }
+
+        const ProbabilisticOperatorProxy op = operators[decision->action];
+        operators_.push_back(decision->action);
+        costs_.push_back(op.get_cost());
+
+        value_t probability_sum = 0_vt;
+
+        for (const ProbabilisticOutcomeProxy outcome : op.get_outcomes()) {
+            probability_sum += outcome.get_probability();
+            cumulative_probabilities_.push_back(probability_sum);
+
+            const State successor = state_registry.get_successor_state(
+                state,
+                outcome.get_effects());
+            successors_.push_back(get_index(successor));
+        }
+
+        outcome_offsets_.push_back(cumulative_probabilities_.size());
+    }
+}
+
+SimulationStatistics PolicySimulator::simulate(
+    int num_trajectories,
+    int max_length,
+    unsigned num_threads,
+    std::uint64_t seed,
+    TrajectoryOutputFormat format,
+    const std::string& filename,
+    const StatePrinter& print_state) const
+{
+    assert(max_length > 0);
+
+    const ProbabilisticOperatorsProxy operators = task_proxy_.get_operators();
+    StateRegistry& state_registry = state_space_.get_state_registry();
+
+    const char* const cost_type = task_properties::is_unit_cost(task_proxy_)
+                                      ? "unit cost"
+                                      : "general cost";
+
+    auto sample = [&](int index, Trajectory& trajectory) {
+        utils::RandomNumberGenerator rng(get_trajectory_seed(seed, index));
+
+        trajectory.steps.clear();
+        trajectory.cost = 0_vt;
+        trajectory.truncated = false;
+
+        int state = 0;
+
+        while (operators_[state] != OperatorID::no_operator) {
+            if (static_cast<int>(trajectory.steps.size()) == max_length) {
+                trajectory.truncated = true;
+                break;
+            }
+
+            const auto first = cumulative_probabilities_.begin() +
+                               outcome_offsets_[state];
+            const auto last = cumulative_probabilities_.begin() +
+                              outcome_offsets_[state + 1];
+
+            // Random number p in [0, 1), choose the first outcome whose
+            // cumulative probability is at least p.
+            const value_t p = rng.random();
+            const auto it =
+                std::min(std::lower_bound(first, last, p), last - 1);
+            const int outcome = static_cast<int>(it - first);
+
+            trajectory.steps.emplace_back(state, outcome);
+            trajectory.cost += costs_[state];
+            state = successors_[outcome_offsets_[state] + outcome];
+        }
+
+        trajectory.final_state = state;
+    };
+
+    auto write_text = [&](const Trajectory& trajectory, std::ostream& out) {
+        for (const auto& [state, outcome] : trajectory.steps) {
+            print_state(state_registry.lookup_state(state_ids_[state]), out);
+            out << "(" << operators[operators_[state]].get_name()
+                << " [outcome " << outcome << "])" << std::endl;
+        }
+
+        print_state(
+            state_registry.lookup_state(state_ids_[trajectory.final_state]),
+            out);
+        out << "; cost = " << trajectory.cost << " (" << cost_type << ")"
+            << std::endl;
+    };
+
+    std::ofstream out;
+
+    if (format == TrajectoryOutputFormat::TEXT) {
+        out.open(filename);
+    } else if (format == TrajectoryOutputFormat::BINARY) {
+        out.open(filename, std::ios::binary);
+
+        FileHeader header;
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = FORMAT_VERSION;
+        header.value_size = sizeof(value_t);
+        header.num_trajectories = num_trajectories;
+        write_binary(out, header);
+    }
+
+    std::unique_ptr<ThreadPool> pool;
+    if (num_threads > 1) pool = std::make_unique<ThreadPool>(num_threads);
+
+    SimulationStatistics statistics;
+    std::vector<Trajectory> batch(std::min(num_trajectories, BATCH_SIZE));
+
+    for (int begin = 0; begin < num_trajectories; begin += BATCH_SIZE) {
+        const int size = std::min(BATCH_SIZE, num_trajectories - begin);
+
+        if (pool) {
+            parallel_for(*pool, size, [&](std::size_t i) {
+                sample(begin + static_cast<int>(i), batch[i]);
+            });
+        } else {
+            for (int i = 0; i != size; ++i) sample(begin + i, batch[i]);
+        }
+
+        // Write the trajectories in order and collect the statistics.
+        for (int i = 0; i != size; ++i) {
+            const Trajectory& trajectory = batch[i];
+            const bool goal = is_goal_[trajectory.final_state];
+
+            ++statistics.trajectories;
+            statistics.steps += trajectory.steps.size();
+            statistics.cost_sum += trajectory.cost;
+            statistics.squared_cost_sum += trajectory.cost * trajectory.cost;
+            if (goal) ++statistics.goal_trajectories;
+            if (trajectory.truncated) ++statistics.truncated_trajectories;
+
+            switch (format) {
+            case TrajectoryOutputFormat::SEPARATE_FILES: {
+                std::ofstream file(
+                    "trajectory_" + std::to_string(begin + i) + ".plan");
+                write_text(trajectory, file);
+                break;
+            }
+            case TrajectoryOutputFormat::TEXT:
+                out << "; trajectory " << begin + i << std::endl;
+                write_text(trajectory, out);
+                break;
+            case TrajectoryOutputFormat::BINARY: {
+                RecordHeader record;
+                record.num_steps =
+                    static_cast<std::uint32_t>(trajectory.steps.size());
+                record.flags = (goal ? 1U : 0U) |
+                               (trajectory.truncated ? 2U : 0U);
+                record.cost = trajectory.cost;
+                write_binary(out, record);
+
+                for (const auto& [state, outcome] : trajectory.steps) {
+                    write_binary(
+                        out,
+                        static_cast<std::int32_t>(
+                            operators_[state].get_index()));
+                    write_binary(out, static_cast<std::int32_t>(outcome));
+                }
+                break;
+            }
+            case TrajectoryOutputFormat::NONE: break;
+            }
+        }
+    }
+
+    if (out.is_open() && !out.flush()) {
+        std::cerr << "Could not write trajectory file " << filename
+                  << std::endl;
+    }
+
+    return statistics;
+}
+
+} // namespace probfd::solvers
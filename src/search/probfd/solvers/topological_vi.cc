@@ -17,8 +17,14 @@ using namespace algorithms::topological_vi;
 using namespace plugins;
 
 class TopologicalVISolver : public MDPSolver {
+    const int num_threads_;
+
 public:
-    using MDPSolver::MDPSolver;
+    explicit TopologicalVISolver(const Options& opts)
+        : MDPSolver(opts)
+        , num_threads_(opts.get<int>("threads"))
+    {
+    }
 
     std::string get_algorithm_name() const override
     {
@@ -28,7 +34,8 @@ public:
     std::unique_ptr<FDRMDPAlgorithm> create_algorithm() override
     {
         return std::make_unique<TopologicalValueIteration<State, OperatorID>>(
-            false);
+            false,
+            num_threads_);
     }
 };
 
@@ -41,6 +48,17 @@ public:
     {
         document_title("Topological Value Iteration.");
         MDPSolver::add_options_to_feature(*this);
+
+        add_option<int>(
+            "threads",
+            "Number of threads used to solve independent SCCs in parallel. "
+            "With more than one thread, the SCCs are solved after the "
+            "reachable state space has been explored completely. The max_time "
+            "limit measures the CPU time summed over all threads, so with N "
+            "threads it may be reached up to N times sooner in wall-clock time "
+            "than with a single thread.",
+            "1",
+            Bounds("1", "infinity"));
     }
 };
 
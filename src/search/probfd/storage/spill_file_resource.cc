@@ -0,0 +1,141 @@
+#include "probfd/storage/spill_file_resource.h"
+
+#include "downward/utils/system.h"
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace probfd::storage {
+
+static constexpr std::size_t MIN_REGION_SIZE = std::size_t(1) << 20;
+static constexpr std::size_t MAX_REGION_SIZE = std::size_t(64) << 20;
+
+SpillFileResource::SpillFileResource(
+    const std::filesystem::path& directory,
+    std::size_t memory_limit)
+    : memory_limit_(memory_limit)
+    , region_size_(
+          std::clamp(memory_limit / 8, MIN_REGION_SIZE, MAX_REGION_SIZE))
+{
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+    // Regions are mapped at file offsets that are multiples of their size.
+    const auto page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    region_size_ = (region_size_ + page_size - 1) / page_size * page_size;
+
+    std::string file_template = (directory / "probfd-spill-XXXXXX").string();
+    fd_ = ::mkstemp(file_template.data());
+
+    if (fd_ == -1) {
+        std::cerr << "Could not create a spill file in " << directory
+                  << std::endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+
+    // The file is removed once it is closed.
+    ::unlink(file_template.c_str());
+#else
+    std::cerr << "Spill files are not supported on this operating system. "
+              << "Using main memory instead." << std::endl;
+#endif
+}
+
+SpillFileResource::~SpillFileResource()
+{
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+    for (const Region& region : regions_) {
+        ::munmap(region.data, region.size);
+    }
+
+    if (fd_ != -1) ::close(fd_);
+#endif
+}
+
+void* SpillFileResource::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    allocated_bytes_ += bytes;
+
+    if (fd_ == -1) return fallback_.allocate(bytes, alignment);
+
+    void* p = current_;
+    if (!std::align(alignment, bytes, p, space_left_)) {
+        // Regions are page-aligned, so a new region is suitably aligned.
+        add_region(bytes);
+        p = current_;
+    }
+
+    current_ = static_cast<std::byte*>(p) + bytes;
+    space_left_ -= bytes;
+
+    spill_cold_regions();
+
+    return p;
+}
+
+void SpillFileResource::add_region(std::size_t min_size)
+{
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+    const std::size_t size =
+        (min_size + region_size_ - 1) / region_size_ * region_size_;
+    const std::size_t offset = file_size_;
+
+    if (::ftruncate(fd_, static_cast<off_t>(offset + size)) != 0) {
+        throw std::bad_alloc();
+    }
+
+    void* data = ::mmap(
+        nullptr,
+        size,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED,
+        fd_,
+        static_cast<off_t>(offset));
+
+    if (data == MAP_FAILED) throw std::bad_alloc();
+
+    file_size_ = offset + size;
+    regions_.emplace_back(static_cast<std::byte*>(data), offset, size);
+    current_ = static_cast<std::byte*>(data);
+    space_left_ = size;
+#else
+    (void)min_size;
+#endif
+}
+
+void SpillFileResource::spill_cold_regions()
+{
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+    // The current position in the file.
+    const std::size_t frontier = file_size_ - space_left_;
+
+    while (num_cold_regions_ + 1 < regions_.size()) {
+        const Region& region = regions_[num_cold_regions_];
+        if (frontier - (region.offset + region.size) < memory_limit_) break;
+
+        /*
+          Let the operating system write the region back to the file and
+          release its pages. Pages accessed again later are faulted back in
+          and may be reclaimed by the operating system at any time, since they
+          are backed by the file.
+        */
+#ifdef MADV_PAGEOUT
+        ::madvise(region.data, region.size, MADV_PAGEOUT);
+#else
+        ::msync(region.data, region.size, MS_ASYNC);
+        ::madvise(region.data, region.size, MADV_DONTNEED);
+#endif
+
+        spilled_bytes_ += region.size;
+        ++num_cold_regions_;
+    }
+#endif
+}
+
+} // namespace probfd::storage
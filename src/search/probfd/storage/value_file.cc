@@ -0,0 +1,313 @@
+#include "probfd/storage/value_file.h"
+
+#include "probfd/cost_function.h"
+#include "probfd/policy.h"
+#include "probfd/probabilistic_task.h"
+#include "probfd/task_proxy.h"
+
+#include "downward/task_utils/task_properties.h"
+
+#include "downward/utils/hash.h"
+#include "downward/utils/system.h"
+
+#include "downward/operator_id.h"
+#include "downward/state_registry.h"
+#include "downward/task_proxy.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+
+namespace probfd::storage {
+
+namespace {
+constexpr char MAGIC[8] = {'P', 'F', 'D', 'V', 'A', 'L', 'S', '\0'};
+
+void feed_value(utils::HashState& hash_state, value_t value)
+{
+    utils::feed(hash_state, std::bit_cast<std::uint64_t>(value));
+}
+
+template <typename T>
+void write_raw(std::ostream& out, const T* data, std::size_t count = 1)
+{
+    out.write(reinterpret_cast<const char*>(data), sizeof(T) * count);
+}
+
+template <typename T>
+void read_raw(
+    std::istream& in,
+    const std::filesystem::path& path,
+    T* data,
+    std::size_t count = 1)
+{
+    in.read(reinterpret_cast<char*>(data), sizeof(T) * count);
+
+    if (!in) {
+        std::cerr << "Value file " << path << " is truncated." << std::endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+}
+} // namespace
+
+std::uint64_t compute_task_fingerprint(
+    const ProbabilisticTask& task,
+    FDRCostFunction& cost_function)
+{
+    utils::HashState hash_state;
+
+    const int num_variables = task.get_num_variables();
+    utils::feed(hash_state, num_variables);
+    for (int var = 0; var != num_variables; ++var) {
+        utils::feed(hash_state, task.get_variable_domain_size(var));
+    }
+
+    const int num_axioms = task.get_num_axioms();
+    utils::feed(hash_state, num_axioms);
+    for (int axiom = 0; axiom != num_axioms; ++axiom) {
+        const int num_pres = task.get_num_axiom_preconditions(axiom);
+        utils::feed(hash_state, num_pres);
+        for (int i = 0; i != num_pres; ++i) {
+            utils::feed(hash_state, task.get_axiom_precondition(axiom, i));
+        }
+
+        const int num_effs = task.get_num_axiom_effects(axiom);
+        utils::feed(hash_state, num_effs);
+        for (int i = 0; i != num_effs; ++i) {
+            utils::feed(hash_state, task.get_axiom_effect(axiom, i));
+            const int num_conds =
+                task.get_num_axiom_effect_conditions(axiom, i);
+            utils::feed(hash_state, num_conds);
+            for (int j = 0; j != num_conds; ++j) {
+                utils::feed(
+                    hash_state,
+                    task.get_axiom_effect_condition(axiom, i, j));
+            }
+        }
+    }
+
+    const int num_operators = task.get_num_operators();
+    utils::feed(hash_state, num_operators);
+    for (int op = 0; op != num_operators; ++op) {
+        feed_value(hash_state, cost_function.get_action_cost(OperatorID(op)));
+
+        const int num_pres = task.get_num_operator_preconditions(op);
+        utils::feed(hash_state, num_pres);
+        for (int i = 0; i != num_pres; ++i) {
+            utils::feed(hash_state, task.get_operator_precondition(op, i));
+        }
+
+        const int num_outcomes = task.get_num_operator_outcomes(op);
+        utils::feed(hash_state, num_outcomes);
+        for (int out = 0; out != num_outcomes; ++out) {
+            feed_value(
+                hash_state,
+                task.get_operator_outcome_probability(op, out));
+
+            const int num_effs = task.get_num_operator_outcome_effects(op, out);
+            utils::feed(hash_state, num_effs);
+            for (int i = 0; i != num_effs; ++i) {
+                utils::feed(
+                    hash_state,
+                    task.get_operator_outcome_effect(op, out, i));
+                const int num_conds =
+                    task.get_num_operator_outcome_effect_conditions(
+                        op,
+                        out,
+                        i);
+                utils::feed(hash_state, num_conds);
+                for (int j = 0; j != num_conds; ++j) {
+                    utils::feed(
+                        hash_state,
+                        task.get_operator_outcome_effect_condition(
+                            op,
+                            out,
+                            i,
+                            j));
+                }
+            }
+        }
+    }
+
+    const int num_goals = task.get_num_goals();
+    utils::feed(hash_state, num_goals);
+    for (int i = 0; i != num_goals; ++i) {
+        utils::feed(hash_state, task.get_goal_fact(i));
+    }
+
+    // The action costs were fed above. Goal states terminate without cost.
+    feed_value(hash_state, cost_function.get_non_goal_termination_cost());
+
+    return hash_state.get_hash64();
+}
+
+void write_value_file(
+    const std::filesystem::path& path,
+    const ProbabilisticTask& task,
+    FDRCostFunction& cost_function,
+    const Policy<State, OperatorID>& policy)
+{
+    using Bin = int_packer::IntPacker::Bin;
+
+    ProbabilisticTaskProxy task_proxy(task);
+    const int_packer::IntPacker& packer =
+        task_properties::g_state_packers[task_proxy];
+    const std::size_t bins_per_state = packer.get_num_bins();
+
+    std::vector<Bin> states;
+    std::vector<int> operators;
+    std::vector<Interval> values;
+
+    policy.for_each_decision(
+        [&](const State& state, const PolicyDecision<OperatorID>& decision) {
+            assert(&state.get_registry()->get_state_packer() == &packer);
+            const Bin* buffer = state.get_buffer();
+            states.insert(states.end(), buffer, buffer + bins_per_state);
+            operators.push_back(decision.action.get_index());
+            values.push_back(decision.q_value_interval);
+        });
+
+    // Sort the records by packed state for lookups with a binary search.
+    std::vector<std::size_t> order(values.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::sort(order, [&](std::size_t left, std::size_t right) {
+        return std::lexicographical_compare(
+            states.data() + left * bins_per_state,
+            states.data() + (left + 1) * bins_per_state,
+            states.data() + right * bins_per_state,
+            states.data() + (right + 1) * bins_per_state);
+    });
+
+    std::ofstream out(path, std::ios::binary);
+
+    const auto num_variables =
+        static_cast<std::uint32_t>(task.get_num_variables());
+    const std::uint64_t fingerprint =
+        compute_task_fingerprint(task, cost_function);
+    const auto num_bins = static_cast<std::uint32_t>(bins_per_state);
+    const std::uint64_t num_entries = values.size();
+
+    write_raw(out, MAGIC, sizeof(MAGIC));
+    write_raw(out, &num_variables);
+    for (std::uint32_t var = 0; var != num_variables; ++var) {
+        const std::int32_t domain_size = task.get_variable_domain_size(var);
+        write_raw(out, &domain_size);
+    }
+    write_raw(out, &fingerprint);
+    write_raw(out, &num_bins);
+    write_raw(out, &num_entries);
+
+    for (const std::size_t index : order) {
+        const std::int32_t op = operators[index];
+        const value_t lower = values[index].lower;
+        const value_t upper = values[index].upper;
+        write_raw(out, states.data() + index * bins_per_state, bins_per_state);
+        write_raw(out, &op);
+        write_raw(out, &lower);
+        write_raw(out, &upper);
+    }
+
+    if (!out) {
+        std::cerr << "Could not write value file " << path << std::endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+}
+
+ValueFile::ValueFile(const std::filesystem::path& path)
+{
+    std::ifstream in(path, std::ios::binary);
+
+    if (!in) {
+        std::cerr << "Could not open value file " << path << std::endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+
+    char magic[sizeof(MAGIC)];
+    read_raw(in, path, magic, sizeof(MAGIC));
+
+    if (std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+        std::cerr << path << " is not a value file." << std::endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+
+    std::uint32_t num_variables;
+    read_raw(in, path, &num_variables);
+    domain_sizes_.resize(num_variables);
+    read_raw(in, path, domain_sizes_.data(), num_variables);
+
+    read_raw(in, path, &task_fingerprint_);
+
+    std::uint32_t num_bins;
+    read_raw(in, path, &num_bins);
+    bins_per_state_ = num_bins;
+
+    std::uint64_t num_entries;
+    read_raw(in, path, &num_entries);
+
+    states_.resize(num_entries * bins_per_state_);
+    values_.reserve(num_entries);
+
+    for (std::size_t i = 0; i != num_entries; ++i) {
+        // The policy operator is not needed for lookups.
+        std::int32_t op;
+        value_t lower;
+        value_t upper;
+        read_raw(in, path, states_.data() + i * bins_per_state_, num_bins);
+        read_raw(in, path, &op);
+        read_raw(in, path, &lower);
+        read_raw(in, path, &upper);
+        values_.emplace_back(lower, upper);
+    }
+}
+
+bool ValueFile::has_same_variables(const ProbabilisticTask& task) const
+{
+    if (static_cast<int>(domain_sizes_.size()) != task.get_num_variables()) {
+        return false;
+    }
+
+    for (std::size_t var = 0; var != domain_sizes_.size(); ++var) {
+        if (domain_sizes_[var] != task.get_variable_domain_size(var)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+const Interval* ValueFile::lookup(const Bin* packed_state) const
+{
+    std::size_t low = 0;
+    std::size_t high = values_.size();
+
+    // Binary search for the first stored state not less than the state.
+    while (low < high) {
+        const std::size_t mid = low + (high - low) / 2;
+        const Bin* stored = get_state(mid);
+        if (std::lexicographical_compare(
+                stored,
+                stored + bins_per_state_,
+                packed_state,
+                packed_state + bins_per_state_)) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    if (low == values_.size() ||
+        !std::equal(
+            packed_state,
+            packed_state + bins_per_state_,
+            get_state(low))) {
+        return nullptr;
+    }
+
+    return &values_[low];
+}
+
+} // namespace probfd::storage
@@ -29,11 +29,12 @@ TaskStateSpace::TaskStateSpace(
     std::shared_ptr<ProbabilisticTask> task,
     utils::LogProxy log,
     std::shared_ptr<FDRSimpleCostFunction> cost_function,
-    const std::vector<std::shared_ptr<::Evaluator>>& path_dependent_evaluators)
+    const std::vector<std::shared_ptr<::Evaluator>>& path_dependent_evaluators,
+    std::pmr::memory_resource* state_memory)
     : task_proxy_(*task)
     , log_(std::move(log))
     , gen_(task_proxy_)
-    , state_registry_(task_proxy_)
+    , state_registry_(task_proxy_, state_memory)
     , cost_function_(std::move(cost_function))
     , notify_(path_dependent_evaluators)
 {
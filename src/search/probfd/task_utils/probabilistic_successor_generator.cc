@@ -3,26 +3,161 @@
 #include "probfd/task_utils/probabilistic_successor_generator_factory.h"
 #include "probfd/task_utils/probabilistic_successor_generator_internals.h"
 
+#include "probfd/task_state_space.h"
+#include "probfd/transition.h"
+
+#include "downward/task_utils/task_properties.h"
+
+#include "downward/state_registry.h"
 #include "downward/task_proxy.h"
 
+#include <cassert>
+#include <cstdlib>
+
 using namespace std;
 
 namespace probfd::successor_generator {
 
+namespace {
+class PackedValues {
+    const int_packer::IntPacker::Bin* buffer_;
+    const int_packer::IntPacker::Location* locations_;
+
+public:
+    PackedValues(
+        const int_packer::IntPacker::Bin* buffer,
+        const int_packer::IntPacker::Location* locations)
+        : buffer_(buffer)
+        , locations_(locations)
+    {
+    }
+
+    int operator[](int var) const
+    {
+        const int_packer::IntPacker::Location& location = locations_[var];
+        return static_cast<int>(
+            (buffer_[location.bin_index] & location.read_mask) >>
+            location.shift);
+    }
+};
+
+class UnpackedValues {
+    const int* values_;
+
+public:
+    explicit UnpackedValues(const int* values)
+        : values_(values)
+    {
+    }
+
+    int operator[](int var) const { return values_[var]; }
+};
+
+/*
+  Calls f for all operators applicable in the state with the given values,
+  starting at the node at position pc. The last child of a fork and the
+  selected child of a switch are visited without recursion.
+*/
+template <typename Values, typename F>
+void for_each_applicable(const int* code, int pc, const Values& values, F& f)
+{
+    for (;;) {
+        const int* node = code + pc;
+
+        switch (node[0]) {
+        case FORK: {
+            const int num_children = node[1];
+            if (num_children == 0) return;
+            for (int i = 0; i != num_children - 1; ++i) {
+                for_each_applicable(code, node[2 + i], values, f);
+            }
+            pc = node[1 + num_children];
+            break;
+        }
+
+        case VECTOR_SWITCH:
+            pc = node[2 + values[node[1]]];
+            if (pc == NO_CHILD) return;
+            break;
+
+        case SORTED_SWITCH: {
+            const int value = values[node[1]];
+            const int* entries = node + 3;
+            int low = 0;
+            int high = node[2];
+
+            // Binary search for the value.
+            while (low < high) {
+                const int mid = (low + high) / 2;
+                if (entries[2 * mid] < value) {
+                    low = mid + 1;
+                } else {
+                    high = mid;
+                }
+            }
+
+            if (low == node[2] || entries[2 * low] != value) return;
+            pc = entries[2 * low + 1];
+            break;
+        }
+
+        case SINGLE_SWITCH:
+            if (values[node[1]] != node[2]) return;
+            pc = node[3];
+            break;
+
+        case LEAF:
+            for (int i = 0; i != node[1]; ++i) {
+                f(OperatorID(node[2 + i]));
+            }
+            return;
+
+        default: abort();
+        }
+    }
+}
+} // namespace
+
 ProbabilisticSuccessorGenerator::ProbabilisticSuccessorGenerator(
     const TaskBaseProxy& task_proxy)
-    : root_(ProbabilisticSuccessorGeneratorFactory(task_proxy).create())
+    : state_packer_(&task_properties::g_state_packers[task_proxy])
 {
+    root_ = ProbabilisticSuccessorGeneratorFactory(task_proxy)
+                .create()
+                ->compile(code_);
+
+    const int num_variables =
+        static_cast<int>(task_proxy.get_variables().size());
+    locations_.reserve(num_variables);
+    for (int var = 0; var != num_variables; ++var) {
+        locations_.push_back(state_packer_->get_location(var));
+    }
 }
 
-ProbabilisticSuccessorGenerator::~ProbabilisticSuccessorGenerator() = default;
+template <typename F>
+void ProbabilisticSuccessorGenerator::for_each_applicable_operator(
+    const State& state,
+    F f) const
+{
+    const StateRegistry* registry = state.get_registry();
+
+    if (registry && &registry->get_state_packer() == state_packer_) {
+        const PackedValues values(state.get_buffer(), locations_.data());
+        for_each_applicable(code_.data(), root_, values, f);
+    } else {
+        state.unpack();
+        const UnpackedValues values(state.get_unpacked_values().data());
+        for_each_applicable(code_.data(), root_, values, f);
+    }
+}
 
 void ProbabilisticSuccessorGenerator::generate_applicable_ops(
     const State& state,
     vector<OperatorID>& applicable_ops) const
 {
-    state.unpack();
-    root_->generate_applicable_ops(state.get_unpacked_values(), applicable_ops);
+    for_each_applicable_operator(state, [&](OperatorID id) {
+        applicable_ops.push_back(id);
+    });
 }
 
 void ProbabilisticSuccessorGenerator::generate_transitions(
@@ -30,8 +165,10 @@ void ProbabilisticSuccessorGenerator::generate_transitions(
     std::vector<Transition<OperatorID>>& transitions,
     TaskStateSpace& task_state_space) const
 {
-    state.unpack();
-    root_->generate_transitions(state, transitions, task_state_space);
+    for_each_applicable_operator(state, [&](OperatorID id) {
+        auto& t = transitions.emplace_back(id);
+        task_state_space.compute_successor_dist(state, id, t.successor_dist);
+    });
 }
 
 } // namespace probfd::successor_generator
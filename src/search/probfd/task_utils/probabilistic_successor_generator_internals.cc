@@ -1,74 +1,15 @@
 #include "probfd/task_utils/probabilistic_successor_generator_internals.h"
 
-#include "downward/task_proxy.h"
-
-#include "probfd/task_state_space.h"
-#include "probfd/transition.h"
-
+#include <algorithm>
 #include <cassert>
 #include <utility>
 
 using namespace std;
 
 /*
-  Notes on possible optimizations:
-
-  - Using specialized allocators (e.g. an arena allocator) could
-    improve cache locality and reduce memory.
-
-  - We could keep the different nodes in a single vector (for example
-    of type unique_ptr<ProbabilisticGeneratorBase>) and then use indices rather
-    than pointers for representing child nodes. This would reduce the
-    memory overhead for pointers in 64-bit builds. However, this
-    overhead is not as bad as it used to be.
-
-  - Going further down this route, on the more extreme end of the
-    spectrum, we could use a "byte-code" style representation, where
-    the successor generator is just a long vector of ints combining
-    information about node type with node payload.
-
-    For example, we could represent different node types as follows,
-    where BINARY_FORK etc. are symbolic constants for tagging node
-    types:
-
-    - binary fork: [BINARY_FORK, child_1, child_2]
-    - multi-fork:  [MULTI_FORK, n, child_1, ..., child_n]
-    - vector switch: [VECTOR_SWITCH, var_id, child_1, ..., child_k]
-    - single switch: [SINGLE_SWITCH, var_id, value, child_index]
-    - hash switch: [HASH_SWITCH, var_id, map_no]
-      where map_no is an index into a separate vector of hash maps
-      (represented out of band)
-    - single leaf: [SINGLE_LEAF, op_id]
-    - vector leaf: [VECTOR_LEAF, n, op_id_1, ..., op_id_n]
-
-    We could compact this further by permitting to use operator IDs
-    directly wherever child nodes are used, by using e.g. negative
-    numbers for operatorIDs and positive numbers for node IDs,
-    obviating the need for SINGLE_LEAF. This would also make
-    VECTOR_LEAF redundant, as MULTI_FORK could be used instead.
-
-    Further, if the other symbolic constants are negative numbers,
-    we could represent forks just as [n, child_1, ..., child_n] without
-    symbolic constant at the start, unifying binary and multi-forks.
-
-    To completely unify the representation, not needing hash values
-    out of band, we might consider switches of the form [SWITCH, k,
-    var_id, value_1, child_1, ..., value_k, child_k] that permit
-    binary searching. This would only leave switch and fork nodes, and
-    we could do away with the type tags by just using +k for one node
-    type and -k for the other. (But it may be useful to leave the
-    possibility of the current vector switches for very dense switch
-    nodes, which could be used in the case where k equals the domain
-    size of the variable in question.)
-
-  - More modestly, we could stick with the current polymorphic code,
-    but just use more types of nodes, such as switch nodes that stores
-    a vector of (value, child) pairs to be scanned linearly or with
-    binary search.
-
-  - We can also try to optimize memory usage of the existing nodes
-    further, e.g. by replacing vectors with something smaller, like a
-    zero-terminated heap-allocated array.
+  The nodes are compiled in post-order, i.e., the code of the children of a
+  node precedes the code of the node, so that the positions of the children
+  are known when the code of the node is emitted. The root is compiled last.
 */
 
 namespace probfd::successor_generator {
@@ -86,21 +27,14 @@ ProbabilisticGeneratorForkBinary::ProbabilisticGeneratorForkBinary(
     assert(this->generator_2_);
 }
 
-void ProbabilisticGeneratorForkBinary::generate_applicable_ops(
-    const vector<int>& state,
-    vector<OperatorID>& applicable_ops) const
+int ProbabilisticGeneratorForkBinary::compile(vector<int>& code) const
 {
-    generator_1_->generate_applicable_ops(state, applicable_ops);
-    generator_2_->generate_applicable_ops(state, applicable_ops);
-}
+    const int child_1 = generator_1_->compile(code);
+    const int child_2 = generator_2_->compile(code);
 
-void ProbabilisticGeneratorForkBinary::generate_transitions(
-    const State& state,
-    std::vector<Transition<OperatorID>>& transitions,
-    TaskStateSpace& task_state_space) const
-{
-    generator_1_->generate_transitions(state, transitions, task_state_space);
-    generator_2_->generate_transitions(state, transitions, task_state_space);
+    const int pos = static_cast<int>(code.size());
+    code.insert(code.end(), {FORK, 2, child_1, child_2});
+    return pos;
 }
 
 ProbabilisticGeneratorForkMulti::ProbabilisticGeneratorForkMulti(
@@ -114,21 +48,18 @@ ProbabilisticGeneratorForkMulti::ProbabilisticGeneratorForkMulti(
     assert(this->children_.empty() || this->children_.size() >= 2);
 }
 
-void ProbabilisticGeneratorForkMulti::generate_applicable_ops(
-    const vector<int>& state,
-    vector<OperatorID>& applicable_ops) const
+int ProbabilisticGeneratorForkMulti::compile(vector<int>& code) const
 {
+    vector<int> children;
+    children.reserve(children_.size());
     for (const auto& generator : children_)
-        generator->generate_applicable_ops(state, applicable_ops);
-}
+        children.push_back(generator->compile(code));
 
-void ProbabilisticGeneratorForkMulti::generate_transitions(
-    const State& state,
-    std::vector<Transition<OperatorID>>& transitions,
-    TaskStateSpace& task_state_space) const
-{
-    for (const auto& generator : children_)
-        generator->generate_transitions(state, transitions, task_state_space);
+    const int pos = static_cast<int>(code.size());
+    code.push_back(FORK);
+    code.push_back(static_cast<int>(children.size()));
+    code.insert(code.end(), children.begin(), children.end());
+    return pos;
 }
 
 ProbabilisticGeneratorSwitchVector::ProbabilisticGeneratorSwitchVector(
@@ -139,32 +70,18 @@ ProbabilisticGeneratorSwitchVector::ProbabilisticGeneratorSwitchVector(
 {
 }
 
-void ProbabilisticGeneratorSwitchVector::generate_applicable_ops(
-    const vector<int>& state,
-    vector<OperatorID>& applicable_ops) const
+int ProbabilisticGeneratorSwitchVector::compile(vector<int>& code) const
 {
-    int val = state[switch_var_id_];
-    const unique_ptr<ProbabilisticGeneratorBase>& generator_for_val =
-        generator_for_value_[val];
-    if (generator_for_val) {
-        generator_for_val->generate_applicable_ops(state, applicable_ops);
-    }
-}
+    vector<int> children;
+    children.reserve(generator_for_value_.size());
+    for (const auto& generator : generator_for_value_)
+        children.push_back(generator ? generator->compile(code) : NO_CHILD);
 
-void ProbabilisticGeneratorSwitchVector::generate_transitions(
-    const State& state,
-    std::vector<Transition<OperatorID>>& transitions,
-    TaskStateSpace& task_state_space) const
-{
-    int val = state.get_unpacked_values()[switch_var_id_];
-    const unique_ptr<ProbabilisticGeneratorBase>& generator_for_val =
-        generator_for_value_[val];
-    if (generator_for_val) {
-        generator_for_val->generate_transitions(
-            state,
-            transitions,
-            task_state_space);
-    }
+    const int pos = static_cast<int>(code.size());
+    code.push_back(VECTOR_SWITCH);
+    code.push_back(switch_var_id_);
+    code.insert(code.end(), children.begin(), children.end());
+    return pos;
 }
 
 ProbabilisticGeneratorSwitchHash::ProbabilisticGeneratorSwitchHash(
@@ -176,34 +93,24 @@ ProbabilisticGeneratorSwitchHash::ProbabilisticGeneratorSwitchHash(
 {
 }
 
-void ProbabilisticGeneratorSwitchHash::generate_applicable_ops(
-    const vector<int>& state,
-    vector<OperatorID>& applicable_ops) const
+int ProbabilisticGeneratorSwitchHash::compile(vector<int>& code) const
 {
-    int val = state[switch_var_id_];
-    const auto& child = generator_for_value_.find(val);
-    if (child != generator_for_value_.end()) {
-        const unique_ptr<ProbabilisticGeneratorBase>& generator_for_val =
-            child->second;
-        generator_for_val->generate_applicable_ops(state, applicable_ops);
-    }
-}
+    vector<pair<int, int>> children;
+    children.reserve(generator_for_value_.size());
+    for (const auto& [value, generator] : generator_for_value_)
+        children.emplace_back(value, generator->compile(code));
 
-void ProbabilisticGeneratorSwitchHash::generate_transitions(
-    const State& state,
-    std::vector<Transition<OperatorID>>& transitions,
-    TaskStateSpace& task_state_space) const
-{
-    int val = state.get_unpacked_values()[switch_var_id_];
-    const auto& child = generator_for_value_.find(val);
-    if (child != generator_for_value_.end()) {
-        const unique_ptr<ProbabilisticGeneratorBase>& generator_for_val =
-            child->second;
-        generator_for_val->generate_transitions(
-            state,
-            transitions,
-            task_state_space);
+    sort(children.begin(), children.end());
+
+    const int pos = static_cast<int>(code.size());
+    code.push_back(SORTED_SWITCH);
+    code.push_back(switch_var_id_);
+    code.push_back(static_cast<int>(children.size()));
+    for (const auto& [value, child] : children) {
+        code.push_back(value);
+        code.push_back(child);
     }
+    return pos;
 }
 
 ProbabilisticGeneratorSwitchSingle::ProbabilisticGeneratorSwitchSingle(
@@ -216,26 +123,13 @@ ProbabilisticGeneratorSwitchSingle::ProbabilisticGeneratorSwitchSingle(
 {
 }
 
-void ProbabilisticGeneratorSwitchSingle::generate_applicable_ops(
-    const vector<int>& state,
-    vector<OperatorID>& applicable_ops) const
+int ProbabilisticGeneratorSwitchSingle::compile(vector<int>& code) const
 {
-    if (value_ == state[switch_var_id_]) {
-        generator_for_value_->generate_applicable_ops(state, applicable_ops);
-    }
-}
+    const int child = generator_for_value_->compile(code);
 
-void ProbabilisticGeneratorSwitchSingle::generate_transitions(
-    const State& state,
-    std::vector<Transition<OperatorID>>& transitions,
-    TaskStateSpace& task_state_space) const
-{
-    if (value_ == state.get_unpacked_values()[switch_var_id_]) {
-        generator_for_value_->generate_transitions(
-            state,
-            transitions,
-            task_state_space);
-    }
+    const int pos = static_cast<int>(code.size());
+    code.insert(code.end(), {SINGLE_SWITCH, switch_var_id_, value_, child});
+    return pos;
 }
 
 ProbabilisticGeneratorLeafVector::ProbabilisticGeneratorLeafVector(
@@ -244,31 +138,15 @@ ProbabilisticGeneratorLeafVector::ProbabilisticGeneratorLeafVector(
 {
 }
 
-void ProbabilisticGeneratorLeafVector::generate_applicable_ops(
-    const vector<int>&,
-    vector<OperatorID>& applicable_ops) const
+int ProbabilisticGeneratorLeafVector::compile(vector<int>& code) const
 {
-    /*
-      In our experiments (issue688), a loop over push_back was faster
-      here than doing this with a single insert call because the
-      containers are typically very small. However, we have changed
-      the container type from list to vector since then, so this might
-      no longer apply.
-    */
+    const int pos = static_cast<int>(code.size());
+    code.push_back(LEAF);
+    code.push_back(static_cast<int>(applicable_operators_.size()));
     for (OperatorID id : applicable_operators_) {
-        applicable_ops.push_back(id);
-    }
-}
-
-void ProbabilisticGeneratorLeafVector::generate_transitions(
-    const State& state,
-    std::vector<Transition<OperatorID>>& transitions,
-    TaskStateSpace& task_state_space) const
-{
-    for (OperatorID id : applicable_operators_) {
-        auto& t = transitions.emplace_back(id);
-        task_state_space.compute_successor_dist(state, id, t.successor_dist);
+        code.push_back(id.get_index());
     }
+    return pos;
 }
 
 ProbabilisticGeneratorLeafSingle::ProbabilisticGeneratorLeafSingle(
@@ -277,23 +155,11 @@ ProbabilisticGeneratorLeafSingle::ProbabilisticGeneratorLeafSingle(
 {
 }
 
-void ProbabilisticGeneratorLeafSingle::generate_applicable_ops(
-    const vector<int>&,
-    vector<OperatorID>& applicable_ops) const
-{
-    applicable_ops.push_back(applicable_operator_);
-}
-
-void ProbabilisticGeneratorLeafSingle::generate_transitions(
-    const State& state,
-    std::vector<Transition<OperatorID>>& transitions,
-    TaskStateSpace& task_state_space) const
+int ProbabilisticGeneratorLeafSingle::compile(vector<int>& code) const
 {
-    auto& t = transitions.emplace_back(applicable_operator_);
-    task_state_space.compute_successor_dist(
-        state,
-        applicable_operator_,
-        t.successor_dist);
+    const int pos = static_cast<int>(code.size());
+    code.insert(code.end(), {LEAF, 1, applicable_operator_.get_index()});
+    return pos;
 }
 
 } // namespace probfd::successor_generator
@@ -0,0 +1,838 @@
+#include "probfd/tasks/binary_task.h"
+
+#include "probfd/operator_table.h"
+#include "probfd/probabilistic_task.h"
+#include "probfd/value_type.h"
+
+#include "downward/utils/system.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using utils::ExitCode;
+
+namespace probfd::tasks {
+
+namespace {
+
+constexpr char MAGIC[8] = {'\x7f', 'P', 'F', 'D', 'T', 'A', 'S', 'K'};
+constexpr std::uint32_t VERSION = 1;
+
+enum Section : std::uint32_t {
+    VARIABLES,
+    FACT_OFFSETS,
+    STRING_OFFSETS,
+    STRING_DATA,
+    MUTEX_OFFSETS,
+    MUTEXES,
+    INITIAL_STATE,
+    GOALS,
+    AXIOM_PRECONDITION_OFFSETS,
+    AXIOM_PRECONDITIONS,
+    AXIOM_EFFECT_OFFSETS,
+    AXIOM_EFFECTS,
+    AXIOM_CONDITION_OFFSETS,
+    AXIOM_CONDITIONS,
+    OPERATOR_COSTS,
+    PRECONDITION_OFFSETS,
+    PRECONDITIONS,
+    OUTCOME_OFFSETS,
+    OUTCOME_PROBABILITIES,
+    EFFECT_OFFSETS,
+    EFFECTS,
+    CONDITION_OFFSETS,
+    CONDITIONS,
+    NUM_SECTIONS
+};
+
+struct SectionEntry {
+    std::uint64_t offset; // In bytes from the start of the file.
+    std::uint64_t size;   // In bytes.
+};
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t num_sections;
+    SectionEntry sections[NUM_SECTIONS];
+};
+
+struct VariableRecord {
+    std::int32_t domain_size;
+    std::int32_t axiom_layer;
+    std::int32_t default_axiom_value;
+};
+
+static_assert(sizeof(FactPair) == 2 * sizeof(std::int32_t));
+static_assert(std::is_trivially_copyable_v<FactPair>);
+static_assert(sizeof(FileHeader) % alignof(std::max_align_t) == 0);
+
+constexpr std::size_t SECTION_ALIGNMENT = 8;
+
+/*
+  The memory holding a binary task, either a read-only mapping of the input
+  file or a heap buffer with the contents of the input stream.
+*/
+class TaskImage {
+    void* mapping_ = nullptr;
+    std::size_t mapping_size_ = 0;
+    std::vector<std::uint64_t> buffer_;
+
+    const std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+
+public:
+    explicit TaskImage(std::istream& in);
+    ~TaskImage();
+
+    TaskImage(const TaskImage&) = delete;
+    TaskImage& operator=(const TaskImage&) = delete;
+
+    [[nodiscard]]
+    std::span<const std::byte> get_data() const
+    {
+        return {data_, size_};
+    }
+
+private:
+    bool try_map_standard_input();
+};
+
+TaskImage::TaskImage(std::istream& in)
+{
+    // The standard input can only be mapped if the task starts at the
+    // beginning of the file, i.e., if no input has been consumed so far.
+    if (&in == &std::cin && in.tellg() == std::streampos(0) &&
+        try_map_standard_input()) {
+        return;
+    }
+
+    std::vector<char> contents;
+    std::array<char, 1 << 16> chunk;
+    while (in.read(chunk.data(), chunk.size()) || in.gcount() > 0) {
+        contents.insert(
+            contents.end(),
+            chunk.data(),
+            chunk.data() + in.gcount());
+    }
+
+    // Copy to a buffer of words to align the sections.
+    buffer_.resize((contents.size() + 7) / 8);
+    std::memcpy(buffer_.data(), contents.data(), contents.size());
+    data_ = reinterpret_cast<const std::byte*>(buffer_.data());
+    size_ = contents.size();
+}
+
+TaskImage::~TaskImage()
+{
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+    if (mapping_) ::munmap(mapping_, mapping_size_);
+#endif
+}
+
+bool TaskImage::try_map_standard_input()
+{
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+    struct stat file_status;
+    if (::fstat(STDIN_FILENO, &file_status) != 0 ||
+        !S_ISREG(file_status.st_mode) || file_status.st_size == 0) {
+        return false;
+    }
+
+    mapping_size_ = static_cast<std::size_t>(file_status.st_size);
+    mapping_ =
+        ::mmap(nullptr, mapping_size_, PROT_READ, MAP_PRIVATE, STDIN_FILENO, 0);
+
+    if (mapping_ == MAP_FAILED) {
+        mapping_ = nullptr;
+        return false;
+    }
+
+    data_ = static_cast<const std::byte*>(mapping_);
+    size_ = mapping_size_;
+    return true;
+#else
+    return false;
+#endif
+}
+
+[[noreturn]]
+void binary_input_error(const std::string& message)
+{
+    cerr << "Invalid binary task: " << message << endl;
+    utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+}
+
+class BinaryRootTask : public ProbabilisticTask {
+    TaskImage image_;
+
+    std::span<const VariableRecord> variables_;
+    std::span<const std::int32_t> fact_offsets_;
+    std::span<const std::uint64_t> string_offsets_;
+    std::span<const char> string_data_;
+    std::span<const std::int32_t> mutex_offsets_;
+    std::span<const FactPair> mutexes_;
+    std::span<const std::int32_t> initial_state_;
+    std::span<const FactPair> goals_;
+
+    std::span<const std::int32_t> axiom_precondition_offsets_;
+    std::span<const FactPair> axiom_preconditions_;
+    std::span<const std::int32_t> axiom_effect_offsets_;
+    std::span<const FactPair> axiom_effects_;
+    std::span<const std::int32_t> axiom_condition_offsets_;
+    std::span<const FactPair> axiom_conditions_;
+
+    OperatorTable operators_;
+
+    template <typename T>
+    std::span<const T> get_section(const FileHeader& header, Section section);
+
+    std::string get_string(std::size_t index) const;
+
+public:
+    explicit BinaryRootTask(std::istream& in);
+
+    // The operator table refers to the storage of this task, so the task can
+    // neither be copied nor moved.
+    BinaryRootTask(const BinaryRootTask&) = delete;
+    BinaryRootTask& operator=(const BinaryRootTask&) = delete;
+
+    int get_num_variables() const override { return variables_.size(); }
+
+    string get_variable_name(int var) const override
+    {
+        return get_string(var);
+    }
+
+    int get_variable_domain_size(int var) const override
+    {
+        return variables_[var].domain_size;
+    }
+
+    int get_variable_axiom_layer(int var) const override
+    {
+        return variables_[var].axiom_layer;
+    }
+
+    int get_variable_default_axiom_value(int var) const override
+    {
+        return variables_[var].default_axiom_value;
+    }
+
+    string get_fact_name(const FactPair& fact) const override
+    {
+        return get_string(
+            variables_.size() + fact_offsets_[fact.var] + fact.value);
+    }
+
+    bool are_facts_mutex(const FactPair& fact1, const FactPair& fact2)
+        const override;
+
+    int get_num_axioms() const override
+    {
+        return axiom_precondition_offsets_.size() - 1;
+    }
+
+    string get_axiom_name(int) const override { return "<axiom>"; }
+
+    int get_num_axiom_preconditions(int index) const override
+    {
+        return axiom_precondition_offsets_[index + 1] -
+               axiom_precondition_offsets_[index];
+    }
+
+    FactPair
+    get_axiom_precondition(int op_index, int fact_index) const override
+    {
+        return axiom_preconditions_
+            [axiom_precondition_offsets_[op_index] + fact_index];
+    }
+
+    int get_num_axiom_effects(int op_index) const override
+    {
+        return axiom_effect_offsets_[op_index + 1] -
+               axiom_effect_offsets_[op_index];
+    }
+
+    int get_num_axiom_effect_conditions(int op_index, int eff_index)
+        const override
+    {
+        const int effect = axiom_effect_offsets_[op_index] + eff_index;
+        return axiom_condition_offsets_[effect + 1] -
+               axiom_condition_offsets_[effect];
+    }
+
+    FactPair
+    get_axiom_effect_condition(int op_index, int eff_index, int cond_index)
+        const override
+    {
+        const int effect = axiom_effect_offsets_[op_index] + eff_index;
+        return axiom_conditions_[axiom_condition_offsets_[effect] + cond_index];
+    }
+
+    FactPair get_axiom_effect(int op_index, int eff_index) const override
+    {
+        return axiom_effects_[axiom_effect_offsets_[op_index] + eff_index];
+    }
+
+    int get_num_operators() const override
+    {
+        return operators_.get_num_operators();
+    }
+
+    value_t get_operator_cost(int index) const override
+    {
+        return operators_.costs[index];
+    }
+
+    string get_operator_name(int index) const override
+    {
+        return get_string(
+            variables_.size() + fact_offsets_[variables_.size()] + index);
+    }
+
+    int get_num_operator_preconditions(int index) const override
+    {
+        return operators_.get_num_preconditions(index);
+    }
+
+    FactPair
+    get_operator_precondition(int op_index, int fact_index) const override
+    {
+        return operators_.get_precondition(op_index, fact_index);
+    }
+
+    int get_num_operator_outcomes(int index) const override
+    {
+        return operators_.get_num_outcomes(index);
+    }
+
+    value_t get_operator_outcome_probability(int index, int outcome_index)
+        const override
+    {
+        return operators_.get_outcome_probability(index, outcome_index);
+    }
+
+    int get_operator_outcome_id(int index, int outcome_index) const override
+    {
+        return operators_.get_outcome_id(index, outcome_index);
+    }
+
+    int get_num_operator_outcome_effects(int op_index, int outcome_index)
+        const override
+    {
+        return operators_.get_num_effects(op_index, outcome_index);
+    }
+
+    FactPair
+    get_operator_outcome_effect(int op_index, int outcome_index, int eff_index)
+        const override
+    {
+        return operators_.get_effect(op_index, outcome_index, eff_index);
+    }
+
+    int get_num_operator_outcome_effect_conditions(
+        int op_index,
+        int outcome_index,
+        int eff_index) const override
+    {
+        return operators_.get_num_effect_conditions(
+            op_index,
+            outcome_index,
+            eff_index);
+    }
+
+    FactPair get_operator_outcome_effect_condition(
+        int op_index,
+        int outcome_index,
+        int eff_index,
+        int cond_index) const override
+    {
+        return operators_.get_effect_condition(
+            op_index,
+            outcome_index,
+            eff_index,
+            cond_index);
+    }
+
+    int get_num_goals() const override { return goals_.size(); }
+
+    FactPair get_goal_fact(int index) const override { return goals_[index]; }
+
+    vector<int> get_initial_state_values() const override
+    {
+        return vector<int>(initial_state_.begin(), initial_state_.end());
+    }
+
+    void convert_ancestor_state_values(
+        vector<int>&,
+        const AbstractTaskBase* ancestor_task) const override
+    {
+        if (this != ancestor_task) {
+            ABORT("Invalid state conversion");
+        }
+    }
+
+    int convert_operator_index(int index, const AbstractTaskBase* ancestor_task)
+        const override
+    {
+        if (this != ancestor_task) {
+            ABORT("Invalid operator ID conversion");
+        }
+        return index;
+    }
+};
+
+template <typename T>
+std::span<const T>
+BinaryRootTask::get_section(const FileHeader& header, Section section)
+{
+    const std::span<const std::byte> data = image_.get_data();
+    const SectionEntry& entry = header.sections[section];
+
+    if (entry.offset % SECTION_ALIGNMENT != 0 || entry.offset > data.size() ||
+        entry.size > data.size() - entry.offset || entry.size % sizeof(T)) {
+        binary_input_error(
+            "section " + std::to_string(section) + " is corrupt");
+    }
+
+    return {
+        reinterpret_cast<const T*>(data.data() + entry.offset),
+        entry.size / sizeof(T)};
+}
+
+BinaryRootTask::BinaryRootTask(std::istream& in)
+    : image_(in)
+{
+    const std::span<const std::byte> data = image_.get_data();
+
+    if (data.size() < sizeof(FileHeader)) {
+        binary_input_error("the header is truncated");
+    }
+
+    const auto& header = *reinterpret_cast<const FileHeader*>(data.data());
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        binary_input_error("wrong magic number");
+    }
+
+    if (header.version != VERSION) {
+        binary_input_error(
+            "expected format version " + std::to_string(VERSION) + ", got " +
+            std::to_string(header.version));
+    }
+
+    if (header.num_sections != NUM_SECTIONS) {
+        binary_input_error(
+            "expected " + std::to_string(NUM_SECTIONS) + " sections, got " +
+            std::to_string(header.num_sections));
+    }
+
+    variables_ = get_section<VariableRecord>(header, VARIABLES);
+    fact_offsets_ = get_section<std::int32_t>(header, FACT_OFFSETS);
+    string_offsets_ = get_section<std::uint64_t>(header, STRING_OFFSETS);
+    string_data_ = get_section<char>(header, STRING_DATA);
+    mutex_offsets_ = get_section<std::int32_t>(header, MUTEX_OFFSETS);
+    mutexes_ = get_section<FactPair>(header, MUTEXES);
+    initial_state_ = get_section<std::int32_t>(header, INITIAL_STATE);
+    goals_ = get_section<FactPair>(header, GOALS);
+
+    axiom_precondition_offsets_ =
+        get_section<std::int32_t>(header, AXIOM_PRECONDITION_OFFSETS);
+    axiom_preconditions_ = get_section<FactPair>(header, AXIOM_PRECONDITIONS);
+    axiom_effect_offsets_ =
+        get_section<std::int32_t>(header, AXIOM_EFFECT_OFFSETS);
+    axiom_effects_ = get_section<FactPair>(header, AXIOM_EFFECTS);
+    axiom_condition_offsets_ =
+        get_section<std::int32_t>(header, AXIOM_CONDITION_OFFSETS);
+    axiom_conditions_ = get_section<FactPair>(header, AXIOM_CONDITIONS);
+
+    operators_.costs = get_section<value_t>(header, OPERATOR_COSTS);
+    operators_.precondition_offsets =
+        get_section<std::int32_t>(header, PRECONDITION_OFFSETS);
+    operators_.preconditions = get_section<FactPair>(header, PRECONDITIONS);
+    operators_.outcome_offsets =
+        get_section<std::int32_t>(header, OUTCOME_OFFSETS);
+    operators_.outcome_probabilities =
+        get_section<value_t>(header, OUTCOME_PROBABILITIES);
+    operators_.effect_offsets =
+        get_section<std::int32_t>(header, EFFECT_OFFSETS);
+    operators_.effects = get_section<FactPair>(header, EFFECTS);
+    operators_.condition_offsets =
+        get_section<std::int32_t>(header, CONDITION_OFFSETS);
+    operators_.conditions = get_section<FactPair>(header, CONDITIONS);
+
+    /*
+      Check the sizes the accessors rely on. The facts themselves are not
+      validated, since binary tasks are converted from validated text input.
+    */
+    auto is_csr = [](std::span<const std::int32_t> offsets,
+                     std::size_t num_lists,
+                     std::size_t num_elements) {
+        return offsets.size() == num_lists + 1 && offsets.front() == 0 &&
+               std::size_t(offsets.back()) == num_elements &&
+               std::ranges::is_sorted(offsets);
+    };
+
+    const std::size_t num_variables = variables_.size();
+    const std::size_t num_operators = operators_.costs.size();
+    const std::size_t num_axioms =
+        axiom_precondition_offsets_.empty()
+            ? 0
+            : axiom_precondition_offsets_.size() - 1;
+
+    if (fact_offsets_.size() != num_variables + 1 ||
+        initial_state_.size() != num_variables) {
+        binary_input_error("inconsistent number of variables");
+    }
+
+    const std::size_t num_facts = fact_offsets_.back();
+    const std::size_t num_strings = num_variables + num_facts + num_operators;
+
+    if (!is_csr(mutex_offsets_, num_facts, mutexes_.size()) ||
+        string_offsets_.size() != num_strings + 1 ||
+        string_offsets_.back() > string_data_.size() ||
+        !std::ranges::is_sorted(string_offsets_) ||
+        !is_csr(
+            axiom_precondition_offsets_,
+            num_axioms,
+            axiom_preconditions_.size()) ||
+        !is_csr(axiom_effect_offsets_, num_axioms, axiom_effects_.size()) ||
+        !is_csr(
+            axiom_condition_offsets_,
+            axiom_effects_.size(),
+            axiom_conditions_.size()) ||
+        !is_csr(
+            operators_.precondition_offsets,
+            num_operators,
+            operators_.preconditions.size()) ||
+        !is_csr(
+            operators_.outcome_offsets,
+            num_operators,
+            operators_.outcome_probabilities.size()) ||
+        !is_csr(
+            operators_.effect_offsets,
+            operators_.outcome_probabilities.size(),
+            operators_.effects.size()) ||
+        !is_csr(
+            operators_.condition_offsets,
+            operators_.effects.size(),
+            operators_.conditions.size())) {
+        binary_input_error("inconsistent section sizes");
+    }
+
+    set_operator_table(operators_);
+}
+
+std::string BinaryRootTask::get_string(std::size_t index) const
+{
+    const std::uint64_t begin = string_offsets_[index];
+    const std::uint64_t end = string_offsets_[index + 1];
+    return std::string(string_data_.data() + begin, end - begin);
+}
+
+bool BinaryRootTask::are_facts_mutex(
+    const FactPair& fact1,
+    const FactPair& fact2) const
+{
+    if (fact1.var == fact2.var) {
+        // Same variable: mutex iff different value.
+        return fact1.value != fact2.value;
+    }
+
+    const int fact_id = fact_offsets_[fact1.var] + fact1.value;
+    const auto begin = mutexes_.begin() + mutex_offsets_[fact_id];
+    const auto end = mutexes_.begin() + mutex_offsets_[fact_id + 1];
+    return std::binary_search(begin, end, fact2);
+}
+
+/*
+  Collects the sections of a binary task before they are written.
+*/
+class SectionWriter {
+    std::array<std::vector<std::byte>, NUM_SECTIONS> sections_;
+
+public:
+    template <typename T>
+    void set(Section section, const std::vector<T>& elements)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto* bytes = reinterpret_cast<const std::byte*>(elements.data());
+        sections_[section].assign(bytes, bytes + elements.size() * sizeof(T));
+    }
+
+    void write(std::ostream& out) const;
+};
+
+void SectionWriter::write(std::ostream& out) const
+{
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.num_sections = NUM_SECTIONS;
+
+    std::uint64_t offset = sizeof(FileHeader);
+    for (std::size_t i = 0; i != NUM_SECTIONS; ++i) {
+        header.sections[i] = {offset, sections_[i].size()};
+        offset += sections_[i].size();
+        offset = (offset + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT *
+                 SECTION_ALIGNMENT;
+    }
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    const char padding[SECTION_ALIGNMENT] = {};
+    for (const std::vector<std::byte>& section : sections_) {
+        const std::size_t size = section.size();
+        const std::size_t padded_size =
+            (size + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT *
+            SECTION_ALIGNMENT;
+        out.write(reinterpret_cast<const char*>(section.data()), size);
+        out.write(padding, padded_size - size);
+    }
+}
+
+// Appends a list to a list in compressed sparse row form.
+template <typename F>
+void append_list(
+    std::vector<std::int32_t>& offsets,
+    std::vector<FactPair>& elements,
+    int size,
+    F get_element)
+{
+    for (int i = 0; i != size; ++i) {
+        elements.push_back(get_element(i));
+    }
+    offsets.push_back(elements.size());
+}
+
+} // namespace
+
+bool is_binary_task(std::istream& in)
+{
+    // A task in the text format never starts with this byte.
+    if (in.peek() != std::char_traits<char>::to_int_type(MAGIC[0])) {
+        return false;
+    }
+
+    // Compare the full magic number and the format version if the stream
+    // can be rewound afterwards. Otherwise, the reader checks them.
+    const std::streampos start = in.tellg();
+    if (start == std::streampos(-1)) return true;
+
+    char prefix[sizeof(MAGIC) + sizeof(VERSION)];
+    const bool complete = static_cast<bool>(in.read(prefix, sizeof(prefix)));
+    in.clear();
+    in.seekg(start);
+
+    if (!complete || std::memcmp(prefix, MAGIC, sizeof(MAGIC)) != 0) {
+        return false;
+    }
+
+    std::uint32_t version;
+    std::memcpy(&version, prefix + sizeof(MAGIC), sizeof(version));
+    return version == VERSION;
+}
+
+std::unique_ptr<ProbabilisticTask> read_binary_task(std::istream& in)
+{
+    return std::make_unique<BinaryRootTask>(in);
+}
+
+void write_binary_task(
+    const ProbabilisticTask& task,
+    std::span<const std::vector<FactPair>> mutexes,
+    std::ostream& out)
+{
+    SectionWriter writer;
+
+    const int num_variables = task.get_num_variables();
+
+    std::vector<VariableRecord> variables;
+    std::vector<std::int32_t> fact_offsets = {0};
+    std::vector<std::uint64_t> string_offsets = {0};
+    std::vector<char> string_data;
+
+    auto add_string = [&](const std::string& s) {
+        string_data.insert(string_data.end(), s.begin(), s.end());
+        string_offsets.push_back(string_data.size());
+    };
+
+    for (int var = 0; var != num_variables; ++var) {
+        const int domain_size = task.get_variable_domain_size(var);
+        variables.emplace_back(
+            domain_size,
+            task.get_variable_axiom_layer(var),
+            task.get_variable_default_axiom_value(var));
+        fact_offsets.push_back(fact_offsets.back() + domain_size);
+        add_string(task.get_variable_name(var));
+    }
+
+    for (int var = 0; var != num_variables; ++var) {
+        for (int val = 0; val != variables[var].domain_size; ++val) {
+            add_string(task.get_fact_name({var, val}));
+        }
+    }
+
+    for (int op = 0; op != task.get_num_operators(); ++op) {
+        add_string(task.get_operator_name(op));
+    }
+
+    assert(mutexes.size() == std::size_t(fact_offsets.back()));
+
+    std::vector<std::int32_t> mutex_offsets = {0};
+    std::vector<FactPair> mutex_facts;
+    for (const std::vector<FactPair>& facts : mutexes) {
+        const auto begin = mutex_facts.insert(
+            mutex_facts.end(),
+            facts.begin(),
+            facts.end());
+        std::sort(begin, mutex_facts.end());
+        mutex_offsets.push_back(mutex_facts.size());
+    }
+
+    std::vector<FactPair> goals;
+    for (int i = 0; i != task.get_num_goals(); ++i) {
+        goals.push_back(task.get_goal_fact(i));
+    }
+
+    writer.set(VARIABLES, variables);
+    writer.set(FACT_OFFSETS, fact_offsets);
+    writer.set(STRING_OFFSETS, string_offsets);
+    writer.set(STRING_DATA, string_data);
+    writer.set(MUTEX_OFFSETS, mutex_offsets);
+    writer.set(MUTEXES, mutex_facts);
+    writer.set(INITIAL_STATE, task.get_initial_state_values());
+    writer.set(GOALS, goals);
+
+    std::vector<std::int32_t> axiom_precondition_offsets = {0};
+    std::vector<FactPair> axiom_preconditions;
+    std::vector<std::int32_t> axiom_effect_offsets = {0};
+    std::vector<FactPair> axiom_effects;
+    std::vector<std::int32_t> axiom_condition_offsets = {0};
+    std::vector<FactPair> axiom_conditions;
+
+    for (int axiom = 0; axiom != task.get_num_axioms(); ++axiom) {
+        append_list(
+            axiom_precondition_offsets,
+            axiom_preconditions,
+            task.get_num_axiom_preconditions(axiom),
+            [&](int i) { return task.get_axiom_precondition(axiom, i); });
+
+        const int num_effects = task.get_num_axiom_effects(axiom);
+        for (int eff = 0; eff != num_effects; ++eff) {
+            append_list(
+                axiom_condition_offsets,
+                axiom_conditions,
+                task.get_num_axiom_effect_conditions(axiom, eff),
+                [&](int i) {
+                    return task.get_axiom_effect_condition(axiom, eff, i);
+                });
+        }
+
+        append_list(
+            axiom_effect_offsets,
+            axiom_effects,
+            num_effects,
+            [&](int i) { return task.get_axiom_effect(axiom, i); });
+    }
+
+    writer.set(AXIOM_PRECONDITION_OFFSETS, axiom_precondition_offsets);
+    writer.set(AXIOM_PRECONDITIONS, axiom_preconditions);
+    writer.set(AXIOM_EFFECT_OFFSETS, axiom_effect_offsets);
+    writer.set(AXIOM_EFFECTS, axiom_effects);
+    writer.set(AXIOM_CONDITION_OFFSETS, axiom_condition_offsets);
+    writer.set(AXIOM_CONDITIONS, axiom_conditions);
+
+    std::vector<value_t> operator_costs;
+    std::vector<std::int32_t> precondition_offsets = {0};
+    std::vector<FactPair> preconditions;
+    std::vector<std::int32_t> outcome_offsets = {0};
+    std::vector<value_t> outcome_probabilities;
+    std::vector<std::int32_t> effect_offsets = {0};
+    std::vector<FactPair> effects;
+    std::vector<std::int32_t> condition_offsets = {0};
+    std::vector<FactPair> conditions;
+
+    for (int op = 0; op != task.get_num_operators(); ++op) {
+        operator_costs.push_back(task.get_operator_cost(op));
+
+        append_list(
+            precondition_offsets,
+            preconditions,
+            task.get_num_operator_preconditions(op),
+            [&](int i) { return task.get_operator_precondition(op, i); });
+
+        const int num_outcomes = task.get_num_operator_outcomes(op);
+        for (int out = 0; out != num_outcomes; ++out) {
+            // Outcome ids are assigned consecutively by the reader.
+            assert(
+                task.get_operator_outcome_id(op, out) ==
+                int(outcome_probabilities.size()));
+
+            outcome_probabilities.push_back(
+                task.get_operator_outcome_probability(op, out));
+
+            const int num_effects =
+                task.get_num_operator_outcome_effects(op, out);
+            for (int eff = 0; eff != num_effects; ++eff) {
+                append_list(
+                    condition_offsets,
+                    conditions,
+                    task.get_num_operator_outcome_effect_conditions(
+                        op,
+                        out,
+                        eff),
+                    [&](int i) {
+                        return task.get_operator_outcome_effect_condition(
+                            op,
+                            out,
+                            eff,
+                            i);
+                    });
+            }
+
+            append_list(effect_offsets, effects, num_effects, [&](int i) {
+                return task.get_operator_outcome_effect(op, out, i);
+            });
+        }
+
+        outcome_offsets.push_back(outcome_probabilities.size());
+    }
+
+    writer.set(OPERATOR_COSTS, operator_costs);
+    writer.set(PRECONDITION_OFFSETS, precondition_offsets);
+    writer.set(PRECONDITIONS, preconditions);
+    writer.set(OUTCOME_OFFSETS, outcome_offsets);
+    writer.set(OUTCOME_PROBABILITIES, outcome_probabilities);
+    writer.set(EFFECT_OFFSETS, effect_offsets);
+    writer.set(EFFECTS, effects);
+    writer.set(CONDITION_OFFSETS, condition_offsets);
+    writer.set(CONDITIONS, conditions);
+
+    writer.write(out);
+
+    if (!out) {
+        cerr << "Could not write the binary task." << endl;
+        utils::exit_with(ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+}
+
+} // namespace probfd::tasks
@@ -1,6 +1,8 @@
 #include "probfd/tasks/root_task.h"
 #include "probfd/tasks/all_outcomes_determinization.h"
+#include "probfd/tasks/binary_task.h"
 
+#include "probfd/operator_table.h"
 #include "probfd/probabilistic_task.h"
 #include "probfd/value_type.h"
 
@@ -13,10 +15,16 @@
 #include "downward/plugins/plugin.h"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <cctype>
+#include <charconv>
 #include <compare>
+#include <cstdint>
+#include <istream>
 #include <memory>
 #include <set>
+#include <string_view>
 #include <vector>
 
 using namespace std;
@@ -30,6 +38,32 @@ namespace {
 
 const auto PRE_FILE_PROB_VERSION = "3P";
 
+/*
+  Tokenizer for the translator output. The input is read into memory as a
+  whole and tokenized in place, which is considerably faster than extracting
+  the tokens from the input stream one by one.
+*/
+class TaskInput {
+    std::string buffer_;
+    const char* pos_;
+    const char* end_;
+
+public:
+    explicit TaskInput(std::istream& in);
+
+    // Skips whitespace.
+    void skip_whitespace();
+
+    // Reads the next whitespace-separated token.
+    std::string_view read_word();
+
+    // Reads the next token as an integer.
+    int read_int();
+
+    // Reads the remainder of the current line, excluding the line break.
+    std::string read_line();
+};
+
 struct ExplicitVariable {
     int domain_size;
     string name;
@@ -37,7 +71,7 @@ struct ExplicitVariable {
     int axiom_layer;
     int axiom_default_value;
 
-    explicit ExplicitVariable(std::istream& in);
+    explicit ExplicitVariable(TaskInput& in);
 };
 
 struct ExplicitEffect {
@@ -67,9 +101,9 @@ struct DeterministicOperator {
     int cost;
     string name;
 
-    DeterministicOperator(std::istream& in, bool use_metric);
+    DeterministicOperator(TaskInput& in, bool use_metric);
 
-    void read_pre_post(std::istream& in);
+    void read_pre_post(TaskInput& in);
 };
 
 struct ProbabilisticOutcome {
@@ -78,7 +112,7 @@ struct ProbabilisticOutcome {
     string name;
 
     ProbabilisticOutcome(
-        std::istream& in,
+        TaskInput& in,
         const vector<DeterministicOperator>& deterministic_operators,
         int& cost,
         vector<FactPair>& preconditions);
@@ -92,7 +126,7 @@ struct ProbabilisticOperator {
     int outcomes_start_index;
 
     ProbabilisticOperator(
-        std::istream& in,
+        TaskInput& in,
         int outcomes_start_index,
         const vector<DeterministicOperator>& deterministic_operators);
 };
@@ -102,30 +136,48 @@ struct ExplicitAxiom {
     vector<ExplicitEffect> effects;
     string name;
 
-    explicit ExplicitAxiom(std::istream& in);
+    explicit ExplicitAxiom(TaskInput& in);
 
-    void read_pre_post(std::istream& in);
+    void read_pre_post(TaskInput& in);
 };
 
 class RootTask : public ProbabilisticTask {
     vector<ExplicitVariable> variables;
     // TODO: think about using hash sets here.
     vector<vector<set<FactPair>>> mutexes;
-    vector<ProbabilisticOperator> operators;
     vector<ExplicitAxiom> axioms;
     vector<int> initial_state_values;
     vector<FactPair> goals;
 
+    // The operators are stored in compressed sparse row form, see
+    // OperatorTable.
+    vector<string> operator_names;
+    vector<value_t> operator_costs;
+    vector<int32_t> operator_precondition_offsets;
+    vector<FactPair> operator_preconditions;
+    vector<int32_t> outcome_offsets;
+    vector<value_t> outcome_probabilities;
+    vector<int32_t> effect_offsets;
+    vector<FactPair> effects;
+    vector<int32_t> condition_offsets;
+    vector<FactPair> effect_conditions;
+    OperatorTable operator_table;
+
     const ExplicitVariable& get_variable(int var) const;
     const ExplicitAxiom& get_axiom(int index) const;
-    const ProbabilisticOperator& get_operator(int index) const;
-    const ProbabilisticOutcome& get_outcome(int op_id, int outcome_index) const;
     const ExplicitEffect& get_axiom_effect_(int op_id, int effect_id) const;
-    const ExplicitEffect&
-    get_operator_effect(int op_id, int outcome_index, int effect_id) const;
+
+    void set_operators(const vector<ProbabilisticOperator>& operators);
 
 public:
-    explicit RootTask(std::istream& in);
+    explicit RootTask(TaskInput& in);
+
+    // The operator table refers to the storage of this task, so the task can
+    // neither be copied nor moved.
+    RootTask(const RootTask&) = delete;
+    RootTask& operator=(const RootTask&) = delete;
+
+    void write_binary(std::ostream& out) const;
 
     int get_num_variables() const override;
     string get_variable_name(int var) const override;
@@ -262,10 +314,62 @@ void check_facts(
     }
 }
 
-void check_magic(std::istream& in, const string& magic)
+TaskInput::TaskInput(std::istream& in)
+{
+    std::array<char, 1 << 16> chunk;
+    while (in.read(chunk.data(), chunk.size()) || in.gcount() > 0) {
+        buffer_.append(chunk.data(), in.gcount());
+    }
+
+    pos_ = buffer_.data();
+    end_ = pos_ + buffer_.size();
+}
+
+void TaskInput::skip_whitespace()
+{
+    while (pos_ != end_ && std::isspace(static_cast<unsigned char>(*pos_))) {
+        ++pos_;
+    }
+}
+
+std::string_view TaskInput::read_word()
+{
+    skip_whitespace();
+    const char* begin = pos_;
+    while (pos_ != end_ && !std::isspace(static_cast<unsigned char>(*pos_))) {
+        ++pos_;
+    }
+    return {begin, pos_};
+}
+
+int TaskInput::read_int()
 {
-    string word;
-    in >> word;
+    std::string_view word = read_word();
+    if (word.starts_with('+')) word.remove_prefix(1);
+
+    int value;
+    auto [ptr, ec] =
+        std::from_chars(word.data(), word.data() + word.size(), value);
+
+    if (ec != std::errc() || ptr != word.data() + word.size()) {
+        cerr << "Expected an integer, got '" << word << "'." << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+
+    return value;
+}
+
+std::string TaskInput::read_line()
+{
+    const char* begin = pos_;
+    const char* line_end = std::find(pos_, end_, '\n');
+    pos_ = line_end == end_ ? end_ : line_end + 1;
+    return std::string(begin, line_end);
+}
+
+void check_magic(TaskInput& in, std::string_view magic)
+{
+    std::string_view word = in.read_word();
     if (word != magic) {
         cerr << "Failed to match magic word '" << magic << "'." << endl
              << "Got '" << word << "'." << endl;
@@ -278,29 +382,29 @@ void check_magic(std::istream& in, const string& magic)
     }
 }
 
-vector<FactPair> read_facts(std::istream& in)
+vector<FactPair> read_facts(TaskInput& in)
 {
-    int count;
-    in >> count;
+    int count = in.read_int();
     vector<FactPair> conditions;
     conditions.reserve(count);
     for (int i = 0; i < count; ++i) {
         FactPair condition = FactPair::no_fact;
-        in >> condition.var >> condition.value;
+        condition.var = in.read_int();
+        condition.value = in.read_int();
         conditions.push_back(condition);
     }
     return conditions;
 }
 
-ExplicitVariable::ExplicitVariable(std::istream& in)
+ExplicitVariable::ExplicitVariable(TaskInput& in)
 {
     check_magic(in, "begin_variable");
-    in >> name;
-    in >> axiom_layer;
-    in >> domain_size;
-    in >> ws;
+    name = in.read_word();
+    axiom_layer = in.read_int();
+    domain_size = in.read_int();
+    in.skip_whitespace();
     fact_names.resize(domain_size);
-    for (int i = 0; i < domain_size; ++i) getline(in, fact_names[i]);
+    for (int i = 0; i < domain_size; ++i) fact_names[i] = in.read_line();
     check_magic(in, "end_variable");
 }
 
@@ -315,14 +419,13 @@ ExplicitEffect::ExplicitEffect(
 }
 
 ProbabilisticOutcome::ProbabilisticOutcome(
-    std::istream& in,
+    TaskInput& in,
     const vector<DeterministicOperator>& deterministic_operators,
     int& cost,
     vector<FactPair>& preconditions)
 {
     // Read deterministic operator index
-    int det_index;
-    in >> det_index;
+    int det_index = in.read_int();
 
     const DeterministicOperator& det_op = deterministic_operators[det_index];
     name = det_op.name;
@@ -331,21 +434,18 @@ ProbabilisticOutcome::ProbabilisticOutcome(
     preconditions = det_op.preconditions;
 
     // Read probability
-    std::string p;
-    in >> p;
-    probability = string_to_value(p);
+    probability = string_to_value(std::string(in.read_word()));
 }
 
-DeterministicOperator::DeterministicOperator(std::istream& in, bool use_metric)
+DeterministicOperator::DeterministicOperator(TaskInput& in, bool use_metric)
 {
     check_magic(in, "begin_operator");
-    in >> ws;
-    getline(in, name);
+    in.skip_whitespace();
+    name = in.read_line();
     preconditions = read_facts(in);
 
     // Read number of effects
-    int count;
-    in >> count;
+    int count = in.read_int();
     effects.reserve(count);
 
     // Read each effect
@@ -353,8 +453,7 @@ DeterministicOperator::DeterministicOperator(std::istream& in, bool use_metric)
         read_pre_post(in);
     }
 
-    int op_cost;
-    in >> op_cost;
+    int op_cost = in.read_int();
     cost = use_metric ? op_cost : 1;
     check_magic(in, "end_operator");
 
@@ -364,11 +463,12 @@ DeterministicOperator::DeterministicOperator(std::istream& in, bool use_metric)
     std::sort(effects.begin(), effects.end());
 }
 
-void DeterministicOperator::read_pre_post(std::istream& in)
+void DeterministicOperator::read_pre_post(TaskInput& in)
 {
     vector<FactPair> conditions = read_facts(in);
-    int var, pre, value_post;
-    in >> var >> pre >> value_post;
+    int var = in.read_int();
+    int pre = in.read_int();
+    int value_post = in.read_int();
     if (pre != -1) {
         preconditions.emplace_back(var, pre);
     }
@@ -376,18 +476,17 @@ void DeterministicOperator::read_pre_post(std::istream& in)
 }
 
 ProbabilisticOperator::ProbabilisticOperator(
-    std::istream& in,
+    TaskInput& in,
     int outcomes_start_index,
     const vector<DeterministicOperator>& deterministic_operators)
     : outcomes_start_index(outcomes_start_index)
 {
     check_magic(in, "begin_probabilistic_operator");
-    in >> ws;
-    getline(in, name);
+    in.skip_whitespace();
+    name = in.read_line();
 
     // Read number of outcomes
-    int num_outcomes;
-    in >> num_outcomes;
+    int num_outcomes = in.read_int();
     this->outcomes.reserve(num_outcomes);
 
     assert(num_outcomes >= 1);
@@ -404,12 +503,11 @@ ProbabilisticOperator::ProbabilisticOperator(
     check_magic(in, "end_probabilistic_operator");
 }
 
-ExplicitAxiom::ExplicitAxiom(std::istream& in)
+ExplicitAxiom::ExplicitAxiom(TaskInput& in)
 {
     name = "<axiom>";
     check_magic(in, "begin_rule");
-    int count;
-    in >> count;
+    int count = in.read_int();
     effects.reserve(count);
     for (int i = 0; i < count; ++i) {
         read_pre_post(in);
@@ -417,22 +515,22 @@ ExplicitAxiom::ExplicitAxiom(std::istream& in)
     check_magic(in, "end_rule");
 }
 
-void ExplicitAxiom::read_pre_post(std::istream& in)
+void ExplicitAxiom::read_pre_post(TaskInput& in)
 {
     vector<FactPair> conditions = read_facts(in);
-    int var, pre, value_post;
-    in >> var >> pre >> value_post;
+    int var = in.read_int();
+    int pre = in.read_int();
+    int value_post = in.read_int();
     if (pre != -1) {
         preconditions.emplace_back(var, pre);
     }
     effects.emplace_back(var, value_post, std::move(conditions));
 }
 
-void read_and_verify_version(std::istream& in)
+void read_and_verify_version(TaskInput& in)
 {
-    std::string version;
     check_magic(in, "begin_version");
-    in >> version;
+    std::string_view version = in.read_word();
     check_magic(in, "end_version");
     if (version != PRE_FILE_PROB_VERSION) {
         cerr << "Expected translator output file version "
@@ -442,19 +540,17 @@ void read_and_verify_version(std::istream& in)
     }
 }
 
-bool read_metric(std::istream& in)
+bool read_metric(TaskInput& in)
 {
-    bool use_metric;
     check_magic(in, "begin_metric");
-    in >> use_metric;
+    bool use_metric = in.read_int() != 0;
     check_magic(in, "end_metric");
     return use_metric;
 }
 
-vector<ExplicitVariable> read_variables(std::istream& in)
+vector<ExplicitVariable> read_variables(TaskInput& in)
 {
-    int count;
-    in >> count;
+    int count = in.read_int();
     vector<ExplicitVariable> variables;
     variables.reserve(count);
     for (int i = 0; i < count; ++i) {
@@ -464,14 +560,13 @@ vector<ExplicitVariable> read_variables(std::istream& in)
 }
 
 vector<vector<set<FactPair>>>
-read_mutexes(std::istream& in, const vector<ExplicitVariable>& variables)
+read_mutexes(TaskInput& in, const vector<ExplicitVariable>& variables)
 {
     vector<vector<set<FactPair>>> inconsistent_facts(variables.size());
     for (size_t i = 0; i < variables.size(); ++i)
         inconsistent_facts[i].resize(variables[i].domain_size);
 
-    int num_mutex_groups;
-    in >> num_mutex_groups;
+    int num_mutex_groups = in.read_int();
 
     /*
       NOTE: Mutex groups can overlap, in which case the same mutex
@@ -482,14 +577,12 @@ read_mutexes(std::istream& in, const vector<ExplicitVariable>& variables)
     */
     for (int i = 0; i < num_mutex_groups; ++i) {
         check_magic(in, "begin_mutex_group");
-        int num_facts;
-        in >> num_facts;
+        int num_facts = in.read_int();
         vector<FactPair> invariant_group;
         invariant_group.reserve(num_facts);
         for (int j = 0; j < num_facts; ++j) {
-            int var;
-            int value;
-            in >> var >> value;
+            int var = in.read_int();
+            int value = in.read_int();
             invariant_group.emplace_back(var, value);
         }
         check_magic(in, "end_mutex_group");
@@ -514,7 +607,7 @@ read_mutexes(std::istream& in, const vector<ExplicitVariable>& variables)
     return inconsistent_facts;
 }
 
-vector<FactPair> read_goal(std::istream& in)
+vector<FactPair> read_goal(TaskInput& in)
 {
     check_magic(in, "begin_goal");
     vector<FactPair> goals = read_facts(in);
@@ -527,10 +620,9 @@ vector<FactPair> read_goal(std::istream& in)
 }
 
 vector<ExplicitAxiom>
-read_axioms(std::istream& in, const vector<ExplicitVariable>& variables)
+read_axioms(TaskInput& in, const vector<ExplicitVariable>& variables)
 {
-    int count;
-    in >> count;
+    int count = in.read_int();
     vector<ExplicitAxiom> axioms;
     axioms.reserve(count);
     for (int i = 0; i < count; ++i) {
@@ -540,10 +632,9 @@ read_axioms(std::istream& in, const vector<ExplicitVariable>& variables)
     return axioms;
 }
 
-vector<DeterministicOperator> read_operators(std::istream& in, bool use_metric)
+vector<DeterministicOperator> read_operators(TaskInput& in, bool use_metric)
 {
-    int count;
-    in >> count;
+    int count = in.read_int();
     vector<DeterministicOperator> actions;
     actions.reserve(count);
     for (int i = 0; i < count; ++i) {
@@ -553,12 +644,11 @@ vector<DeterministicOperator> read_operators(std::istream& in, bool use_metric)
 }
 
 vector<ProbabilisticOperator> read_probabilistic_operators(
-    std::istream& in,
+    TaskInput& in,
     const vector<DeterministicOperator>& deterministic_operators,
     const vector<ExplicitVariable>& variables)
 {
-    int count;
-    in >> count;
+    int count = in.read_int();
     vector<ProbabilisticOperator> actions;
     actions.reserve(count);
     int outcomes_index = 0;
@@ -571,7 +661,7 @@ vector<ProbabilisticOperator> read_probabilistic_operators(
     return actions;
 }
 
-RootTask::RootTask(std::istream& in)
+RootTask::RootTask(TaskInput& in)
 {
     read_and_verify_version(in);
     bool use_metric = read_metric(in);
@@ -583,7 +673,7 @@ RootTask::RootTask(std::istream& in)
     initial_state_values.resize(num_variables);
     check_magic(in, "begin_state");
     for (int i = 0; i < num_variables; ++i) {
-        in >> initial_state_values[i];
+        initial_state_values[i] = in.read_int();
     }
     check_magic(in, "end_state");
 
@@ -596,7 +686,8 @@ RootTask::RootTask(std::istream& in)
     std::vector<DeterministicOperator> det_operators;
     det_operators = read_operators(in, use_metric);
     axioms = read_axioms(in, variables);
-    operators = read_probabilistic_operators(in, det_operators, variables);
+    set_operators(
+        read_probabilistic_operators(in, det_operators, variables));
     /* TODO: We should be stricter here and verify that we
        have reached the end of "in". */
 
@@ -608,18 +699,22 @@ RootTask::RootTask(std::istream& in)
     axiom_evaluator.evaluate(initial_state_values);
 }
 
-const ExplicitVariable& RootTask::get_variable(int var) const
+void RootTask::write_binary(std::ostream& out) const
 {
-    assert(utils::in_bounds(var, variables));
-    return variables[var];
+    vector<vector<FactPair>> fact_mutexes;
+    for (const vector<set<FactPair>>& var_mutexes : mutexes) {
+        for (const set<FactPair>& mutex_facts : var_mutexes) {
+            fact_mutexes.emplace_back(mutex_facts.begin(), mutex_facts.end());
+        }
+    }
+
+    write_binary_task(*this, fact_mutexes, out);
 }
 
-const ProbabilisticOutcome&
-RootTask::get_outcome(int op_id, int outcome_index) const
+const ExplicitVariable& RootTask::get_variable(int var) const
 {
-    const ProbabilisticOperator& op = get_operator(op_id);
-    assert(utils::in_bounds(outcome_index, op.outcomes));
-    return op.outcomes[outcome_index];
+    assert(utils::in_bounds(var, variables));
+    return variables[var];
 }
 
 const ExplicitEffect&
@@ -630,24 +725,58 @@ RootTask::get_axiom_effect_(int op_id, int effect_id) const
     return axiom.effects[effect_id];
 }
 
-const ExplicitEffect&
-RootTask::get_operator_effect(int op_id, int outcome_index, int effect_id) const
-{
-    const ProbabilisticOutcome& outcome = get_outcome(op_id, outcome_index);
-    assert(utils::in_bounds(effect_id, outcome.effects));
-    return outcome.effects[effect_id];
-}
-
 const ExplicitAxiom& RootTask::get_axiom(int index) const
 {
     assert(utils::in_bounds(index, axioms));
     return axioms[index];
 }
 
-const ProbabilisticOperator& RootTask::get_operator(int index) const
-{
-    assert(utils::in_bounds(index, operators));
-    return operators[index];
+void RootTask::set_operators(const vector<ProbabilisticOperator>& operators)
+{
+    operator_precondition_offsets.push_back(0);
+    outcome_offsets.push_back(0);
+    effect_offsets.push_back(0);
+    condition_offsets.push_back(0);
+
+    for (const ProbabilisticOperator& op : operators) {
+        assert(op.outcomes_start_index == ssize(outcome_probabilities));
+        operator_names.push_back(op.name);
+        operator_costs.push_back(static_cast<value_t>(op.cost));
+        operator_preconditions.insert(
+            operator_preconditions.end(),
+            op.preconditions.begin(),
+            op.preconditions.end());
+        operator_precondition_offsets.push_back(operator_preconditions.size());
+
+        for (const ProbabilisticOutcome& outcome : op.outcomes) {
+            outcome_probabilities.push_back(outcome.probability);
+
+            for (const ExplicitEffect& effect : outcome.effects) {
+                effects.push_back(effect.fact);
+                effect_conditions.insert(
+                    effect_conditions.end(),
+                    effect.conditions.begin(),
+                    effect.conditions.end());
+                condition_offsets.push_back(effect_conditions.size());
+            }
+
+            effect_offsets.push_back(effects.size());
+        }
+
+        outcome_offsets.push_back(outcome_probabilities.size());
+    }
+
+    operator_table.costs = operator_costs;
+    operator_table.precondition_offsets = operator_precondition_offsets;
+    operator_table.preconditions = operator_preconditions;
+    operator_table.outcome_offsets = outcome_offsets;
+    operator_table.outcome_probabilities = outcome_probabilities;
+    operator_table.effect_offsets = effect_offsets;
+    operator_table.effects = effects;
+    operator_table.condition_offsets = condition_offsets;
+    operator_table.conditions = effect_conditions;
+
+    set_operator_table(operator_table);
 }
 
 int RootTask::get_num_variables() const
@@ -742,51 +871,51 @@ FactPair RootTask::get_axiom_effect_condition(
 
 int RootTask::get_num_operators() const
 {
-    return operators.size();
+    return operator_table.get_num_operators();
 }
 
 value_t RootTask::get_operator_cost(int index) const
 {
-    return static_cast<value_t>(get_operator(index).cost);
+    assert(utils::in_bounds(index, operator_costs));
+    return operator_costs[index];
 }
 
 string RootTask::get_operator_name(int index) const
 {
-    return get_operator(index).name;
+    assert(utils::in_bounds(index, operator_names));
+    return operator_names[index];
 }
 
 int RootTask::get_num_operator_preconditions(int index) const
 {
-    return get_operator(index).preconditions.size();
+    return operator_table.get_num_preconditions(index);
 }
 
 FactPair RootTask::get_operator_precondition(int op_index, int fact_index) const
 {
-    const ProbabilisticOperator& op = get_operator(op_index);
-    assert(utils::in_bounds(fact_index, op.preconditions));
-    return op.preconditions[fact_index];
+    return operator_table.get_precondition(op_index, fact_index);
 }
 
 int RootTask::get_num_operator_outcomes(int index) const
 {
-    return get_operator(index).outcomes.size();
+    return operator_table.get_num_outcomes(index);
 }
 
 value_t
 RootTask::get_operator_outcome_probability(int index, int outcome_index) const
 {
-    return get_outcome(index, outcome_index).probability;
+    return operator_table.get_outcome_probability(index, outcome_index);
 }
 
 int RootTask::get_operator_outcome_id(int index, int outcome_index) const
 {
-    return get_operator(index).outcomes_start_index + outcome_index;
+    return operator_table.get_outcome_id(index, outcome_index);
 }
 
 int RootTask::get_num_operator_outcome_effects(int op_index, int outcome_index)
     const
 {
-    return get_outcome(op_index, outcome_index).effects.size();
+    return operator_table.get_num_effects(op_index, outcome_index);
 }
 
 FactPair RootTask::get_operator_outcome_effect(
@@ -794,7 +923,7 @@ FactPair RootTask::get_operator_outcome_effect(
     int outcome_index,
     int eff_index) const
 {
-    return get_operator_effect(op_index, outcome_index, eff_index).fact;
+    return operator_table.get_effect(op_index, outcome_index, eff_index);
 }
 
 int RootTask::get_num_operator_outcome_effect_conditions(
@@ -802,8 +931,10 @@ int RootTask::get_num_operator_outcome_effect_conditions(
     int outcome_index,
     int eff_index) const
 {
-    return get_operator_effect(op_index, outcome_index, eff_index)
-        .conditions.size();
+    return operator_table.get_num_effect_conditions(
+        op_index,
+        outcome_index,
+        eff_index);
 }
 
 FactPair RootTask::get_operator_outcome_effect_condition(
@@ -812,10 +943,11 @@ FactPair RootTask::get_operator_outcome_effect_condition(
     int eff_index,
     int cond_index) const
 {
-    const ExplicitEffect& effect =
-        get_operator_effect(op_index, outcome_index, eff_index);
-    assert(utils::in_bounds(cond_index, effect.conditions));
-    return effect.conditions[cond_index];
+    return operator_table.get_effect_condition(
+        op_index,
+        outcome_index,
+        eff_index,
+        cond_index);
 }
 
 int RootTask::get_num_goals() const
@@ -857,7 +989,17 @@ int RootTask::convert_operator_index(
 
 std::unique_ptr<ProbabilisticTask> read_sas_task(std::istream& in)
 {
-    return std::make_unique<RootTask>(in);
+    if (is_binary_task(in)) return read_binary_task(in);
+
+    TaskInput input(in);
+    return std::make_unique<RootTask>(input);
+}
+
+void convert_sas_task_to_binary(std::istream& in, std::ostream& out)
+{
+    TaskInput input(in);
+    RootTask task(input);
+    task.write_binary(out);
 }
 
 std::shared_ptr<ProbabilisticTask> read_root_tasks(std::istream& in)
@@ -0,0 +1,170 @@
+#include "probfd/utils/thread_pool.h"
+
+#include <cassert>
+#include <utility>
+
+namespace probfd {
+
+namespace {
+// Identifies the pool and queue of the current worker thread, if any.
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local unsigned current_index = 0;
+} // namespace
+
+ThreadPool::ThreadPool(unsigned num_threads)
+{
+    assert(num_threads > 0);
+
+    queues_.reserve(num_threads);
+    for (unsigned i = 0; i != num_threads; ++i) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    workers_.reserve(num_threads);
+    for (unsigned i = 0; i != num_threads; ++i) {
+        workers_.emplace_back([this, i] { worker_loop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    cancelled_ = true;
+
+    {
+        std::lock_guard lock(sleep_mutex_);
+        stop_ = true;
+    }
+
+    sleep_cv_.notify_all();
+
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(Task task)
+{
+    const unsigned index =
+        current_pool == this
+            ? current_index
+            : next_queue_.fetch_add(1, std::memory_order_relaxed) %
+                  queues_.size();
+
+    ++unfinished_;
+
+    {
+        WorkerQueue& queue = *queues_[index];
+        std::lock_guard lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+
+    {
+        // Increment under the lock to avoid lost wake-ups.
+        std::lock_guard lock(sleep_mutex_);
+        ++queued_;
+    }
+
+    sleep_cv_.notify_one();
+}
+
+void ThreadPool::wait()
+{
+    assert(current_pool != this);
+
+    {
+        std::unique_lock lock(done_mutex_);
+        done_cv_.wait(lock, [this] { return unfinished_ == 0; });
+    }
+
+    if (exception_) {
+        std::exception_ptr e = std::exchange(exception_, nullptr);
+        cancelled_ = false;
+        std::rethrow_exception(e);
+    }
+}
+
+unsigned ThreadPool::get_num_threads() const
+{
+    return static_cast<unsigned>(workers_.size());
+}
+
+unsigned ThreadPool::get_hardware_concurrency()
+{
+    const unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+void ThreadPool::worker_loop(unsigned index)
+{
+    current_pool = this;
+    current_index = index;
+
+    Task task;
+
+    for (;;) {
+        if (try_pop(index, task)) {
+            run_task(task);
+            continue;
+        }
+
+        std::unique_lock lock(sleep_mutex_);
+        sleep_cv_.wait(lock, [this] { return stop_ || queued_ > 0; });
+        if (stop_) return;
+    }
+}
+
+bool ThreadPool::try_pop(unsigned index, Task& task)
+{
+    // Own queue first (LIFO), then steal from the others (FIFO).
+    {
+        WorkerQueue& own = *queues_[index];
+        std::lock_guard lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            --queued_;
+            return true;
+        }
+    }
+
+    const std::size_t num_queues = queues_.size();
+
+    for (std::size_t i = 1; i != num_queues; ++i) {
+        WorkerQueue& victim = *queues_[(index + i) % num_queues];
+        std::lock_guard lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            --queued_;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::run_task(Task& task)
+{
+    if (!cancelled_) {
+        try {
+            task();
+        } catch (...) {
+            std::lock_guard lock(done_mutex_);
+            if (!exception_) exception_ = std::current_exception();
+            cancelled_ = true;
+        }
+    }
+
+    task = nullptr;
+    finish_task();
+}
+
+void ThreadPool::finish_task()
+{
+    if (--unfinished_ == 0) {
+        std::lock_guard lock(done_mutex_);
+        done_cv_.notify_all();
+    }
+}
+
+} // namespace probfd
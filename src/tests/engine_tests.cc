@@ -2,15 +2,24 @@
 
 #include "probfd/tasks/root_task.h"
 
+#include "probfd/algorithms/flat_value_iteration.h"
 #include "probfd/algorithms/fret.h"
+#include "probfd/algorithms/heuristic_search_base.h"
 #include "probfd/algorithms/heuristic_depth_first_search.h"
+#include "probfd/algorithms/parallel_lrtdp.h"
+#include "probfd/algorithms/qvalue_batch.h"
+#include "probfd/algorithms/topological_value_iteration.h"
 
 #include "probfd/policy_pickers/arbitrary_tiebreaker.h"
 
+#include "probfd/policies/vector_policy.h"
+
 #include "probfd/heuristics/constant_evaluator.h"
 
 #include "probfd/quotients/quotient_system.h"
 
+#include "probfd/solvers/policy_simulator.h"
+
 #include "probfd/ssp_cost_function.h"
 #include "probfd/task_proxy.h"
 #include "probfd/task_state_space.h"
@@ -19,6 +28,16 @@
 
 #include "tests/verification/policy_verification.h"
 
+#include "downward/utils/rng.h"
+#include "downward/utils/system.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+
 using namespace probfd;
 using namespace tests;
 
@@ -103,6 +122,190 @@ TEST(EngineTests, test_interval_update4)
     ASSERT_EQ(interval.upper, std::min(40.0_vt, 39.0_vt));
 }
 
+TEST(EngineTests, test_qvalue_batch_interval)
+{
+    algorithms::QValueBatch<true> batch;
+
+    // Self-loop with probability 0.5 is normalized away.
+    batch.begin_transition(1.0_vt);
+    batch.add_successor(0.5_vt, Interval(2.0_vt, 4.0_vt));
+    batch.add_self_loop(0.5_vt);
+    batch.end_transition();
+
+    batch.begin_transition(3.0_vt);
+    batch.add_successor(0.25_vt, Interval(0.0_vt, 8.0_vt));
+    batch.add_successor(0.75_vt, Interval(0.0_vt, 12.0_vt));
+    batch.end_transition();
+
+    // Pure self-loop
+    batch.begin_transition(1.0_vt);
+    batch.add_self_loop(1.0_vt);
+    batch.end_transition();
+
+    batch.end_state();
+
+    batch.compute_qvalues();
+
+    ASSERT_EQ(batch.get_qvalue(0).lower, 4.0_vt);
+    ASSERT_EQ(batch.get_qvalue(0).upper, 6.0_vt);
+    ASSERT_EQ(batch.get_qvalue(1).lower, 3.0_vt);
+    ASSERT_EQ(batch.get_qvalue(1).upper, 14.0_vt);
+    ASSERT_TRUE(batch.is_self_loop(2));
+    ASSERT_FALSE(batch.has_only_self_loops(0));
+
+    Interval best = batch.compute_min_qvalue(0, Interval(100.0_vt));
+
+    ASSERT_EQ(best.lower, 3.0_vt);
+    ASSERT_EQ(best.upper, 6.0_vt);
+}
+
+namespace {
+/*
+ * A chain of states 0, ..., 5. The only action of state i < 5 has cost 1 and
+ * moves to state i + 1 with probability 1/2, otherwise it stays in state i.
+ * State 5 is the goal, so the optimal value of state i is 2 * (5 - i).
+ * Non-goal states terminate with cost 100.
+ */
+class SelfLoopChainMDP : public SimpleMDP<int, int> {
+public:
+    static constexpr int GOAL = 5;
+
+    probfd::StateID get_state_id(int state) override { return state; }
+
+    int get_state(probfd::StateID state_id) override
+    {
+        return static_cast<int>(state_id);
+    }
+
+    void
+    generate_applicable_actions(int state, std::vector<int>& result) override
+    {
+        if (state != GOAL) result.push_back(0);
+    }
+
+    void generate_action_transitions(
+        int state,
+        int,
+        Distribution<probfd::StateID>& result) override
+    {
+        result.add_probability(state, 0.5_vt);
+        result.add_probability(state + 1, 0.5_vt);
+    }
+
+    void generate_all_transitions(
+        int state,
+        std::vector<int>& aops,
+        std::vector<Distribution<probfd::StateID>>& successors) override
+    {
+        generate_applicable_actions(state, aops);
+        for (const int action : aops) {
+            generate_action_transitions(
+                state,
+                action,
+                successors.emplace_back());
+        }
+    }
+
+    void generate_all_transitions(
+        int state,
+        std::vector<Transition<int>>& transitions) override
+    {
+        std::vector<int> aops;
+        generate_applicable_actions(state, aops);
+        for (const int action : aops) {
+            Transition<int>& t = transitions.emplace_back(action);
+            generate_action_transitions(state, action, t.successor_dist);
+        }
+    }
+
+    value_t get_action_cost(int) override { return 1_vt; }
+
+    bool is_goal(int state) const override { return state == GOAL; }
+
+    value_t get_non_goal_termination_cost() const override { return 100_vt; }
+};
+} // namespace
+
+TEST(EngineTests, test_batched_bellman_update)
+{
+    using namespace algorithms::heuristic_search;
+
+    using StateInfo = PerStateBaseInformation<int, false, true>;
+    using Base = HeuristicSearchBase<int, int, StateInfo>;
+
+    SelfLoopChainMDP mdp;
+    heuristics::BlindEvaluator<int> heuristic;
+
+    Base base(
+        std::make_shared<policy_pickers::ArbitraryTiebreaker<int, int>>(true));
+
+    // Listed against the direction of the chain, so that updating the states
+    // one after another would solve the chain in a single pass.
+    const std::vector<probfd::StateID> state_ids = {5, 4, 3, 2, 1, 0};
+
+    int passes = 0;
+    while (base.bellman_update(mdp, heuristic, state_ids)) {
+        ++passes;
+
+        // All states are updated simultaneously from the values of the
+        // previous pass, so the values propagate one state per pass.
+        for (int state = 0; state != SelfLoopChainMDP::GOAL; ++state) {
+            const int distance = SelfLoopChainMDP::GOAL - state;
+            const Interval bounds = base.lookup_bounds(state);
+            ASSERT_EQ(bounds.lower, 2_vt * std::min(passes, distance));
+            ASSERT_EQ(
+                bounds.upper,
+                passes < distance ? 100_vt : 2_vt * distance);
+        }
+    }
+
+    ASSERT_EQ(passes, SelfLoopChainMDP::GOAL);
+    ASSERT_EQ(base.lookup_bounds(SelfLoopChainMDP::GOAL).upper, 0_vt);
+
+    // A single-state update agrees with the batched fixpoint.
+    for (const probfd::StateID state_id : state_ids) {
+        ASSERT_FALSE(base.bellman_update(mdp, heuristic, state_id));
+    }
+}
+
+TEST(EngineTests, test_soa_state_infos)
+{
+    using namespace algorithms::heuristic_search;
+
+    using BaseInfo = PerStateBaseInformation<
+        OperatorID,
+        true,
+        false,
+        StateInfoLayout::STRUCT_OF_ARRAYS>;
+    using StateInfo =
+        algorithms::lrtdp::internal::PerStateInformation<BaseInfo>;
+    using AOSInfo = algorithms::lrtdp::internal::PerStateInformation<
+        PerStateBaseInformation<OperatorID, true, false>>;
+
+    internal::StateInfos<StateInfo> state_infos;
+
+    StateInfo info = state_infos[3];
+    info.set_on_fringe();
+    info.value = 5.0_vt;
+    info.set_policy(OperatorID(2));
+    info.mark_solved();
+
+    const StateInfo other = state_infos[3];
+    ASSERT_TRUE(other.is_on_fringe());
+    ASSERT_TRUE(other.is_solved());
+    ASSERT_EQ(other.get_policy(), OperatorID(2));
+    ASSERT_EQ(state_infos.lookup_value(3), 5.0_vt);
+
+    const auto& const_infos = state_infos;
+    ASSERT_FALSE(const_infos[2].is_value_initialized());
+    ASSERT_FALSE(const_infos[100].is_value_initialized());
+    ASSERT_EQ(std::ranges::distance(state_infos.get_infos()), 4);
+
+    ASSERT_LT(
+        internal::StateInfos<StateInfo>::BYTES_PER_STATE,
+        internal::StateInfos<AOSInfo>::BYTES_PER_STATE);
+}
+
 TEST(EngineTests, test_ilao_blocksworld_6_blocks)
 {
     using namespace algorithms::heuristic_depth_first_search;
@@ -206,4 +409,504 @@ TEST(EngineTests, test_fret_ilao_blocksworld_6_blocks)
     EXPECT_NEAR(decision->q_value_interval.lower, 8.011, 0.01);
     ASSERT_TRUE(
         verify_policy(mdp, *policy, mdp.get_state_id(mdp.get_initial_state())));
-}
\ No newline at end of file
+}
+
+TEST(EngineTests, test_parallel_tvi_blocksworld_6_blocks)
+{
+    using namespace algorithms::topological_vi;
+
+    std::shared_ptr<ProbabilisticTask> task(new BlocksworldTask(
+        6,
+        {{1, 0}, {2}, {5, 4, 3}},
+        {{1, 4}, {5, 3, 2, 0}}));
+
+    tasks::set_root_task(task);
+
+    ProbabilisticTaskProxy task_proxy(*task);
+
+    ProgressReport report(0.0_vt, std::cout, false);
+    heuristics::BlindEvaluator<State> heuristic;
+    auto cost_function = std::make_shared<SSPCostFunction>(task_proxy);
+
+    TaskStateSpace mdp(task, utils::get_silent_log(), cost_function);
+
+    TopologicalValueIteration<State, OperatorID> sequential_tvi(false);
+    TopologicalValueIteration<State, OperatorID> parallel_tvi(false, 4);
+
+    Interval sequential_value = sequential_tvi.solve(
+        mdp,
+        heuristic,
+        mdp.get_initial_state(),
+        report,
+        std::numeric_limits<double>::infinity());
+
+    Interval parallel_value = parallel_tvi.solve(
+        mdp,
+        heuristic,
+        mdp.get_initial_state(),
+        report,
+        std::numeric_limits<double>::infinity());
+
+    EXPECT_NEAR(sequential_value.lower, 8.011, 0.01);
+    EXPECT_NEAR(parallel_value.lower, sequential_value.lower, g_epsilon);
+    ASSERT_EQ(
+        sequential_tvi.get_statistics().sccs,
+        parallel_tvi.get_statistics().sccs);
+}
+
+TEST(EngineTests, test_parallel_lrtdp_blocksworld_6_blocks)
+{
+    using namespace algorithms::lrtdp;
+
+    std::shared_ptr<ProbabilisticTask> task(new BlocksworldTask(
+        6,
+        {{1, 0}, {2}, {5, 4, 3}},
+        {{1, 4}, {5, 3, 2, 0}}));
+
+    tasks::set_root_task(task);
+
+    ProbabilisticTaskProxy task_proxy(*task);
+
+    ProgressReport report(0.0_vt, std::cout, false);
+    heuristics::BlindEvaluator<State> heuristic;
+    auto cost_function = std::make_shared<SSPCostFunction>(task_proxy);
+
+    TaskStateSpace mdp(task, utils::get_silent_log(), cost_function);
+
+    ParallelLRTDP<State, OperatorID> lrtdp(
+        TrialTerminationCondition::TERMINAL,
+        4,
+        42);
+
+    auto policy = lrtdp.compute_policy(
+        mdp,
+        heuristic,
+        mdp.get_initial_state(),
+        report,
+        std::numeric_limits<double>::infinity());
+
+    std::optional<PolicyDecision<OperatorID>> decision =
+        policy->get_decision(mdp.get_initial_state());
+
+    ASSERT_TRUE(decision.has_value());
+    EXPECT_NEAR(decision->q_value_interval.lower, 8.011, 0.01);
+    ASSERT_TRUE(
+        verify_policy(mdp, *policy, mdp.get_state_id(mdp.get_initial_state())));
+}
+
+TEST(EngineTests, test_flat_vi_blocksworld_6_blocks)
+{
+    using namespace algorithms::flat_vi;
+
+    std::shared_ptr<ProbabilisticTask> task(new BlocksworldTask(
+        6,
+        {{1, 0}, {2}, {5, 4, 3}},
+        {{1, 4}, {5, 3, 2, 0}}));
+
+    tasks::set_root_task(task);
+
+    ProbabilisticTaskProxy task_proxy(*task);
+
+    ProgressReport report(0.0_vt, std::cout, false);
+    heuristics::BlindEvaluator<State> heuristic;
+    auto cost_function = std::make_shared<SSPCostFunction>(task_proxy);
+
+    TaskStateSpace mdp(task, utils::get_silent_log(), cost_function);
+
+    FlatValueIteration<State, OperatorID> topological_vi(false, true);
+    FlatValueIteration<State, OperatorID> gauss_seidel_vi(false, false);
+
+    auto policy = topological_vi.compute_policy(
+        mdp,
+        heuristic,
+        mdp.get_initial_state(),
+        report,
+        std::numeric_limits<double>::infinity());
+
+    Interval gauss_seidel_value = gauss_seidel_vi.solve(
+        mdp,
+        heuristic,
+        mdp.get_initial_state(),
+        report,
+        std::numeric_limits<double>::infinity());
+
+    std::optional<PolicyDecision<OperatorID>> decision =
+        policy->get_decision(mdp.get_initial_state());
+
+    ASSERT_TRUE(decision.has_value());
+    EXPECT_NEAR(decision->q_value_interval.lower, 8.011, 0.01);
+    EXPECT_NEAR(gauss_seidel_value.lower, 8.011, 0.01);
+    ASSERT_TRUE(
+        verify_policy(mdp, *policy, mdp.get_state_id(mdp.get_initial_state())));
+}
+
+namespace {
+/*
+ * States 0 and 1 form a zero-cost trap. Action 2 leaves it from state 1 with
+ * cost 1 and reaches the goal state 2 with probability 1/2, so the optimal
+ * value of states 0 and 1 is 2.
+ */
+class TrapMDP : public SimpleMDP<int, int> {
+public:
+    probfd::StateID get_state_id(int state) override { return state; }
+
+    int get_state(probfd::StateID state_id) override
+    {
+        return static_cast<int>(state_id);
+    }
+
+    void
+    generate_applicable_actions(int state, std::vector<int>& result) override
+    {
+        if (state == 0) {
+            result.push_back(0);
+        } else if (state == 1) {
+            result.push_back(1);
+            result.push_back(2);
+        }
+    }
+
+    void generate_action_transitions(
+        int,
+        int action,
+        Distribution<probfd::StateID>& result) override
+    {
+        switch (action) {
+        case 0: result.add_probability(1, 1_vt); break;
+        case 1: result.add_probability(0, 1_vt); break;
+        default:
+            result.add_probability(0, 0.5_vt);
+            result.add_probability(2, 0.5_vt);
+        }
+    }
+
+    void generate_all_transitions(
+        int state,
+        std::vector<int>& aops,
+        std::vector<Distribution<probfd::StateID>>& successors) override
+    {
+        generate_applicable_actions(state, aops);
+        for (const int action : aops) {
+            generate_action_transitions(
+                state,
+                action,
+                successors.emplace_back());
+        }
+    }
+
+    void generate_all_transitions(
+        int state,
+        std::vector<Transition<int>>& transitions) override
+    {
+        std::vector<int> aops;
+        generate_applicable_actions(state, aops);
+        for (const int action : aops) {
+            Transition<int>& t = transitions.emplace_back(action);
+            generate_action_transitions(state, action, t.successor_dist);
+        }
+    }
+
+    value_t get_action_cost(int action) override
+    {
+        return action == 2 ? 1_vt : 0_vt;
+    }
+
+    bool is_goal(int state) const override { return state == 2; }
+
+    value_t get_non_goal_termination_cost() const override
+    {
+        return INFINITE_VALUE;
+    }
+};
+} // namespace
+
+TEST(EngineTests, test_flat_interval_vi_collapses_traps)
+{
+    using namespace algorithms::flat_vi;
+
+    ProgressReport report(0.0_vt, std::cout, false);
+    heuristics::BlindEvaluator<int> heuristic;
+    TrapMDP mdp;
+
+    for (const bool topological : {true, false}) {
+        FlatValueIteration<int, int, true> vi(false, topological);
+
+        auto policy = vi.compute_policy(
+            mdp,
+            heuristic,
+            0,
+            report,
+            std::numeric_limits<double>::infinity());
+
+        std::optional<PolicyDecision<int>> decision0 = policy->get_decision(0);
+        std::optional<PolicyDecision<int>> decision1 = policy->get_decision(1);
+
+        ASSERT_TRUE(decision0.has_value());
+        ASSERT_TRUE(decision1.has_value());
+        ASSERT_EQ(decision0->action, 0);
+        ASSERT_EQ(decision1->action, 2);
+        EXPECT_NEAR(decision0->q_value_interval.lower, 2.0, 0.001);
+        EXPECT_NEAR(decision0->q_value_interval.upper, 2.0, 0.001);
+        ASSERT_FALSE(policy->get_decision(2).has_value());
+    }
+}
+
+TEST(EngineTests, test_vector_policy_matches_map_reference)
+{
+    // TrapMDP maps every integer to the state ID of the same value.
+    TrapMDP mdp;
+    utils::RandomNumberGenerator rng(42);
+
+    for (const bool store_bounds : {true, false}) {
+        // Start with fewer slots than state IDs to exercise the growth path.
+        policies::VectorPolicy<int, int> policy(&mdp, 16, store_bounds);
+
+        std::map<int, PolicyDecision<int>> reference;
+        std::vector<int> insertion_order;
+
+        for (int i = 0; i != 5000; ++i) {
+            const int state = rng.random(1000) * 3;
+            const int action = rng.random(10);
+            const value_t lower = rng.random();
+            const Interval bounds(lower, lower + rng.random());
+
+            policy.emplace_decision(state, action, bounds);
+
+            // The first decision emplaced for a state is kept.
+            if (reference.emplace(state, PolicyDecision<int>{action, bounds})
+                    .second) {
+                insertion_order.push_back(state);
+            }
+        }
+
+        ASSERT_EQ(policy.size(), reference.size());
+        ASSERT_EQ(policy.get_state_ids().size(), insertion_order.size());
+        for (std::size_t i = 0; i != insertion_order.size(); ++i) {
+            ASSERT_EQ(policy.get_state_ids()[i], insertion_order[i]);
+        }
+
+        const auto expect_decision = [&](int state,
+                                         const PolicyDecision<int>& decision) {
+            const PolicyDecision<int>& expected = reference.at(state);
+            ASSERT_EQ(decision.action, expected.action);
+            if (store_bounds) {
+                ASSERT_EQ(
+                    decision.q_value_interval.lower,
+                    expected.q_value_interval.lower);
+                ASSERT_EQ(
+                    decision.q_value_interval.upper,
+                    expected.q_value_interval.upper);
+            } else {
+                ASSERT_EQ(decision.q_value_interval.lower, -INFINITE_VALUE);
+                ASSERT_EQ(decision.q_value_interval.upper, INFINITE_VALUE);
+            }
+        };
+
+        // Includes IDs that were never emplaced and IDs past the last slot.
+        for (int state = 0; state != 3100; ++state) {
+            const std::optional decision = policy.find_decision(state);
+            ASSERT_EQ(decision.has_value(), reference.contains(state));
+            ASSERT_EQ(
+                policy.get_decision(state).has_value(),
+                decision.has_value());
+            if (!decision) continue;
+            expect_decision(state, *decision);
+            expect_decision(state, *policy.get_decision(state));
+            expect_decision(state, policy[state]);
+        }
+
+        std::size_t index = 0;
+        policy.for_each_decision(
+            [&](const int& state, const PolicyDecision<int>& decision) {
+                ASSERT_LT(index, insertion_order.size());
+                ASSERT_EQ(state, insertion_order[index++]);
+                expect_decision(state, decision);
+            });
+        ASSERT_EQ(index, insertion_order.size());
+    }
+}
+
+namespace {
+/*
+  Picks up block 1 and puts it back onto block 0 or the table, forever. Blocks
+  0 and 2 are never moved.
+*/
+class RepeatedPickUpPolicy : public Policy<State, OperatorID> {
+    const BlocksworldTask& task_;
+
+public:
+    explicit RepeatedPickUpPolicy(const BlocksworldTask& task)
+        : task_(task)
+    {
+    }
+
+    std::optional<PolicyDecision<OperatorID>>
+    get_decision(const State& state) const override
+    {
+        const auto holds = [&](FactPair fact) {
+            return state[fact.var].get_value() == fact.value;
+        };
+
+        int op_index;
+        if (holds(task_.get_fact_block_in_hand(1))) {
+            op_index = task_.get_operator_put_block_on_block_index(1, 0);
+        } else if (!holds(task_.get_fact_is_hand_empty(true))) {
+            return std::nullopt;
+        } else if (holds(task_.get_fact_block_on_block(1, 0))) {
+            op_index = task_.get_operator_pick_up_block_on_block_index(1, 0);
+        } else if (holds(task_.get_fact_block_on_table(1))) {
+            op_index = task_.get_operator_pick_up_block_from_table_index(1);
+        } else {
+            return std::nullopt;
+        }
+
+        return PolicyDecision<OperatorID>{OperatorID(op_index)};
+    }
+
+    void for_each_decision(
+        std::function<void(const State&, const PolicyDecision<OperatorID>&)>)
+        const override
+    {
+    }
+
+    void print(
+        std::ostream&,
+        std::function<void(const State&, std::ostream&)>,
+        std::function<void(const OperatorID&, std::ostream&)>) override
+    {
+    }
+};
+
+std::string read_file(const std::filesystem::path& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), {});
+}
+} // namespace
+
+TEST(EngineTests, test_policy_simulator_thread_independence)
+{
+    using namespace algorithms::topological_vi;
+
+    std::shared_ptr<ProbabilisticTask> task(new BlocksworldTask(
+        6,
+        {{1, 0}, {2}, {5, 4, 3}},
+        {{1, 4}, {5, 3, 2, 0}}));
+
+    tasks::set_root_task(task);
+
+    ProbabilisticTaskProxy task_proxy(*task);
+
+    ProgressReport report(0.0_vt, std::cout, false);
+    heuristics::BlindEvaluator<State> heuristic;
+    auto cost_function = std::make_shared<SSPCostFunction>(task_proxy);
+
+    TaskStateSpace mdp(task, utils::get_silent_log(), cost_function);
+
+    TopologicalValueIteration<State, OperatorID> tvi(false);
+
+    auto policy = tvi.compute_policy(
+        mdp,
+        heuristic,
+        mdp.get_initial_state(),
+        report,
+        std::numeric_limits<double>::infinity());
+
+    solvers::PolicySimulator simulator(task_proxy, mdp, *policy);
+    ASSERT_GT(simulator.get_num_states(), 1);
+
+    const auto print_state = [](const State&, std::ostream&) {};
+
+    // More trajectories than fit into one batch.
+    constexpr int num_trajectories = 2500;
+
+    std::vector<std::string> files;
+    std::vector<solvers::SimulationStatistics> statistics;
+
+    for (const unsigned num_threads : {1U, 2U, 3U}) {
+        const std::filesystem::path path =
+            std::filesystem::temp_directory_path() /
+            ("probfd_trajectories_" + std::to_string(utils::get_process_id()));
+
+        statistics.push_back(simulator.simulate(
+            num_trajectories,
+            100,
+            num_threads,
+            42,
+            solvers::TrajectoryOutputFormat::BINARY,
+            path.string(),
+            print_state));
+
+        files.push_back(read_file(path));
+        std::filesystem::remove(path);
+    }
+
+    for (std::size_t i = 0; i != files.size(); ++i) {
+        ASSERT_FALSE(files[i].empty());
+        ASSERT_EQ(files[i], files.front());
+
+        ASSERT_EQ(statistics[i].trajectories, num_trajectories);
+        ASSERT_EQ(statistics[i].steps, statistics.front().steps);
+        ASSERT_EQ(
+            statistics[i].goal_trajectories,
+            statistics.front().goal_trajectories);
+        ASSERT_EQ(
+            statistics[i].truncated_trajectories,
+            statistics.front().truncated_trajectories);
+        ASSERT_EQ(statistics[i].cost_sum, statistics.front().cost_sum);
+    }
+
+    // The optimal policy reaches the goal almost surely, so most trajectories
+    // reach it within 100 steps.
+    ASSERT_GT(statistics.front().goal_trajectories, num_trajectories / 2);
+
+    // A different seed gives different trajectories.
+    const solvers::SimulationStatistics other_seed = simulator.simulate(
+        num_trajectories,
+        100,
+        1,
+        43,
+        solvers::TrajectoryOutputFormat::NONE,
+        "",
+        print_state);
+    ASSERT_NE(other_seed.steps, statistics.front().steps);
+}
+
+TEST(EngineTests, test_policy_simulator_truncates_cycles)
+{
+    auto task = std::make_shared<BlocksworldTask>(
+        3,
+        std::vector<std::vector<int>>{{0}, {1}, {2}},
+        std::vector<std::vector<int>>{{2, 0}});
+
+    tasks::set_root_task(task);
+
+    ProbabilisticTaskProxy task_proxy(*task);
+    auto cost_function = std::make_shared<SSPCostFunction>(task_proxy);
+    TaskStateSpace mdp(task, utils::get_silent_log(), cost_function);
+
+    RepeatedPickUpPolicy policy(*task);
+    solvers::PolicySimulator simulator(task_proxy, mdp, policy);
+
+    // Block 1 is on block 0, on the table or in the hand.
+    ASSERT_EQ(simulator.get_num_states(), 3);
+
+    constexpr int num_trajectories = 100;
+    constexpr int trajectory_length = 25;
+
+    for (const unsigned num_threads : {1U, 2U}) {
+        const solvers::SimulationStatistics statistics = simulator.simulate(
+            num_trajectories,
+            trajectory_length,
+            num_threads,
+            42,
+            solvers::TrajectoryOutputFormat::NONE,
+            "",
+            [](const State&, std::ostream&) {});
+
+        ASSERT_EQ(statistics.trajectories, num_trajectories);
+        ASSERT_EQ(statistics.goal_trajectories, 0);
+        ASSERT_EQ(statistics.truncated_trajectories, num_trajectories);
+        ASSERT_EQ(statistics.steps, num_trajectories * trajectory_length);
+    }
+}
@@ -2,18 +2,44 @@
 
 #include "probfd/tasks/root_task.h"
 
+#include "probfd/task_utils/task_properties.h"
+
+#include "probfd/algorithms/topological_value_iteration.h"
+
+#include "probfd/heuristics/constant_evaluator.h"
+
+#include "probfd/policy.h"
+#include "probfd/progress_report.h"
+#include "probfd/ssp_cost_function.h"
 #include "probfd/task_proxy.h"
+#include "probfd/task_state_space.h"
 
 #include "probfd/cartesian_abstractions/abstraction.h"
+#include "probfd/cartesian_abstractions/cartesian_heuristic_function.h"
+#include "probfd/cartesian_abstractions/cost_saturation.h"
+#include "probfd/cartesian_abstractions/distances.h"
+#include "probfd/cartesian_abstractions/evaluators.h"
+#include "probfd/cartesian_abstractions/ilao_policy_generator.h"
 #include "probfd/cartesian_abstractions/probabilistic_transition_system.h"
+#include "probfd/cartesian_abstractions/split_selector.h"
+#include "probfd/cartesian_abstractions/subtask_generators.h"
+#include "probfd/cartesian_abstractions/trace_based_flaw_generator.h"
 #include "probfd/cartesian_abstractions/types.h"
 
 #include "downward/cartesian_abstractions/refinement_hierarchy.h"
 
+#include "downward/utils/countdown_timer.h"
+#include "downward/utils/exceptions.h"
 #include "downward/utils/logging.h"
 
+#include "downward/plugins/options.h"
+
 #include <filesystem>
 #include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <vector>
 
 using namespace probfd;
 using namespace probfd::cartesian_abstractions;
@@ -74,4 +100,217 @@ TEST(CartesianTests, test_probabilistic_transition_system2)
     abs.refine(refinement_hierarchy, abs.get_abstract_state(1), 2, {1, 2, 3});
     ASSERT_EQ(abs.get_num_states(), 3);
     ASSERT_EQ(get_num_transitions(abs.get_transition_system()), 34);
-}
\ No newline at end of file
+}
+
+static std::vector<CartesianHeuristicFunction> compute_goal_cost_partitioning(
+    const std::shared_ptr<ProbabilisticTask>& task,
+    int num_threads)
+{
+    plugins::Options opts;
+    opts.set<FactOrder>("order", FactOrder::ORIGINAL);
+    opts.set<int>("random_seed", 42);
+
+    CostSaturation cost_saturation(
+        {std::make_shared<GoalDecomposition>(opts)},
+        std::make_shared<AStarFlawGeneratorFactory>(),
+        std::make_shared<SplitSelectorMinUnwantedFactory>(),
+        std::numeric_limits<int>::max(),
+        std::numeric_limits<int>::max(),
+        std::numeric_limits<double>::infinity(),
+        false,
+        num_threads,
+        utils::get_silent_log());
+
+    return cost_saturation.generate_heuristic_functions(task);
+}
+
+TEST(CartesianTests, test_concurrent_cost_saturation_admissible)
+{
+    std::fstream file("resources/pblocksworld_example.sas");
+    std::shared_ptr<ProbabilisticTask> task = tasks::read_sas_task(file);
+    tasks::set_root_task(task);
+
+    const ProbabilisticTaskProxy task_proxy(*task);
+    ASSERT_GT(task_proxy.get_goals().size(), 1);
+
+    std::vector<CartesianHeuristicFunction> sequential =
+        compute_goal_cost_partitioning(task, 1);
+    std::vector<CartesianHeuristicFunction> concurrent =
+        compute_goal_cost_partitioning(task, 3);
+
+    ASSERT_FALSE(sequential.empty());
+    ASSERT_FALSE(concurrent.empty());
+
+    // Compute the optimal state values of the reachable states.
+    auto cost_function = std::make_shared<SSPCostFunction>(task_proxy);
+    TaskStateSpace mdp(task, utils::get_silent_log(), cost_function);
+    heuristics::BlindEvaluator<State> blind;
+    ProgressReport report(0.0_vt, std::cout, false);
+
+    algorithms::topological_vi::TopologicalValueIteration<State, OperatorID>
+        tvi(false);
+    auto policy = tvi.compute_policy(
+        mdp,
+        blind,
+        mdp.get_initial_state(),
+        report,
+        std::numeric_limits<double>::infinity());
+
+    int num_states = 0;
+    policy->for_each_decision(
+        [&](const State& state, const PolicyDecision<OperatorID>& decision) {
+            ++num_states;
+
+            value_t sum = 0_vt;
+            for (const CartesianHeuristicFunction& function : concurrent) {
+                sum += function.get_value(state);
+            }
+
+            ASSERT_LE(sum, decision.q_value_interval.lower + 0.001_vt);
+
+            // The first abstraction is refined and saturated for the full
+            // costs, as in the sequential computation.
+            ASSERT_EQ(
+                concurrent.front().get_value(state),
+                sequential.front().get_value(state));
+        });
+
+    ASSERT_GT(num_states, 0);
+}
+
+namespace {
+/// An abstraction refined by hand, with the distance estimates maintained by
+/// an ILAO* policy generator.
+struct ILAOAbstraction {
+    RefinementHierarchy refinement_hierarchy;
+    Abstraction abstraction;
+    CartesianHeuristic heuristic;
+    ILAOPolicyGenerator policy_generator;
+
+    ILAOAbstraction(
+        const std::shared_ptr<ProbabilisticTask>& task,
+        bool incremental_distances)
+        : refinement_hierarchy(task)
+        , abstraction(
+              ProbabilisticTaskProxy(*task),
+              probfd::task_properties::get_operator_costs(
+                  ProbabilisticTaskProxy(*task)),
+              utils::get_silent_log())
+        , policy_generator(incremental_distances)
+    {
+    }
+
+    // Splits the abstract initial state like CEGAR does.
+    void split_initial_state(int var, int value)
+    {
+        const AbstractState& state = abstraction.get_initial_state();
+        const int state_id = state.get_id();
+        const auto [v1_id, v2_id] =
+            abstraction.refine(refinement_hierarchy, state, var, {value});
+        heuristic.on_split(state_id);
+        policy_generator.notify_split(v1_id, v2_id);
+    }
+
+    void find_solution(utils::CountdownTimer& timer)
+    {
+        policy_generator.find_solution(
+            abstraction,
+            &abstraction.get_initial_state(),
+            heuristic,
+            timer);
+    }
+
+    // Checks the estimates against the goal distances computed from scratch.
+    void verify_distances()
+    {
+        CartesianHeuristic blind;
+        for (int i = 1; i != abstraction.get_num_states(); ++i) {
+            blind.on_split(0);
+        }
+
+        const std::vector<value_t> distances =
+            compute_distances(abstraction, blind);
+
+        const int init_id = abstraction.get_initial_state().get_id();
+        ASSERT_NEAR(heuristic.get_h_value(init_id), distances[init_id], 0.001);
+
+        for (int i = 0; i != abstraction.get_num_states(); ++i) {
+            ASSERT_LE(heuristic.get_h_value(i), distances[i] + 0.001_vt);
+        }
+    }
+};
+} // namespace
+
+TEST(CartesianTests, test_ilao_incremental_distances)
+{
+    std::fstream file("resources/pblocksworld_example.sas");
+    std::shared_ptr<ProbabilisticTask> task = tasks::read_sas_task(file);
+    tasks::set_root_task(task);
+
+    const ProbabilisticTaskProxy task_proxy(*task);
+    const State initial_state = task_proxy.get_initial_state();
+
+    ILAOAbstraction incremental(task, true);
+    ILAOAbstraction full(task, false);
+
+    utils::CountdownTimer timer(std::numeric_limits<double>::infinity());
+
+    for (VariableProxy var : task_proxy.get_variables()) {
+        if (var.get_domain_size() == 1) continue;
+
+        const int value = initial_state[var].get_value();
+        incremental.split_initial_state(var.get_id(), value);
+        full.split_initial_state(var.get_id(), value);
+
+        incremental.find_solution(timer);
+        full.find_solution(timer);
+
+        incremental.verify_distances();
+        full.verify_distances();
+
+        const int init_id = full.abstraction.get_initial_state().get_id();
+        ASSERT_NEAR(
+            incremental.heuristic.get_h_value(init_id),
+            full.heuristic.get_h_value(init_id),
+            0.001);
+    }
+}
+
+TEST(CartesianTests, test_ilao_incremental_distances_timeout)
+{
+    std::fstream file("resources/pblocksworld_example.sas");
+    std::shared_ptr<ProbabilisticTask> task = tasks::read_sas_task(file);
+    tasks::set_root_task(task);
+
+    const ProbabilisticTaskProxy task_proxy(*task);
+    const State initial_state = task_proxy.get_initial_state();
+
+    ILAOAbstraction incremental(task, true);
+
+    utils::CountdownTimer timer(std::numeric_limits<double>::infinity());
+    utils::CountdownTimer expired_timer(0.0);
+
+    bool timed_out = false;
+
+    for (VariableProxy var : task_proxy.get_variables()) {
+        if (var.get_domain_size() == 1) continue;
+
+        incremental.split_initial_state(
+            var.get_id(),
+            initial_state[var].get_value());
+
+        // Interrupt the update of the estimates after the first split.
+        if (!timed_out) {
+            timed_out = true;
+            ASSERT_THROW(
+                incremental.find_solution(expired_timer),
+                utils::TimeoutException);
+            continue;
+        }
+
+        incremental.find_solution(timer);
+        incremental.verify_distances();
+    }
+
+    ASSERT_TRUE(timed_out);
+}
@@ -1,15 +1,89 @@
 #include <gtest/gtest.h>
 
+#include "probfd/algorithms/ta_topological_value_iteration.h"
+
+#include "probfd/pdbs/assignment_enumerator.h"
+#include "probfd/pdbs/match_tree.h"
+#include "probfd/pdbs/max_orthogonal_finder.h"
+#include "probfd/pdbs/pattern_collection_generator_hillclimbing.h"
+#include "probfd/pdbs/pattern_collection_generator_systematic.h"
+#include "probfd/pdbs/pattern_collection_information.h"
+#include "probfd/pdbs/pdb_cache.h"
+#include "probfd/pdbs/pdb_collection_evaluator.h"
+#include "probfd/pdbs/probability_aware_pattern_database.h"
+#include "probfd/pdbs/projection_operator.h"
+#include "probfd/pdbs/projection_state_space.h"
 #include "probfd/pdbs/state_ranking_function.h"
+#include "probfd/pdbs/trivial_finder_factory.h"
+#include "probfd/pdbs/utils.h"
+#include "probfd/pdbs/value_table.h"
+
+#include "probfd/heuristics/constant_evaluator.h"
+
+#include "probfd/quotients/quotient_max_heuristic.h"
+#include "probfd/quotients/quotient_system.h"
 
+#include "probfd/tasks/root_task.h"
+
+#include "probfd/cost_function.h"
+#include "probfd/ssp_cost_function.h"
 #include "probfd/task_proxy.h"
+#include "probfd/task_state_space.h"
 #include "tests/tasks/blocksworld.h"
 
+#include "downward/task_utils/task_properties.h"
+
+#include "downward/utils/logging.h"
+#include "downward/utils/system.h"
+
+#include "downward/plugins/options.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 using namespace probfd;
 using namespace probfd::pdbs;
 
 using namespace tests;
 
+namespace {
+class MutableCostFunction : public FDRSimpleCostFunction {
+    ProbabilisticTaskProxy task_proxy_;
+
+public:
+    std::vector<value_t> costs;
+
+    explicit MutableCostFunction(ProbabilisticTaskProxy task_proxy)
+        : task_proxy_(task_proxy)
+        , costs(task_proxy.get_operators().size(), 1_vt)
+    {
+    }
+
+    value_t get_action_cost(OperatorID op_id) override
+    {
+        return costs[op_id.get_index()];
+    }
+
+    bool is_goal(const State& state) const override
+    {
+        return ::task_properties::is_goal_state(task_proxy_, state);
+    }
+
+    value_t get_non_goal_termination_cost() const override
+    {
+        return INFINITE_VALUE;
+    }
+};
+} // namespace
+
 TEST(PDBTests, test_ranking_function_empty_pattern)
 {
     BlocksworldTask task(3, {{1, 0}, {2}}, {{1}, {2, 0}});
@@ -106,4 +180,520 @@ TEST(PDBTests, test_ranking_function_all_variables)
          task.get_fact_block_on_table(2),
          task.get_fact_is_hand_empty(true)});
     ASSERT_EQ(ranking_function.get_abstract_rank(example_state), 1751);
-}
\ No newline at end of file
+}
+TEST(PDBTests, test_pdb_cache_round_trip)
+{
+    const std::filesystem::path directory =
+        std::filesystem::temp_directory_path() /
+        ("probfd_pdb_cache_test_" + std::to_string(utils::get_process_id()));
+
+    PDBCache cache(directory);
+
+    const std::vector<value_t> values = {0_vt, 1.5_vt, INFINITE_VALUE, 3_vt};
+    const PDBCache::Key key{42, 7};
+
+    ASSERT_FALSE(cache.load(key, values.size()).has_value());
+
+    cache.store(key, values);
+
+    std::optional<ValueTable> table = cache.load(key, values.size());
+    ASSERT_TRUE(table.has_value());
+    ASSERT_EQ(table->size(), values.size());
+
+    for (std::size_t i = 0; i != values.size(); ++i) {
+        ASSERT_EQ((*table)[i], values[i]);
+    }
+
+    // A table of different size or with a different key is not found.
+    ASSERT_FALSE(cache.load(key, values.size() + 1).has_value());
+    ASSERT_FALSE(cache.load({42, 8}, values.size()).has_value());
+    ASSERT_FALSE(cache.load({43, 7}, values.size()).has_value());
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(PDBTests, test_pdb_cache_key_shared_between_tasks)
+{
+    // The second task is the first one with blocks 1 and 2 swapped.
+    BlocksworldTask task1(3, {{1, 0}, {2}}, {{1}, {2, 0}});
+    BlocksworldTask task2(3, {{2, 0}, {1}}, {{2}, {1, 0}});
+
+    ProbabilisticTaskProxy task_proxy1(task1);
+    ProbabilisticTaskProxy task_proxy2(task2);
+
+    MutableCostFunction cost_function1(task_proxy1);
+    MutableCostFunction cost_function2(task_proxy2);
+
+    auto get_key = [](ProbabilisticTaskProxy task_proxy,
+                      MutableCostFunction& cost_function,
+                      Pattern pattern) {
+        std::ranges::sort(pattern);
+        StateRankingFunction ranking_function(
+            task_proxy.get_variables(),
+            pattern);
+        return PDBCache::compute_key(
+            task_proxy,
+            cost_function,
+            ranking_function,
+            ranking_function.get_abstract_rank(task_proxy.get_initial_state()));
+    };
+
+    // The projections onto the same block of either task are equal, although
+    // the pattern variables differ.
+    const PDBCache::Key key1 = get_key(
+        task_proxy1,
+        cost_function1,
+        {task1.get_clear_var(1), task1.get_hand_var()});
+    const PDBCache::Key key2 = get_key(
+        task_proxy2,
+        cost_function2,
+        {task2.get_clear_var(2), task2.get_hand_var()});
+
+    ASSERT_EQ(key1, key2);
+
+    // Projections with different action costs are not.
+    std::ranges::fill(cost_function2.costs, 2_vt);
+
+    ASSERT_NE(
+        key1,
+        get_key(
+            task_proxy2,
+            cost_function2,
+            {task2.get_clear_var(2), task2.get_hand_var()}));
+}
+
+TEST(PDBTests, test_value_table_encodings)
+{
+    const std::vector<value_t> values =
+        {0_vt, 0.1_vt, 0.25_vt, 1_vt / 3_vt, 0.1_vt, 7.5_vt, INFINITE_VALUE};
+
+    for (const ValueTableEncoding encoding :
+         {ValueTableEncoding::DOUBLE,
+          ValueTableEncoding::FLOAT,
+          ValueTableEncoding::QUANTIZED16,
+          ValueTableEncoding::DICTIONARY}) {
+        ValueTable table(values);
+        table.encode(encoding);
+
+        ASSERT_EQ(table.size(), values.size());
+        ASSERT_LE(
+            table.get_memory_usage(),
+            values.size() * get_max_bytes_per_value(encoding) +
+                (encoding == ValueTableEncoding::DICTIONARY
+                     ? values.size() * sizeof(value_t)
+                     : 0));
+
+        for (std::size_t i = 0; i != values.size(); ++i) {
+            // Lossy encodings must round down to remain admissible.
+            ASSERT_LE(table[i], values[i]);
+            if (values[i] != INFINITE_VALUE) {
+                ASSERT_NEAR(table[i], values[i], 1e-3);
+            }
+        }
+
+        ASSERT_EQ(table[values.size() - 1], INFINITE_VALUE);
+    }
+
+    // The dictionary encoding is exact.
+    ValueTable table(values);
+    table.encode(ValueTableEncoding::DICTIONARY);
+
+    for (std::size_t i = 0; i != values.size(); ++i) {
+        ASSERT_EQ(table[i], values[i]);
+    }
+}
+
+TEST(PDBTests, test_incremental_value_table_update)
+{
+    using namespace algorithms::ta_topological_vi;
+
+    using TVI =
+        TATopologicalValueIteration<StateRank, const ProjectionOperator*>;
+
+    BlocksworldTask task(3, {{1, 0}, {2}}, {{1}, {2, 0}});
+
+    ProbabilisticTaskProxy task_proxy(task);
+    VariablesProxy variables = task_proxy.get_variables();
+
+    Pattern pattern(variables.size());
+    std::iota(pattern.begin(), pattern.end(), 0);
+
+    StateRankingFunction ranking_function(variables, pattern);
+    const StateRank initial_state =
+        ranking_function.get_abstract_rank(task_proxy.get_initial_state());
+    const std::size_t num_states = ranking_function.num_states();
+
+    heuristics::BlindEvaluator<StateRank> heuristic;
+    MutableCostFunction cost_function(task_proxy);
+
+    TVI tvi;
+    std::vector<value_t> values(num_states, INFINITE_VALUE);
+
+    {
+        ProjectionStateSpace mdp(
+            task_proxy,
+            cost_function,
+            ranking_function,
+            false);
+        tvi.solve(mdp, heuristic, initial_state, values);
+    }
+
+    // Make the first operator more expensive.
+    cost_function.costs[0] = 5_vt;
+
+    ProjectionStateSpace
+        mdp(task_proxy, cost_function, ranking_function, false);
+
+    std::vector<probfd::StateID> changed_states;
+    std::vector<const ProjectionOperator*> aops;
+
+    for (std::size_t s = 0; s != num_states; ++s) {
+        aops.clear();
+        mdp.generate_applicable_actions(StateRank(s), aops);
+        if (std::ranges::any_of(aops, [](const ProjectionOperator* op) {
+                return op->operator_id.get_index() == 0;
+            })) {
+            changed_states.push_back(s);
+        }
+    }
+
+    tvi.resolve(mdp, heuristic, initial_state, values, changed_states);
+
+    std::vector<value_t> expected(num_states, INFINITE_VALUE);
+    TVI().solve(mdp, heuristic, initial_state, expected);
+
+    for (std::size_t s = 0; s != num_states; ++s) {
+        if (expected[s] == INFINITE_VALUE) {
+            ASSERT_EQ(values[s], INFINITE_VALUE);
+        } else {
+            ASSERT_NEAR(values[s], expected[s], 1e-4);
+        }
+    }
+
+    // Without changes, all SCCs are reused and no backup is performed.
+    tvi.resolve(mdp, heuristic, initial_state, values, {});
+
+    const Statistics statistics = tvi.get_statistics();
+    ASSERT_EQ(statistics.reused_sccs, statistics.sccs);
+    ASSERT_EQ(statistics.bellman_backups, 0ULL);
+
+    for (std::size_t s = 0; s != num_states; ++s) {
+        if (expected[s] != INFINITE_VALUE) {
+            ASSERT_NEAR(values[s], expected[s], 1e-4);
+        }
+    }
+}
+
+TEST(PDBTests, test_hillclimbing_threads_do_not_change_collection)
+{
+    std::shared_ptr<ProbabilisticTask> task(new BlocksworldTask(
+        4,
+        {{1, 0}, {3, 2}},
+        {{0, 1}, {2, 3}}));
+
+    tasks::set_root_task(task);
+
+    auto cost_function =
+        std::make_shared<SSPCostFunction>(ProbabilisticTaskProxy(*task));
+
+    auto generate_patterns = [&](int threads) {
+        plugins::Options initial_opts;
+        initial_opts.set<utils::Verbosity>(
+            "verbosity",
+            utils::Verbosity::SILENT);
+        initial_opts.set<int>("pattern_max_size", 1);
+        initial_opts.set<bool>("only_interesting_patterns", true);
+
+        plugins::Options opts;
+        opts.set<utils::Verbosity>("verbosity", utils::Verbosity::SILENT);
+        opts.set<std::shared_ptr<PatternCollectionGenerator>>(
+            "initial_generator",
+            std::make_shared<PatternCollectionGeneratorSystematic>(
+                initial_opts));
+        opts.set<std::shared_ptr<SubCollectionFinderFactory>>(
+            "subcollection_finder_factory",
+            std::make_shared<TrivialFinderFactory>());
+        opts.set<int>("pdb_max_size", 2000000);
+        opts.set<int>("collection_max_size", 10000000);
+        opts.set<int>("search_space_max_size", 30000000);
+        opts.set<int>("num_samples", 100);
+        opts.set<int>("min_improvement", 1);
+        opts.set<double>("max_time", std::numeric_limits<double>::infinity());
+        opts.set<int>("threads", threads);
+        opts.set<ValueTableEncoding>(
+            "value_encoding",
+            ValueTableEncoding::DOUBLE);
+        opts.set<std::string>("cache_dir", "");
+        opts.set<int>("random_seed", 42);
+
+        PatternCollectionGeneratorHillclimbing generator(opts);
+        return *generator.generate(task, cost_function).get_patterns();
+    };
+
+    const PatternCollection sequential = generate_patterns(1);
+
+    ASSERT_FALSE(sequential.empty());
+    ASSERT_EQ(generate_patterns(4), sequential);
+}
+
+TEST(PDBTests, test_compute_pdbs_appends_nothing_on_failure)
+{
+    BlocksworldTask task(3, {{1, 0}, {2}}, {{1}, {2, 0}});
+
+    ProbabilisticTaskProxy task_proxy(task);
+
+    for (const unsigned threads : {1U, 4U}) {
+        PPDBCollection pdbs;
+
+        auto compute_pdb = [&](std::size_t i) {
+            if (i == 2) throw std::runtime_error("failed");
+            StateRankingFunction ranking_function(
+                task_proxy.get_variables(),
+                {static_cast<int>(i)});
+            std::vector<value_t> values(ranking_function.num_states(), 0_vt);
+            return std::make_unique<ProbabilityAwarePatternDatabase>(
+                std::move(ranking_function),
+                std::move(values));
+        };
+
+        ASSERT_THROW(
+            compute_pdbs(pdbs, 4, threads, compute_pdb),
+            std::runtime_error);
+        ASSERT_TRUE(pdbs.empty());
+
+        compute_pdbs(pdbs, 2, threads, compute_pdb);
+        ASSERT_EQ(pdbs.size(), 2);
+        ASSERT_EQ(pdbs[1]->get_pattern(), Pattern{1});
+    }
+}
+
+TEST(PDBTests, test_collection_evaluator_batches)
+{
+    std::shared_ptr<ProbabilisticTask> task(new BlocksworldTask(
+        4,
+        {{1, 0}, {3, 2}},
+        {{0, 1}, {2, 3}}));
+
+    tasks::set_root_task(task);
+
+    ProbabilisticTaskProxy task_proxy(*task);
+    auto cost_function = std::make_shared<SSPCostFunction>(task_proxy);
+    const State initial_state = task_proxy.get_initial_state();
+
+    // Overlapping patterns, so that variables are shared between PDBs.
+    auto patterns = std::make_shared<PatternCollection>();
+    const int num_variables =
+        static_cast<int>(task_proxy.get_variables().size());
+    for (int var = 0; var + 1 < num_variables; ++var) {
+        patterns->push_back({var, var + 1});
+    }
+
+    auto pdbs = std::make_shared<PPDBCollection>();
+    for (const Pattern& pattern : *patterns) {
+        pdbs->push_back(std::make_unique<ProbabilityAwarePatternDatabase>(
+            task_proxy,
+            *cost_function,
+            pattern,
+            initial_state));
+    }
+
+    auto finder = std::make_shared<AdditiveMaxOrthogonalityFinder>(task_proxy);
+    auto subcollections = finder->compute_subcollections(*patterns);
+
+    const value_t termination_cost =
+        cost_function->get_non_goal_termination_cost();
+
+    PDBCollectionEvaluator evaluator(
+        pdbs,
+        subcollections,
+        finder,
+        termination_cost);
+
+    // Counts the batches to check that the quotient heuristic forwards them.
+    class CollectionHeuristic : public FDREvaluator {
+        const PDBCollectionEvaluator& evaluator_;
+
+    public:
+        mutable int num_batches = 0;
+
+        explicit CollectionHeuristic(const PDBCollectionEvaluator& evaluator)
+            : evaluator_(evaluator)
+        {
+        }
+
+        value_t evaluate(const State& state) const override
+        {
+            return evaluator_.evaluate(state);
+        }
+
+        void evaluate_batch(
+            std::span<const State* const> states,
+            std::span<value_t> values) const override
+        {
+            ++num_batches;
+            evaluator_.evaluate(states, values);
+        }
+    } heuristic(evaluator);
+
+    TaskStateSpace mdp(task, utils::get_silent_log(), cost_function);
+
+    std::vector<State> states;
+    std::vector<bool> seen;
+    std::vector<Transition<OperatorID>> transitions;
+
+    auto insert = [&](probfd::StateID id) {
+        if (id >= seen.size()) seen.resize(id + 1, false);
+        if (seen[id]) return;
+        seen[id] = true;
+        states.push_back(mdp.get_state(id));
+    };
+
+    insert(mdp.get_state_id(mdp.get_initial_state()));
+
+    for (std::size_t i = 0; i != states.size(); ++i) {
+        transitions.clear();
+        mdp.generate_all_transitions(states[i], transitions);
+        for (const auto& transition : transitions) {
+            for (const probfd::StateID succ_id :
+                 transition.successor_dist.support()) {
+                insert(succ_id);
+            }
+        }
+    }
+
+    // The unpacked copy of the initial state is read through the other path.
+    State unpacked_initial_state = states.front();
+    unpacked_initial_state.unpack();
+    states.push_back(unpacked_initial_state);
+
+    std::vector<value_t> expected;
+    for (const State& state : states) {
+        expected.push_back(
+            finder->evaluate(*pdbs, *subcollections, state, termination_cost));
+        ASSERT_EQ(evaluator.evaluate(state), expected.back());
+    }
+
+    std::vector<const State*> state_ptrs;
+    for (const State& state : states) state_ptrs.push_back(&state);
+
+    std::vector<value_t> values(states.size());
+    evaluator.evaluate(state_ptrs, values);
+    ASSERT_EQ(values, expected);
+
+    // Evaluating a smaller batch afterwards reuses the larger buffers.
+    evaluator.evaluate(
+        std::span(state_ptrs).subspan(1, 3),
+        std::span(values).first(3));
+    ASSERT_TRUE(std::equal(values.begin(), values.begin() + 3, &expected[1]));
+
+    // Collapse some states and compare the batched maxima over the members.
+    using QState = quotients::QuotientState<State, OperatorID>;
+
+    quotients::QuotientSystem<State, OperatorID> quotient(mdp);
+    std::vector<probfd::StateID> collapsed = {1, 2, 3};
+    quotient.build_quotient(collapsed);
+
+    quotients::QuotientMaxHeuristic<State, OperatorID> qheuristic(heuristic);
+
+    std::vector<QState> qstates;
+    for (std::size_t i = 0; i != seen.size(); ++i) {
+        const probfd::StateID qstate_id =
+            quotient.translate_state_id(probfd::StateID(i));
+        qstates.push_back(quotient.get_state(qstate_id));
+    }
+
+    std::vector<const QState*> qstate_ptrs;
+    for (const QState& qstate : qstates) qstate_ptrs.push_back(&qstate);
+
+    std::vector<value_t> qvalues(qstates.size());
+    qheuristic.evaluate_batch(qstate_ptrs, qvalues);
+
+    ASSERT_EQ(heuristic.num_batches, 1);
+    ASSERT_EQ(qstates[1].num_members(), 3u);
+
+    for (std::size_t i = 0; i != qstates.size(); ++i) {
+        ASSERT_EQ(qvalues[i], qheuristic.evaluate(qstates[i]));
+    }
+}
+
+TEST(PDBTests, test_match_tree_applicable_operators)
+{
+    const std::vector<int> domain_sizes = {3, 2, 4, 2};
+    const AssignmentEnumerator enumerator(domain_sizes);
+
+    /*
+      Insert one operator for every partial assignment, i.e., every
+      combination of preconditions. A precondition value equal to the domain
+      size encodes a variable without precondition.
+    */
+    std::vector<std::vector<FactPair>> preconditions;
+
+    std::vector<int> values(domain_sizes.size(), 0);
+    for (;;) {
+        std::vector<FactPair>& pres = preconditions.emplace_back();
+        for (std::size_t var = 0; var != values.size(); ++var) {
+            if (values[var] != domain_sizes[var]) {
+                pres.emplace_back(static_cast<int>(var), values[var]);
+            }
+        }
+
+        std::size_t var = 0;
+        while (var != values.size() && values[var] == domain_sizes[var]) {
+            values[var++] = 0;
+        }
+        if (var == values.size()) break;
+        ++values[var];
+    }
+
+    ASSERT_EQ(preconditions.size(), 4 * 3 * 5 * 3);
+
+    MatchTree match_tree(preconditions.size());
+
+    for (std::size_t i = 0; i != preconditions.size(); ++i) {
+        match_tree.insert(
+            enumerator,
+            ProjectionOperator(
+                OperatorID(static_cast<int>(i)),
+                1_vt,
+                Distribution<int>()),
+            preconditions[i],
+            false);
+    }
+
+    // With operator pruning, equivalent operators are inserted only once.
+    match_tree.insert(
+        enumerator,
+        ProjectionOperator(OperatorID(-1), 1_vt, Distribution<int>()),
+        preconditions.front(),
+        true);
+
+    match_tree.finalize();
+
+    std::vector<const ProjectionOperator*> operators;
+
+    for (unsigned rank = 0; rank != enumerator.num_assignments(); ++rank) {
+        const std::vector<int> state = enumerator.unrank(rank);
+
+        std::vector<int> expected;
+        for (std::size_t i = 0; i != preconditions.size(); ++i) {
+            if (std::ranges::all_of(preconditions[i], [&](FactPair fact) {
+                    return state[fact.var] == fact.value;
+                })) {
+                expected.push_back(static_cast<int>(i));
+            }
+        }
+
+        operators.clear();
+        match_tree.get_applicable_operators(StateRank(rank), operators);
+
+        std::vector<int> applicable;
+        for (const ProjectionOperator* op : operators) {
+            applicable.push_back(op->operator_id.get_index());
+        }
+        std::ranges::sort(applicable);
+
+        // Each state satisfies 2^4 partial assignments of itself.
+        ASSERT_EQ(expected.size(), 16);
+        ASSERT_EQ(applicable, expected);
+    }
+}
@@ -0,0 +1,265 @@
+#include <gtest/gtest.h>
+
+#include "probfd/utils/small_vector.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace probfd;
+
+namespace {
+// Counts the live instances to detect leaked or doubly destroyed elements.
+struct Tracked {
+    static inline int live = 0;
+
+    int value;
+
+    Tracked(int value)
+        : value(value)
+    {
+        ++live;
+    }
+
+    Tracked(const Tracked& other)
+        : value(other.value)
+    {
+        ++live;
+    }
+
+    Tracked(Tracked&& other) noexcept
+        : value(other.value)
+    {
+        other.value = -1;
+        ++live;
+    }
+
+    Tracked& operator=(const Tracked&) = default;
+    Tracked& operator=(Tracked&&) noexcept = default;
+
+    ~Tracked() { --live; }
+
+    friend bool operator==(const Tracked&, const Tracked&) = default;
+};
+
+template <typename T, std::size_t N>
+std::vector<T> to_vector(const SmallVector<T, N>& vector)
+{
+    return std::vector<T>(vector.begin(), vector.end());
+}
+
+SmallVector<std::string, 2> make_strings(int n)
+{
+    SmallVector<std::string, 2> vector;
+    for (int i = 0; i != n; ++i) {
+        vector.push_back("element " + std::to_string(i));
+    }
+    return vector;
+}
+} // namespace
+
+TEST(SmallVectorTests, test_inline_to_heap_growth)
+{
+    {
+        SmallVector<Tracked, 2> vector;
+        ASSERT_TRUE(vector.empty());
+        ASSERT_TRUE(vector.is_inline());
+        ASSERT_EQ(vector.capacity(), 2u);
+
+        vector.emplace_back(0);
+        vector.emplace_back(1);
+        ASSERT_TRUE(vector.is_inline());
+
+        vector.emplace_back(2);
+        ASSERT_FALSE(vector.is_inline());
+        ASSERT_GE(vector.capacity(), 3u);
+
+        for (int i = 3; i != 10; ++i) vector.emplace_back(i);
+
+        ASSERT_EQ(vector.size(), 10u);
+        for (int i = 0; i != 10; ++i) ASSERT_EQ(vector[i].value, i);
+        ASSERT_EQ(Tracked::live, 10);
+
+        vector.clear();
+        ASSERT_TRUE(vector.empty());
+        ASSERT_FALSE(vector.is_inline());
+        ASSERT_EQ(Tracked::live, 0);
+    }
+
+    ASSERT_EQ(Tracked::live, 0);
+}
+
+TEST(SmallVectorTests, test_grow_with_own_element)
+{
+    SmallVector<std::string, 2> vector = make_strings(2);
+
+    // The argument refers to an element that is moved by the growth.
+    vector.push_back(vector.front());
+    vector.emplace(vector.begin() + 1, vector.back());
+
+    std::vector<std::string> expected = {
+        "element 0",
+        "element 0",
+        "element 1",
+        "element 0"};
+    ASSERT_EQ(to_vector(vector), expected);
+}
+
+TEST(SmallVectorTests, test_copy_between_inline_and_heap)
+{
+    {
+        const SmallVector<Tracked, 2> empty;
+        SmallVector<Tracked, 2> inline_vector;
+        inline_vector.emplace_back(1);
+        SmallVector<Tracked, 2> heap_vector;
+        for (int i = 0; i != 5; ++i) heap_vector.emplace_back(i);
+
+        SmallVector<Tracked, 2> copy_inline(inline_vector);
+        ASSERT_TRUE(copy_inline.is_inline());
+        ASSERT_EQ(copy_inline, inline_vector);
+
+        SmallVector<Tracked, 2> copy_heap(heap_vector);
+        ASSERT_FALSE(copy_heap.is_inline());
+        ASSERT_EQ(copy_heap, heap_vector);
+
+        // Inline target, heap source.
+        copy_inline = heap_vector;
+        ASSERT_EQ(copy_inline, heap_vector);
+
+        // Heap target, inline source. The heap memory is kept.
+        copy_heap = inline_vector;
+        ASSERT_EQ(copy_heap, inline_vector);
+
+        copy_heap = empty;
+        ASSERT_TRUE(copy_heap.empty());
+
+        ASSERT_EQ(Tracked::live, 1 + 5 + 5);
+    }
+
+    ASSERT_EQ(Tracked::live, 0);
+}
+
+TEST(SmallVectorTests, test_move_between_inline_and_heap)
+{
+    {
+        SmallVector<Tracked, 2> inline_vector;
+        inline_vector.emplace_back(1);
+        SmallVector<Tracked, 2> heap_vector;
+        for (int i = 0; i != 5; ++i) heap_vector.emplace_back(i);
+
+        SmallVector<Tracked, 2> moved_inline(std::move(inline_vector));
+        ASSERT_TRUE(moved_inline.is_inline());
+        ASSERT_EQ(moved_inline.size(), 1u);
+        ASSERT_EQ(moved_inline[0].value, 1);
+        ASSERT_TRUE(inline_vector.empty());
+
+        const Tracked* heap_data = heap_vector.data();
+        SmallVector<Tracked, 2> moved_heap(std::move(heap_vector));
+        ASSERT_EQ(moved_heap.data(), heap_data);
+        ASSERT_EQ(moved_heap.size(), 5u);
+        ASSERT_TRUE(heap_vector.empty());
+        ASSERT_TRUE(heap_vector.is_inline());
+
+        // Inline target, heap source.
+        moved_inline = std::move(moved_heap);
+        ASSERT_EQ(moved_inline.data(), heap_data);
+        ASSERT_EQ(moved_inline.size(), 5u);
+        ASSERT_TRUE(moved_heap.empty());
+
+        // Heap target, inline source.
+        SmallVector<Tracked, 2> source;
+        source.emplace_back(7);
+        moved_inline = std::move(source);
+        ASSERT_TRUE(moved_inline.is_inline());
+        ASSERT_EQ(moved_inline.size(), 1u);
+        ASSERT_EQ(moved_inline[0].value, 7);
+        ASSERT_TRUE(source.empty());
+
+        ASSERT_EQ(Tracked::live, 1);
+
+        // The moved-from vectors are usable.
+        heap_vector.emplace_back(3);
+        ASSERT_EQ(heap_vector[0].value, 3);
+    }
+
+    ASSERT_EQ(Tracked::live, 0);
+}
+
+TEST(SmallVectorTests, test_swap)
+{
+    SmallVector<std::string, 2> inline_vector = make_strings(1);
+    SmallVector<std::string, 2> heap_vector = make_strings(4);
+
+    inline_vector.swap(heap_vector);
+
+    ASSERT_EQ(inline_vector, make_strings(4));
+    ASSERT_EQ(heap_vector, make_strings(1));
+    ASSERT_TRUE(heap_vector.is_inline());
+}
+
+TEST(SmallVectorTests, test_insert)
+{
+    SmallVector<std::unique_ptr<int>, 2> vector;
+    vector.emplace(vector.end(), std::make_unique<int>(1));
+    vector.emplace(vector.begin(), std::make_unique<int>(0));
+    ASSERT_TRUE(vector.is_inline());
+
+    // Inserting into a full vector moves it to the heap.
+    vector.emplace(vector.begin() + 1, std::make_unique<int>(5));
+    ASSERT_FALSE(vector.is_inline());
+    vector.emplace(vector.end(), std::make_unique<int>(2));
+    vector.emplace(vector.begin() + 2, std::make_unique<int>(6));
+
+    std::vector<int> values;
+    for (const auto& p : vector) values.push_back(*p);
+    ASSERT_EQ(values, (std::vector<int>{0, 5, 6, 1, 2}));
+}
+
+TEST(SmallVectorTests, test_erase)
+{
+    {
+        SmallVector<Tracked, 2> vector;
+        for (int i = 0; i != 6; ++i) vector.emplace_back(i);
+
+        auto it = vector.erase(vector.begin() + 1);
+        ASSERT_EQ(it->value, 2);
+        ASSERT_EQ(Tracked::live, 5);
+
+        it = vector.erase(vector.begin() + 1, vector.begin() + 3);
+        ASSERT_EQ(it->value, 4);
+        ASSERT_EQ(Tracked::live, 3);
+
+        it = vector.erase(vector.begin(), vector.begin());
+        ASSERT_EQ(it, vector.begin());
+
+        it = vector.erase(vector.end() - 1);
+        ASSERT_EQ(it, vector.end());
+
+        ASSERT_EQ(to_vector(vector), (std::vector<Tracked>{0, 4}));
+
+        const std::size_t removed =
+            erase_if(vector, [](const Tracked& t) { return t.value == 0; });
+        ASSERT_EQ(removed, 1u);
+        ASSERT_EQ(to_vector(vector), (std::vector<Tracked>{4}));
+        ASSERT_EQ(Tracked::live, 1);
+    }
+
+    ASSERT_EQ(Tracked::live, 0);
+}
+
+TEST(SmallVectorTests, test_self_assignment)
+{
+    for (int n : {1, 4}) {
+        SmallVector<std::string, 2> vector = make_strings(n);
+        auto& alias = vector;
+
+        vector = alias;
+        ASSERT_EQ(vector, make_strings(n));
+
+        vector = std::move(alias);
+        ASSERT_EQ(vector, make_strings(n));
+
+        vector.swap(alias);
+        ASSERT_EQ(vector, make_strings(n));
+    }
+}
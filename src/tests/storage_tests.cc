@@ -0,0 +1,555 @@
+#include <gtest/gtest.h>
+
+#include "probfd/tasks/root_task.h"
+
+#include "probfd/algorithms/topological_value_iteration.h"
+
+#include "probfd/heuristics/constant_evaluator.h"
+#include "probfd/heuristics/stored_value_heuristic.h"
+
+#include "probfd/storage/chunked_list_pool.h"
+#include "probfd/storage/spill_file_resource.h"
+#include "probfd/storage/value_file.h"
+
+#include "probfd/cost_function.h"
+#include "probfd/maxprob_cost_function.h"
+#include "probfd/policy.h"
+#include "probfd/progress_report.h"
+#include "probfd/ssp_cost_function.h"
+#include "probfd/task_proxy.h"
+#include "probfd/task_state_space.h"
+
+#include "tests/tasks/blocksworld.h"
+
+#include "downward/task_utils/task_properties.h"
+
+#include "downward/utils/logging.h"
+#include "downward/utils/system.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace probfd;
+using namespace probfd::storage;
+
+using namespace tests;
+
+namespace {
+/// The SSP cost function of a task with a finite cost for terminating in a
+/// non-goal state.
+class FiniteTerminationCostFunction : public FDRSimpleCostFunction {
+    ProbabilisticTaskProxy task_proxy_;
+    const value_t termination_cost_;
+
+public:
+    FiniteTerminationCostFunction(
+        ProbabilisticTaskProxy task_proxy,
+        value_t termination_cost)
+        : task_proxy_(task_proxy)
+        , termination_cost_(termination_cost)
+    {
+    }
+
+    value_t get_action_cost(OperatorID op_id) override
+    {
+        return task_proxy_.get_operators()[op_id].get_cost();
+    }
+
+    bool is_goal(const State& state) const override
+    {
+        return ::task_properties::is_goal_state(task_proxy_, state);
+    }
+
+    value_t get_non_goal_termination_cost() const override
+    {
+        return termination_cost_;
+    }
+};
+
+std::filesystem::path get_temporary_path(const std::string& name)
+{
+    return std::filesystem::temp_directory_path() /
+           (name + "_" + std::to_string(utils::get_process_id()));
+}
+
+constexpr std::size_t MiB = std::size_t(1) << 20;
+
+void create_spill_file(const std::filesystem::path& directory)
+{
+    SpillFileResource resource(directory, MiB);
+}
+} // namespace
+
+TEST(StorageTests, test_value_file_round_trip)
+{
+    using namespace algorithms::topological_vi;
+
+    std::shared_ptr<ProbabilisticTask> task(new BlocksworldTask(
+        6,
+        {{1, 0}, {2}, {5, 4, 3}},
+        {{1, 4}, {5, 3, 2, 0}}));
+
+    tasks::set_root_task(task);
+
+    ProbabilisticTaskProxy task_proxy(*task);
+
+    ProgressReport report(0.0_vt, std::cout, false);
+    heuristics::BlindEvaluator<State> heuristic;
+    auto cost_function = std::make_shared<SSPCostFunction>(task_proxy);
+
+    TaskStateSpace mdp(task, utils::get_silent_log(), cost_function);
+
+    TopologicalValueIteration<State, OperatorID> tvi(false);
+
+    auto policy = tvi.compute_policy(
+        mdp,
+        heuristic,
+        mdp.get_initial_state(),
+        report,
+        std::numeric_limits<double>::infinity());
+
+    const std::filesystem::path path = get_temporary_path("probfd_values");
+    write_value_file(path, *task, *cost_function, *policy);
+
+    ValueFile value_file(path);
+    std::filesystem::remove(path);
+
+    ASSERT_TRUE(value_file.has_same_variables(*task));
+    ASSERT_EQ(
+        value_file.get_task_fingerprint(),
+        compute_task_fingerprint(*task, *cost_function));
+
+    std::size_t num_decisions = 0;
+    policy->for_each_decision(
+        [&](const State& state, const PolicyDecision<OperatorID>& decision) {
+            ++num_decisions;
+            const Interval* stored = value_file.lookup(state.get_buffer());
+            ASSERT_NE(stored, nullptr);
+            ASSERT_EQ(stored->lower, decision.q_value_interval.lower);
+            ASSERT_EQ(stored->upper, decision.q_value_interval.upper);
+        });
+
+    ASSERT_GT(num_decisions, 0);
+    ASSERT_EQ(value_file.size(), num_decisions);
+}
+
+TEST(StorageTests, test_value_file_fingerprint_mismatch)
+{
+    BlocksworldTask task(6, {{1, 0}, {2}, {5, 4, 3}}, {{1, 4}, {5, 3, 2, 0}});
+    ProbabilisticTaskProxy task_proxy(task);
+
+    SSPCostFunction ssp_cost_function(task_proxy);
+    const std::uint64_t fingerprint =
+        compute_task_fingerprint(task, ssp_cost_function);
+
+    // The initial state does not influence the fingerprint.
+    BlocksworldTask other_initial_state(
+        6,
+        {{0, 1, 2, 3, 4, 5}},
+        {{1, 4}, {5, 3, 2, 0}});
+    SSPCostFunction other_ssp_cost_function{
+        ProbabilisticTaskProxy(other_initial_state)};
+    ASSERT_EQ(
+        compute_task_fingerprint(other_initial_state, other_ssp_cost_function),
+        fingerprint);
+
+    // Neither do repeated evaluations.
+    ASSERT_EQ(compute_task_fingerprint(task, ssp_cost_function), fingerprint);
+
+    // The goal does.
+    BlocksworldTask other_goal(
+        6,
+        {{1, 0}, {2}, {5, 4, 3}},
+        {{4, 1}, {5, 3, 2, 0}});
+    SSPCostFunction other_goal_cost_function{
+        ProbabilisticTaskProxy(other_goal)};
+    ASSERT_NE(
+        compute_task_fingerprint(other_goal, other_goal_cost_function),
+        fingerprint);
+
+    // So do the action costs...
+    MaxProbCostFunction maxprob_cost_function(task_proxy);
+    ASSERT_NE(
+        compute_task_fingerprint(task, maxprob_cost_function),
+        fingerprint);
+
+    // ...and the termination cost of non-goal states.
+    FiniteTerminationCostFunction finite_cost_function(task_proxy, 100_vt);
+    ASSERT_NE(
+        compute_task_fingerprint(task, finite_cost_function),
+        fingerprint);
+
+    FiniteTerminationCostFunction other_finite_cost_function(
+        task_proxy,
+        200_vt);
+    ASSERT_NE(
+        compute_task_fingerprint(task, other_finite_cost_function),
+        compute_task_fingerprint(task, finite_cost_function));
+}
+
+TEST(StorageTests, test_value_file_require_same_task)
+{
+    using namespace algorithms::topological_vi;
+
+    std::shared_ptr<ProbabilisticTask> task(new BlocksworldTask(
+        4,
+        {{1, 0}, {2, 3}},
+        {{1, 2}, {3, 0}}));
+
+    tasks::set_root_task(task);
+
+    ProbabilisticTaskProxy task_proxy(*task);
+
+    ProgressReport report(0.0_vt, std::cout, false);
+    heuristics::BlindEvaluator<State> heuristic;
+    auto cost_function = std::make_shared<SSPCostFunction>(task_proxy);
+
+    TaskStateSpace mdp(task, utils::get_silent_log(), cost_function);
+
+    TopologicalValueIteration<State, OperatorID> tvi(false);
+
+    auto policy = tvi.compute_policy(
+        mdp,
+        heuristic,
+        mdp.get_initial_state(),
+        report,
+        std::numeric_limits<double>::infinity());
+
+    const std::filesystem::path path = get_temporary_path("probfd_values");
+    write_value_file(path, *task, *cost_function, *policy);
+
+    ValueFile value_file(path);
+    std::filesystem::remove(path);
+
+    utils::LogProxy log = utils::get_silent_log();
+
+    // The same task.
+    ASSERT_TRUE(heuristics::can_use_stored_values(
+        value_file,
+        *task,
+        *cost_function,
+        true,
+        log));
+
+    // A task with a different initial state.
+    BlocksworldTask other_initial_state(4, {{0, 1, 2, 3}}, {{1, 2}, {3, 0}});
+    SSPCostFunction other_initial_state_cost_function{
+        ProbabilisticTaskProxy(other_initial_state)};
+    ASSERT_TRUE(heuristics::can_use_stored_values(
+        value_file,
+        other_initial_state,
+        other_initial_state_cost_function,
+        true,
+        log));
+
+    // A task with a different goal is only accepted on request.
+    BlocksworldTask other_goal(4, {{1, 0}, {2, 3}}, {{2, 1}, {3, 0}});
+    SSPCostFunction other_goal_cost_function{
+        ProbabilisticTaskProxy(other_goal)};
+    ASSERT_FALSE(heuristics::can_use_stored_values(
+        value_file,
+        other_goal,
+        other_goal_cost_function,
+        true,
+        log));
+    ASSERT_TRUE(heuristics::can_use_stored_values(
+        value_file,
+        other_goal,
+        other_goal_cost_function,
+        false,
+        log));
+
+    // So is a different cost function for the same task.
+    FiniteTerminationCostFunction finite_cost_function(task_proxy, 100_vt);
+    ASSERT_FALSE(heuristics::can_use_stored_values(
+        value_file,
+        *task,
+        finite_cost_function,
+        true,
+        log));
+    ASSERT_TRUE(heuristics::can_use_stored_values(
+        value_file,
+        *task,
+        finite_cost_function,
+        false,
+        log));
+
+    // A task with different variables is never accepted.
+    BlocksworldTask other_variables(5, {{1, 0}, {2, 3, 4}}, {{1, 2}, {3, 0}});
+    SSPCostFunction other_variables_cost_function{
+        ProbabilisticTaskProxy(other_variables)};
+    ASSERT_FALSE(heuristics::can_use_stored_values(
+        value_file,
+        other_variables,
+        other_variables_cost_function,
+        false,
+        log));
+}
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+TEST(StorageTests, test_spill_file_memory_limit)
+{
+    // With this limit, the spill file is divided into regions of 1 MiB.
+    constexpr std::size_t memory_limit = 4 * MiB;
+    constexpr std::size_t chunk_size = 64 * 1024;
+    constexpr std::size_t chunk_length = chunk_size / sizeof(std::uint32_t);
+
+    SpillFileResource resource(
+        std::filesystem::temp_directory_path(),
+        memory_limit);
+
+    std::vector<std::uint32_t*> chunks;
+
+    auto allocate_chunk = [&]() {
+        auto* chunk = static_cast<std::uint32_t*>(
+            resource.allocate(chunk_size, alignof(std::uint32_t)));
+        std::fill_n(chunk, chunk_length, chunks.size());
+        chunks.push_back(chunk);
+    };
+
+    // A region is spilled as soon as memory_limit bytes were allocated after
+    // it, but not earlier.
+    while (resource.get_allocated_bytes() + chunk_size < memory_limit + MiB) {
+        allocate_chunk();
+        ASSERT_EQ(resource.get_spilled_bytes(), 0);
+    }
+
+    allocate_chunk();
+    ASSERT_EQ(resource.get_allocated_bytes(), memory_limit + MiB);
+    ASSERT_EQ(resource.get_spilled_bytes(), MiB);
+
+    // From now on, between memory_limit and memory_limit plus one region of
+    // the most recently allocated bytes stay in memory.
+    while (resource.get_allocated_bytes() < 4 * memory_limit) {
+        allocate_chunk();
+        const std::size_t resident =
+            resource.get_allocated_bytes() - resource.get_spilled_bytes();
+        ASSERT_GE(resident, memory_limit);
+        ASSERT_LT(resident, memory_limit + MiB);
+    }
+
+    // Spilled chunks are faulted back in at their addresses.
+    for (std::size_t i = 0; i != chunks.size(); ++i) {
+        ASSERT_EQ(chunks[i][0], i);
+        ASSERT_EQ(chunks[i][chunk_length - 1], i);
+    }
+}
+#endif
+
+TEST(StorageTests, test_spill_file_alignment)
+{
+    SpillFileResource resource(std::filesystem::temp_directory_path(), MiB);
+
+    std::vector<std::pair<std::byte*, std::size_t>> blocks;
+    std::size_t total_bytes = 0;
+
+    auto allocate = [&](std::size_t bytes, std::size_t alignment) {
+        auto* block = static_cast<std::byte*>(
+            resource.allocate(bytes, alignment));
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(block) % alignment, 0);
+        std::memset(block, static_cast<int>(blocks.size() % 256), bytes);
+        blocks.emplace_back(block, bytes);
+        total_bytes += bytes;
+    };
+
+    for (std::size_t round = 0; round != 50; ++round) {
+        for (std::size_t alignment = 1; alignment <= 4096; alignment *= 2) {
+            allocate(2 * round + 1, alignment);
+        }
+    }
+
+    // Allocations larger than a region get a region of their own.
+    allocate(3 * MiB + 1, 4096);
+    allocate(7, 8);
+
+    ASSERT_EQ(resource.get_allocated_bytes(), total_bytes);
+
+    for (std::size_t i = 0; i != blocks.size(); ++i) {
+        const auto [block, bytes] = blocks[i];
+        ASSERT_EQ(block[0], static_cast<std::byte>(i % 256));
+        ASSERT_EQ(block[bytes - 1], static_cast<std::byte>(i % 256));
+    }
+
+    // No two blocks overlap.
+    std::ranges::sort(blocks);
+    for (std::size_t i = 1; i != blocks.size(); ++i) {
+        ASSERT_LE(blocks[i - 1].first + blocks[i - 1].second, blocks[i].first);
+    }
+}
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+TEST(StorageTests, test_spill_file_unwritable_directory)
+{
+    const auto critical_error = testing::ExitedWithCode(
+        static_cast<int>(utils::ExitCode::SEARCH_CRITICAL_ERROR));
+
+    // A directory that does not exist.
+    EXPECT_EXIT(
+        create_spill_file(get_temporary_path("probfd_missing") / "spill"),
+        critical_error,
+        "Could not create a spill file");
+
+    // A regular file instead of a directory.
+    const std::filesystem::path file_path =
+        get_temporary_path("probfd_no_directory");
+    std::ofstream(file_path).close();
+    EXPECT_EXIT(
+        create_spill_file(file_path),
+        critical_error,
+        "Could not create a spill file");
+    std::filesystem::remove(file_path);
+
+    // A directory without write permission. Skipped if the permissions are
+    // not enforced, e.g. when running as root.
+    const std::filesystem::path directory_path =
+        get_temporary_path("probfd_read_only");
+    std::filesystem::create_directory(directory_path);
+    std::filesystem::permissions(
+        directory_path,
+        std::filesystem::perms::owner_read | std::filesystem::perms::owner_exec);
+
+    if (!std::ofstream(directory_path / "probe")) {
+        EXPECT_EXIT(
+            create_spill_file(directory_path),
+            critical_error,
+            "Could not create a spill file");
+    }
+
+    std::filesystem::permissions(
+        directory_path,
+        std::filesystem::perms::owner_all);
+    std::filesystem::remove_all(directory_path);
+}
+#endif
+
+TEST(StorageTests, test_chunked_list_pool_growth)
+{
+    using Pool = ChunkedListPool<std::uint64_t>;
+
+    // Two elements are stored inline, seven per chunk of 64 bytes.
+    static_assert(sizeof(Pool::List) == 24);
+    constexpr std::size_t chunk_bytes = 64;
+
+    Pool pool;
+    Pool::List list;
+    Pool::List other_list;
+
+    ASSERT_TRUE(list.empty());
+
+    std::vector<std::uint64_t> expected;
+
+    for (std::uint64_t i = 0; i != 100; ++i) {
+        pool.add(list, i);
+        expected.push_back(i);
+        ASSERT_FALSE(list.empty());
+
+        // The chunks of both lists are interleaved.
+        if (i % 10 == 0) pool.add(other_list, i);
+
+        const std::size_t num_chunks = i < 2 ? 0 : (i - 2) / 7 + 1;
+        const std::size_t num_other_chunks = i < 20 ? 0 : (i / 10 - 2) / 7 + 1;
+        ASSERT_EQ(
+            pool.size_in_bytes(),
+            (num_chunks + num_other_chunks) * chunk_bytes);
+    }
+
+    std::vector<std::uint64_t> elements;
+    std::vector<std::size_t> chunk_sizes;
+    pool.for_each_chunk(list, [&](std::span<const std::uint64_t> chunk) {
+        chunk_sizes.push_back(chunk.size());
+        elements.insert(elements.end(), chunk.begin(), chunk.end());
+    });
+
+    // The inline elements, followed by 14 chunks.
+    ASSERT_EQ(chunk_sizes.size(), 15);
+    ASSERT_EQ(chunk_sizes.front(), 2);
+    ASSERT_TRUE(std::ranges::all_of(chunk_sizes, [](std::size_t size) {
+        return size != 0 && size <= 7;
+    }));
+
+    std::ranges::sort(elements);
+    ASSERT_EQ(elements, expected);
+
+    std::vector<std::uint64_t> other_elements;
+    pool.for_each(other_list, [&](std::uint64_t element) {
+        other_elements.push_back(element);
+    });
+    std::ranges::sort(other_elements);
+    ASSERT_EQ(
+        other_elements,
+        (std::vector<std::uint64_t>{0, 10, 20, 30, 40, 50, 60, 70, 80, 90}));
+}
+
+TEST(StorageTests, test_chunked_list_pool_erase_and_clear)
+{
+    using Pool = ChunkedListPool<std::uint64_t>;
+
+    Pool pool;
+    Pool::List list;
+    Pool::List other_list;
+
+    for (std::uint64_t i = 0; i != 100; ++i) {
+        pool.add(list, i);
+    }
+
+    // Lists may be extended while another list is traversed.
+    pool.for_each(list, [&](std::uint64_t element) {
+        if (element % 2 == 0) pool.add(other_list, element);
+    });
+
+    std::vector<std::uint64_t> evens;
+    pool.for_each(other_list, [&](std::uint64_t element) {
+        evens.push_back(element);
+    });
+    ASSERT_EQ(evens.size(), 50);
+
+    pool.erase_if(list, [](std::uint64_t element) {
+        return element % 2 == 0;
+    });
+
+    std::vector<std::uint64_t> odds;
+    pool.for_each(list, [&](std::uint64_t element) {
+        odds.push_back(element);
+    });
+    std::ranges::sort(odds);
+    ASSERT_EQ(odds.size(), 50);
+    for (std::size_t i = 0; i != odds.size(); ++i) {
+        ASSERT_EQ(odds[i], 2 * i + 1);
+    }
+
+    // Chunks that become empty are recycled.
+    const std::size_t size_after_erase = pool.size_in_bytes();
+    pool.erase_if(list, [](std::uint64_t) { return true; });
+    ASSERT_TRUE(list.empty());
+    ASSERT_EQ(pool.size_in_bytes(), size_after_erase);
+
+    for (std::uint64_t i = 0; i != 100; ++i) {
+        pool.add(list, i);
+    }
+    ASSERT_EQ(pool.size_in_bytes(), size_after_erase);
+
+    // So are the chunks of cleared lists.
+    pool.clear(list);
+    pool.clear(other_list);
+    ASSERT_TRUE(list.empty());
+    ASSERT_TRUE(other_list.empty());
+
+    std::size_t num_elements = 0;
+    pool.for_each(list, [&](std::uint64_t) { ++num_elements; });
+    ASSERT_EQ(num_elements, 0);
+
+    for (std::uint64_t i = 0; i != 100; ++i) {
+        pool.add(other_list, i);
+    }
+    ASSERT_EQ(pool.size_in_bytes(), size_after_erase);
+}
@@ -1,12 +1,418 @@
 #include <gtest/gtest.h>
 
+#include "probfd/tasks/binary_task.h"
+#include "probfd/tasks/delegating_task.h"
 #include "probfd/tasks/root_task.h"
 
+#include "probfd/task_utils/probabilistic_successor_generator.h"
+#include "probfd/task_utils/task_properties.h"
+
+#include "probfd/operator_table.h"
 #include "probfd/probabilistic_task.h"
+#include "probfd/task_proxy.h"
+
+#include "downward/utils/system.h"
 
+#include "downward/state_registry.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <span>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace probfd;
+
+namespace {
+
+std::string read_binary_test_task()
+{
+    std::fstream file("resources/test1.sas");
+    std::ostringstream out;
+    tasks::convert_sas_task_to_binary(file, out);
+    return out.str();
+}
+
+void expect_same_operators(
+    const ProbabilisticTask& expected,
+    const ProbabilisticTask& actual)
+{
+    ASSERT_EQ(expected.get_num_operators(), actual.get_num_operators());
+
+    for (int op = 0; op != expected.get_num_operators(); ++op) {
+        ASSERT_EQ(
+            expected.get_operator_name(op),
+            actual.get_operator_name(op));
+        ASSERT_EQ(
+            expected.get_operator_cost(op),
+            actual.get_operator_cost(op));
+
+        const int num_pres = expected.get_num_operator_preconditions(op);
+        ASSERT_EQ(num_pres, actual.get_num_operator_preconditions(op));
+        for (int i = 0; i != num_pres; ++i) {
+            ASSERT_EQ(
+                expected.get_operator_precondition(op, i),
+                actual.get_operator_precondition(op, i));
+        }
+
+        const int num_outcomes = expected.get_num_operator_outcomes(op);
+        ASSERT_EQ(num_outcomes, actual.get_num_operator_outcomes(op));
+        for (int o = 0; o != num_outcomes; ++o) {
+            ASSERT_EQ(
+                expected.get_operator_outcome_probability(op, o),
+                actual.get_operator_outcome_probability(op, o));
+            ASSERT_EQ(
+                expected.get_operator_outcome_id(op, o),
+                actual.get_operator_outcome_id(op, o));
+
+            const int num_effs =
+                expected.get_num_operator_outcome_effects(op, o);
+            ASSERT_EQ(
+                num_effs,
+                actual.get_num_operator_outcome_effects(op, o));
+            for (int e = 0; e != num_effs; ++e) {
+                ASSERT_EQ(
+                    expected.get_operator_outcome_effect(op, o, e),
+                    actual.get_operator_outcome_effect(op, o, e));
+
+                const int num_conds =
+                    expected.get_num_operator_outcome_effect_conditions(
+                        op,
+                        o,
+                        e);
+                ASSERT_EQ(
+                    num_conds,
+                    actual.get_num_operator_outcome_effect_conditions(
+                        op,
+                        o,
+                        e));
+                for (int c = 0; c != num_conds; ++c) {
+                    ASSERT_EQ(
+                        expected.get_operator_outcome_effect_condition(
+                            op,
+                            o,
+                            e,
+                            c),
+                        actual.get_operator_outcome_effect_condition(
+                            op,
+                            o,
+                            e,
+                            c));
+                }
+            }
+        }
+    }
+}
+
+void expect_same_task(
+    const ProbabilisticTask& expected,
+    const ProbabilisticTask& actual)
+{
+    const int num_variables = expected.get_num_variables();
+    ASSERT_EQ(num_variables, actual.get_num_variables());
+
+    for (int var = 0; var != num_variables; ++var) {
+        ASSERT_EQ(
+            expected.get_variable_name(var),
+            actual.get_variable_name(var));
+        ASSERT_EQ(
+            expected.get_variable_domain_size(var),
+            actual.get_variable_domain_size(var));
+        ASSERT_EQ(
+            expected.get_variable_axiom_layer(var),
+            actual.get_variable_axiom_layer(var));
+        ASSERT_EQ(
+            expected.get_variable_default_axiom_value(var),
+            actual.get_variable_default_axiom_value(var));
+
+        for (int val = 0; val != expected.get_variable_domain_size(var);
+             ++val) {
+            const FactPair fact(var, val);
+            ASSERT_EQ(
+                expected.get_fact_name(fact),
+                actual.get_fact_name(fact));
+
+            for (int var2 = 0; var2 != num_variables; ++var2) {
+                for (int val2 = 0;
+                     val2 != expected.get_variable_domain_size(var2);
+                     ++val2) {
+                    const FactPair fact2(var2, val2);
+                    ASSERT_EQ(
+                        expected.are_facts_mutex(fact, fact2),
+                        actual.are_facts_mutex(fact, fact2));
+                }
+            }
+        }
+    }
+
+    ASSERT_EQ(expected.get_num_axioms(), actual.get_num_axioms());
+
+    ASSERT_EQ(expected.get_num_goals(), actual.get_num_goals());
+    for (int i = 0; i != expected.get_num_goals(); ++i) {
+        ASSERT_EQ(expected.get_goal_fact(i), actual.get_goal_fact(i));
+    }
+
+    ASSERT_EQ(
+        expected.get_initial_state_values(),
+        actual.get_initial_state_values());
+
+    expect_same_operators(expected, actual);
+}
+
+void read_from_string(const std::string& contents)
+{
+    std::istringstream in(contents);
+    tasks::read_binary_task(in);
+}
+
+/*
+  Redirects the standard input to a file with the binary test task behind the
+  given prefix and reads the task from std::cin after skipping the prefix.
+  Exits with code 0 if the task matches the text task.
+*/
+[[noreturn]] void read_from_standard_input(const std::string& prefix)
+{
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() /
+        ("probfd_stdin_" + std::to_string(utils::get_process_id()));
+
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << prefix << read_binary_test_task();
+    }
+
+    if (!std::freopen(path.c_str(), "rb", stdin)) std::exit(2);
+    std::filesystem::remove(path);
+
+    std::cin.ignore(static_cast<std::streamsize>(prefix.size()));
+    if (!tasks::is_binary_task(std::cin)) std::exit(3);
+    auto binary_task = tasks::read_binary_task(std::cin);
+
+    std::fstream file("resources/test1.sas");
+    auto text_task = tasks::read_sas_task(file);
+    expect_same_task(*text_task, *binary_task);
+
+    std::exit(testing::Test::HasFailure() ? 1 : 0);
+}
+
+void expect_csr(
+    std::span<const std::int32_t> offsets,
+    std::size_t num_lists,
+    std::size_t num_elements)
+{
+    ASSERT_EQ(offsets.size(), num_lists + 1);
+    ASSERT_EQ(offsets.front(), 0);
+    ASSERT_EQ(offsets.back(), static_cast<std::int32_t>(num_elements));
+    ASSERT_TRUE(std::ranges::is_sorted(offsets));
+}
+
+/*
+  Checks that the operator table of a task is well-formed and that the task
+  proxies read the same operators from it as through the virtual interface of
+  a delegating task, which has no operator table.
+*/
+void expect_consistent_operator_table(
+    const std::shared_ptr<ProbabilisticTask>& task)
+{
+    const OperatorTable* table = task->get_operator_table();
+    ASSERT_NE(table, nullptr);
+
+    const int num_operators = task->get_num_operators();
+    ASSERT_EQ(table->get_num_operators(), num_operators);
+    expect_csr(
+        table->precondition_offsets,
+        num_operators,
+        table->preconditions.size());
+    expect_csr(
+        table->outcome_offsets,
+        num_operators,
+        table->outcome_probabilities.size());
+    expect_csr(
+        table->effect_offsets,
+        table->outcome_probabilities.size(),
+        table->effects.size());
+    expect_csr(
+        table->condition_offsets,
+        table->effects.size(),
+        table->conditions.size());
+
+    // The classical proxies read the preconditions from the same arrays.
+    ASSERT_EQ(
+        task->get_precondition_offsets(),
+        table->precondition_offsets.data());
+    ASSERT_EQ(
+        task->get_contiguous_preconditions(),
+        table->preconditions.data());
+
+    tasks::DelegatingTask delegating_task(task);
+    ASSERT_EQ(delegating_task.get_operator_table(), nullptr);
+    ASSERT_EQ(delegating_task.get_precondition_offsets(), nullptr);
+
+    const ProbabilisticTaskProxy table_proxy(*task);
+    const ProbabilisticTaskProxy virtual_proxy(delegating_task);
+
+    int next_outcome_id = 0;
+
+    for (int op = 0; op != num_operators; ++op) {
+        const ProbabilisticOperatorProxy table_op =
+            table_proxy.get_operators()[op];
+        const ProbabilisticOperatorProxy virtual_op =
+            virtual_proxy.get_operators()[op];
+
+        ASSERT_EQ(table_op.get_cost(), virtual_op.get_cost());
+
+        const auto table_pres = table_op.get_preconditions();
+        const auto virtual_pres = virtual_op.get_preconditions();
+        ASSERT_EQ(table_pres.size(), virtual_pres.size());
+        for (std::size_t i = 0; i != table_pres.size(); ++i) {
+            ASSERT_EQ(table_pres[i].get_pair(), virtual_pres[i].get_pair());
+        }
+
+        const auto table_outcomes = table_op.get_outcomes();
+        const auto virtual_outcomes = virtual_op.get_outcomes();
+        ASSERT_EQ(table_outcomes.size(), virtual_outcomes.size());
+
+        for (std::size_t o = 0; o != table_outcomes.size(); ++o) {
+            const auto table_outcome = table_outcomes[o];
+            const auto virtual_outcome = virtual_outcomes[o];
+
+            // The outcomes of all operators are numbered consecutively.
+            ASSERT_EQ(table_outcome.get_determinization_id(), next_outcome_id);
+            ASSERT_EQ(
+                virtual_outcome.get_determinization_id(),
+                next_outcome_id);
+            ++next_outcome_id;
+
+            ASSERT_EQ(
+                table_outcome.get_probability(),
+                virtual_outcome.get_probability());
+
+            const auto table_effects = table_outcome.get_effects();
+            const auto virtual_effects = virtual_outcome.get_effects();
+            ASSERT_EQ(table_effects.size(), virtual_effects.size());
+
+            for (std::size_t e = 0; e != table_effects.size(); ++e) {
+                ASSERT_EQ(
+                    table_effects[e].get_fact().get_pair(),
+                    virtual_effects[e].get_fact().get_pair());
+
+                const auto table_conds = table_effects[e].get_conditions();
+                const auto virtual_conds =
+                    virtual_effects[e].get_conditions();
+                ASSERT_EQ(table_conds.size(), virtual_conds.size());
+                for (std::size_t c = 0; c != table_conds.size(); ++c) {
+                    ASSERT_EQ(
+                        table_conds[c].get_pair(),
+                        virtual_conds[c].get_pair());
+                }
+            }
+        }
+    }
+
+    ASSERT_EQ(
+        next_outcome_id,
+        static_cast<int>(table->outcome_probabilities.size()));
+}
+
+/*
+  Writes a task in the text format whose successor generator uses every node
+  type. The variables have the given domain sizes. For every fact, there is an
+  operator without preconditions that achieves it, so that every state is
+  reachable. The other operators have the given preconditions and no effect
+  besides resetting the last variable.
+*/
+std::string write_successor_generator_test_task(
+    const std::vector<int>& domain_sizes,
+    const std::vector<std::vector<std::pair<int, int>>>& preconditions)
+{
+    const int num_variables = static_cast<int>(domain_sizes.size());
+
+    std::ostringstream out;
+    out << "begin_version\n3P\nend_version\n"
+        << "begin_metric\n0\nend_metric\n"
+        << num_variables << "\n";
+
+    for (int var = 0; var != num_variables; ++var) {
+        out << "begin_variable\nvar" << var << "\n-1\n"
+            << domain_sizes[var] << "\n";
+        for (int val = 0; val != domain_sizes[var]; ++val) {
+            out << "Atom fact" << var << "-" << val << "()\n";
+        }
+        out << "end_variable\n";
+    }
+
+    out << "0\nbegin_state\n";
+    for (int var = 0; var != num_variables; ++var) out << "0\n";
+    out << "end_state\nbegin_goal\n1\n0 1\nend_goal\n";
+
+    std::vector<std::string> names;
+    std::ostringstream operators;
+
+    for (int var = 0; var != num_variables; ++var) {
+        for (int val = 0; val != domain_sizes[var]; ++val) {
+            names.push_back("set " + std::to_string(var) + " " +
+                            std::to_string(val));
+            operators << "begin_operator\n" << names.back() << "\n0\n1\n"
+                      << "0 " << var << " -1 " << val << "\n1\n"
+                      << "end_operator\n";
+        }
+    }
+
+    for (const auto& pres : preconditions) {
+        names.push_back("test " + std::to_string(names.size()));
+        operators << "begin_operator\n" << names.back() << "\n"
+                  << pres.size() << "\n";
+        for (const auto& [var, val] : pres) {
+            operators << var << " " << val << "\n";
+        }
+        operators << "1\n0 " << num_variables - 1 << " -1 0\n1\n"
+                  << "end_operator\n";
+    }
+
+    out << names.size() << "\n" << operators.str() << "0\n" << names.size()
+        << "\n";
+
+    for (std::size_t i = 0; i != names.size(); ++i) {
+        out << "begin_probabilistic_operator\n" << names[i] << "\n1\n"
+            << i << " 1\nend_probabilistic_operator\n";
+    }
+
+    return out.str();
+}
+
+void expect_applicable_operators(
+    const ProbabilisticTaskProxy& task_proxy,
+    const successor_generator::ProbabilisticSuccessorGenerator& generator,
+    const State& state)
+{
+    std::vector<int> expected;
+    for (const ProbabilisticOperatorProxy op : task_proxy.get_operators()) {
+        if (probfd::task_properties::is_applicable(op, state)) {
+            expected.push_back(op.get_id());
+        }
+    }
+
+    std::vector<OperatorID> applicable_ops;
+    generator.generate_applicable_ops(state, applicable_ops);
+
+    std::vector<int> applicable;
+    for (const OperatorID op_id : applicable_ops) {
+        applicable.push_back(op_id.get_index());
+    }
+    std::ranges::sort(applicable);
+
+    ASSERT_EQ(applicable, expected);
+}
+
+} // namespace
 
 TEST(TaskTests, test_read_sas_task)
 {
@@ -20,4 +426,168 @@ TEST(TaskTests, test_read_sas_task)
         task->get_initial_state_values(),
         std::vector({1, 0, 0, 0, 1, 6, 6, 5, 1, 6, 0}));
     ASSERT_EQ(task->get_num_goals(), 7);
-}
\ No newline at end of file
+}
+
+TEST(TaskTests, test_binary_task_round_trip)
+{
+    std::fstream file("resources/test1.sas");
+    auto text_task = tasks::read_sas_task(file);
+
+    std::istringstream in(read_binary_test_task());
+    ASSERT_TRUE(tasks::is_binary_task(in));
+
+    auto binary_task = tasks::read_sas_task(in);
+    expect_same_task(*text_task, *binary_task);
+}
+
+TEST(TaskTests, test_binary_task_from_standard_input)
+{
+    // The file is mapped into memory.
+    EXPECT_EXIT(read_from_standard_input(""), testing::ExitedWithCode(0), "");
+
+    // The task does not start at the beginning of the file, so the remaining
+    // input is read instead.
+    EXPECT_EXIT(
+        read_from_standard_input("prefix"),
+        testing::ExitedWithCode(0),
+        "");
+}
+
+TEST(TaskTests, test_is_binary_task_checks_header)
+{
+    std::string contents = read_binary_test_task();
+
+    std::istringstream text_in("begin_version\n3\nend_version\n");
+    ASSERT_FALSE(tasks::is_binary_task(text_in));
+    ASSERT_EQ(text_in.tellg(), 0);
+
+    // Only the first byte of the magic number matches.
+    contents[1] = 'X';
+    std::istringstream in(contents);
+    ASSERT_FALSE(tasks::is_binary_task(in));
+    ASSERT_EQ(in.tellg(), 0);
+
+    // Unsupported format version.
+    contents = read_binary_test_task();
+    contents[8] ^= 0x7f;
+    std::istringstream version_in(contents);
+    ASSERT_FALSE(tasks::is_binary_task(version_in));
+    ASSERT_EQ(version_in.tellg(), 0);
+
+    // Truncated magic number.
+    std::istringstream truncated_in(contents.substr(0, 4));
+    ASSERT_FALSE(tasks::is_binary_task(truncated_in));
+    ASSERT_EQ(truncated_in.tellg(), 0);
+}
+
+TEST(TaskTests, test_binary_task_rejects_malformed_input)
+{
+    const std::string contents = read_binary_test_task();
+    const auto input_error = testing::ExitedWithCode(
+        static_cast<int>(utils::ExitCode::SEARCH_INPUT_ERROR));
+
+    // Truncated header.
+    EXPECT_EXIT(
+        read_from_string(contents.substr(0, 12)),
+        input_error,
+        "header is truncated");
+
+    // Truncated sections.
+    EXPECT_EXIT(
+        read_from_string(contents.substr(0, contents.size() / 2)),
+        input_error,
+        "is corrupt");
+
+    // Wrong magic number.
+    std::string wrong_magic = contents;
+    wrong_magic[7] = 'X';
+    EXPECT_EXIT(
+        read_from_string(wrong_magic),
+        input_error,
+        "wrong magic number");
+
+    // Unsupported format version, stored after the magic number.
+    std::string wrong_version = contents;
+    wrong_version[8] ^= 0x7f;
+    EXPECT_EXIT(
+        read_from_string(wrong_version),
+        input_error,
+        "expected format version");
+}
+
+TEST(TaskTests, test_operator_table)
+{
+    std::fstream file("resources/test1.sas");
+    std::shared_ptr<ProbabilisticTask> text_task = tasks::read_sas_task(file);
+    expect_consistent_operator_table(text_task);
+
+    std::istringstream in(read_binary_test_task());
+    std::shared_ptr<ProbabilisticTask> binary_task = tasks::read_sas_task(in);
+    expect_consistent_operator_table(binary_task);
+}
+
+TEST(TaskTests, test_successor_generator)
+{
+    /*
+      The preconditions on the first variable, with its large domain, lead to
+      a sorted switch. Those on the second variable cover its whole domain and
+      lead to a vector switch, and the single precondition on the third
+      variable leads to a single-value switch. Operators with the same
+      preconditions share a leaf, and all switches are combined by forks.
+    */
+    std::istringstream in(write_successor_generator_test_task(
+        {100, 3, 2, 2},
+        {{{0, 5}},
+         {{0, 50}},
+         {{0, 5}, {1, 2}},
+         {{0, 5}, {1, 2}},
+         {{1, 0}},
+         {{1, 1}},
+         {{1, 2}},
+         {{2, 1}},
+         {{1, 1}, {2, 0}, {3, 1}},
+         {}}));
+
+    std::shared_ptr<ProbabilisticTask> task = tasks::read_sas_task(in);
+    const ProbabilisticTaskProxy task_proxy(*task);
+    ASSERT_EQ(task_proxy.get_operators().size(), 107 + 10);
+
+    const successor_generator::ProbabilisticSuccessorGenerator generator(
+        task_proxy);
+
+    // Register all states by a breadth-first search.
+    StateRegistry registry(task_proxy);
+    std::vector<State> queue = {registry.get_initial_state()};
+
+    for (std::size_t i = 0; i != queue.size(); ++i) {
+        const State state = queue[i];
+
+        for (const ProbabilisticOperatorProxy op : task_proxy.get_operators()) {
+            if (!probfd::task_properties::is_applicable(op, state)) continue;
+
+            for (const auto outcome : op.get_outcomes()) {
+                State successor =
+                    registry.get_successor_state(state, outcome.get_effects());
+                // The state is new if the registry grew.
+                if (registry.size() != queue.size()) {
+                    queue.push_back(std::move(successor));
+                }
+            }
+        }
+    }
+
+    ASSERT_EQ(queue.size(), 100 * 3 * 2 * 2);
+
+    for (const State& state : queue) {
+        // Registered states are read from their packed buffers...
+        expect_applicable_operators(task_proxy, generator, state);
+
+        // ...and states without registry from their unpacked values.
+        state.unpack();
+        std::vector<int> values = state.get_unpacked_values();
+        expect_applicable_operators(
+            task_proxy,
+            generator,
+            task_proxy.create_state(std::move(values)));
+    }
+}